@@ -73,13 +73,14 @@ KeyedService* AdsServiceFactory::BuildServiceInstanceFor(
       brave_adaptive_captcha::BraveAdaptiveCaptchaServiceFactory::GetInstance()
           ->GetForProfile(profile);
 #endif
-  brave_federated::AsyncDataStore* notification_ad_async_data_store = nullptr;
+  brave_federated::AsyncColumnarDataStore* notification_ad_async_data_store =
+      nullptr;
   auto* federated_service =
       brave_federated::BraveFederatedServiceFactory::GetForBrowserContext(
           profile);
   if (federated_service) {
     notification_ad_async_data_store =
-        federated_service->GetDataStoreService()->GetDataStore(
+        federated_service->GetDataStoreService()->GetColumnarDataStore(
             brave_federated::kNotificationAdTaskName);
   }
 
@@ -6,18 +6,17 @@
 #include "brave/browser/brave_ads/ads_tab_helper.h"
 
 #include <memory>
-#include <string>
+#include <utility>
 
 #include "brave/browser/brave_ads/ads_service_factory.h"
 #include "brave/browser/brave_ads/search_result_ad/search_result_ad_service_factory.h"
 #include "brave/components/brave_ads/content/browser/search_result_ad/search_result_ad_service.h"
 #include "chrome/browser/profiles/profile.h"
-#include "components/dom_distiller/content/browser/distiller_javascript_utils.h"
-#include "components/dom_distiller/content/browser/distiller_page_web_contents.h"
 #include "components/sessions/content/session_tab_helper.h"
 #include "content/public/browser/navigation_handle.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/web_contents.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
 #include "ui/base/page_transition_types.h"
 #include "ui/base/resource/resource_bundle.h"
 #include "url/gurl.h"
@@ -30,6 +29,13 @@
 
 namespace brave_ads {
 
+namespace {
+
+// Text beyond this size is not used for text classification.
+constexpr uint32_t kMaximumTextSize = 1 << 20;
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       content::WebContentsUserData<AdsTabHelper>(*web_contents),
@@ -67,43 +73,36 @@ void AdsTabHelper::TabUpdated() {
                              is_active_, is_browser_active_);
 }
 
-void AdsTabHelper::RunIsolatedJavaScript(
+void AdsTabHelper::ExtractPageContent(
     content::RenderFrameHost* render_frame_host) {
   DCHECK(render_frame_host);
 
-  dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "new XMLSerializer().serializeToString(document)",
-      base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
-                     weak_factory_.GetWeakPtr()));
-
-  dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "document?.body?.innerText",
-      base::BindOnce(&AdsTabHelper::OnJavaScriptTextResult,
-                     weak_factory_.GetWeakPtr()));
-}
-
-void AdsTabHelper::OnJavaScriptHtmlResult(base::Value value) {
-  if (!ads_service_) {
+  if (!ads_service_ || !ads_service_->IsEnabled()) {
     return;
   }
 
-  if (!value.is_string()) {
-    return;
-  }
-  const std::string& html = value.GetString();
-  ads_service_->OnHtmlLoaded(tab_id_, redirect_chain_, html);
+  // Rebinding drops the reply to a previous extraction which is still pending,
+  // as the content it would report no longer belongs to |redirect_chain_|.
+  page_content_extractor_.reset();
+  render_frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+      &page_content_extractor_);
+
+  // The markup is only used to extract conversion ids.
+  page_content_extractor_->ExtractPageContent(
+      kMaximumTextSize, ads_service_->ShouldAllowConversionTracking(),
+      base::BindOnce(&AdsTabHelper::OnPageContentExtracted,
+                     weak_factory_.GetWeakPtr()));
 }
 
-void AdsTabHelper::OnJavaScriptTextResult(base::Value value) {
+void AdsTabHelper::OnPageContentExtracted(
+    base::ReadOnlySharedMemoryRegion text,
+    base::ReadOnlySharedMemoryRegion html) {
   if (!ads_service_) {
     return;
   }
 
-  if (!value.is_string()) {
-    return;
-  }
-  const std::string& text = value.GetString();
-  ads_service_->OnTextLoaded(tab_id_, redirect_chain_, text);
+  ads_service_->OnHtmlLoaded(tab_id_, redirect_chain_, std::move(html));
+  ads_service_->OnTextLoaded(tab_id_, redirect_chain_, std::move(text));
 }
 
 void AdsTabHelper::DidFinishNavigation(
@@ -136,7 +135,7 @@ void AdsTabHelper::DidFinishNavigation(
   content::RenderFrameHost* render_frame_host =
       navigation_handle->GetRenderFrameHost();
 
-  RunIsolatedJavaScript(render_frame_host);
+  ExtractPageContent(render_frame_host);
 }
 
 void AdsTabHelper::DocumentOnLoadCompletedInPrimaryMainFrame() {
@@ -150,7 +149,7 @@ void AdsTabHelper::DocumentOnLoadCompletedInPrimaryMainFrame() {
     return;
   }
 
-  RunIsolatedJavaScript(render_frame_host);
+  ExtractPageContent(render_frame_host);
 }
 
 void AdsTabHelper::DidFinishLoad(content::RenderFrameHost* render_frame_host,
@@ -9,12 +9,15 @@
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/weak_ptr.h"
+#include "brave/components/brave_ads/common/page_content_extractor.mojom.h"
 #include "build/build_config.h"
 #include "components/sessions/core/session_id.h"
 #include "content/public/browser/media_player_id.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
+#include "mojo/public/cpp/bindings/associated_remote.h"
 
 #if !BUILDFLAG(IS_ANDROID)
 #include "chrome/browser/ui/browser_list_observer.h"
@@ -23,16 +26,6 @@
 class Browser;
 class GURL;
 
-namespace dom_distiller {
-
-class DistillerPage;
-
-namespace proto {
-class DomDistillerResult;
-}  // namespace proto
-
-}  // namespace dom_distiller
-
 namespace brave_ads {
 
 class AdsService;
@@ -55,11 +48,10 @@ class AdsTabHelper : public content::WebContentsObserver,
 
   void TabUpdated();
 
-  void RunIsolatedJavaScript(content::RenderFrameHost* render_frame_host);
-
-  void OnJavaScriptHtmlResult(base::Value value);
+  void ExtractPageContent(content::RenderFrameHost* render_frame_host);
 
-  void OnJavaScriptTextResult(base::Value value);
+  void OnPageContentExtracted(base::ReadOnlySharedMemoryRegion text,
+                              base::ReadOnlySharedMemoryRegion html);
 
   // content::WebContentsObserver overrides
   void DidFinishNavigation(
@@ -90,6 +82,7 @@ class AdsTabHelper : public content::WebContentsObserver,
   bool is_browser_active_ = true;
   std::vector<GURL> redirect_chain_;
   bool should_process_ = false;
+  mojo::AssociatedRemote<mojom::PageContentExtractor> page_content_extractor_;
 
   base::WeakPtrFactory<AdsTabHelper> weak_factory_;
   WEB_CONTENTS_USER_DATA_KEY_DECL();
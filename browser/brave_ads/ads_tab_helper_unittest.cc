@@ -0,0 +1,220 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/brave_ads/ads_tab_helper.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/strings/string_piece.h"
+#include "brave/browser/brave_ads/ads_service_factory.h"
+#include "brave/components/brave_ads/browser/mock_ads_service.h"
+#include "brave/components/brave_ads/common/page_content_extractor.mojom.h"
+#include "chrome/browser/sessions/session_tab_helper_factory.h"
+#include "chrome/test/base/chrome_render_view_host_test_harness.h"
+#include "components/sessions/core/session_id.h"
+#include "content/public/test/navigation_simulator.h"
+#include "mojo/public/cpp/bindings/associated_receiver.h"
+#include "mojo/public/cpp/bindings/pending_associated_receiver.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=AdsTabHelperTest*
+
+using testing::_;
+using testing::ElementsAre;
+using testing::NiceMock;
+using testing::Return;
+
+namespace brave_ads {
+
+namespace {
+
+constexpr char kUrl[] = "https://brave.com/";
+constexpr char kSameDocumentUrl[] = "https://brave.com/#privacy";
+constexpr char kText[] = "Hello World";
+constexpr char kHtml[] = "<html><body>Hello World</body></html>";
+
+base::ReadOnlySharedMemoryRegion CopyToRegion(base::StringPiece value) {
+  base::MappedReadOnlyRegion shared_memory =
+      base::ReadOnlySharedMemoryRegion::Create(value.size());
+  value.copy(shared_memory.mapping.GetMemoryAs<char>(), value.size());
+  return std::move(shared_memory.region);
+}
+
+std::string ReadRegion(const base::ReadOnlySharedMemoryRegion& region) {
+  if (!region.IsValid()) {
+    return {};
+  }
+
+  const base::ReadOnlySharedMemoryMapping mapping = region.Map();
+  return std::string(mapping.GetMemoryAs<char>(), mapping.size());
+}
+
+class FakePageContentExtractor final : public mojom::PageContentExtractor {
+ public:
+  FakePageContentExtractor() = default;
+  FakePageContentExtractor(const FakePageContentExtractor&) = delete;
+  FakePageContentExtractor& operator=(const FakePageContentExtractor&) =
+      delete;
+  ~FakePageContentExtractor() override = default;
+
+  void BindReceiver(mojo::ScopedInterfaceEndpointHandle handle) {
+    receiver_.reset();
+    receiver_.Bind(mojo::PendingAssociatedReceiver<mojom::PageContentExtractor>(
+        std::move(handle)));
+  }
+
+  int extract_page_content_count() const {
+    return extract_page_content_count_;
+  }
+
+  bool last_include_html() const { return last_include_html_; }
+
+ private:
+  // mojom::PageContentExtractor:
+  void ExtractPageContent(const uint32_t max_text_size,
+                          const bool include_html,
+                          ExtractPageContentCallback callback) override {
+    extract_page_content_count_++;
+    last_include_html_ = include_html;
+
+    std::move(callback).Run(CopyToRegion(kText),
+                            include_html ? CopyToRegion(kHtml)
+                                         : base::ReadOnlySharedMemoryRegion());
+  }
+
+  int extract_page_content_count_ = 0;
+  bool last_include_html_ = false;
+
+  mojo::AssociatedReceiver<mojom::PageContentExtractor> receiver_{this};
+};
+
+}  // namespace
+
+class AdsTabHelperTest : public ChromeRenderViewHostTestHarness {
+ public:
+  AdsTabHelperTest() = default;
+  AdsTabHelperTest(const AdsTabHelperTest&) = delete;
+  AdsTabHelperTest& operator=(const AdsTabHelperTest&) = delete;
+  ~AdsTabHelperTest() override = default;
+
+  void SetUp() override {
+    ChromeRenderViewHostTestHarness::SetUp();
+
+    ads_service_ = static_cast<NiceMock<MockAdsService>*>(
+        AdsServiceFactory::GetForProfile(profile()));
+    ASSERT_TRUE(ads_service_);
+
+    CreateSessionServiceTabHelper(web_contents());
+    AdsTabHelper::CreateForWebContents(web_contents());
+
+    NavigateAndCommit(GURL(kUrl));
+
+    main_rfh()->GetRemoteAssociatedInterfaces()->OverrideBinderForTesting(
+        mojom::PageContentExtractor::Name_,
+        base::BindRepeating(&FakePageContentExtractor::BindReceiver,
+                            base::Unretained(&page_content_extractor_)));
+  }
+
+  TestingProfile::TestingFactories GetTestingFactories() const override {
+    return {{AdsServiceFactory::GetInstance(),
+             base::BindRepeating([](content::BrowserContext* context)
+                                     -> std::unique_ptr<KeyedService> {
+               return std::make_unique<NiceMock<MockAdsService>>();
+             })}};
+  }
+
+  void NavigateSameDocument() {
+    content::NavigationSimulator::CreateRendererInitiated(
+        GURL(kSameDocumentUrl), main_rfh())
+        ->CommitSameDocument();
+    task_environment()->RunUntilIdle();
+  }
+
+ protected:
+  raw_ptr<NiceMock<MockAdsService>> ads_service_ = nullptr;  // NOT OWNED
+  FakePageContentExtractor page_content_extractor_;
+};
+
+TEST_F(AdsTabHelperTest, ForwardExtractedPageContentWithRedirectChain) {
+  // Arrange
+  ON_CALL(*ads_service_, IsEnabled()).WillByDefault(Return(true));
+  ON_CALL(*ads_service_, ShouldAllowConversionTracking())
+      .WillByDefault(Return(true));
+
+  std::string html;
+  EXPECT_CALL(*ads_service_,
+              OnHtmlLoaded(_, ElementsAre(GURL(kSameDocumentUrl)), _))
+      .WillOnce([&html](const SessionID& tab_id,
+                        const std::vector<GURL>& redirect_chain,
+                        base::ReadOnlySharedMemoryRegion region) {
+        html = ReadRegion(region);
+      });
+
+  std::string text;
+  EXPECT_CALL(*ads_service_,
+              OnTextLoaded(_, ElementsAre(GURL(kSameDocumentUrl)), _))
+      .WillOnce([&text](const SessionID& tab_id,
+                        const std::vector<GURL>& redirect_chain,
+                        base::ReadOnlySharedMemoryRegion region) {
+        text = ReadRegion(region);
+      });
+
+  // Act
+  NavigateSameDocument();
+
+  // Assert
+  EXPECT_TRUE(page_content_extractor_.last_include_html());
+  EXPECT_EQ(kHtml, html);
+  EXPECT_EQ(kText, text);
+}
+
+TEST_F(AdsTabHelperTest, ForwardEmptyHtmlIfConversionTrackingIsNotAllowed) {
+  // Arrange
+  ON_CALL(*ads_service_, IsEnabled()).WillByDefault(Return(true));
+  ON_CALL(*ads_service_, ShouldAllowConversionTracking())
+      .WillByDefault(Return(false));
+
+  bool is_html_region_valid = true;
+  EXPECT_CALL(*ads_service_, OnHtmlLoaded)
+      .WillOnce([&is_html_region_valid](
+                    const SessionID& tab_id,
+                    const std::vector<GURL>& redirect_chain,
+                    base::ReadOnlySharedMemoryRegion region) {
+        is_html_region_valid = region.IsValid();
+      });
+  EXPECT_CALL(*ads_service_, OnTextLoaded);
+
+  // Act
+  NavigateSameDocument();
+
+  // Assert
+  EXPECT_FALSE(page_content_extractor_.last_include_html());
+  EXPECT_FALSE(is_html_region_valid);
+}
+
+TEST_F(AdsTabHelperTest, DoNotExtractPageContentIfAdsAreDisabled) {
+  // Arrange
+  ON_CALL(*ads_service_, IsEnabled()).WillByDefault(Return(false));
+
+  EXPECT_CALL(*ads_service_, OnHtmlLoaded).Times(0);
+  EXPECT_CALL(*ads_service_, OnTextLoaded).Times(0);
+
+  // Act
+  NavigateSameDocument();
+
+  // Assert
+  EXPECT_EQ(0, page_content_extractor_.extract_page_content_count());
+}
+
+}  // namespace brave_ads
@@ -201,13 +201,15 @@ brave_shields::AdBlockService* BraveBrowserProcessImpl::ad_block_service() {
         base::ThreadPool::CreateSequencedTaskRunner(
             {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
              base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}));
+    const base::FilePath profile_dir =
+        profile_manager()->user_data_dir().Append(
+            profile_manager()->GetInitialProfileDir());
     ad_block_service_ = std::make_unique<brave_shields::AdBlockService>(
         local_state(), GetApplicationLocale(), component_updater(), task_runner,
+        profile_dir,
         std::make_unique<brave_shields::AdBlockSubscriptionServiceManager>(
             local_state(), task_runner,
-            AdBlockSubscriptionDownloadManagerGetter(),
-            profile_manager()->user_data_dir().Append(
-                profile_manager()->GetInitialProfileDir())));
+            AdBlockSubscriptionDownloadManagerGetter(), profile_dir));
   }
   return ad_block_service_.get();
 }
@@ -36,6 +36,7 @@
 #include "brave/components/brave_ads/common/features.h"
 #include "brave/components/brave_federated/features.h"
 #include "brave/components/brave_rewards/browser/rewards_protocol_handler.h"
+#include "brave/components/brave_search/browser/backup_results_service.h"
 #include "brave/components/brave_search/browser/brave_search_default_host.h"
 #include "brave/components/brave_search/browser/brave_search_default_host_private.h"
 #include "brave/components/brave_search/browser/brave_search_fallback_host.h"
@@ -356,10 +357,13 @@ void BindBraveSearchFallbackHost(
     return;
 
   content::BrowserContext* context = render_process_host->GetBrowserContext();
+  auto* backup_results_service =
+      brave_search::BackupResultsService::GetOrCreate(
+          context, context->GetDefaultStoragePartition()
+                       ->GetURLLoaderFactoryForBrowserProcess());
   mojo::MakeSelfOwnedReceiver(
       std::make_unique<brave_search::BraveSearchFallbackHost>(
-          context->GetDefaultStoragePartition()
-              ->GetURLLoaderFactoryForBrowserProcess()),
+          backup_results_service->GetWeakPtr()),
       std::move(receiver));
 }
 
@@ -2113,6 +2113,27 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringCustomStyle) {
   EXPECT_EQ(base::Value(true), result.value);
 }
 
+// Test hiding 10k elements matched by generic class selectors
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringManySelectors) {
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  std::string rules;
+  for (int i = 0; i < 10000; i++) {
+    rules += base::StringPrintf("##.generic-ad-%d\n", i);
+  }
+  UpdateAdBlockInstanceWithRules(rules);
+
+  GURL tab_url = embedded_test_server()->GetURL(
+      "b.com", "/cosmetic_filtering_many_selectors.html");
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(browser(), tab_url));
+
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+
+  auto result = EvalJs(contents, "waitForAllHidden()");
+  ASSERT_TRUE(result.error.empty());
+  EXPECT_EQ(10000, EvalJs(contents, "countHidden()"));
+}
+
 // Test rules overridden by hostname-specific exception rules
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringUnhide) {
   ASSERT_TRUE(InstallDefaultAdBlockExtension());
@@ -6,10 +6,16 @@
 #include "brave/components/brave_wallet/browser/eth_pending_tx_tracker.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "base/bind.h"
+#include "base/containers/flat_map.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/memory/raw_ptr.h"
 #include "base/test/bind.h"
+#include "base/values.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/eth_nonce_tracker.h"
 #include "brave/components/brave_wallet/browser/eth_transaction.h"
@@ -32,6 +38,116 @@
 
 namespace brave_wallet {
 
+namespace {
+
+// A local JSON-RPC node which answers eth_getTransactionReceipt calls, alone
+// or in a batch, from the receipts it was given.
+class FakeJsonRpcNode {
+ public:
+  explicit FakeJsonRpcNode(network::TestURLLoaderFactory* url_loader_factory)
+      : url_loader_factory_(url_loader_factory) {
+    url_loader_factory_->SetInterceptor(base::BindRepeating(
+        &FakeJsonRpcNode::OnRequest, base::Unretained(this)));
+  }
+
+  // Transactions without a receipt are reported as pending.
+  void SetReceiptStatus(const std::string& tx_hash, bool status) {
+    receipt_statuses_[tx_hash] = status;
+  }
+
+  // Answers batches with a single error, as nodes without batch support do.
+  void set_reject_batches(bool reject_batches) {
+    reject_batches_ = reject_batches;
+  }
+
+  size_t request_count() const { return request_count_; }
+  size_t receipt_call_count() const { return receipt_call_count_; }
+
+ private:
+  base::Value::Dict HandleCall(const base::Value::Dict& call) {
+    base::Value::Dict response;
+    response.Set("jsonrpc", "2.0");
+    if (const base::Value* id = call.Find("id"))
+      response.Set("id", id->Clone());
+
+    const std::string* method = call.FindString("method");
+    const base::Value::List* params = call.FindList("params");
+    if (!method || *method != "eth_getTransactionReceipt" || !params ||
+        params->empty() || !(*params)[0].is_string()) {
+      base::Value::Dict error;
+      error.Set("code", -32601);
+      error.Set("message", "Method not found");
+      response.Set("error", std::move(error));
+      return response;
+    }
+
+    ++receipt_call_count_;
+    const std::string& tx_hash = (*params)[0].GetString();
+    auto it = receipt_statuses_.find(tx_hash);
+    if (it == receipt_statuses_.end()) {
+      response.Set("result", base::Value());
+      return response;
+    }
+    base::Value::Dict receipt;
+    receipt.Set("transactionHash", tx_hash);
+    receipt.Set("transactionIndex", "0x1");
+    receipt.Set("blockNumber", "0xb");
+    receipt.Set(
+        "blockHash",
+        "0xc6ef2fc5426d6ad6fd9e2a26abeab0aa2411b7ab17f30a99d3cb96aed1d1055b");
+    receipt.Set("cumulativeGasUsed", "0x33bc");
+    receipt.Set("gasUsed", "0x4dc");
+    receipt.Set("contractAddress",
+                "0xb60e8dd61c5d32be8058bb8eb970870f07233155");
+    receipt.Set("logs", base::Value::List());
+    receipt.Set("logsBloom", "0x00...0");
+    receipt.Set("status", it->second ? "0x1" : "0x0");
+    response.Set("result", std::move(receipt));
+    return response;
+  }
+
+  void OnRequest(const network::ResourceRequest& request) {
+    ++request_count_;
+    url_loader_factory_->ClearResponses();
+    base::StringPiece request_string(request.request_body->elements()
+                                         ->at(0)
+                                         .As<network::DataElementBytes>()
+                                         .AsStringPiece());
+    absl::optional<base::Value> request_value =
+        base::JSONReader::Read(request_string);
+    ASSERT_TRUE(request_value);
+
+    std::string response;
+    if (request_value->is_list() && reject_batches_) {
+      base::Value::Dict error;
+      error.Set("code", -32600);
+      error.Set("message", "Batch requests are not supported");
+      base::Value::Dict rejection;
+      rejection.Set("jsonrpc", "2.0");
+      rejection.Set("id", base::Value());
+      rejection.Set("error", std::move(error));
+      base::JSONWriter::Write(base::Value(std::move(rejection)), &response);
+    } else if (request_value->is_list()) {
+      base::Value::List batch;
+      for (const auto& call : request_value->GetList())
+        batch.Append(HandleCall(call.GetDict()));
+      base::JSONWriter::Write(base::Value(std::move(batch)), &response);
+    } else {
+      base::JSONWriter::Write(
+          base::Value(HandleCall(request_value->GetDict())), &response);
+    }
+    url_loader_factory_->AddResponse(request.url.spec(), response);
+  }
+
+  raw_ptr<network::TestURLLoaderFactory> url_loader_factory_;
+  base::flat_map<std::string, bool> receipt_statuses_;
+  size_t request_count_ = 0;
+  size_t receipt_call_count_ = 0;
+  bool reject_batches_ = false;
+};
+
+}  // namespace
+
 class EthPendingTxTrackerUnitTest : public testing::Test {
  public:
   EthPendingTxTrackerUnitTest() {
@@ -83,6 +199,7 @@ TEST_F(EthPendingTxTrackerUnitTest, IsNonceTaken) {
   meta.set_id(TxMeta::GenerateMetaID());
   meta.tx()->set_nonce(uint256_t(123));
 
+  pending_tx_tracker.UpdateConfirmedNonces();
   EXPECT_FALSE(pending_tx_tracker.IsNonceTaken(meta));
 
   EthTxMeta meta_in_state;
@@ -92,7 +209,14 @@ TEST_F(EthPendingTxTrackerUnitTest, IsNonceTaken) {
   meta_in_state.tx()->set_nonce(uint256_t(123));
   tx_state_manager.AddOrUpdateTx(meta_in_state);
 
+  pending_tx_tracker.UpdateConfirmedNonces();
   EXPECT_TRUE(pending_tx_tracker.IsNonceTaken(meta));
+
+  // Nonces of other accounts don't count.
+  meta.set_from(
+      EthAddress::FromHex("0x2f015c60e0be116b1f0cd534704db9c92118fb6b")
+          .ToChecksumAddress());
+  EXPECT_FALSE(pending_tx_tracker.IsNonceTaken(meta));
 }
 
 TEST_F(EthPendingTxTrackerUnitTest, ShouldTxDropped) {
@@ -157,51 +281,40 @@ TEST_F(EthPendingTxTrackerUnitTest, UpdatePendingTransactions) {
   base::RunLoop().RunUntilIdle();
   EthTxMeta meta;
   meta.set_id("001");
+  meta.set_tx_hash("0x1");
   meta.set_from(addr1);
   meta.set_status(mojom::TransactionStatus::Submitted);
   tx_state_manager.AddOrUpdateTx(meta);
   meta.set_id("002");
+  meta.set_tx_hash("0x2");
   meta.set_from(addr2);
   meta.tx()->set_nonce(uint256_t(4));
   meta.set_status(mojom::TransactionStatus::Confirmed);
   tx_state_manager.AddOrUpdateTx(meta);
   meta.set_id("003");
+  meta.set_tx_hash("0x3");
   meta.set_from(addr2);
   meta.tx()->set_nonce(uint256_t(4));
   meta.set_status(mojom::TransactionStatus::Submitted);
   tx_state_manager.AddOrUpdateTx(meta);
   meta.set_id("004");
+  meta.set_tx_hash("0x4");
   meta.set_from(addr2);
   meta.tx()->set_nonce(uint256_t(5));
   meta.set_status(mojom::TransactionStatus::Submitted);
   tx_state_manager.AddOrUpdateTx(meta);
 
-  test_url_loader_factory()->SetInterceptor(
-      base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
-        test_url_loader_factory()->AddResponse(
-            request.url.spec(),
-            "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":{"
-            "\"transactionHash\":"
-            "\"0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce5682"
-            "38\","
-            "\"transactionIndex\":  \"0x1\","
-            "\"blockNumber\": \"0xb\","
-            "\"blockHash\": "
-            "\"0xc6ef2fc5426d6ad6fd9e2a26abeab0aa2411b7ab17f30a99d3cb96aed1d105"
-            "5b\","
-            "\"cumulativeGasUsed\": \"0x33bc\","
-            "\"gasUsed\": \"0x4dc\","
-            "\"contractAddress\": "
-            "\"0xb60e8dd61c5d32be8058bb8eb970870f07233155\","
-            "\"logs\": [],"
-            "\"logsBloom\": \"0x00...0\","
-            "\"status\": \"0x1\"}}");
-      }));
+  FakeJsonRpcNode node(test_url_loader_factory());
+  node.SetReceiptStatus("0x1", true);
+  node.SetReceiptStatus("0x4", true);
 
   size_t num_pending;
-  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(&num_pending));
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(1, &num_pending));
   EXPECT_EQ(3UL, num_pending);
   WaitForResponse();
+  // 003 is dropped for its nonce, the others share one request.
+  EXPECT_EQ(node.request_count(), 1u);
+  EXPECT_EQ(node.receipt_call_count(), 2u);
   auto meta_from_state = tx_state_manager.GetEthTx("001");
   ASSERT_NE(meta_from_state, nullptr);
   EXPECT_EQ(meta_from_state->status(), mojom::TransactionStatus::Confirmed);
@@ -218,4 +331,153 @@ TEST_F(EthPendingTxTrackerUnitTest, UpdatePendingTransactions) {
             "0xb60e8dd61c5d32be8058bb8eb970870f07233155");
 }
 
+TEST_F(EthPendingTxTrackerUnitTest,
+       UpdatePendingTransactionsWithoutBatchSupport) {
+  std::string addr =
+      EthAddress::FromHex("0x2f015c60e0be116b1f0cd534704db9c92118fb6a")
+          .ToChecksumAddress();
+  JsonRpcService service(shared_url_loader_factory(), GetPrefs());
+  EthTxStateManager tx_state_manager(GetPrefs(), &service);
+  EthNonceTracker nonce_tracker(&tx_state_manager, &service);
+  EthPendingTxTracker pending_tx_tracker(&tx_state_manager, &service,
+                                         &nonce_tracker);
+  base::RunLoop().RunUntilIdle();
+  FakeJsonRpcNode node(test_url_loader_factory());
+  node.set_reject_batches(true);
+  node.SetReceiptStatus("0x1", true);
+
+  EthTxMeta meta;
+  meta.set_id("001");
+  meta.set_tx_hash("0x1");
+  meta.set_from(addr);
+  meta.tx()->set_nonce(uint256_t(1));
+  meta.set_status(mojom::TransactionStatus::Submitted);
+  tx_state_manager.AddOrUpdateTx(meta);
+  meta.set_id("002");
+  meta.set_tx_hash("0x2");
+  meta.tx()->set_nonce(uint256_t(2));
+  tx_state_manager.AddOrUpdateTx(meta);
+
+  size_t num_pending;
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(1, &num_pending));
+  WaitForResponse();
+  // The rejected batch is followed by a request per receipt.
+  EXPECT_EQ(node.request_count(), 3u);
+  EXPECT_EQ(node.receipt_call_count(), 2u);
+  EXPECT_EQ(tx_state_manager.GetEthTx("001")->status(),
+            mojom::TransactionStatus::Confirmed);
+  EXPECT_EQ(tx_state_manager.GetEthTx("002")->status(),
+            mojom::TransactionStatus::Submitted);
+
+  // The node is not sent batches again.
+  meta.set_id("003");
+  meta.set_tx_hash("0x3");
+  meta.tx()->set_nonce(uint256_t(3));
+  tx_state_manager.AddOrUpdateTx(meta);
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(2, &num_pending));
+  WaitForResponse();
+  EXPECT_EQ(node.request_count(), 5u);
+  EXPECT_EQ(node.receipt_call_count(), 4u);
+}
+
+TEST_F(EthPendingTxTrackerUnitTest,
+       UpdatePendingTransactionsWhileReceiptsAreFetched) {
+  std::string addr =
+      EthAddress::FromHex("0x2f015c60e0be116b1f0cd534704db9c92118fb6a")
+          .ToChecksumAddress();
+  JsonRpcService service(shared_url_loader_factory(), GetPrefs());
+  EthTxStateManager tx_state_manager(GetPrefs(), &service);
+  EthNonceTracker nonce_tracker(&tx_state_manager, &service);
+  EthPendingTxTracker pending_tx_tracker(&tx_state_manager, &service,
+                                         &nonce_tracker);
+  base::RunLoop().RunUntilIdle();
+  FakeJsonRpcNode node(test_url_loader_factory());
+
+  EthTxMeta meta;
+  meta.set_id("001");
+  meta.set_tx_hash("0x1");
+  meta.set_from(addr);
+  meta.tx()->set_nonce(uint256_t(1));
+  meta.set_status(mojom::TransactionStatus::Submitted);
+  tx_state_manager.AddOrUpdateTx(meta);
+
+  size_t num_pending;
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(1, &num_pending));
+  WaitForResponse();
+  EXPECT_EQ(node.request_count(), 1u);
+
+  // The receipt is only requested once at a new block, even before it arrives.
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(2, &num_pending));
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(2, &num_pending));
+  WaitForResponse();
+  EXPECT_EQ(node.request_count(), 2u);
+  EXPECT_EQ(node.receipt_call_count(), 2u);
+}
+
+TEST_F(EthPendingTxTrackerUnitTest, UpdatePendingTransactionsOncePerBlock) {
+  std::string addr =
+      EthAddress::FromHex("0x2f015c60e0be116b1f0cd534704db9c92118fb6a")
+          .ToChecksumAddress();
+  JsonRpcService service(shared_url_loader_factory(), GetPrefs());
+  EthTxStateManager tx_state_manager(GetPrefs(), &service);
+  EthNonceTracker nonce_tracker(&tx_state_manager, &service);
+  EthPendingTxTracker pending_tx_tracker(&tx_state_manager, &service,
+                                         &nonce_tracker);
+  base::RunLoop().RunUntilIdle();
+  FakeJsonRpcNode node(test_url_loader_factory());
+
+  EthTxMeta meta;
+  meta.set_id("001");
+  meta.set_tx_hash("0x1");
+  meta.set_from(addr);
+  meta.tx()->set_nonce(uint256_t(1));
+  meta.set_status(mojom::TransactionStatus::Submitted);
+  tx_state_manager.AddOrUpdateTx(meta);
+
+  size_t num_pending;
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(1, &num_pending));
+  WaitForResponse();
+  EXPECT_EQ(node.request_count(), 1u);
+
+  // Still pending at the same block, so no need to ask again.
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(1, &num_pending));
+  WaitForResponse();
+  EXPECT_EQ(1UL, num_pending);
+  EXPECT_EQ(node.request_count(), 1u);
+
+  // A transaction submitted meanwhile is checked alone.
+  meta.set_id("002");
+  meta.set_tx_hash("0x2");
+  meta.tx()->set_nonce(uint256_t(2));
+  tx_state_manager.AddOrUpdateTx(meta);
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(1, &num_pending));
+  WaitForResponse();
+  EXPECT_EQ(2UL, num_pending);
+  EXPECT_EQ(node.request_count(), 2u);
+  EXPECT_EQ(node.receipt_call_count(), 2u);
+
+  // Both are checked again once a new block arrives.
+  node.SetReceiptStatus("0x1", true);
+  node.SetReceiptStatus("0x2", true);
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(2, &num_pending));
+  WaitForResponse();
+  EXPECT_EQ(node.request_count(), 3u);
+  EXPECT_EQ(node.receipt_call_count(), 4u);
+  EXPECT_EQ(tx_state_manager.GetEthTx("001")->status(),
+            mojom::TransactionStatus::Confirmed);
+  EXPECT_EQ(tx_state_manager.GetEthTx("002")->status(),
+            mojom::TransactionStatus::Confirmed);
+
+  // An unknown block always checks.
+  meta.set_id("003");
+  meta.set_tx_hash("0x3");
+  meta.tx()->set_nonce(uint256_t(3));
+  tx_state_manager.AddOrUpdateTx(meta);
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(0, &num_pending));
+  WaitForResponse();
+  EXPECT_TRUE(pending_tx_tracker.UpdatePendingTransactions(0, &num_pending));
+  WaitForResponse();
+  EXPECT_EQ(node.request_count(), 5u);
+}
+
 }  // namespace brave_wallet
@@ -1286,6 +1286,78 @@ TEST_F(KeyringServiceUnitTest, LockAndUnlock) {
   }
 }
 
+TEST_F(KeyringServiceUnitTest, UnlockMigratesToHkdf) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitWithFeatures(
+      {brave_wallet::features::kBraveWalletFilecoinFeature}, {});
+  std::string mnemonic;
+  std::string encrypted_mnemonic;
+  {
+    KeyringService service(json_rpc_service(), GetPrefs());
+    // Filecoin keyring is created with a key derived from the password, like
+    // before keys were derived from the default keyring key
+    ASSERT_NE(service.CreateKeyring(mojom::kFilecoinKeyringId, "brave"),
+              nullptr);
+    ASSERT_NE(service.CreateKeyring(mojom::kDefaultKeyringId, "brave"),
+              nullptr);
+    ASSERT_TRUE(
+        AddFilecoinAccount(&service, "FIL Account 1", mojom::kFilecoinMainnet));
+    EXPECT_FALSE(service.IsKeyringUsingHkdf(mojom::kFilecoinKeyringId));
+    mnemonic = service.GetMnemonicForKeyringImpl(mojom::kFilecoinKeyringId);
+    ASSERT_FALSE(mnemonic.empty());
+    encrypted_mnemonic =
+        GetStringPrefForKeyring(kEncryptedMnemonic, mojom::kFilecoinKeyringId);
+  }
+  {
+    KeyringService service(json_rpc_service(), GetPrefs());
+    EXPECT_TRUE(Unlock(&service, "brave"));
+    EXPECT_FALSE(service.IsLocked(mojom::kFilecoinKeyringId));
+    EXPECT_TRUE(service.IsKeyringUsingHkdf(mojom::kFilecoinKeyringId));
+    EXPECT_TRUE(service.IsKeyringUsingHkdf(mojom::kFilecoinTestnetKeyringId));
+    EXPECT_NE(
+        GetStringPrefForKeyring(kEncryptedMnemonic, mojom::kFilecoinKeyringId),
+        encrypted_mnemonic);
+    EXPECT_EQ(service.GetMnemonicForKeyringImpl(mojom::kFilecoinKeyringId),
+              mnemonic);
+  }
+  {
+    KeyringService service(json_rpc_service(), GetPrefs());
+    EXPECT_FALSE(Unlock(&service, "brave1"));
+    EXPECT_TRUE(service.IsLocked(mojom::kFilecoinKeyringId));
+
+    EXPECT_TRUE(Unlock(&service, "brave"));
+    EXPECT_FALSE(service.IsLocked(mojom::kFilecoinKeyringId));
+    EXPECT_EQ(service.GetMnemonicForKeyringImpl(mojom::kFilecoinKeyringId),
+              mnemonic);
+    EXPECT_EQ(
+        1u,
+        service.GetAccountInfosForKeyring(mojom::kFilecoinKeyringId).size());
+  }
+}
+
+TEST_F(KeyringServiceUnitTest, LockCancelsPendingUnlock) {
+  {
+    KeyringService service(json_rpc_service(), GetPrefs());
+    ASSERT_TRUE(CreateWallet(&service, "brave"));
+  }
+
+  KeyringService service(json_rpc_service(), GetPrefs());
+  absl::optional<bool> result;
+  service.Unlock("brave", base::BindLambdaForTesting(
+                              [&](bool success) { result = success; }));
+  // Keys are derived on a worker thread
+  EXPECT_FALSE(result);
+
+  service.Lock();
+  ASSERT_TRUE(result);
+  EXPECT_FALSE(*result);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(service.IsLocked());
+
+  EXPECT_TRUE(Unlock(&service, "brave"));
+  EXPECT_FALSE(service.IsLocked());
+}
+
 TEST_F(KeyringServiceUnitTest, Reset) {
   KeyringService service(json_rpc_service(), GetPrefs());
   ASSERT_TRUE(CreateWallet(&service, "brave"));
@@ -3,8 +3,10 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include "base/callback_helpers.h"
 #include "base/containers/flat_map.h"
 #include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
 #include "base/memory/raw_ptr.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
@@ -23,10 +25,13 @@
 #include "brave/components/constants/brave_paths.h"
 #include "brave/components/greaselion/browser/greaselion_download_service.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
+#include "brave/components/greaselion/browser/greaselion_service_impl.h"
 #include "chrome/browser/extensions/extension_browsertest.h"
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/extension_file_task_runner.h"
+#include "extensions/browser/extension_registry.h"
 #include "extensions/common/file_util.h"
 #include "net/dns/mock_host_resolver.h"
 #include "ui/base/ui_base_switches.h"
@@ -37,6 +42,7 @@ using extensions::ExtensionBrowserTest;
 using greaselion::GreaselionDownloadService;
 using greaselion::GreaselionService;
 using greaselion::GreaselionServiceFactory;
+using greaselion::GreaselionServiceImpl;
 
 const char kTestDataDirectory[] = "greaselion-data";
 const char kEmbeddedTestServerDirectory[] = "greaselion";
@@ -562,7 +568,7 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, CleanShutdown) {
   ui_test_utils::WaitForBrowserToClose(browser());
 }
 
-IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, FoldersAreRemovedOnUpdate) {
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, CachedFoldersAreReusedOnUpdate) {
   ASSERT_TRUE(InstallMockExtension());
 
   auto io_runner = base::ThreadPool::CreateSequencedTaskRunner(
@@ -582,7 +588,7 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, FoldersAreRemovedOnUpdate) {
           GreaselionServiceFactory::GetInstallDirectory();
 
       base::FilePath extensions_dir =
-          extensions::file_util::GetInstallTempDir(install_dir);
+          GreaselionServiceImpl::GetCacheDirectory(install_dir);
 
       base::FileEnumerator enumerator(extensions_dir, false,
                                       base::FileEnumerator::DIRECTORIES);
@@ -617,6 +623,68 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, FoldersAreRemovedOnUpdate) {
   EXPECT_EQ(after_update, start_count);
 }
 
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, UnwantedFoldersArePruned) {
+  ASSERT_TRUE(InstallMockExtension());
+
+  const base::FilePath stale_dir =
+      GreaselionServiceImpl::GetCacheDirectory(
+          GreaselionServiceFactory::GetInstallDirectory())
+          .AppendASCII("0.0.0_stale");
+  {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    ASSERT_TRUE(base::CreateDirectory(stale_dir));
+  }
+
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(profile());
+  ASSERT_TRUE(greaselion_service);
+  greaselion_service->UpdateInstalledExtensions();
+  GreaselionServiceWaiter(greaselion_service).Wait();
+
+  // Pruning runs on the extension file task runner before the conversions.
+  base::RunLoop run_loop;
+  extensions::GetExtensionFileTaskRunner()->PostTaskAndReply(
+      FROM_HERE, base::DoNothing(), run_loop.QuitClosure());
+  run_loop.Run();
+
+  base::ScopedAllowBlockingForTesting allow_blocking;
+  EXPECT_FALSE(base::PathExists(stale_dir));
+  const auto extension_ids = greaselion_service->GetExtensionIdsForTesting();
+  ASSERT_FALSE(extension_ids.empty());
+
+  // The directories of loaded extensions are kept.
+  auto* registry = extensions::ExtensionRegistry::Get(profile());
+  for (const auto& extension_id : extension_ids) {
+    const extensions::Extension* extension =
+        registry->enabled_extensions().GetByID(extension_id);
+    ASSERT_TRUE(extension);
+    EXPECT_TRUE(base::PathExists(extension->path()));
+  }
+}
+
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       UnchangedExtensionsAreNotReloadedOnUpdate) {
+  ASSERT_TRUE(InstallMockExtension());
+
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(profile());
+  ASSERT_TRUE(greaselion_service);
+
+  auto extension_ids = greaselion_service->GetExtensionIdsForTesting();
+  ASSERT_GT(extension_ids.size(), 0UL);
+  auto* registry = extensions::ExtensionRegistry::Get(profile());
+  const extensions::Extension* extension =
+      registry->enabled_extensions().GetByID(extension_ids[0]);
+  ASSERT_TRUE(extension);
+
+  greaselion_service->UpdateInstalledExtensions();
+  GreaselionServiceWaiter(greaselion_service).Wait();
+
+  EXPECT_EQ(extension_ids, greaselion_service->GetExtensionIdsForTesting());
+  EXPECT_EQ(extension,
+            registry->enabled_extensions().GetByID(extension_ids[0]));
+}
+
 #if !BUILDFLAG(IS_MAC)
 IN_PROC_BROWSER_TEST_F(GreaselionServiceLocaleTestEnglish,
                        ScriptInjectionWithMessagesDefaultLocale) {
@@ -108,6 +108,34 @@ void BraveExternalProcessImporterClient::OnImportItemFinished(
   brave_profile_import_->ReportImportItemFinished(import_item);
 }
 
+void BraveExternalProcessImporterClient::OnHistoryImportStart(
+    uint32_t total_history_rows_count) {
+  // Groups are not accumulated, so there is nothing to reserve.
+}
+
+void BraveExternalProcessImporterClient::OnHistoryImportGroup(
+    const std::vector<ImporterURLRow>& history_rows_group,
+    int visit_source) {
+  if (cancelled_)
+    return;
+
+  bridge_->SetHistoryItems(history_rows_group,
+                           static_cast<importer::VisitSource>(visit_source));
+}
+
+void BraveExternalProcessImporterClient::OnFaviconsImportStart(
+    uint32_t total_favicons_count) {
+  // Groups are not accumulated, so there is nothing to reserve.
+}
+
+void BraveExternalProcessImporterClient::OnFaviconsImportGroup(
+    const favicon_base::FaviconUsageDataList& favicons_group) {
+  if (cancelled_)
+    return;
+
+  bridge_->SetFavicons(favicons_group);
+}
+
 void BraveExternalProcessImporterClient::OnCreditCardImportReady(
     const std::u16string& name_on_card,
     const std::u16string& expiration_month,
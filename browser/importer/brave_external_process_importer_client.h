@@ -7,6 +7,7 @@
 #define BRAVE_BROWSER_IMPORTER_BRAVE_EXTERNAL_PROCESS_IMPORTER_CLIENT_H_
 
 #include <string>
+#include <vector>
 
 #include "base/memory/weak_ptr.h"
 #include "brave/common/importer/profile_import.mojom.h"
@@ -34,6 +35,16 @@ class BraveExternalProcessImporterClient
   void Cancel() override;
   void CloseMojoHandles() override;
   void OnImportItemFinished(importer::ImportItem import_item) override;
+  // Brave's importers send history and favicons in several batches, which
+  // upstream would accumulate and import again with every later batch.
+  // Each group is passed to the bridge as it arrives instead.
+  void OnHistoryImportStart(uint32_t total_history_rows_count) override;
+  void OnHistoryImportGroup(
+      const std::vector<ImporterURLRow>& history_rows_group,
+      int visit_source) override;
+  void OnFaviconsImportStart(uint32_t total_favicons_count) override;
+  void OnFaviconsImportGroup(
+      const favicon_base::FaviconUsageDataList& favicons_group) override;
 
   // brave::mojom::ProfileImportObserver overrides:
   void OnCreditCardImportReady(const std::u16string& name_on_card,
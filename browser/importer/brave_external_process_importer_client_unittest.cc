@@ -0,0 +1,125 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/importer/brave_external_process_importer_client.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/memory/weak_ptr.h"
+#include "base/run_loop.h"
+#include "base/strings/number_conversions.h"
+#include "base/task/cancelable_task_tracker.h"
+#include "base/test/bind.h"
+#include "base/time/time.h"
+#include "brave/browser/importer/brave_in_process_importer_bridge.h"
+#include "chrome/browser/history/history_service_factory.h"
+#include "chrome/browser/importer/external_process_importer_host.h"
+#include "chrome/browser/importer/profile_writer.h"
+#include "chrome/common/importer/importer_data_types.h"
+#include "chrome/common/importer/importer_url_row.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/history/core/browser/history_service.h"
+#include "components/history/core/browser/history_types.h"
+#include "components/history/core/test/history_service_test_util.h"
+#include "components/keyed_service/core/service_access_type.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=BraveExternalProcessImporterClientTest*
+
+namespace {
+
+// Matches the group size of the utility process' ExternalProcessImporterBridge.
+constexpr size_t kHistoryRowsPerGroup = 100;
+
+std::vector<ImporterURLRow> BuildHistoryRows(size_t first, size_t count) {
+  std::vector<ImporterURLRow> rows;
+  for (size_t i = first; i < first + count; ++i) {
+    ImporterURLRow row(
+        GURL("https://site" + base::NumberToString(i) + ".com/"));
+    row.title = u"Site";
+    row.visit_count = 1;
+    row.last_visit = base::Time::Now() - base::Days(1);
+    rows.push_back(row);
+  }
+  return rows;
+}
+
+}  // namespace
+
+class BraveExternalProcessImporterClientTest : public testing::Test {
+ public:
+  void SetUp() override {
+    TestingProfile::Builder builder;
+    builder.AddTestingFactory(HistoryServiceFactory::GetInstance(),
+                              HistoryServiceFactory::GetDefaultFactory());
+    profile_ = builder.Build();
+
+    bridge_ = new BraveInProcessImporterBridge(
+        new ProfileWriter(profile_.get()),
+        base::WeakPtr<ExternalProcessImporterHost>());
+    importer::SourceProfile source_profile;
+    source_profile.importer_type = importer::TYPE_CHROME;
+    client_ = base::MakeRefCounted<BraveExternalProcessImporterClient>(
+        base::WeakPtr<ExternalProcessImporterHost>(), source_profile,
+        importer::HISTORY, bridge_.get());
+  }
+
+  history::HistoryService* history_service() {
+    return HistoryServiceFactory::GetForProfile(
+        profile_.get(), ServiceAccessType::EXPLICIT_ACCESS);
+  }
+
+  // Sends |rows| the way the utility process sends one SetHistoryItems call.
+  void SendHistoryItems(const std::vector<ImporterURLRow>& rows) {
+    client_->OnHistoryImportStart(rows.size());
+    for (size_t i = 0; i < rows.size(); i += kHistoryRowsPerGroup) {
+      const size_t end = std::min(rows.size(), i + kHistoryRowsPerGroup);
+      client_->OnHistoryImportGroup(
+          std::vector<ImporterURLRow>(rows.begin() + i, rows.begin() + end),
+          importer::VISIT_SOURCE_CHROME_IMPORTED);
+    }
+  }
+
+  size_t GetVisitCount(const GURL& url) {
+    size_t visit_count = 0;
+    base::RunLoop run_loop;
+    history_service()->QueryURL(
+        url, /*want_visits=*/true,
+        base::BindLambdaForTesting([&](history::QueryURLResult result) {
+          visit_count = result.visits.size();
+          run_loop.Quit();
+        }),
+        &tracker_);
+    run_loop.Run();
+    return visit_count;
+  }
+
+ protected:
+  content::BrowserTaskEnvironment task_environment_;
+  std::unique_ptr<TestingProfile> profile_;
+  scoped_refptr<BraveInProcessImporterBridge> bridge_;
+  scoped_refptr<BraveExternalProcessImporterClient> client_;
+  base::CancelableTaskTracker tracker_;
+};
+
+TEST_F(BraveExternalProcessImporterClientTest, ImportHistoryInChunks) {
+  // Two chunks, each sent in more than one group.
+  const std::vector<ImporterURLRow> first_chunk = BuildHistoryRows(0, 150);
+  const std::vector<ImporterURLRow> second_chunk = BuildHistoryRows(150, 150);
+  SendHistoryItems(first_chunk);
+  SendHistoryItems(second_chunk);
+  history::BlockUntilHistoryProcessesPendingRequests(history_service());
+
+  // Every row is imported exactly once.
+  for (const auto* chunk : {&first_chunk, &second_chunk}) {
+    for (const auto& row : *chunk)
+      EXPECT_EQ(1u, GetVisitCount(row.url)) << row.url;
+  }
+}
@@ -42,6 +42,7 @@
 #include "content/public/test/browser_test.h"
 #include "content/public/test/content_mock_cert_verifier.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "net/base/url_util.h"
 #include "net/dns/mock_host_resolver.h"
 #include "net/dns/public/secure_dns_mode.h"
 #include "net/test/embedded_test_server/http_request.h"
@@ -51,6 +52,9 @@
 namespace {
 const char kTestLinkImportPath[] = "/link.png";
 const char kUnavailableLinkImportPath[] = "/unavailable.png";
+// UnixFS CIDv0 and cumulative size of brave/test/data/adbanner.js.
+const char kTestFileCid[] = "QmWjP8qSVnHvd7vp3uPvkxy6L4yQPMD9wvy9yE3q4w5wAd";
+const int64_t kTestFileCumulativeSize = 43;
 
 std::string GetFileNameForText(const std::string& text,
                                const std::string& host) {
@@ -290,6 +294,34 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     return HandleImportRequests(expected_result, request);
   }
 
+  // Fake node which reports every object as stored locally and fails
+  // uploads, so imports only succeed when the upload is skipped.
+  std::unique_ptr<net::test_server::HttpResponse>
+  HandleLocalContentImportRequests(
+      const std::string& expected_response,
+      const net::test_server::HttpRequest& request) {
+    const GURL gurl = request.GetURL();
+    if (gurl.path_piece() == kImportStatPath) {
+      std::string arg;
+      EXPECT_TRUE(net::GetValueForKeyInQuery(gurl, "arg", &arg));
+      auto http_response =
+          std::make_unique<net::test_server::BasicHttpResponse>();
+      http_response->set_code(net::HTTP_OK);
+      http_response->set_content_type("application/json");
+      http_response->set_content(base::StringPrintf(
+          R"({"Hash":"%s","WithLocality":true,"Local":true})",
+          arg.substr(arg.rfind('/') + 1).c_str()));
+      return http_response;
+    }
+    if (gurl.path_piece() == kImportAddPath) {
+      auto http_response =
+          std::make_unique<net::test_server::BasicHttpResponse>();
+      http_response->set_code(net::HTTP_INTERNAL_SERVER_ERROR);
+      return http_response;
+    }
+    return HandleImportRequests(expected_response, request);
+  }
+
   std::unique_ptr<net::test_server::HttpResponse> HandleImportRequests(
       const std::string& expected_response,
       const net::test_server::HttpRequest& request) {
@@ -634,6 +666,14 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     }
   }
 
+  void OnImportCompletedWithHash(const std::string& expected_hash,
+                                 int64_t expected_size,
+                                 const ipfs::ImportedData& data) {
+    EXPECT_EQ(data.hash, expected_hash);
+    EXPECT_EQ(data.size, expected_size);
+    OnImportCompletedSuccess(data);
+  }
+
   void OnImportCompletedFail(ipfs::ImportState expected,
                              const std::string& expected_filename,
                              const ipfs::ImportedData& data) {
@@ -1232,6 +1272,41 @@ IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportFileToIpfsSuccess) {
   WaitForRequest();
 }
 
+IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportFileToIpfsSkipsLocal) {
+  ResetTestServer(base::BindRepeating(
+      &IpfsServiceBrowserTest::HandleLocalContentImportRequests,
+      base::Unretained(this), std::string()));
+  auto file_to_upload = embedded_test_server()->GetFullPathFromSourceDirectory(
+      base::FilePath(FILE_PATH_LITERAL("brave/test/data/adbanner.js")));
+  ipfs_service()->ImportFileToIpfs(
+      file_to_upload, std::string(),
+      base::BindOnce(&IpfsServiceBrowserTest::OnImportCompletedWithHash,
+                     base::Unretained(this),
+                     std::string(kTestFileCid), kTestFileCumulativeSize));
+  WaitForRequest();
+}
+
+IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportFileToIpfsStreamed) {
+  // Entry lines as the node streams them, the entry of the wrapping directory
+  // has an empty name.
+  std::string expected_response = base::StrCat(
+      {R"({"Name":"adbanner.js",)",
+       R"("Hash":")", kTestFileCid, R"(",)",
+       R"("Size":"43"})", "\n",
+       R"({"Name":"","Hash":"QmYbK4SLa","Size":"101"})", "\n"});
+  ResetTestServer(
+      base::BindRepeating(&IpfsServiceBrowserTest::HandleImportRequests,
+                          base::Unretained(this), expected_response));
+  auto file_to_upload = embedded_test_server()->GetFullPathFromSourceDirectory(
+      base::FilePath(FILE_PATH_LITERAL("brave/test/data/adbanner.js")));
+  ipfs_service()->ImportFileToIpfs(
+      file_to_upload, std::string(),
+      base::BindOnce(&IpfsServiceBrowserTest::OnImportCompletedWithHash,
+                     base::Unretained(this),
+                     std::string(kTestFileCid), kTestFileCumulativeSize));
+  WaitForRequest();
+}
+
 IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, ImportDirectoryToIpfsSuccess) {
   std::string expected_response =
       R"({"Name":"autoplay-whitelist-data", "Size":"567857", "Hash": "QmYbK4SLa"})";
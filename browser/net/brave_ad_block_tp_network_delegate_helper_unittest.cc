@@ -99,7 +99,7 @@ class BraveAdBlockTPNetworkDelegateHelperTest : public testing::Test {
     auto adblock_service = std::make_unique<brave_shields::AdBlockService>(
         brave_component_updater_delegate_->local_state(),
         brave_component_updater_delegate_->locale(), nullptr,
-        brave_component_updater_delegate_->GetTaskRunner(),
+        brave_component_updater_delegate_->GetTaskRunner(), user_data_dir,
         std::make_unique<brave_shields::AdBlockSubscriptionServiceManager>(
             brave_component_updater_delegate_->local_state(),
             brave_component_updater_delegate_->GetTaskRunner(),
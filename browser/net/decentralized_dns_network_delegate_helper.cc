@@ -8,6 +8,8 @@
 #include <utility>
 #include <vector>
 
+#include "base/metrics/histogram_functions.h"
+#include "base/time/time.h"
 #include "brave/browser/brave_wallet/json_rpc_service_factory.h"
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
@@ -20,6 +22,40 @@
 
 namespace decentralized_dns {
 
+namespace {
+
+constexpr char kUnstoppableDomainsResolveTimeHistogramName[] =
+    "Brave.DecentralizedDns.UnstoppableDomainsResolveTime";
+constexpr char kEnsResolveTimeHistogramName[] =
+    "Brave.DecentralizedDns.EnsResolveTime";
+
+void OnUnstoppableDomainsResolveDns(
+    const brave::ResponseCallback& next_callback,
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    base::TimeTicks start_time,
+    const GURL& url,
+    brave_wallet::mojom::ProviderError error,
+    const std::string& error_message) {
+  base::UmaHistogramTimes(kUnstoppableDomainsResolveTimeHistogramName,
+                          base::TimeTicks::Now() - start_time);
+  OnBeforeURLRequest_UnstoppableDomainsRedirectWork(next_callback, ctx, url,
+                                                    error, error_message);
+}
+
+void OnEnsResolverGetContentHash(const brave::ResponseCallback& next_callback,
+                                 std::shared_ptr<brave::BraveRequestInfo> ctx,
+                                 base::TimeTicks start_time,
+                                 const std::string& content_hash,
+                                 brave_wallet::mojom::ProviderError error,
+                                 const std::string& error_message) {
+  base::UmaHistogramTimes(kEnsResolveTimeHistogramName,
+                          base::TimeTicks::Now() - start_time);
+  OnBeforeURLRequest_EnsRedirectWork(next_callback, ctx, content_hash, error,
+                                     error_message);
+}
+
+}  // namespace
+
 int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
     const brave::ResponseCallback& next_callback,
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
@@ -39,8 +75,8 @@ int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
           g_browser_process->local_state())) {
     json_rpc_service->UnstoppableDomainsResolveDns(
         ctx->request_url.host(),
-        base::BindOnce(&OnBeforeURLRequest_UnstoppableDomainsRedirectWork,
-                       next_callback, ctx));
+        base::BindOnce(&OnUnstoppableDomainsResolveDns, next_callback, ctx,
+                       base::TimeTicks::Now()));
 
     return net::ERR_IO_PENDING;
   }
@@ -49,8 +85,8 @@ int OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
       IsENSResolveMethodEthereum(g_browser_process->local_state())) {
     json_rpc_service->EnsResolverGetContentHash(
         ctx->request_url.host(),
-        base::BindOnce(&OnBeforeURLRequest_EnsRedirectWork, next_callback,
-                       ctx));
+        base::BindOnce(&OnEnsResolverGetContentHash, next_callback, ctx,
+                       base::TimeTicks::Now()));
 
     return net::ERR_IO_PENDING;
   }
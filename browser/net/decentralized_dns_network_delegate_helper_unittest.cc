@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "base/run_loop.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_feature_list.h"
 #include "brave/browser/brave_wallet/json_rpc_service_factory.h"
 #include "brave/browser/net/url_context.h"
@@ -66,6 +67,9 @@ class DecentralizedDnsNetworkDelegateHelperTest : public testing::Test {
   network::TestURLLoaderFactory& test_url_loader_factory() {
     return test_url_loader_factory_;
   }
+  brave_wallet::JsonRpcService* json_rpc_service() {
+    return json_rpc_service_;
+  }
 
  private:
   content::BrowserTaskEnvironment task_environment_;
@@ -217,6 +221,7 @@ TEST_F(DecentralizedDnsNetworkDelegateHelperTest,
   EXPECT_EQ(brave_request_info->new_url_spec, "https://brave.com/");
 
   // Eth result.
+  json_rpc_service()->ClearDecentralizedDnsCache();
   EXPECT_EQ(net::ERR_IO_PENDING,
             OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
                 ResponseCallback(), brave_request_info));
@@ -233,6 +238,52 @@ TEST_F(DecentralizedDnsNetworkDelegateHelperTest,
   EXPECT_EQ(brave_request_info->new_url_spec, "ipfs://hash");
 }
 
+TEST_F(DecentralizedDnsNetworkDelegateHelperTest,
+       UnstoppableDomainsRedirectWorkUsesCachedResolution) {
+  local_state()->SetInteger(kUnstoppableDomainsResolveMethod,
+                            static_cast<int>(ResolveMethodTypes::ETHEREUM));
+  base::HistogramTester histogram_tester;
+
+  auto polygon_spec = brave_wallet::GetUnstoppableDomainsRpcUrl(
+                          brave_wallet::mojom::kPolygonMainnetChainId)
+                          .spec();
+  auto eth_spec = brave_wallet::GetUnstoppableDomainsRpcUrl(
+                      brave_wallet::mojom::kMainnetChainId)
+                      .spec();
+
+  auto brave_request_info =
+      std::make_shared<brave::BraveRequestInfo>(GURL("http://brave.crypto"));
+  brave_request_info->browser_context = profile();
+  EXPECT_EQ(net::ERR_IO_PENDING,
+            OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
+                ResponseCallback(), brave_request_info));
+  test_url_loader_factory().SimulateResponseForPendingRequest(
+      polygon_spec,
+      brave_wallet::MakeJsonRpcStringArrayResponse(
+          {"", "", "", "", "", "https://brave.com"}),
+      net::HTTP_OK);
+  test_url_loader_factory().SimulateResponseForPendingRequest(
+      eth_spec,
+      brave_wallet::MakeJsonRpcStringArrayResponse({"", "", "", "", "", ""}),
+      net::HTTP_OK);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(brave_request_info->new_url_spec, "https://brave.com/");
+
+  // Navigating to the domain again does not resolve it again.
+  brave_request_info =
+      std::make_shared<brave::BraveRequestInfo>(GURL("http://brave.crypto"));
+  brave_request_info->browser_context = profile();
+  EXPECT_EQ(net::ERR_IO_PENDING,
+            OnBeforeURLRequest_DecentralizedDnsPreRedirectWork(
+                ResponseCallback(), brave_request_info));
+  EXPECT_EQ(0, test_url_loader_factory().NumPending());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(brave_request_info->new_url_spec, "https://brave.com/");
+
+  histogram_tester.ExpectTotalCount(
+      "Brave.DecentralizedDns.UnstoppableDomainsResolveTime", 2);
+}
+
 TEST_F(DecentralizedDnsNetworkDelegateHelperTest, EnsRedirectWork) {
   GURL url("http://brantly.eth");
   auto brave_request_info = std::make_shared<brave::BraveRequestInfo>(url);
@@ -5,21 +5,52 @@
 
 #include "brave/browser/ui/webui/brave_federated/federated_internals_page_handler.h"
 
+#include <cmath>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/bind.h"
+#include "base/strings/string_number_conversions.h"
 #include "brave/browser/brave_federated/brave_federated_service_factory.h"
 #include "brave/components/brave_federated/brave_federated_service.h"
 #include "brave/components/brave_federated/data_store_service.h"
-#include "brave/components/brave_federated/data_stores/async_data_store.h"
+#include "brave/components/brave_federated/data_stores/async_columnar_data_store.h"
 #include "brave/components/brave_federated/notification_ad_task_constants.h"
 #include "brave/components/brave_federated/public/interfaces/brave_federated.mojom.h"
 #include "chrome/browser/profiles/profile.h"
 
 namespace brave_federated {
 
+namespace {
+
+std::string DecodeValue(const TrainingMatrix& training_matrix,
+                        size_t column,
+                        float value) {
+  const mojom::DataType data_type = training_matrix.columns[column].data_type;
+  if (data_type == mojom::DataType::kBool) {
+    return value != 0.0f ? "true" : "false";
+  }
+
+  if (data_type == mojom::DataType::kString) {
+    for (const auto& entry : training_matrix.dictionaries[column]) {
+      if (static_cast<float>(entry.second) == value) {
+        return entry.first;
+      }
+    }
+    return std::string();
+  }
+
+  if (data_type == mojom::DataType::kInt ||
+      data_type == mojom::DataType::kInt64) {
+    return base::NumberToString(static_cast<int64_t>(value));
+  }
+
+  return base::NumberToString(value);
+}
+
+}  // namespace
+
 FederatedInternalsPageHandler::FederatedInternalsPageHandler(
     mojo::PendingReceiver<federated_internals::mojom::PageHandler> receiver,
     mojo::PendingRemote<federated_internals::mojom::Page> page,
@@ -36,27 +67,35 @@ void FederatedInternalsPageHandler::UpdateDataStoresInfo() {
   if (!data_store_service_) {
     return;
   }
-  AsyncDataStore* notification_ad_data_store =
-      data_store_service_->GetDataStore(kNotificationAdTaskName);
+  AsyncColumnarDataStore* notification_ad_data_store =
+      data_store_service_->GetColumnarDataStore(kNotificationAdTaskName);
   if (!notification_ad_data_store) {
     return;
   }
 
-  notification_ad_data_store->LoadTrainingData(
+  notification_ad_data_store->LoadTrainingMatrix(
       base::BindOnce(&FederatedInternalsPageHandler::OnUpdateDataStoresInfo,
                      weak_ptr_factory_.GetWeakPtr()));
 }
 
 void FederatedInternalsPageHandler::OnUpdateDataStoresInfo(
-    TrainingData training_data) {
+    TrainingMatrix training_matrix) {
   std::vector<federated_internals::mojom::TrainingInstancePtr>
       training_instances;
-  for (auto& item : training_data) {
+  for (size_t row = 0; row < training_matrix.num_rows; ++row) {
     auto training_instance =
         federated_internals::mojom::TrainingInstance::New();
-    training_instance->id = item.first;
-    std::vector<mojom::CovariateInfoPtr>& covariates = item.second;
-    for (auto& covariate : covariates) {
+    training_instance->id = static_cast<int>(row);
+    const float* values = training_matrix.Row(row);
+    for (size_t column = 0; column < training_matrix.num_columns; ++column) {
+      if (std::isnan(values[column])) {
+        continue;
+      }
+
+      auto covariate = mojom::CovariateInfo::New();
+      covariate->type = training_matrix.columns[column].type;
+      covariate->data_type = training_matrix.columns[column].data_type;
+      covariate->value = DecodeValue(training_matrix, column, values[column]);
       training_instance->covariates.push_back(std::move(covariate));
     }
 
@@ -9,7 +9,7 @@
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "brave/browser/ui/webui/brave_federated/federated_internals.mojom.h"
-#include "brave/components/brave_federated/data_stores/data_store.h"
+#include "brave/components/brave_federated/data_stores/columnar_data_store.h"
 #include "mojo/public/cpp/bindings/receiver.h"
 #include "mojo/public/cpp/bindings/remote.h"
 
@@ -36,7 +36,7 @@ class FederatedInternalsPageHandler
   void UpdateDataStoresInfo() override;
 
  private:
-  void OnUpdateDataStoresInfo(brave_federated::TrainingData training_data);
+  void OnUpdateDataStoresInfo(brave_federated::TrainingMatrix training_matrix);
 
   mojo::Receiver<federated_internals::mojom::PageHandler> receiver_;
   mojo::Remote<federated_internals::mojom::Page> page_;
@@ -0,0 +1,120 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "net/cookies/cookie_monster.h"
+
+#include <memory>
+
+#include "base/callback_helpers.h"
+#include "base/test/bind.h"
+#include "base/time/time.h"
+#include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_deletion_info.h"
+#include "net/cookies/cookie_options.h"
+#include "net/test/test_with_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+// npm run test -- brave_unit_tests --filter=BraveCookieMonsterTest*
+
+namespace net {
+
+namespace {
+
+const char kThirdPartyURL[] = "https://tracker.example/";
+const char kTopFrameURL[] = "https://site.example/";
+const char kOtherTopFrameURL[] = "https://other.example/";
+
+CookieOptions MakeEphemeralOptions(const GURL& top_frame_url) {
+  CookieOptions options = CookieOptions::MakeAllInclusive();
+  options.set_should_use_ephemeral_storage(true);
+  options.set_top_frame_origin(url::Origin::Create(top_frame_url));
+  return options;
+}
+
+}  // namespace
+
+class BraveCookieMonsterTest : public ::testing::Test,
+                               public WithTaskEnvironment {
+ public:
+  BraveCookieMonsterTest()
+      : cookie_monster_(std::make_unique<CookieMonster>(
+            nullptr /* store */,
+            nullptr /* net_log */,
+            /*first_party_sets_enabled=*/false)) {}
+
+ protected:
+  void SetEphemeralCookie(const GURL& top_frame_url) {
+    const GURL url(kThirdPartyURL);
+    cookie_monster_->SetCanonicalCookieAsync(
+        CanonicalCookie::Create(url, "a=1", base::Time::Now(),
+                                /*server_time=*/absl::nullopt,
+                                /*cookie_partition_key=*/absl::nullopt),
+        url, MakeEphemeralOptions(top_frame_url), base::DoNothing());
+    RunUntilIdle();
+  }
+
+  size_t GetEphemeralCookieCount(const GURL& top_frame_url) {
+    size_t count = 0;
+    bool did_run_callback = false;
+    cookie_monster_->GetCookieListWithOptionsAsync(
+        GURL(kThirdPartyURL), MakeEphemeralOptions(top_frame_url),
+        CookiePartitionKeyCollection(),
+        base::BindLambdaForTesting(
+            [&](const CookieAccessResultList& included,
+                const CookieAccessResultList& excluded) {
+              did_run_callback = true;
+              count = included.size();
+            }));
+    RunUntilIdle();
+    EXPECT_TRUE(did_run_callback);
+    return count;
+  }
+
+  std::unique_ptr<CookieMonster> cookie_monster_;
+};
+
+TEST_F(BraveCookieMonsterTest, GetFromUnsetPartitionDoesNotCreateStore) {
+  EXPECT_EQ(0u, GetEphemeralCookieCount(GURL(kTopFrameURL)));
+  EXPECT_EQ(0u, cookie_monster_->ephemeral_cookie_stores_count_for_testing());
+
+  SetEphemeralCookie(GURL(kTopFrameURL));
+  EXPECT_EQ(1u, cookie_monster_->ephemeral_cookie_stores_count_for_testing());
+
+  EXPECT_EQ(1u, GetEphemeralCookieCount(GURL(kTopFrameURL)));
+  EXPECT_EQ(0u, GetEphemeralCookieCount(GURL(kOtherTopFrameURL)));
+  EXPECT_EQ(1u, cookie_monster_->ephemeral_cookie_stores_count_for_testing());
+}
+
+TEST_F(BraveCookieMonsterTest, UnboundedDeleteDropsAllPartitions) {
+  SetEphemeralCookie(GURL(kTopFrameURL));
+  SetEphemeralCookie(GURL(kOtherTopFrameURL));
+  EXPECT_EQ(2u, cookie_monster_->ephemeral_cookie_stores_count_for_testing());
+
+  cookie_monster_->DeleteAllCreatedInTimeRangeAsync(
+      CookieDeletionInfo::TimeRange(), base::DoNothing());
+  RunUntilIdle();
+
+  EXPECT_EQ(0u, cookie_monster_->ephemeral_cookie_stores_count_for_testing());
+  EXPECT_EQ(0u, GetEphemeralCookieCount(GURL(kTopFrameURL)));
+  EXPECT_EQ(0u, GetEphemeralCookieCount(GURL(kOtherTopFrameURL)));
+}
+
+TEST_F(BraveCookieMonsterTest, BoundedDeleteKeepsPartitions) {
+  SetEphemeralCookie(GURL(kTopFrameURL));
+  EXPECT_EQ(1u, cookie_monster_->ephemeral_cookie_stores_count_for_testing());
+
+  cookie_monster_->DeleteAllCreatedInTimeRangeAsync(
+      CookieDeletionInfo::TimeRange(base::Time::Now() + base::Days(1),
+                                    base::Time()),
+      base::DoNothing());
+  RunUntilIdle();
+
+  EXPECT_EQ(1u, cookie_monster_->ephemeral_cookie_stores_count_for_testing());
+  EXPECT_EQ(1u, GetEphemeralCookieCount(GURL(kTopFrameURL)));
+}
+
+}  // namespace net
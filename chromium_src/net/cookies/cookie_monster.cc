@@ -34,6 +34,15 @@ CookieMonster::CookieMonster(scoped_refptr<PersistentCookieStore> store,
 
 CookieMonster::~CookieMonster() {}
 
+ChromiumCookieMonster* CookieMonster::FindEphemeralCookieStoreForTopFrameURL(
+    const GURL& top_frame_url) {
+  auto it =
+      ephemeral_cookie_stores_.find(URLToEphemeralStorageDomain(top_frame_url));
+  if (it == ephemeral_cookie_stores_.end())
+    return nullptr;
+  return it->second.get();
+}
+
 ChromiumCookieMonster*
 CookieMonster::GetOrCreateEphemeralCookieStoreForTopFrameURL(
     const GURL& top_frame_url) {
@@ -61,6 +70,11 @@ void CookieMonster::DeleteCanonicalCookieAsync(const CanonicalCookie& cookie,
 void CookieMonster::DeleteAllCreatedInTimeRangeAsync(
     const CookieDeletionInfo::TimeRange& creation_range,
     DeleteCallback callback) {
+  if (creation_range.start().is_null() && creation_range.end().is_null()) {
+    // Every ephemeral cookie matches, so drop the partitions outright rather
+    // than emptying each monster and keeping it around.
+    ephemeral_cookie_stores_.clear();
+  }
   for (auto& it : ephemeral_cookie_stores_) {
     it.second->DeleteAllCreatedInTimeRangeAsync(creation_range,
                                                 DeleteCallback());
@@ -144,8 +158,14 @@ void CookieMonster::GetCookieListWithOptionsAsync(
       return;
     }
     ChromiumCookieMonster* ephemeral_monster =
-        GetOrCreateEphemeralCookieStoreForTopFrameURL(
+        FindEphemeralCookieStoreForTopFrameURL(
             options.top_frame_origin()->GetURL());
+    if (!ephemeral_monster) {
+      // Nothing was set in this partition yet, so there is nothing to read.
+      MaybeRunCookieCallback(std::move(callback), CookieAccessResultList(),
+                             CookieAccessResultList());
+      return;
+    }
     ephemeral_monster->GetCookieListWithOptionsAsync(
         url, options, cookie_partition_key_collection, std::move(callback));
     return;
@@ -53,10 +53,18 @@ class NET_EXPORT CookieMonster : public ChromiumCookieMonster {
       const CookiePartitionKeyCollection& cookie_partition_key_collection,
       GetCookieListCallback callback) override;
 
+  size_t ephemeral_cookie_stores_count_for_testing() const {
+    return ephemeral_cookie_stores_.size();
+  }
+
  private:
   NetLogWithSource net_log_;
   std::map<std::string, std::unique_ptr<ChromiumCookieMonster>>
       ephemeral_cookie_stores_;
+  // Returns nullptr if nothing was ever stored for |top_frame_url|, so that
+  // reads from third-party contexts don't allocate a monster each.
+  ChromiumCookieMonster* FindEphemeralCookieStoreForTopFrameURL(
+      const GURL& top_frame_url);
   ChromiumCookieMonster* GetOrCreateEphemeralCookieStoreForTopFrameURL(
       const GURL& top_frame_url);
 };
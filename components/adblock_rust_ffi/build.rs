@@ -0,0 +1,44 @@
+use std::env;
+use std::fs;
+use std::path::{Path, PathBuf};
+
+// Exposes the resolved version of the `adblock` dependency as `ADBLOCK_VERSION`
+// so that consumers can key data serialized by the engine on it.
+fn main() {
+    let manifest_dir = PathBuf::from(env::var("CARGO_MANIFEST_DIR").unwrap());
+    // Brave builds this crate through //brave/build/rust, while `cargo build`
+    // in this directory uses a lockfile next to the manifest.
+    let lockfiles = [
+        manifest_dir.join("../../build/rust/Cargo.lock"),
+        manifest_dir.join("Cargo.lock"),
+    ];
+
+    let version = lockfiles
+        .iter()
+        .filter(|lockfile| lockfile.exists())
+        .find_map(|lockfile| {
+            println!("cargo:rerun-if-changed={}", lockfile.display());
+            get_package_version(lockfile, "adblock")
+        })
+        .expect("Error: adblock version not found in Cargo.lock");
+
+    println!("cargo:rustc-env=ADBLOCK_VERSION={}", version);
+}
+
+fn get_package_version(lockfile: &Path, name: &str) -> Option<String> {
+    let contents = fs::read_to_string(lockfile).ok()?;
+    let name_line = format!("name = \"{}\"", name);
+    let mut lines = contents.lines();
+    while let Some(line) = lines.next() {
+        if line.trim() != name_line {
+            continue;
+        }
+        return lines
+            .next()?
+            .trim()
+            .strip_prefix("version = \"")?
+            .strip_suffix('"')
+            .map(str::to_owned);
+    }
+    None
+}
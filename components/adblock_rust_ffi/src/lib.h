@@ -39,6 +39,12 @@ typedef void (*C_DomainResolverCallback)(const char*, uint32_t*, uint32_t*);
  */
 bool set_domain_resolver(C_DomainResolverCallback resolver);
 
+/**
+ * Returns the version of the adblock-rust crate as a static C string. Engines
+ * serialized by one version can't be deserialized by another.
+ */
+const char* adblock_version(void);
+
 /**
  * Create a new `Engine`, interpreting `data` as a C string and then parsing as
  * a filter list in ABP syntax.
@@ -135,6 +141,18 @@ bool engine_deserialize(struct C_Engine* engine,
                         const char* data,
                         size_t data_size);
 
+/**
+ * Serializes the engine into a buffer that can later be passed to
+ * `engine_deserialize`. The buffer must be destroyed with
+ * `engine_serialized_destroy`.
+ */
+bool engine_serialize(struct C_Engine* engine, char** data, size_t* data_size);
+
+/**
+ * Destroy a buffer returned by `engine_serialize` once you are done with it.
+ */
+void engine_serialized_destroy(char* data, size_t data_size);
+
 /**
  * Destroy a `Engine` once you are done with it.
  */
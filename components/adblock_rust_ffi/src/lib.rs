@@ -46,6 +46,13 @@ pub unsafe extern "C" fn set_domain_resolver(resolver: DomainResolverCallback) -
     .is_ok()
 }
 
+/// Returns the version of the adblock-rust crate as a static C string. Engines serialized by one
+/// version can't be deserialized by another.
+#[no_mangle]
+pub extern "C" fn adblock_version() -> *const c_char {
+    concat!(env!("ADBLOCK_VERSION"), "\0").as_ptr() as *const c_char
+}
+
 /// Create a new `Engine`, interpreting `data` as a C string and then parsing as a filter list in
 /// ABP syntax.
 #[no_mangle]
@@ -267,6 +274,42 @@ pub unsafe extern "C" fn engine_deserialize(
     ok
 }
 
+/// Serializes the engine into a buffer that can later be passed to
+/// `engine_deserialize`. The buffer must be destroyed with
+/// `engine_serialized_destroy`.
+#[no_mangle]
+pub unsafe extern "C" fn engine_serialize(
+    engine: *mut Engine,
+    data: *mut *mut c_char,
+    data_size: *mut size_t,
+) -> bool {
+    assert!(!engine.is_null());
+    let engine = Box::leak(Box::from_raw(engine));
+    match engine.serialize_raw() {
+        Ok(serialized) => {
+            let serialized = serialized.into_boxed_slice();
+            *data_size = serialized.len();
+            *data = Box::into_raw(serialized) as *mut u8 as *mut c_char;
+            true
+        }
+        Err(_) => {
+            eprintln!("Error serializing adblock engine");
+            false
+        }
+    }
+}
+
+/// Destroy a buffer returned by `engine_serialize` once you are done with it.
+#[no_mangle]
+pub unsafe extern "C" fn engine_serialized_destroy(data: *mut c_char, data_size: size_t) {
+    if !data.is_null() {
+        drop(Box::from_raw(std::slice::from_raw_parts_mut(
+            data as *mut u8,
+            data_size,
+        )));
+    }
+}
+
 /// Destroy a `Engine` once you are done with it.
 #[no_mangle]
 pub unsafe extern "C" fn engine_destroy(engine: *mut Engine) {
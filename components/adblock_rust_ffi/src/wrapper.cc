@@ -16,6 +16,10 @@ bool SetDomainResolver(DomainResolverCallback resolver) {
   return set_domain_resolver(resolver);
 }
 
+std::string GetVersion() {
+  return adblock_version();
+}
+
 std::vector<FilterList> FilterList::default_list;
 std::vector<FilterList> FilterList::regional_list;
 
@@ -130,6 +134,17 @@ bool Engine::deserialize(const char* data, size_t data_size) {
   return engine_deserialize(raw, data, data_size);
 }
 
+std::vector<unsigned char> Engine::serialize() {
+  char* data = nullptr;
+  size_t data_size = 0;
+  if (!engine_serialize(raw, &data, &data_size))
+    return std::vector<unsigned char>();
+
+  std::vector<unsigned char> serialized(data, data + data_size);
+  engine_serialized_destroy(data, data_size);
+  return serialized;
+}
+
 void Engine::addTag(const std::string& tag) {
   engine_add_tag(raw, tag.c_str());
 }
@@ -42,6 +42,10 @@ typedef C_DomainResolverCallback DomainResolverCallback;
 
 bool ADBLOCK_EXPORT SetDomainResolver(DomainResolverCallback resolver);
 
+// Returns the version of the adblock-rust crate, which serialized engines are
+// tied to.
+std::string ADBLOCK_EXPORT GetVersion();
+
 class ADBLOCK_EXPORT FilterList {
  public:
   FilterList(const std::string& uuid,
@@ -103,6 +107,8 @@ class ADBLOCK_EXPORT Engine {
                                bool is_third_party,
                                const std::string& resource_type);
   bool deserialize(const char* data, size_t data_size);
+  // Returns an empty vector if the engine could not be serialized.
+  std::vector<unsigned char> serialize();
   void addTag(const std::string& tag);
   void addResource(const std::string& key,
                    const std::string& content_type,
@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/observer_list.h"
 #include "base/time/time.h"
 #include "brave/components/brave_adaptive_captcha/buildflags/buildflags.h"
@@ -59,6 +60,9 @@ class AdsService : public KeyedService {
   // Called to allow or disallow conversion tracking.
   virtual void SetAllowConversionTracking(const bool should_allow) = 0;
 
+  // Returns |true| if conversion tracking is allowed.
+  virtual bool ShouldAllowConversionTracking() const = 0;
+
   // Returns |true| if subdivision targeting is supported.
   virtual bool ShouldAllowSubdivisionTargeting() const = 0;
 
@@ -121,17 +125,19 @@ class AdsService : public KeyedService {
 
   // Called when the page for |tab_id| has loaded and the content is available
   // for analysis. |redirect_chain| containing a chain of redirect URLs that
-  // occurred for this navigation. |html| containing the page content as HTML.
+  // occurred for this navigation. |html| containing the page content as HTML,
+  // which is invalid if the content was not extracted.
   virtual void OnHtmlLoaded(const SessionID& tab_id,
                             const std::vector<GURL>& redirect_chain,
-                            const std::string& html) = 0;
+                            base::ReadOnlySharedMemoryRegion html) = 0;
 
   // Called when the page for |tab_id| has loaded and the content is available
   // for analysis. |redirect_chain| containing a chain of redirect URLs that
-  // occurred for this navigation. |text| containing the page content as text.
+  // occurred for this navigation. |text| containing the page content as text,
+  // which is invalid if the page has no text.
   virtual void OnTextLoaded(const SessionID& tab_id,
                             const std::vector<GURL>& redirect_chain,
-                            const std::string& text) = 0;
+                            base::ReadOnlySharedMemoryRegion text) = 0;
 
   // Called when a page navigation was initiated by a user gesture.
   // |page_transition_type| containing the page transition type, see enums for
@@ -51,7 +51,7 @@
 #include "brave/components/brave_ads/common/features.h"
 #include "brave/components/brave_ads/common/pref_names.h"
 #include "brave/components/brave_federated/data_store_service.h"
-#include "brave/components/brave_federated/data_stores/async_data_store.h"
+#include "brave/components/brave_federated/data_stores/async_columnar_data_store.h"
 #include "brave/components/brave_federated/features.h"
 #include "brave/components/brave_rewards/browser/rewards_p3a.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
@@ -150,6 +150,15 @@ std::string URLMethodToRequestType(ads::mojom::UrlRequestMethodType method) {
   }
 }
 
+bool AppendOnFileTaskRunner(const base::FilePath& path,
+                            const std::string& value) {
+  if (!base::PathExists(path)) {
+    return base::WriteFile(path, value);
+  }
+
+  return base::AppendToFile(path, value);
+}
+
 std::string LoadOnFileTaskRunner(const base::FilePath& path) {
   std::string data;
   bool success = base::ReadFileToString(path, &data);
@@ -305,7 +314,7 @@ AdsServiceImpl::AdsServiceImpl(
     std::unique_ptr<DeviceId> device_id,
     history::HistoryService* history_service,
     brave_rewards::RewardsService* rewards_service,
-    brave_federated::AsyncDataStore* notification_ad_timing_data_store)
+    brave_federated::AsyncColumnarDataStore* notification_ad_timing_data_store)
     : profile_(profile),
       history_service_(history_service),
 #if BUILDFLAG(BRAVE_ADAPTIVE_CAPTCHA_ENABLED)
@@ -1010,6 +1019,10 @@ void AdsServiceImpl::SetAllowConversionTracking(const bool should_allow) {
   SetBooleanPref(ads::prefs::kShouldAllowConversionTracking, should_allow);
 }
 
+bool AdsServiceImpl::ShouldAllowConversionTracking() const {
+  return GetBooleanPref(ads::prefs::kShouldAllowConversionTracking);
+}
+
 bool AdsServiceImpl::ShouldAllowSubdivisionTargeting() const {
   return GetBooleanPref(ads::prefs::kShouldAllowSubdivisionTargeting);
 }
@@ -1106,22 +1119,22 @@ void AdsServiceImpl::OnChangeLocale(const std::string& locale) {
 
 void AdsServiceImpl::OnHtmlLoaded(const SessionID& tab_id,
                                   const std::vector<GURL>& redirect_chain,
-                                  const std::string& html) {
+                                  base::ReadOnlySharedMemoryRegion html) {
   if (!IsBatAdsBound()) {
     return;
   }
 
-  bat_ads_->OnHtmlLoaded(tab_id.id(), redirect_chain, html);
+  bat_ads_->OnHtmlLoaded(tab_id.id(), redirect_chain, std::move(html));
 }
 
 void AdsServiceImpl::OnTextLoaded(const SessionID& tab_id,
                                   const std::vector<GURL>& redirect_chain,
-                                  const std::string& text) {
+                                  base::ReadOnlySharedMemoryRegion text) {
   if (!IsBatAdsBound()) {
     return;
   }
 
-  bat_ads_->OnTextLoaded(tab_id.id(), redirect_chain, text);
+  bat_ads_->OnTextLoaded(tab_id.id(), redirect_chain, std::move(text));
 }
 
 void AdsServiceImpl::OnUserGesture(const int32_t page_transition_type) {
@@ -1577,6 +1590,17 @@ void AdsServiceImpl::Save(const std::string& name,
                      std::move(callback)));
 }
 
+void AdsServiceImpl::Append(const std::string& name,
+                            const std::string& value,
+                            ads::ResultCallback callback) {
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&AppendOnFileTaskRunner, base_path_.AppendASCII(name),
+                     value),
+      base::BindOnce(&AdsServiceImpl::OnSave, AsWeakPtr(),
+                     std::move(callback)));
+}
+
 void AdsServiceImpl::Load(const std::string& name, ads::LoadCallback callback) {
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
@@ -1702,8 +1726,10 @@ void AdsServiceImpl::LogTrainingInstance(
     return;
   }
 
-  notification_ad_timing_data_store_->AddTrainingInstance(
-      std::move(training_instance),
+  std::vector<brave_federated::TrainingInstance> training_instances;
+  training_instances.push_back(std::move(training_instance));
+  notification_ad_timing_data_store_->AddTrainingInstances(
+      std::move(training_instances),
       base::BindOnce(&AdsServiceImpl::OnLogTrainingInstance, AsWeakPtr()));
 }
 
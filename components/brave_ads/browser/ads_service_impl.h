@@ -57,7 +57,7 @@ class SequencedTaskRunner;
 }  // namespace base
 
 namespace brave_federated {
-class AsyncDataStore;
+class AsyncColumnarDataStore;
 }  // namespace brave_federated
 
 namespace brave_rewards {
@@ -89,7 +89,8 @@ class AdsServiceImpl : public AdsService,
       std::unique_ptr<DeviceId> device_id,
       history::HistoryService* history_service,
       brave_rewards::RewardsService* rewards_service,
-      brave_federated::AsyncDataStore* notification_ad_timing_data_store);
+      brave_federated::AsyncColumnarDataStore*
+          notification_ad_timing_data_store);
   AdsServiceImpl(const AdsServiceImpl&) = delete;
   AdsServiceImpl& operator=(const AdsServiceImpl&) = delete;
   ~AdsServiceImpl() override;
@@ -278,6 +279,7 @@ class AdsServiceImpl : public AdsService,
   void SetNotificationAdsPerHour(const int64_t ads_per_hour) override;
 
   void SetAllowConversionTracking(const bool should_allow) override;
+  bool ShouldAllowConversionTracking() const override;
 
   bool ShouldAllowSubdivisionTargeting() const override;
   std::string GetSubdivisionTargetingCode() const override;
@@ -306,10 +308,10 @@ class AdsServiceImpl : public AdsService,
 
   void OnHtmlLoaded(const SessionID& tab_id,
                     const std::vector<GURL>& redirect_chain,
-                    const std::string& html) override;
+                    base::ReadOnlySharedMemoryRegion html) override;
   void OnTextLoaded(const SessionID& tab_id,
                     const std::vector<GURL>& redirect_chain,
-                    const std::string& text) override;
+                    base::ReadOnlySharedMemoryRegion text) override;
 
   void OnUserGesture(const int32_t page_transition_type) override;
 
@@ -404,6 +406,9 @@ class AdsServiceImpl : public AdsService,
   void Save(const std::string& name,
             const std::string& value,
             ads::ResultCallback callback) override;
+  void Append(const std::string& name,
+              const std::string& value,
+              ads::ResultCallback callback) override;
   void Load(const std::string& name, ads::LoadCallback callback) override;
   void LoadFileResource(const std::string& id,
                         const int version,
@@ -520,7 +525,7 @@ class AdsServiceImpl : public AdsService,
   const raw_ptr<brave_rewards::RewardsService> rewards_service_{
       nullptr};  // NOT OWNED
 
-  const raw_ptr<brave_federated::AsyncDataStore>
+  const raw_ptr<brave_federated::AsyncColumnarDataStore>
       notification_ad_timing_data_store_ = nullptr;  // NOT OWNED
 
   mojo::Remote<bat_ads::mojom::BatAdsService> bat_ads_service_;
@@ -30,6 +30,7 @@ class MockAdsService : public AdsService {
   MOCK_METHOD1(SetNotificationAdsPerHour, void(int64_t));
 
   MOCK_METHOD1(SetAllowConversionTracking, void(bool));
+  MOCK_CONST_METHOD0(ShouldAllowConversionTracking, bool());
 
   MOCK_CONST_METHOD0(ShouldAllowSubdivisionTargeting, bool());
   MOCK_CONST_METHOD0(GetSubdivisionTargetingCode, std::string());
@@ -59,11 +60,11 @@ class MockAdsService : public AdsService {
   MOCK_METHOD3(OnHtmlLoaded,
                void(const SessionID&,
                     const std::vector<GURL>&,
-                    const std::string&));
+                    base::ReadOnlySharedMemoryRegion));
   MOCK_METHOD3(OnTextLoaded,
                void(const SessionID&,
                     const std::vector<GURL>&,
-                    const std::string&));
+                    base::ReadOnlySharedMemoryRegion));
 
   MOCK_METHOD1(OnUserGesture, void(int32_t));
 
@@ -0,0 +1,116 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_ads/renderer/brave_ads_page_content_extractor.h"
+
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "content/public/renderer/render_frame.h"
+#include "gin/converter.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_registry.h"
+#include "third_party/blink/public/platform/web_string.h"
+#include "third_party/blink/public/web/blink.h"
+#include "third_party/blink/public/web/web_frame_content_dumper.h"
+#include "third_party/blink/public/web/web_local_frame.h"
+#include "third_party/blink/public/web/web_script_source.h"
+#include "v8/include/v8.h"
+
+namespace brave_ads {
+
+namespace {
+
+base::ReadOnlySharedMemoryRegion CopyToReadOnlySharedMemoryRegion(
+    base::StringPiece value) {
+  if (value.empty()) {
+    return {};
+  }
+
+  base::MappedReadOnlyRegion shared_memory =
+      base::ReadOnlySharedMemoryRegion::Create(value.size());
+  if (!shared_memory.IsValid()) {
+    return {};
+  }
+
+  value.copy(shared_memory.mapping.GetMemoryAs<char>(), value.size());
+
+  return std::move(shared_memory.region);
+}
+
+}  // namespace
+
+BraveAdsPageContentExtractor::BraveAdsPageContentExtractor(
+    content::RenderFrame* render_frame,
+    const int32_t world_id)
+    : RenderFrameObserver(render_frame), world_id_(world_id) {
+  render_frame->GetAssociatedInterfaceRegistry()->AddInterface(
+      base::BindRepeating(&BraveAdsPageContentExtractor::BindReceiver,
+                          base::Unretained(this)));
+}
+
+BraveAdsPageContentExtractor::~BraveAdsPageContentExtractor() = default;
+
+std::string BraveAdsPageContentExtractor::GetBodyInnerText(
+    const uint32_t max_text_size) const {
+  blink::WebLocalFrame* web_frame = render_frame()->GetWebFrame();
+
+  v8::Isolate* isolate = blink::MainThreadIsolate();
+  v8::HandleScope handle_scope(isolate);
+
+  // Every UTF-16 code unit encodes to at least one UTF-8 byte, so slicing
+  // |max_text_size| code units keeps enough text to fill |max_text_size| bytes
+  // while bounding the string converted out of V8.
+  const std::string script = base::StringPrintf(
+      "document?.body?.innerText?.substring(0, %u) ?? ''", max_text_size);
+  const v8::Local<v8::Value> value =
+      web_frame->ExecuteScriptInIsolatedWorldAndReturnValue(
+          world_id_,
+          blink::WebScriptSource(blink::WebString::FromASCII(script)),
+          blink::BackForwardCacheAware::kAllow);
+
+  std::string text;
+  if (value.IsEmpty() || !gin::ConvertFromV8(isolate, value, &text)) {
+    return {};
+  }
+
+  std::string truncated_text;
+  base::TruncateUTF8ToByteSize(text, max_text_size, &truncated_text);
+  return truncated_text;
+}
+
+void BraveAdsPageContentExtractor::BindReceiver(
+    mojo::PendingAssociatedReceiver<mojom::PageContentExtractor> receiver) {
+  receiver_.reset();
+  receiver_.Bind(std::move(receiver));
+}
+
+void BraveAdsPageContentExtractor::OnDestruct() {
+  delete this;
+}
+
+void BraveAdsPageContentExtractor::ExtractPageContent(
+    const uint32_t max_text_size,
+    const bool include_html,
+    ExtractPageContentCallback callback) {
+  const std::string text = GetBodyInnerText(max_text_size);
+
+  base::ReadOnlySharedMemoryRegion html_region;
+  if (include_html) {
+    html_region = CopyToReadOnlySharedMemoryRegion(
+        blink::WebFrameContentDumper::DumpAsMarkup(
+            render_frame()->GetWebFrame())
+            .Utf8());
+  }
+
+  std::move(callback).Run(CopyToReadOnlySharedMemoryRegion(text),
+                          std::move(html_region));
+}
+
+}  // namespace brave_ads
@@ -0,0 +1,59 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef BRAVE_COMPONENTS_BRAVE_ADS_RENDERER_BRAVE_ADS_PAGE_CONTENT_EXTRACTOR_H_
+#define BRAVE_COMPONENTS_BRAVE_ADS_RENDERER_BRAVE_ADS_PAGE_CONTENT_EXTRACTOR_H_
+
+#include <cstdint>
+#include <string>
+
+#include "brave/components/brave_ads/common/page_content_extractor.mojom.h"
+#include "content/public/renderer/render_frame_observer.h"
+#include "mojo/public/cpp/bindings/associated_receiver.h"
+#include "mojo/public/cpp/bindings/pending_associated_receiver.h"
+
+namespace content {
+class RenderFrame;
+}  // namespace content
+
+namespace brave_ads {
+
+// Extracts the page content of a main frame and shares it with the browser and
+// the ads service without being copied. The text is the body's innerText,
+// evaluated in |world_id| so that page scripts cannot observe or tamper with
+// the extraction.
+class BraveAdsPageContentExtractor final
+    : public content::RenderFrameObserver,
+      public mojom::PageContentExtractor {
+ public:
+  BraveAdsPageContentExtractor(content::RenderFrame* render_frame,
+                               const int32_t world_id);
+  BraveAdsPageContentExtractor(const BraveAdsPageContentExtractor&) = delete;
+  BraveAdsPageContentExtractor& operator=(const BraveAdsPageContentExtractor&) =
+      delete;
+  ~BraveAdsPageContentExtractor() override;
+
+ private:
+  std::string GetBodyInnerText(const uint32_t max_text_size) const;
+
+  void BindReceiver(
+      mojo::PendingAssociatedReceiver<mojom::PageContentExtractor> receiver);
+
+  // RenderFrameObserver:
+  void OnDestruct() override;
+
+  // mojom::PageContentExtractor:
+  void ExtractPageContent(const uint32_t max_text_size,
+                          const bool include_html,
+                          ExtractPageContentCallback callback) override;
+
+  const int32_t world_id_;
+
+  mojo::AssociatedReceiver<mojom::PageContentExtractor> receiver_{this};
+};
+
+}  // namespace brave_ads
+
+#endif  // BRAVE_COMPONENTS_BRAVE_ADS_RENDERER_BRAVE_ADS_PAGE_CONTENT_EXTRACTOR_H_
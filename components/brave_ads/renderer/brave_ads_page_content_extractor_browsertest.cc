@@ -0,0 +1,181 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/renderer/brave_ads_page_content_extractor.h"
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "brave/components/brave_ads/common/page_content_extractor.mojom.h"
+#include "chrome/common/chrome_isolated_world_ids.h"
+#include "content/public/test/render_view_test.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_browser_tests --filter=BraveAdsPageContentExtractor*
+
+namespace brave_ads {
+
+namespace {
+
+std::string ReadRegion(const base::ReadOnlySharedMemoryRegion& region) {
+  if (!region.IsValid()) {
+    return {};
+  }
+
+  const base::ReadOnlySharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid()) {
+    return {};
+  }
+
+  return std::string(mapping.GetMemoryAs<char>(), mapping.size());
+}
+
+}  // namespace
+
+class BraveAdsPageContentExtractorBrowserTest
+    : public content::RenderViewTest {
+ public:
+  BraveAdsPageContentExtractorBrowserTest() = default;
+  ~BraveAdsPageContentExtractorBrowserTest() override = default;
+
+  void SetUp() override {
+    content::RenderViewTest::SetUp();
+
+    // Owned by the render frame, which deletes it on destruction.
+    page_content_extractor_ = new BraveAdsPageContentExtractor(
+        GetMainRenderFrame(), ISOLATED_WORLD_ID_BRAVE_INTERNAL);
+  }
+
+  void ExtractPageContent(const uint32_t max_text_size,
+                          const bool include_html,
+                          std::string* text,
+                          bool* has_html,
+                          std::string* html) {
+    bool did_reply = false;
+    page_content_extractor_->ExtractPageContent(
+        max_text_size, include_html,
+        base::BindOnce(
+            [](bool* did_reply, std::string* text, bool* has_html,
+               std::string* html, base::ReadOnlySharedMemoryRegion text_region,
+               base::ReadOnlySharedMemoryRegion html_region) {
+              *did_reply = true;
+              *text = ReadRegion(text_region);
+              *has_html = html_region.IsValid();
+              *html = ReadRegion(html_region);
+            },
+            &did_reply, text, has_html, html));
+    EXPECT_TRUE(did_reply);
+  }
+
+ private:
+  mojom::PageContentExtractor* page_content_extractor_ = nullptr;
+};
+
+TEST_F(BraveAdsPageContentExtractorBrowserTest, ExtractBodyInnerText) {
+  // Arrange
+  LoadHTML(
+      R"(<html><head><title>Title</title><script>const x = 1;</script></head>)"
+      R"(<body><div>Hello</div><div style="display: none">Hidden</div>)"
+      R"(<script>const y = 2;</script><div>World</div></body></html>)");
+
+  // Act
+  std::string text;
+  bool has_html = false;
+  std::string html;
+  ExtractPageContent(/*max_text_size*/ 1024, /*include_html*/ false, &text,
+                     &has_html, &html);
+
+  // Assert
+  EXPECT_EQ("Hello\nWorld", text);
+  EXPECT_FALSE(has_html);
+}
+
+TEST_F(BraveAdsPageContentExtractorBrowserTest,
+       ExtractBodyInnerTextWhichPageScriptsCannotTamperWith) {
+  // Arrange
+  LoadHTML(
+      R"(<html><body><div>Hello</div><script>)"
+      R"(Object.defineProperty(HTMLElement.prototype, 'innerText', )"
+      R"({ get() { return 'Tampered'; } });)"
+      R"(</script></body></html>)");
+
+  // Act
+  std::string text;
+  bool has_html = false;
+  std::string html;
+  ExtractPageContent(/*max_text_size*/ 1024, /*include_html*/ false, &text,
+                     &has_html, &html);
+
+  // Assert
+  EXPECT_EQ("Hello", text);
+}
+
+TEST_F(BraveAdsPageContentExtractorBrowserTest, TruncateText) {
+  // Arrange
+  LoadHTML(R"(<html><body><div>Hello World</div></body></html>)");
+
+  // Act
+  std::string text;
+  bool has_html = false;
+  std::string html;
+  ExtractPageContent(/*max_text_size*/ 5, /*include_html*/ false, &text,
+                     &has_html, &html);
+
+  // Assert
+  EXPECT_EQ("Hello", text);
+}
+
+TEST_F(BraveAdsPageContentExtractorBrowserTest,
+       TruncateTextOnCharacterBoundary) {
+  // Arrange
+  LoadHTML(R"(<html><head><meta charset="utf-8"></head>)"
+           "<body><div>\xE2\x82\xAC\xE2\x82\xAC</div></body></html>");
+
+  // Act
+  std::string text;
+  bool has_html = false;
+  std::string html;
+  ExtractPageContent(/*max_text_size*/ 4, /*include_html*/ false, &text,
+                     &has_html, &html);
+
+  // Assert
+  EXPECT_EQ("\xE2\x82\xAC", text);
+}
+
+TEST_F(BraveAdsPageContentExtractorBrowserTest, ExtractEmptyTextForEmptyBody) {
+  // Arrange
+  LoadHTML(R"(<html><body></body></html>)");
+
+  // Act
+  std::string text;
+  bool has_html = false;
+  std::string html;
+  ExtractPageContent(/*max_text_size*/ 1024, /*include_html*/ false, &text,
+                     &has_html, &html);
+
+  // Assert
+  EXPECT_TRUE(text.empty());
+}
+
+TEST_F(BraveAdsPageContentExtractorBrowserTest, ExtractHtml) {
+  // Arrange
+  LoadHTML(R"(<html><body><div id="conversion">Hello</div></body></html>)");
+
+  // Act
+  std::string text;
+  bool has_html = false;
+  std::string html;
+  ExtractPageContent(/*max_text_size*/ 1024, /*include_html*/ true, &text,
+                     &has_html, &html);
+
+  // Assert
+  EXPECT_EQ("Hello", text);
+  EXPECT_TRUE(has_html);
+  EXPECT_NE(std::string::npos,
+            html.find(R"(<div id="conversion">Hello</div>)"));
+}
+
+}  // namespace brave_ads
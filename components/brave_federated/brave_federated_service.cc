@@ -7,12 +7,18 @@
 
 #include <utility>
 
+#include "base/bind.h"
+#include "base/json/values_util.h"
 #include "base/logging.h"
 #include "base/path_service.h"
+#include "base/values.h"
 #include "brave/components/brave_federated/data_store_service.h"
 #include "brave/components/brave_federated/data_stores/data_store.h"
 #include "brave/components/brave_federated/eligibility_service.h"
 #include "brave/components/brave_federated/features.h"
+#include "brave/components/brave_federated/learning/notification_ad_timing_task.h"
+#include "brave/components/brave_federated/learning/on_device_trainer.h"
+#include "brave/components/brave_federated/notification_ad_task_constants.h"
 #include "brave/components/brave_federated/operational_patterns.h"
 #include "brave/components/p3a/pref_names.h"
 #include "components/prefs/pref_change_registrar.h"
@@ -22,6 +28,19 @@
 
 namespace brave_federated {
 
+namespace {
+
+constexpr char kNotificationAdTimingModelPrefName[] =
+    "brave.federated.notification_ad_timing_model";
+constexpr char kModelParametersKey[] = "parameters";
+constexpr char kModelLossKey[] = "loss";
+constexpr char kModelTrainedAtKey[] = "trained_at";
+
+// Trained models are refined with newly logged covariates at this interval.
+constexpr base::TimeDelta kOnDeviceTrainingInterval = base::Days(1);
+
+}  // namespace
+
 BraveFederatedService::BraveFederatedService(
     PrefService* prefs,
     PrefService* local_state,
@@ -38,6 +57,7 @@ BraveFederatedService::~BraveFederatedService() {}
 
 void BraveFederatedService::RegisterProfilePrefs(PrefRegistrySimple* registry) {
   OperationalPatterns::RegisterPrefs(registry);
+  registry->RegisterDictionaryPref(kNotificationAdTimingModelPrefName);
 }
 
 DataStoreService* BraveFederatedService::GetDataStoreService() const {
@@ -67,11 +87,14 @@ void BraveFederatedService::Init() {
       new OperationalPatterns(prefs_, url_loader_factory_));
 
   MaybeStartOperationalPatterns();
+
+  MaybeStartOrStopOnDeviceTraining();
 }
 
 void BraveFederatedService::OnPreferenceChanged(const std::string& pref_name) {
   if (pref_name == brave::kP3AEnabled) {
     MaybeStartOrStopOperationalPatterns();
+    MaybeStartOrStopOnDeviceTraining();
   }
 }
 
@@ -110,4 +133,103 @@ void BraveFederatedService::MaybeStopOperationalPatterns() {
   }
 }
 
+bool BraveFederatedService::ShouldStartOnDeviceTraining() {
+  return IsP3AEnabled() && IsFederatedLearningEnabled() &&
+         brave_federated::features::IsOnDeviceTrainingEnabled();
+}
+
+void BraveFederatedService::MaybeStartOrStopOnDeviceTraining() {
+  if (!ShouldStartOnDeviceTraining()) {
+    StopOnDeviceTraining();
+    return;
+  }
+
+  if (notification_ad_timing_trainer_) {
+    return;
+  }
+
+  AsyncColumnarDataStore* data_store =
+      data_store_service_->GetColumnarDataStore(kNotificationAdTaskName);
+  if (!data_store) {
+    return;
+  }
+
+  notification_ad_timing_trainer_ = std::make_unique<OnDeviceTrainer>(
+      std::make_unique<NotificationAdTimingTask>(), data_store,
+      eligibility_service_.get(), TrainingConfig(), TrainingBudget());
+  notification_ad_timing_trainer_->SetInitialParameters(
+      LoadNotificationAdTimingModel());
+  StartOnDeviceTraining();
+}
+
+void BraveFederatedService::StartOnDeviceTraining() {
+  DCHECK(notification_ad_timing_trainer_);
+  notification_ad_timing_trainer_->Start(
+      base::BindOnce(&BraveFederatedService::OnOnDeviceTrainingComplete,
+                     base::Unretained(this)));
+}
+
+void BraveFederatedService::StopOnDeviceTraining() {
+  on_device_training_timer_.Stop();
+  // Destroying the trainer abandons a running session without running its
+  // callback.
+  notification_ad_timing_trainer_.reset();
+  // The model is derived from the user's covariates, so it doesn't outlive
+  // opting out of on-device training.
+  prefs_->ClearPref(kNotificationAdTimingModelPrefName);
+}
+
+void BraveFederatedService::OnOnDeviceTrainingComplete(
+    absl::optional<TrainingResult> result) {
+  if (result) {
+    VLOG(1) << "Trained notification ad timing model on "
+            << result->number_of_examples << " examples";
+    SaveNotificationAdTimingModel(*result);
+    notification_ad_timing_trainer_->SetInitialParameters(
+        std::move(result->parameters));
+  } else {
+    VLOG(1) << "No notification ad timing model was trained";
+  }
+
+  on_device_training_timer_.Start(
+      FROM_HERE, kOnDeviceTrainingInterval,
+      base::BindOnce(&BraveFederatedService::StartOnDeviceTraining,
+                     base::Unretained(this)));
+}
+
+std::vector<float> BraveFederatedService::LoadNotificationAdTimingModel() {
+  std::vector<float> parameters;
+  const base::Value::List* list =
+      prefs_->Get(kNotificationAdTimingModelPrefName)
+          ->GetDict()
+          .FindList(kModelParametersKey);
+  if (!list) {
+    return parameters;
+  }
+
+  for (const auto& value : *list) {
+    if (!value.is_double() && !value.is_int()) {
+      return {};
+    }
+    parameters.push_back(static_cast<float>(value.GetDouble()));
+  }
+
+  return parameters;
+}
+
+void BraveFederatedService::SaveNotificationAdTimingModel(
+    const TrainingResult& result) {
+  base::Value::List parameters;
+  for (const float parameter : result.parameters) {
+    parameters.Append(static_cast<double>(parameter));
+  }
+
+  base::Value::Dict model;
+  model.Set(kModelParametersKey, std::move(parameters));
+  model.Set(kModelLossKey, static_cast<double>(result.progress.loss));
+  model.Set(kModelTrainedAtKey, base::TimeToValue(base::Time::Now()));
+  prefs_->Set(kNotificationAdTimingModelPrefName,
+              base::Value(std::move(model)));
+}
+
 }  // namespace brave_federated
@@ -8,10 +8,13 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/files/file_path.h"
+#include "base/timer/timer.h"
 #include "components/keyed_service/core/keyed_service.h"
 #include "components/prefs/pref_change_registrar.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace network {
 class SharedURLLoaderFactory;
@@ -24,7 +27,9 @@ namespace brave_federated {
 
 class DataStoreService;
 class EligibilityService;
+class OnDeviceTrainer;
 class OperationalPatterns;
+struct TrainingResult;
 
 // In the absence of user data collection, Brave is unable to support learning
 // and decisioning systems for tasks such as private ad matching or private news
@@ -62,6 +67,17 @@ class BraveFederatedService : public KeyedService {
   void MaybeStartOperationalPatterns();
   void MaybeStopOperationalPatterns();
 
+  // On-device training runs while the user has opted into P3A and stops as
+  // soon as they opt out. The trained model is kept in prefs and refined
+  // periodically.
+  bool ShouldStartOnDeviceTraining();
+  void MaybeStartOrStopOnDeviceTraining();
+  void StartOnDeviceTraining();
+  void StopOnDeviceTraining();
+  void OnOnDeviceTrainingComplete(absl::optional<TrainingResult> result);
+  std::vector<float> LoadNotificationAdTimingModel();
+  void SaveNotificationAdTimingModel(const TrainingResult& result);
+
   raw_ptr<PrefService> prefs_ = nullptr;
   raw_ptr<PrefService> local_state_ = nullptr;
   PrefChangeRegistrar local_state_change_registrar_;
@@ -71,6 +87,8 @@ class BraveFederatedService : public KeyedService {
   std::unique_ptr<OperationalPatterns> operational_patterns_;
   std::unique_ptr<DataStoreService> data_store_service_;
   std::unique_ptr<EligibilityService> eligibility_service_;
+  std::unique_ptr<OnDeviceTrainer> notification_ad_timing_trainer_;
+  base::OneShotTimer on_device_training_timer_;
 };
 
 }  // namespace brave_federated
@@ -6,57 +6,162 @@
 #include "brave/components/brave_federated/data_store_service.h"
 
 #include <utility>
+#include <vector>
 
+#include "base/bind.h"
 #include "base/check.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
 #include "base/task/thread_pool.h"
-#include "base/threading/sequence_bound.h"
-#include "base/threading/sequenced_task_runner_handle.h"
-#include "brave/components/brave_federated/data_stores/async_data_store.h"
+#include "brave/components/brave_federated/data_stores/async_columnar_data_store.h"
+#include "brave/components/brave_federated/data_stores/data_store.h"
 #include "brave/components/brave_federated/notification_ad_task_constants.h"
+#include "sql/database.h"
 
 namespace brave_federated {
 
+namespace {
+
+constexpr char kColumnarDatabaseSuffix[] = "_columnar";
+
+std::vector<ColumnInfo> GetNotificationAdTaskColumns() {
+  std::vector<ColumnInfo> columns = {
+      {mojom::CovariateType::kNotificationAdServedAt,
+       mojom::DataType::kDouble},
+      {mojom::CovariateType::kNotificationAdEvent, mojom::DataType::kString},
+      {mojom::CovariateType::kAverageClickthroughRate,
+       mojom::DataType::kDouble},
+      {mojom::CovariateType::kLastNotificationAdWasClicked,
+       mojom::DataType::kBool}};
+
+  // The remaining covariates are user activity event counts and durations.
+  constexpr int kFirstUserActivityType = static_cast<int>(
+      mojom::CovariateType::kNumberOfBrowserDidBecomeActiveEvents);
+  constexpr int kLastUserActivityType =
+      static_cast<int>(mojom::CovariateType::kMaxValue);
+  for (int type = kFirstUserActivityType; type <= kLastUserActivityType;
+       ++type) {
+    columns.push_back(
+        {static_cast<mojom::CovariateType>(type), mojom::DataType::kInt});
+  }
+
+  return columns;
+}
+
+// Reads the training instances logged to the legacy per-covariate store, if
+// any, together with the time they were logged.
+std::vector<TimestampedTrainingInstance> LoadLegacyTrainingInstances(
+    const DataStoreTask& data_store_task,
+    const base::FilePath& db_path) {
+  std::vector<TimestampedTrainingInstance> training_instances;
+  if (!base::PathExists(db_path))
+    return training_instances;
+
+  DataStore data_store(data_store_task, db_path);
+  if (!data_store.InitializeDatabase())
+    return training_instances;
+
+  TrainingData training_data = data_store.LoadTrainingData();
+  const base::flat_map<int, base::Time> creation_times =
+      data_store.LoadTrainingInstanceCreationTimes();
+  training_instances.reserve(training_data.size());
+  for (auto& item : training_data) {
+    const auto iter = creation_times.find(item.first);
+    const base::Time created_at =
+        iter != creation_times.end() ? iter->second : base::Time::Now();
+    training_instances.emplace_back(std::move(item.second), created_at);
+  }
+
+  return training_instances;
+}
+
+void DeleteLegacyDataStore(const base::FilePath& db_path) {
+  base::ThreadPool::PostTask(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(base::IgnoreResult(&sql::Database::Delete), db_path));
+}
+
+}  // namespace
+
 DataStoreService::DataStoreService(const base::FilePath& db_path)
     : db_path_(db_path), weak_factory_(this) {}
 
 DataStoreService::~DataStoreService() = default;
 
 void DataStoreService::Init() {
-  auto callback =
-      base::BindOnce(&DataStoreService::OnInitializeDatabaseComplete,
-                     weak_factory_.GetWeakPtr());
-  DataStoreTask notification_ad_timing_data_store_task(
-      {kNotificationAdTaskId, kNotificationAdTaskName, kMaxNumberOfRecords,
-       kMaxRetentionDays});
-  std::unique_ptr<AsyncDataStore> notification_ad_timing_data_store =
-      std::make_unique<AsyncDataStore>(
-          std::move(notification_ad_timing_data_store_task), db_path_);
-  notification_ad_timing_data_store->InitializeDatabase(std::move(callback));
-
-  data_stores_.emplace(kNotificationAdTaskName,
-                       std::move(notification_ad_timing_data_store));
-}
-
-AsyncDataStore* DataStoreService::GetDataStore(const std::string& name) {
-  auto it = data_stores_.find(name);
-  if (it == data_stores_.end())
+  ColumnarDataStoreTask notification_ad_timing_data_store_task(
+      kNotificationAdTaskId, kNotificationAdTaskName,
+      GetNotificationAdTaskColumns(), kMaxEvents, kMaxRetentionDays);
+  std::unique_ptr<AsyncColumnarDataStore> notification_ad_timing_data_store =
+      std::make_unique<AsyncColumnarDataStore>(
+          std::move(notification_ad_timing_data_store_task),
+          db_path_.InsertBeforeExtensionASCII(kColumnarDatabaseSuffix));
+  notification_ad_timing_data_store->InitializeDatabase(base::BindOnce(
+      &DataStoreService::OnInitializeDatabaseComplete,
+      weak_factory_.GetWeakPtr(), notification_ad_timing_data_store.get(),
+      DataStoreTask{kNotificationAdTaskId, kNotificationAdTaskName,
+                    kMaxNumberOfRecords, kMaxRetentionDays}));
+
+  columnar_data_stores_.emplace(kNotificationAdTaskName,
+                                std::move(notification_ad_timing_data_store));
+}
+
+AsyncColumnarDataStore* DataStoreService::GetColumnarDataStore(
+    const std::string& name) {
+  auto it = columnar_data_stores_.find(name);
+  if (it == columnar_data_stores_.end())
     return nullptr;
 
   return it->second.get();
 }
 
-void DataStoreService::OnInitializeDatabaseComplete(bool success) {
-  if (success) {
-    PurgeDataStoresAfterExpirationDate();
+void DataStoreService::OnInitializeDatabaseComplete(
+    AsyncColumnarDataStore* data_store,
+    const DataStoreTask& legacy_data_store_task,
+    bool success) {
+  DCHECK(data_store);
+  if (!success) {
+    return;
   }
+
+  data_store->PurgeTrainingDataAfterExpirationDate();
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&LoadLegacyTrainingInstances, legacy_data_store_task,
+                     db_path_),
+      base::BindOnce(&DataStoreService::OnLoadLegacyTrainingInstances,
+                     weak_factory_.GetWeakPtr(), data_store));
+}
+
+void DataStoreService::OnLoadLegacyTrainingInstances(
+    AsyncColumnarDataStore* data_store,
+    std::vector<TimestampedTrainingInstance> training_instances) {
+  DCHECK(data_store);
+  if (training_instances.empty()) {
+    DeleteLegacyDataStore(db_path_);
+    return;
+  }
+
+  data_store->AddTimestampedTrainingInstances(
+      std::move(training_instances),
+      base::BindOnce(&DataStoreService::OnMigrateLegacyTrainingInstances,
+                     weak_factory_.GetWeakPtr()));
 }
 
-void DataStoreService::PurgeDataStoresAfterExpirationDate() {
-  for (const auto& entry : data_stores_) {
-    AsyncDataStore* data_store = entry.second.get();
-    DCHECK(data_store);
-    data_store->PurgeTrainingDataAfterExpirationDate();
+void DataStoreService::OnMigrateLegacyTrainingInstances(bool success) {
+  // The legacy store is kept on failure so that migration is retried on the
+  // next startup.
+  if (!success) {
+    VLOG(1) << "Failed to migrate legacy training instances";
+    return;
   }
+
+  DeleteLegacyDataStore(db_path_);
 }
 
 }  // namespace brave_federated
@@ -8,18 +8,23 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
+#include "brave/components/brave_federated/data_stores/columnar_data_store.h"
 
 namespace brave_federated {
 
-class AsyncDataStore;
+class AsyncColumnarDataStore;
+struct DataStoreTask;
 
 // DataStoreService is the shared interface between all adopters applications
 // (ads, news, etc.) and the task-specific data stores, which contains the task
-// logs that are used to train and evaluate task-specific models.
+// logs that are used to train and evaluate task-specific models. Training
+// instances logged to the legacy per-covariate store are migrated to the
+// columnar store on startup.
 class DataStoreService {
  public:
   explicit DataStoreService(const base::FilePath& base_database_path);
@@ -29,14 +34,20 @@ class DataStoreService {
   DataStoreService& operator=(const DataStoreService&) = delete;
 
   void Init();
-  AsyncDataStore* GetDataStore(const std::string& name);
+  AsyncColumnarDataStore* GetColumnarDataStore(const std::string& name);
 
  private:
-  void OnInitializeDatabaseComplete(bool success);
-  void PurgeDataStoresAfterExpirationDate();
+  void OnInitializeDatabaseComplete(AsyncColumnarDataStore* data_store,
+                                    const DataStoreTask& legacy_data_store_task,
+                                    bool success);
+  void OnLoadLegacyTrainingInstances(
+      AsyncColumnarDataStore* data_store,
+      std::vector<TimestampedTrainingInstance> training_instances);
+  void OnMigrateLegacyTrainingInstances(bool success);
 
   base::FilePath db_path_;
-  base::flat_map<std::string, std::unique_ptr<AsyncDataStore>> data_stores_;
+  base::flat_map<std::string, std::unique_ptr<AsyncColumnarDataStore>>
+      columnar_data_stores_;
   base::WeakPtrFactory<DataStoreService> weak_factory_;
 };
 
@@ -0,0 +1,131 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_federated/data_store_service.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_federated/data_stores/async_columnar_data_store.h"
+#include "brave/components/brave_federated/data_stores/data_store.h"
+#include "brave/components/brave_federated/notification_ad_task_constants.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=DataStoreServiceTest*
+
+namespace brave_federated {
+
+namespace {
+
+std::vector<mojom::CovariateInfoPtr> BuildTrainingInstance(
+    const std::string& event) {
+  std::vector<mojom::CovariateInfoPtr> training_instance;
+  mojom::CovariateInfoPtr covariate = mojom::CovariateInfo::New();
+  covariate->type = mojom::CovariateType::kNotificationAdEvent;
+  covariate->data_type = mojom::DataType::kString;
+  covariate->value = event;
+  training_instance.push_back(std::move(covariate));
+  return training_instance;
+}
+
+}  // namespace
+
+class DataStoreServiceTest : public testing::Test {
+ public:
+  DataStoreServiceTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    db_path_ = temp_dir_.GetPath().AppendASCII("data_store.sqlite");
+  }
+
+  TrainingMatrix LoadTrainingMatrix(DataStoreService* data_store_service) {
+    AsyncColumnarDataStore* data_store =
+        data_store_service->GetColumnarDataStore(kNotificationAdTaskName);
+    EXPECT_TRUE(data_store);
+
+    TrainingMatrix training_matrix;
+    base::RunLoop run_loop;
+    data_store->LoadTrainingMatrix(
+        base::BindLambdaForTesting([&](TrainingMatrix result) {
+          training_matrix = std::move(result);
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+    return training_matrix;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath db_path_;
+};
+
+TEST_F(DataStoreServiceTest, MigrateLegacyDataStore) {
+  {
+    DataStore legacy_data_store(
+        {kNotificationAdTaskId, kNotificationAdTaskName, kMaxNumberOfRecords,
+         kMaxRetentionDays},
+        db_path_);
+    ASSERT_TRUE(legacy_data_store.InitializeDatabase());
+    ASSERT_TRUE(legacy_data_store.AddTrainingInstance(
+        BuildTrainingInstance("NotificationAdEventType::kViewed")));
+    ASSERT_TRUE(legacy_data_store.AddTrainingInstance(
+        BuildTrainingInstance(kNotificationAdClickedEventValue)));
+  }
+
+  DataStoreService data_store_service(db_path_);
+  data_store_service.Init();
+  task_environment_.RunUntilIdle();
+
+  const TrainingMatrix training_matrix =
+      LoadTrainingMatrix(&data_store_service);
+  EXPECT_EQ(2u, training_matrix.num_rows);
+  EXPECT_TRUE(training_matrix.GetCategoryCode(
+      mojom::CovariateType::kNotificationAdEvent,
+      kNotificationAdClickedEventValue));
+  EXPECT_FALSE(base::PathExists(db_path_));
+}
+
+TEST_F(DataStoreServiceTest, MigrateLegacyDataStoreKeepsCreationTime) {
+  {
+    DataStore legacy_data_store(
+        {kNotificationAdTaskId, kNotificationAdTaskName, kMaxNumberOfRecords,
+         kMaxRetentionDays},
+        db_path_);
+    ASSERT_TRUE(legacy_data_store.InitializeDatabase());
+    ASSERT_TRUE(legacy_data_store.AddTrainingInstance(
+        BuildTrainingInstance(kNotificationAdClickedEventValue)));
+  }
+  task_environment_.AdvanceClock(kMaxRetentionDays / 2);
+
+  DataStoreService data_store_service(db_path_);
+  data_store_service.Init();
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(1u, LoadTrainingMatrix(&data_store_service).num_rows);
+
+  // The migrated instance expires relative to when it was originally logged
+  // rather than when it was migrated.
+  task_environment_.AdvanceClock(kMaxRetentionDays / 2 + base::Days(1));
+  EXPECT_EQ(0u, LoadTrainingMatrix(&data_store_service).num_rows);
+}
+
+TEST_F(DataStoreServiceTest, DoNotMigrateWithoutLegacyDataStore) {
+  DataStoreService data_store_service(db_path_);
+  data_store_service.Init();
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(0u, LoadTrainingMatrix(&data_store_service).num_rows);
+  EXPECT_FALSE(base::PathExists(db_path_));
+}
+
+}  // namespace brave_federated
@@ -0,0 +1,68 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_federated/data_stores/async_columnar_data_store.h"
+
+#include <utility>
+
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+
+namespace brave_federated {
+
+AsyncColumnarDataStore::AsyncColumnarDataStore(
+    ColumnarDataStoreTask data_store_task,
+    base::FilePath db_path)
+    : data_store_(base::ThreadPool::CreateSequencedTaskRunner(
+                      {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+                       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN}),
+                  std::move(data_store_task),
+                  std::move(db_path)) {}
+
+AsyncColumnarDataStore::~AsyncColumnarDataStore() = default;
+
+void AsyncColumnarDataStore::InitializeDatabase(
+    base::OnceCallback<void(bool)> callback) {
+  data_store_.AsyncCall(&ColumnarDataStore::InitializeDatabase)
+      .Then(std::move(callback));
+}
+
+void AsyncColumnarDataStore::AddTrainingInstances(
+    std::vector<TrainingInstance> training_instances,
+    base::OnceCallback<void(bool)> callback) {
+  data_store_.AsyncCall(&ColumnarDataStore::AddTrainingInstances)
+      .WithArgs(std::move(training_instances))
+      .Then(std::move(callback));
+}
+
+void AsyncColumnarDataStore::AddTimestampedTrainingInstances(
+    std::vector<TimestampedTrainingInstance> training_instances,
+    base::OnceCallback<void(bool)> callback) {
+  data_store_.AsyncCall(&ColumnarDataStore::AddTimestampedTrainingInstances)
+      .WithArgs(std::move(training_instances))
+      .Then(std::move(callback));
+}
+
+void AsyncColumnarDataStore::LoadTrainingMatrix(
+    base::OnceCallback<void(TrainingMatrix)> callback) {
+  data_store_.AsyncCall(&ColumnarDataStore::LoadTrainingMatrix)
+      .Then(std::move(callback));
+}
+
+void AsyncColumnarDataStore::GetCategoryCode(
+    mojom::CovariateType type,
+    const std::string& value,
+    base::OnceCallback<void(absl::optional<float>)> callback) {
+  data_store_.AsyncCall(&ColumnarDataStore::GetCategoryCode)
+      .WithArgs(type, value)
+      .Then(std::move(callback));
+}
+
+void AsyncColumnarDataStore::PurgeTrainingDataAfterExpirationDate() {
+  data_store_.AsyncCall(
+      &ColumnarDataStore::PurgeTrainingDataAfterExpirationDate);
+}
+
+}  // namespace brave_federated
@@ -0,0 +1,49 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_FEDERATED_DATA_STORES_ASYNC_COLUMNAR_DATA_STORE_H_
+#define BRAVE_COMPONENTS_BRAVE_FEDERATED_DATA_STORES_ASYNC_COLUMNAR_DATA_STORE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/threading/sequence_bound.h"
+#include "brave/components/brave_federated/data_stores/columnar_data_store.h"
+
+namespace brave_federated {
+
+// Wrapper around ColumnarDataStore class to handle SequenceBound async logic
+class AsyncColumnarDataStore {
+ public:
+  AsyncColumnarDataStore(ColumnarDataStoreTask data_store_task,
+                         base::FilePath db_path);
+  ~AsyncColumnarDataStore();
+
+  AsyncColumnarDataStore(const AsyncColumnarDataStore&) = delete;
+  AsyncColumnarDataStore& operator=(const AsyncColumnarDataStore&) = delete;
+
+  void InitializeDatabase(base::OnceCallback<void(bool)> callback);
+
+  void AddTrainingInstances(std::vector<TrainingInstance> training_instances,
+                            base::OnceCallback<void(bool)> callback);
+  void AddTimestampedTrainingInstances(
+      std::vector<TimestampedTrainingInstance> training_instances,
+      base::OnceCallback<void(bool)> callback);
+  void LoadTrainingMatrix(base::OnceCallback<void(TrainingMatrix)> callback);
+  void GetCategoryCode(
+      mojom::CovariateType type,
+      const std::string& value,
+      base::OnceCallback<void(absl::optional<float>)> callback);
+  void PurgeTrainingDataAfterExpirationDate();
+
+ private:
+  const base::SequenceBound<ColumnarDataStore> data_store_;
+};
+
+}  // namespace brave_federated
+
+#endif  // BRAVE_COMPONENTS_BRAVE_FEDERATED_DATA_STORES_ASYNC_COLUMNAR_DATA_STORE_H_
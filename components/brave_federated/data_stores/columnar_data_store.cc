@@ -0,0 +1,488 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_federated/data_stores/columnar_data_store.h"
+
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/check.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "sql/recovery.h"
+#include "sql/statement.h"
+#include "sql/transaction.h"
+
+namespace brave_federated {
+
+namespace {
+
+constexpr float kMissingValue = std::numeric_limits<float>::quiet_NaN();
+// Rows are stored at full precision and only narrowed to float when they are
+// loaded into a |TrainingMatrix|.
+constexpr double kMissingStoredValue = std::numeric_limits<double>::quiet_NaN();
+
+void DatabaseErrorCallback(sql::Database* db,
+                           const base::FilePath& db_file_path,
+                           int extended_error,
+                           sql::Statement* stmt) {
+  if (sql::Recovery::ShouldRecover(extended_error)) {
+    // Prevent reentrant calls.
+    db->reset_error_callback();
+
+    // After this call, the |db| handle is poisoned so that future calls will
+    // return errors until the handle is re-opened.
+    sql::Recovery::RecoverDatabase(db, db_file_path);
+
+    // The ignored call signals the test-expectation framework that the error
+    // was handled.
+    std::ignore = sql::Database::IsExpectedSqliteError(extended_error);
+    return;
+  }
+
+  // The default handling is to assert on debug and to ignore on release.
+  if (!sql::Database::IsExpectedSqliteError(extended_error))
+    DLOG(FATAL) << db->GetErrorMessage();
+}
+
+std::string GetColumnName(const ColumnInfo& column) {
+  return base::StringPrintf("c%d", static_cast<int>(column.type));
+}
+
+std::string GetColumnDefinition(const ColumnInfo& column) {
+  return GetColumnName(column) + " REAL";
+}
+
+double ParseNumericValue(const mojom::DataType data_type,
+                         const std::string& value) {
+  if (data_type == mojom::DataType::kBool) {
+    if (value == "true")
+      return 1.0;
+    if (value == "false")
+      return 0.0;
+  }
+
+  double number;
+  if (!base::StringToDouble(value, &number) || !std::isfinite(number))
+    return kMissingStoredValue;
+
+  return number;
+}
+
+}  // namespace
+
+TimestampedTrainingInstance::TimestampedTrainingInstance() = default;
+
+TimestampedTrainingInstance::TimestampedTrainingInstance(
+    TrainingInstance training_instance,
+    base::Time created_at)
+    : training_instance(std::move(training_instance)),
+      created_at(created_at) {}
+
+TimestampedTrainingInstance::TimestampedTrainingInstance(
+    TimestampedTrainingInstance&&) = default;
+
+TimestampedTrainingInstance& TimestampedTrainingInstance::operator=(
+    TimestampedTrainingInstance&&) = default;
+
+TimestampedTrainingInstance::~TimestampedTrainingInstance() = default;
+
+ColumnarDataStoreTask::ColumnarDataStoreTask() = default;
+
+ColumnarDataStoreTask::ColumnarDataStoreTask(int id,
+                                             std::string name,
+                                             std::vector<ColumnInfo> columns,
+                                             int max_number_of_instances,
+                                             base::TimeDelta max_retention_days)
+    : id(id),
+      name(std::move(name)),
+      columns(std::move(columns)),
+      max_number_of_instances(max_number_of_instances),
+      max_retention_days(max_retention_days) {}
+
+ColumnarDataStoreTask::ColumnarDataStoreTask(const ColumnarDataStoreTask&) =
+    default;
+
+ColumnarDataStoreTask& ColumnarDataStoreTask::operator=(
+    const ColumnarDataStoreTask&) = default;
+
+ColumnarDataStoreTask::~ColumnarDataStoreTask() = default;
+
+TrainingMatrix::TrainingMatrix() = default;
+
+TrainingMatrix::TrainingMatrix(TrainingMatrix&&) = default;
+
+TrainingMatrix& TrainingMatrix::operator=(TrainingMatrix&&) = default;
+
+TrainingMatrix::~TrainingMatrix() = default;
+
+absl::optional<size_t> TrainingMatrix::GetColumnIndex(
+    mojom::CovariateType type) const {
+  for (size_t i = 0; i < columns.size(); ++i) {
+    if (columns[i].type == type)
+      return i;
+  }
+
+  return absl::nullopt;
+}
+
+absl::optional<float> TrainingMatrix::GetCategoryCode(
+    mojom::CovariateType type,
+    const std::string& value) const {
+  const absl::optional<size_t> column = GetColumnIndex(type);
+  if (!column || *column >= dictionaries.size())
+    return absl::nullopt;
+
+  const auto& dictionary = dictionaries[*column];
+  const auto iter = dictionary.find(value);
+  if (iter == dictionary.end())
+    return absl::nullopt;
+
+  return static_cast<float>(iter->second);
+}
+
+ColumnarDataStore::ColumnarDataStore(
+    const ColumnarDataStoreTask& data_store_task,
+    const base::FilePath& db_file_path)
+    : database_(
+          {.exclusive_locking = true, .page_size = 4096, .cache_size = 500}),
+      db_file_path_(db_file_path),
+      data_store_task_(data_store_task),
+      table_name_(data_store_task.name),
+      dictionary_table_name_(data_store_task.name + "_dictionary"),
+      dictionaries_(data_store_task.columns.size()) {
+  DCHECK_GT(data_store_task_.max_number_of_instances, 0);
+
+  std::vector<std::string> column_names;
+  std::vector<std::string> placeholders;
+  for (size_t i = 0; i < data_store_task_.columns.size(); ++i) {
+    const ColumnInfo& column = data_store_task_.columns[i];
+    column_indices_[column.type] = i;
+    column_names.push_back(GetColumnName(column));
+    placeholders.push_back("?");
+  }
+
+  insert_sql_ = base::StringPrintf(
+      "INSERT OR REPLACE INTO %s (slot, sequence_number, created_at, %s) "
+      "VALUES (?,?,?,%s)",
+      table_name_.c_str(), base::JoinString(column_names, ",").c_str(),
+      base::JoinString(placeholders, ",").c_str());
+  select_sql_ =
+      base::StringPrintf("SELECT %s FROM %s WHERE created_at >= ?",
+                         base::JoinString(column_names, ",").c_str(),
+                         table_name_.c_str());
+}
+
+ColumnarDataStore::~ColumnarDataStore() = default;
+
+bool ColumnarDataStore::InitializeDatabase() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  database_.set_histogram_tag(data_store_task_.name);
+
+  // To recover from corruption.
+  database_.set_error_callback(
+      base::BindRepeating(&DatabaseErrorCallback, &database_, db_file_path_));
+
+  return database_.Open(db_file_path_) && MaybeCreateTables() && LoadState();
+}
+
+bool ColumnarDataStore::AddTrainingInstance(
+    TrainingInstance training_instance) {
+  std::vector<TrainingInstance> training_instances;
+  training_instances.push_back(std::move(training_instance));
+  return AddTrainingInstances(std::move(training_instances));
+}
+
+bool ColumnarDataStore::AddTrainingInstances(
+    std::vector<TrainingInstance> training_instances) {
+  const base::Time created_at = base::Time::Now();
+
+  std::vector<TimestampedTrainingInstance> timestamped_training_instances;
+  timestamped_training_instances.reserve(training_instances.size());
+  for (auto& training_instance : training_instances) {
+    timestamped_training_instances.emplace_back(std::move(training_instance),
+                                                created_at);
+  }
+
+  return AddTimestampedTrainingInstances(
+      std::move(timestamped_training_instances));
+}
+
+bool ColumnarDataStore::AddTimestampedTrainingInstances(
+    std::vector<TimestampedTrainingInstance> training_instances) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (training_instances.empty())
+    return true;
+
+  sql::Transaction transaction(&database_);
+  if (!transaction.Begin())
+    return false;
+
+  for (const auto& training_instance : training_instances) {
+    if (!InsertTrainingInstance(training_instance.training_instance,
+                                training_instance.created_at)) {
+      transaction.Rollback();
+      // Discard the sequence numbers and category codes of the rolled back
+      // rows.
+      std::ignore = LoadState();
+      return false;
+    }
+  }
+
+  if (!transaction.Commit()) {
+    std::ignore = LoadState();
+    return false;
+  }
+
+  return true;
+}
+
+TrainingMatrix ColumnarDataStore::LoadTrainingMatrix() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  TrainingMatrix training_matrix;
+  training_matrix.num_columns = data_store_task_.columns.size();
+  training_matrix.columns = data_store_task_.columns;
+  training_matrix.dictionaries = dictionaries_;
+  training_matrix.values.reserve(
+      static_cast<size_t>(data_store_task_.max_number_of_instances) *
+      training_matrix.num_columns);
+
+  sql::Statement statement(
+      database_.GetCachedStatement(SQL_FROM_HERE, select_sql_.c_str()));
+  const base::Time expiration_threshold =
+      base::Time::Now() - data_store_task_.max_retention_days;
+  statement.BindDouble(0, expiration_threshold.ToDoubleT());
+
+  while (statement.Step()) {
+    for (size_t i = 0; i < training_matrix.num_columns; ++i) {
+      const int column = static_cast<int>(i);
+      training_matrix.values.push_back(
+          statement.GetColumnType(column) == sql::ColumnType::kNull
+              ? kMissingValue
+              : static_cast<float>(statement.ColumnDouble(column)));
+    }
+    training_matrix.num_rows++;
+  }
+
+  return training_matrix;
+}
+
+absl::optional<float> ColumnarDataStore::GetCategoryCode(
+    mojom::CovariateType type,
+    const std::string& value) const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  const auto column_iter = column_indices_.find(type);
+  if (column_iter == column_indices_.end())
+    return absl::nullopt;
+
+  const auto& dictionary = dictionaries_[column_iter->second];
+  const auto iter = dictionary.find(value);
+  if (iter == dictionary.end())
+    return absl::nullopt;
+
+  return static_cast<float>(iter->second);
+}
+
+bool ColumnarDataStore::DeleteTrainingData() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Transaction transaction(&database_);
+  if (!transaction.Begin() ||
+      !database_.Execute(
+          base::StringPrintf("DELETE FROM %s", table_name_.c_str()).c_str()) ||
+      !database_.Execute(
+          base::StringPrintf("DELETE FROM %s", dictionary_table_name_.c_str())
+              .c_str()) ||
+      !transaction.Commit()) {
+    return false;
+  }
+
+  for (auto& dictionary : dictionaries_) {
+    dictionary.clear();
+  }
+  next_sequence_number_ = 0;
+
+  std::ignore = database_.Execute("VACUUM");
+  return true;
+}
+
+void ColumnarDataStore::PurgeTrainingDataAfterExpirationDate() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Retention by count is enforced by the ring buffer, so only expired rows
+  // need to be deleted here.
+  sql::Statement delete_statement(database_.GetUniqueStatement(
+      base::StringPrintf("DELETE FROM %s WHERE created_at < ?",
+                         table_name_.c_str())
+          .c_str()));
+  const base::Time expiration_threshold =
+      base::Time::Now() - data_store_task_.max_retention_days;
+  delete_statement.BindDouble(0, expiration_threshold.ToDoubleT());
+  delete_statement.Run();
+}
+
+int64_t ColumnarDataStore::GetNumberOfInstancesForTesting() const {
+  sql::Statement statement(database_.GetUniqueStatement(
+      base::StringPrintf("SELECT COUNT(*) FROM %s", table_name_.c_str())
+          .c_str()));
+  if (!statement.Step())
+    return 0;
+
+  return statement.ColumnInt64(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool ColumnarDataStore::MaybeCreateTables() {
+  // Training data is disposable, so a table with a stale schema is dropped
+  // instead of migrated.
+  bool has_valid_schema = database_.DoesTableExist(table_name_);
+  for (const auto& column : data_store_task_.columns) {
+    if (!has_valid_schema)
+      break;
+    has_valid_schema =
+        database_.DoesColumnExist(table_name_.c_str(),
+                                  GetColumnName(column).c_str());
+  }
+
+  if (has_valid_schema && database_.DoesTableExist(dictionary_table_name_))
+    return true;
+
+  std::vector<std::string> column_definitions;
+  for (const auto& column : data_store_task_.columns) {
+    column_definitions.push_back(GetColumnDefinition(column));
+  }
+
+  sql::Transaction transaction(&database_);
+  return transaction.Begin() &&
+         database_.Execute(
+             base::StringPrintf("DROP TABLE IF EXISTS %s", table_name_.c_str())
+                 .c_str()) &&
+         database_.Execute(base::StringPrintf("DROP TABLE IF EXISTS %s",
+                                              dictionary_table_name_.c_str())
+                               .c_str()) &&
+         database_.Execute(
+             base::StringPrintf(
+                 "CREATE TABLE %s (slot INTEGER PRIMARY KEY, "
+                 "sequence_number INTEGER NOT NULL, created_at DOUBLE NOT "
+                 "NULL, %s)",
+                 table_name_.c_str(),
+                 base::JoinString(column_definitions, ",").c_str())
+                 .c_str()) &&
+         database_.Execute(
+             base::StringPrintf(
+                 "CREATE TABLE %s (column_index INTEGER NOT NULL, value TEXT "
+                 "NOT NULL, code INTEGER NOT NULL, PRIMARY KEY (column_index, "
+                 "value))",
+                 dictionary_table_name_.c_str())
+                 .c_str()) &&
+         transaction.Commit();
+}
+
+bool ColumnarDataStore::LoadState() {
+  sql::Statement sequence_statement(database_.GetUniqueStatement(
+      base::StringPrintf("SELECT MAX(sequence_number) FROM %s",
+                         table_name_.c_str())
+          .c_str()));
+  if (!sequence_statement.Step())
+    return false;
+
+  next_sequence_number_ =
+      sequence_statement.GetColumnType(0) == sql::ColumnType::kNull
+          ? 0
+          : sequence_statement.ColumnInt64(0) + 1;
+
+  for (auto& dictionary : dictionaries_) {
+    dictionary.clear();
+  }
+
+  sql::Statement dictionary_statement(database_.GetUniqueStatement(
+      base::StringPrintf("SELECT column_index, value, code FROM %s",
+                         dictionary_table_name_.c_str())
+          .c_str()));
+  while (dictionary_statement.Step()) {
+    const size_t column =
+        static_cast<size_t>(dictionary_statement.ColumnInt(0));
+    if (column >= dictionaries_.size())
+      continue;
+
+    dictionaries_[column][dictionary_statement.ColumnString(1)] =
+        dictionary_statement.ColumnInt(2);
+  }
+
+  return dictionary_statement.Succeeded();
+}
+
+bool ColumnarDataStore::InsertTrainingInstance(
+    const TrainingInstance& training_instance,
+    base::Time created_at) {
+  std::vector<double> row(data_store_task_.columns.size(),
+                          kMissingStoredValue);
+  for (const auto& covariate : training_instance) {
+    DCHECK(covariate);
+    const auto iter = column_indices_.find(covariate->type);
+    if (iter == column_indices_.end())
+      continue;
+
+    row[iter->second] = EncodeValue(iter->second, *covariate);
+  }
+
+  const int64_t sequence_number = next_sequence_number_++;
+  const int64_t slot =
+      sequence_number % data_store_task_.max_number_of_instances;
+
+  sql::Statement statement(
+      database_.GetCachedStatement(SQL_FROM_HERE, insert_sql_.c_str()));
+  statement.BindInt64(0, slot);
+  statement.BindInt64(1, sequence_number);
+  statement.BindDouble(2, created_at.ToDoubleT());
+  for (size_t i = 0; i < row.size(); ++i) {
+    const int index = static_cast<int>(i) + 3;
+    if (std::isnan(row[i])) {
+      statement.BindNull(index);
+    } else {
+      statement.BindDouble(index, row[i]);
+    }
+  }
+
+  return statement.Run();
+}
+
+double ColumnarDataStore::EncodeValue(size_t column,
+                                      const mojom::CovariateInfo& covariate) {
+  const mojom::DataType data_type = data_store_task_.columns[column].data_type;
+  if (data_type != mojom::DataType::kString)
+    return ParseNumericValue(data_type, covariate.value);
+
+  auto& dictionary = dictionaries_[column];
+  const auto iter = dictionary.find(covariate.value);
+  if (iter != dictionary.end())
+    return iter->second;
+
+  const int code = static_cast<int>(dictionary.size());
+  sql::Statement statement(database_.GetCachedStatement(
+      SQL_FROM_HERE,
+      base::StringPrintf(
+          "INSERT INTO %s (column_index, value, code) VALUES (?,?,?)",
+          dictionary_table_name_.c_str())
+          .c_str()));
+  statement.BindInt(0, static_cast<int>(column));
+  statement.BindString(1, covariate.value);
+  statement.BindInt(2, code);
+  if (!statement.Run())
+    return kMissingStoredValue;
+
+  dictionary[covariate.value] = code;
+  return code;
+}
+
+}  // namespace brave_federated
@@ -0,0 +1,146 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_FEDERATED_DATA_STORES_COLUMNAR_DATA_STORE_H_
+#define BRAVE_COMPONENTS_BRAVE_FEDERATED_DATA_STORES_COLUMNAR_DATA_STORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/files/file_path.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "brave/components/brave_federated/public/interfaces/brave_federated.mojom.h"
+#include "sql/database.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace brave_federated {
+
+using TrainingInstance = std::vector<mojom::CovariateInfoPtr>;
+
+// Training instance logged at |created_at|, e.g. when it is migrated from the
+// legacy per-covariate |DataStore|.
+struct TimestampedTrainingInstance {
+  TimestampedTrainingInstance();
+  TimestampedTrainingInstance(TrainingInstance training_instance,
+                              base::Time created_at);
+  TimestampedTrainingInstance(TimestampedTrainingInstance&&);
+  TimestampedTrainingInstance& operator=(TimestampedTrainingInstance&&);
+  ~TimestampedTrainingInstance();
+
+  TrainingInstance training_instance;
+  base::Time created_at;
+};
+
+struct ColumnInfo {
+  mojom::CovariateType type;
+  mojom::DataType data_type;
+};
+
+struct ColumnarDataStoreTask {
+  ColumnarDataStoreTask();
+  ColumnarDataStoreTask(int id,
+                        std::string name,
+                        std::vector<ColumnInfo> columns,
+                        int max_number_of_instances,
+                        base::TimeDelta max_retention_days);
+  ColumnarDataStoreTask(const ColumnarDataStoreTask&);
+  ColumnarDataStoreTask& operator=(const ColumnarDataStoreTask&);
+  ~ColumnarDataStoreTask();
+
+  int id = 0;
+  std::string name;
+  std::vector<ColumnInfo> columns;
+  int max_number_of_instances = 0;
+  base::TimeDelta max_retention_days;
+};
+
+// Dense, row-major matrix of training instances. Row |i| starts at
+// |values[i * num_columns]| and columns follow the order of the task schema.
+// Missing covariates are NaN and string covariates hold their category code,
+// see |ColumnarDataStore::GetCategoryCode|.
+struct TrainingMatrix {
+  TrainingMatrix();
+  TrainingMatrix(TrainingMatrix&&);
+  TrainingMatrix& operator=(TrainingMatrix&&);
+  ~TrainingMatrix();
+
+  const float* Row(size_t row) const { return &values[row * num_columns]; }
+
+  absl::optional<size_t> GetColumnIndex(mojom::CovariateType type) const;
+  absl::optional<float> GetCategoryCode(mojom::CovariateType type,
+                                        const std::string& value) const;
+
+  size_t num_rows = 0;
+  size_t num_columns = 0;
+  std::vector<float> values;
+
+  std::vector<ColumnInfo> columns;
+  std::vector<base::flat_map<std::string, int>> dictionaries;
+};
+
+// Fixed-schema counterpart of |DataStore| which keeps one row per training
+// instance with a typed column per covariate. Rows live in a ring buffer of
+// |max_number_of_instances| slots, so retention by count is enforced by
+// overwriting the oldest slot on insert rather than by deleting rows.
+class ColumnarDataStore {
+ public:
+  ColumnarDataStore(const ColumnarDataStoreTask& data_store_task,
+                    const base::FilePath& db_file_path);
+  ~ColumnarDataStore();
+
+  ColumnarDataStore(const ColumnarDataStore&) = delete;
+  ColumnarDataStore& operator=(const ColumnarDataStore&) = delete;
+
+  bool InitializeDatabase();
+
+  bool AddTrainingInstance(TrainingInstance training_instance);
+  // Inserts all |training_instances| in a single transaction.
+  bool AddTrainingInstances(std::vector<TrainingInstance> training_instances);
+  // Inserts all |training_instances| in a single transaction, keeping their
+  // original creation time.
+  bool AddTimestampedTrainingInstances(
+      std::vector<TimestampedTrainingInstance> training_instances);
+
+  // Loads all unexpired training instances with a single sequential scan.
+  TrainingMatrix LoadTrainingMatrix();
+  absl::optional<float> GetCategoryCode(mojom::CovariateType type,
+                                        const std::string& value) const;
+
+  bool DeleteTrainingData();
+  void PurgeTrainingDataAfterExpirationDate();
+
+  int64_t GetNumberOfInstancesForTesting() const;
+
+ private:
+  bool MaybeCreateTables();
+  bool LoadState();
+  bool InsertTrainingInstance(const TrainingInstance& training_instance,
+                              base::Time created_at);
+  double EncodeValue(size_t column, const mojom::CovariateInfo& covariate);
+
+  sql::Database database_;
+  base::FilePath db_file_path_;
+  ColumnarDataStoreTask data_store_task_;
+
+  std::string table_name_;
+  std::string dictionary_table_name_;
+  std::string insert_sql_;
+  std::string select_sql_;
+
+  base::flat_map<mojom::CovariateType, size_t> column_indices_;
+  // Per-column dictionary of string values to category codes.
+  std::vector<base::flat_map<std::string, int>> dictionaries_;
+  int64_t next_sequence_number_ = 0;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace brave_federated
+
+#endif  // BRAVE_COMPONENTS_BRAVE_FEDERATED_DATA_STORES_COLUMNAR_DATA_STORE_H_
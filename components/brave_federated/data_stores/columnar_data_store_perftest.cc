@@ -0,0 +1,100 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/brave_federated/data_stores/columnar_data_store.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// npm run test -- brave_perftests --filter=ColumnarDataStorePerfTest*
+
+namespace brave_federated {
+
+namespace {
+
+constexpr int kNumberOfColumns = 30;
+constexpr int kBatchSize = 1000;
+
+ColumnarDataStoreTask GetPerfTestTask(int max_number_of_instances) {
+  std::vector<ColumnInfo> columns;
+  for (int i = 0; i < kNumberOfColumns; ++i) {
+    columns.push_back(
+        {static_cast<mojom::CovariateType>(i), mojom::DataType::kDouble});
+  }
+
+  return ColumnarDataStoreTask(0, "perf_test_task", std::move(columns),
+                               max_number_of_instances, base::Days(30));
+}
+
+TrainingInstance BuildTrainingInstance(int seed) {
+  TrainingInstance training_instance;
+  for (int i = 0; i < kNumberOfColumns; ++i) {
+    mojom::CovariateInfoPtr covariate = mojom::CovariateInfo::New();
+    covariate->type = static_cast<mojom::CovariateType>(i);
+    covariate->data_type = mojom::DataType::kDouble;
+    covariate->value = base::NumberToString((seed * 31 + i) % 997);
+    training_instance.push_back(std::move(covariate));
+  }
+  return training_instance;
+}
+
+}  // namespace
+
+class ColumnarDataStorePerfTest : public testing::TestWithParam<int> {
+ protected:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_P(ColumnarDataStorePerfTest, InsertAndLoadThroughput) {
+  const int number_of_instances = GetParam();
+  ColumnarDataStore data_store(
+      GetPerfTestTask(number_of_instances),
+      temp_dir_.GetPath().Append(FILE_PATH_LITERAL("perf_data_store")));
+  ASSERT_TRUE(data_store.InitializeDatabase());
+
+  perf_test::PerfResultReporter reporter(
+      "ColumnarDataStore", base::StringPrintf("%d_instances",
+                                              number_of_instances));
+  reporter.RegisterImportantMetric(".insert_throughput", "runs/s");
+  reporter.RegisterImportantMetric(".load_throughput", "runs/s");
+
+  base::ElapsedTimer insert_timer;
+  for (int i = 0; i < number_of_instances; i += kBatchSize) {
+    std::vector<TrainingInstance> training_instances;
+    for (int j = i; j < i + kBatchSize && j < number_of_instances; ++j) {
+      training_instances.push_back(BuildTrainingInstance(j));
+    }
+    ASSERT_TRUE(data_store.AddTrainingInstances(std::move(training_instances)));
+  }
+  reporter.AddResult(
+      ".insert_throughput",
+      number_of_instances / insert_timer.Elapsed().InSecondsF());
+
+  base::ElapsedTimer load_timer;
+  const TrainingMatrix training_matrix = data_store.LoadTrainingMatrix();
+  reporter.AddResult(".load_throughput",
+                     number_of_instances / load_timer.Elapsed().InSecondsF());
+
+  EXPECT_EQ(static_cast<size_t>(number_of_instances), training_matrix.num_rows);
+}
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         ColumnarDataStorePerfTest,
+                         testing::Values(10000, 100000));
+
+}  // namespace brave_federated
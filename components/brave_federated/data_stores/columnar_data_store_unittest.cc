@@ -0,0 +1,230 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_federated/data_stores/columnar_data_store.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "sql/database.h"
+#include "sql/statement.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=ColumnarDataStoreTest*
+
+namespace brave_federated {
+
+namespace {
+
+constexpr char kTaskName[] = "test_columnar_federated_task";
+constexpr int kMaxNumberOfInstances = 3;
+
+ColumnarDataStoreTask GetTestTask() {
+  return ColumnarDataStoreTask(
+      0, kTaskName,
+      {{mojom::CovariateType::kNotificationAdServedAt,
+        mojom::DataType::kDouble},
+       {mojom::CovariateType::kNotificationAdEvent, mojom::DataType::kString},
+       {mojom::CovariateType::kLastNotificationAdWasClicked,
+        mojom::DataType::kBool}},
+      kMaxNumberOfInstances, base::Days(30));
+}
+
+mojom::CovariateInfoPtr BuildCovariate(mojom::CovariateType type,
+                                       mojom::DataType data_type,
+                                       const std::string& value) {
+  mojom::CovariateInfoPtr covariate = mojom::CovariateInfo::New();
+  covariate->type = type;
+  covariate->data_type = data_type;
+  covariate->value = value;
+  return covariate;
+}
+
+TrainingInstance BuildTrainingInstance(double served_at,
+                                       const std::string& event,
+                                       bool was_clicked) {
+  TrainingInstance training_instance;
+  training_instance.push_back(BuildCovariate(
+      mojom::CovariateType::kNotificationAdServedAt, mojom::DataType::kDouble,
+      base::NumberToString(served_at)));
+  training_instance.push_back(
+      BuildCovariate(mojom::CovariateType::kNotificationAdEvent,
+                     mojom::DataType::kString, event));
+  training_instance.push_back(
+      BuildCovariate(mojom::CovariateType::kLastNotificationAdWasClicked,
+                     mojom::DataType::kBool, was_clicked ? "1" : "0"));
+  return training_instance;
+}
+
+}  // namespace
+
+class ColumnarDataStoreTest : public testing::Test {
+ public:
+  ColumnarDataStoreTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    db_path_ = temp_dir_.GetPath().Append(
+        FILE_PATH_LITERAL("test_columnar_data_store"));
+    data_store_ = std::make_unique<ColumnarDataStore>(GetTestTask(), db_path_);
+    ASSERT_TRUE(data_store_->InitializeDatabase());
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath db_path_;
+  std::unique_ptr<ColumnarDataStore> data_store_;
+};
+
+TEST_F(ColumnarDataStoreTest, LoadTrainingMatrixWhenDatabaseEmpty) {
+  const TrainingMatrix training_matrix = data_store_->LoadTrainingMatrix();
+  EXPECT_EQ(0U, training_matrix.num_rows);
+  EXPECT_EQ(3U, training_matrix.num_columns);
+  EXPECT_TRUE(training_matrix.values.empty());
+}
+
+TEST_F(ColumnarDataStoreTest, AddTrainingInstances) {
+  std::vector<TrainingInstance> training_instances;
+  training_instances.push_back(BuildTrainingInstance(1.5, "clicked", true));
+  training_instances.push_back(BuildTrainingInstance(2.5, "dismissed", false));
+  EXPECT_TRUE(data_store_->AddTrainingInstances(std::move(training_instances)));
+
+  const TrainingMatrix training_matrix = data_store_->LoadTrainingMatrix();
+  ASSERT_EQ(2U, training_matrix.num_rows);
+  ASSERT_EQ(6U, training_matrix.values.size());
+
+  const absl::optional<float> clicked = data_store_->GetCategoryCode(
+      mojom::CovariateType::kNotificationAdEvent, "clicked");
+  const absl::optional<float> dismissed = data_store_->GetCategoryCode(
+      mojom::CovariateType::kNotificationAdEvent, "dismissed");
+  ASSERT_TRUE(clicked);
+  ASSERT_TRUE(dismissed);
+  EXPECT_NE(*clicked, *dismissed);
+  EXPECT_EQ(clicked,
+            training_matrix.GetCategoryCode(
+                mojom::CovariateType::kNotificationAdEvent, "clicked"));
+
+  EXPECT_FLOAT_EQ(1.5f, training_matrix.Row(0)[0]);
+  EXPECT_FLOAT_EQ(*clicked, training_matrix.Row(0)[1]);
+  EXPECT_FLOAT_EQ(1.0f, training_matrix.Row(0)[2]);
+  EXPECT_FLOAT_EQ(2.5f, training_matrix.Row(1)[0]);
+  EXPECT_FLOAT_EQ(*dismissed, training_matrix.Row(1)[1]);
+  EXPECT_FLOAT_EQ(0.0f, training_matrix.Row(1)[2]);
+}
+
+TEST_F(ColumnarDataStoreTest, NumericCovariatesAreStoredAtFullPrecision) {
+  // A timestamp in seconds which cannot be represented exactly as a float.
+  constexpr double kServedAt = 1656000000.125;
+  EXPECT_TRUE(data_store_->AddTrainingInstance(
+      BuildTrainingInstance(kServedAt, "clicked", true)));
+
+  const TrainingMatrix training_matrix = data_store_->LoadTrainingMatrix();
+  ASSERT_EQ(1U, training_matrix.num_rows);
+  EXPECT_FLOAT_EQ(static_cast<float>(kServedAt), training_matrix.Row(0)[0]);
+
+  data_store_.reset();
+  sql::Database database;
+  ASSERT_TRUE(database.Open(db_path_));
+  sql::Statement statement(database.GetUniqueStatement(
+      base::StringPrintf(
+          "SELECT c%d FROM %s",
+          static_cast<int>(mojom::CovariateType::kNotificationAdServedAt),
+          kTaskName)
+          .c_str()));
+  ASSERT_TRUE(statement.Step());
+  EXPECT_EQ(kServedAt, statement.ColumnDouble(0));
+}
+
+TEST_F(ColumnarDataStoreTest, MissingCovariatesAreNaN) {
+  TrainingInstance training_instance;
+  training_instance.push_back(
+      BuildCovariate(mojom::CovariateType::kNotificationAdServedAt,
+                     mojom::DataType::kDouble, "not a number"));
+  EXPECT_TRUE(data_store_->AddTrainingInstance(std::move(training_instance)));
+
+  const TrainingMatrix training_matrix = data_store_->LoadTrainingMatrix();
+  ASSERT_EQ(1U, training_matrix.num_rows);
+  for (const float value : training_matrix.values) {
+    EXPECT_TRUE(std::isnan(value));
+  }
+}
+
+TEST_F(ColumnarDataStoreTest, RingBufferWrapsAround) {
+  for (int i = 0; i < kMaxNumberOfInstances * 2 + 1; ++i) {
+    EXPECT_TRUE(data_store_->AddTrainingInstance(
+        BuildTrainingInstance(i, "viewed", false)));
+  }
+
+  EXPECT_EQ(kMaxNumberOfInstances,
+            data_store_->GetNumberOfInstancesForTesting());
+
+  const TrainingMatrix training_matrix = data_store_->LoadTrainingMatrix();
+  ASSERT_EQ(static_cast<size_t>(kMaxNumberOfInstances),
+            training_matrix.num_rows);
+
+  std::vector<float> served_at;
+  for (size_t i = 0; i < training_matrix.num_rows; ++i) {
+    served_at.push_back(training_matrix.Row(i)[0]);
+  }
+  std::sort(served_at.begin(), served_at.end());
+  EXPECT_EQ(std::vector<float>({4.0f, 5.0f, 6.0f}), served_at);
+}
+
+TEST_F(ColumnarDataStoreTest, StateIsRestoredOnReopen) {
+  EXPECT_TRUE(data_store_->AddTrainingInstance(
+      BuildTrainingInstance(1, "clicked", true)));
+  EXPECT_TRUE(data_store_->AddTrainingInstance(
+      BuildTrainingInstance(2, "viewed", false)));
+  const absl::optional<float> clicked = data_store_->GetCategoryCode(
+      mojom::CovariateType::kNotificationAdEvent, "clicked");
+
+  data_store_.reset();
+  data_store_ = std::make_unique<ColumnarDataStore>(GetTestTask(), db_path_);
+  ASSERT_TRUE(data_store_->InitializeDatabase());
+
+  EXPECT_EQ(clicked,
+            data_store_->GetCategoryCode(
+                mojom::CovariateType::kNotificationAdEvent, "clicked"));
+
+  // The ring buffer continues after the last written slot instead of
+  // overwriting the oldest instances.
+  EXPECT_TRUE(data_store_->AddTrainingInstance(
+      BuildTrainingInstance(3, "viewed", false)));
+  EXPECT_EQ(3, data_store_->GetNumberOfInstancesForTesting());
+}
+
+TEST_F(ColumnarDataStoreTest, DeleteTrainingData) {
+  EXPECT_TRUE(data_store_->AddTrainingInstance(
+      BuildTrainingInstance(1, "clicked", true)));
+  EXPECT_TRUE(data_store_->DeleteTrainingData());
+
+  EXPECT_EQ(0, data_store_->GetNumberOfInstancesForTesting());
+  EXPECT_FALSE(data_store_->GetCategoryCode(
+      mojom::CovariateType::kNotificationAdEvent, "clicked"));
+}
+
+TEST_F(ColumnarDataStoreTest, PurgeTrainingDataAfterExpirationDate) {
+  EXPECT_TRUE(data_store_->AddTrainingInstance(
+      BuildTrainingInstance(1, "clicked", true)));
+  task_environment_.AdvanceClock(base::Days(31));
+
+  EXPECT_EQ(0U, data_store_->LoadTrainingMatrix().num_rows);
+
+  data_store_->PurgeTrainingDataAfterExpirationDate();
+  EXPECT_EQ(0, data_store_->GetNumberOfInstancesForTesting());
+}
+
+}  // namespace brave_federated
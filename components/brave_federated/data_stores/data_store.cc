@@ -152,6 +152,23 @@ TrainingData DataStore::LoadTrainingData() {
   return training_instances;
 }
 
+base::flat_map<int, base::Time> DataStore::LoadTrainingInstanceCreationTimes() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  base::flat_map<int, base::Time> creation_times;
+  sql::Statement statement(database_.GetUniqueStatement(
+      base::StringPrintf("SELECT training_instance_id, MIN(created_at) FROM %s "
+                         "GROUP BY training_instance_id",
+                         data_store_task_.name.c_str())
+          .c_str()));
+  while (statement.Step()) {
+    creation_times[statement.ColumnInt(0)] =
+        base::Time::FromDoubleT(statement.ColumnDouble(1));
+  }
+
+  return creation_times;
+}
+
 bool DataStore::DeleteTrainingData() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -9,9 +9,11 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/files/file_path.h"
 #include "base/gtest_prod_util.h"
 #include "base/sequence_checker.h"
+#include "base/time/time.h"
 #include "brave/components/brave_federated/public/interfaces/brave_federated.mojom.h"
 #include "sql/database.h"
 
@@ -47,6 +49,9 @@ class DataStore {
 
   bool DeleteTrainingData();
   TrainingData LoadTrainingData();
+  // Returns the time each training instance was logged, keyed by training
+  // instance id.
+  base::flat_map<int, base::Time> LoadTrainingInstanceCreationTimes();
   void PurgeTrainingDataAfterExpirationDate();
 
  protected:
@@ -13,6 +13,7 @@ EligibilityService::EligibilityService()
           base::PowerMonitor::AddPowerStateObserverAndReturnOnBatteryState(
               this)) {
   connection_type_ = net::NetworkChangeNotifier::GetConnectionType();
+  is_eligible_ = IsEligibile();
   net::NetworkChangeNotifier::AddNetworkChangeObserver(this);
 }
 
@@ -43,6 +43,10 @@ const char kFieldTrialParameterMockCollectionRequests[] =
     "mock_collection_requests";
 const bool kDefaultMockCollectionRequests = false;
 
+const char kFieldTrialParameterOnDeviceTrainingEnabled[] =
+    "on_device_training_enabled";
+const bool kDefaultOnDeviceTrainingEnabled = false;
+
 }  // namespace
 
 const base::Feature kFederatedLearning{kFeatureName,
@@ -88,5 +92,11 @@ bool MockCollectionRequests() {
       kDefaultMockCollectionRequests);
 }
 
+bool IsOnDeviceTrainingEnabled() {
+  return GetFieldTrialParamByFeatureAsBool(
+      kFederatedLearning, kFieldTrialParameterOnDeviceTrainingEnabled,
+      kDefaultOnDeviceTrainingEnabled);
+}
+
 }  // namespace features
 }  // namespace brave_federated
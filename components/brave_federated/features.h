@@ -24,6 +24,9 @@ int GetCollectionTimerIntervalInSeconds();
 int GetMockTaskDurationInSeconds();
 bool MockCollectionRequests();
 
+// On-device training
+bool IsOnDeviceTrainingEnabled();
+
 }  // namespace features
 
 }  // namespace brave_federated
@@ -0,0 +1,64 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_federated/learning/learning_test_util.h"
+
+#include <cstdint>
+
+namespace brave_federated {
+
+namespace {
+
+constexpr int kNoiseEveryNthExample = 20;
+
+// Linear congruential generator, so that test data does not depend on the
+// standard library implementation.
+class Random {
+ public:
+  explicit Random(uint32_t seed) : state_(seed) {}
+
+  // Returns a value in [-1, 1).
+  float Next() {
+    state_ = state_ * 1664525u + 1013904223u;
+    return static_cast<float>(state_ >> 8) / static_cast<float>(1 << 23) -
+           1.0f;
+  }
+
+ private:
+  uint32_t state_;
+};
+
+}  // namespace
+
+TrainingExamples BuildSyntheticTrainingExamples(
+    size_t number_of_examples,
+    const std::vector<float>& true_weights,
+    float true_bias) {
+  Random random(/*seed*/ 42);
+
+  TrainingExamples examples;
+  examples.num_features = true_weights.size();
+  examples.features.reserve(number_of_examples * examples.num_features);
+  examples.labels.reserve(number_of_examples);
+
+  for (size_t i = 0; i < number_of_examples; ++i) {
+    float z = true_bias;
+    for (const float weight : true_weights) {
+      const float feature = random.Next();
+      examples.features.push_back(feature);
+      z += weight * feature;
+    }
+
+    bool label = z > 0.0f;
+    if (i % kNoiseEveryNthExample == 0) {
+      label = !label;
+    }
+    examples.labels.push_back(label ? 1.0f : 0.0f);
+  }
+
+  return examples;
+}
+
+}  // namespace brave_federated
@@ -0,0 +1,25 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_LEARNING_TEST_UTIL_H_
+#define BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_LEARNING_TEST_UTIL_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "brave/components/brave_federated/learning/training_examples.h"
+
+namespace brave_federated {
+
+// Builds deterministic, linearly separable examples labelled by the sign of
+// |true_weights| . x + |true_bias|, with a fraction of labels flipped as noise.
+TrainingExamples BuildSyntheticTrainingExamples(
+    size_t number_of_examples,
+    const std::vector<float>& true_weights,
+    float true_bias);
+
+}  // namespace brave_federated
+
+#endif  // BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_LEARNING_TEST_UTIL_H_
@@ -0,0 +1,97 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_federated/learning/logistic_regression_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/check_op.h"
+#include "brave/components/brave_federated/learning/training_examples.h"
+#include "brave/components/brave_federated/learning/vector_math.h"
+
+namespace brave_federated {
+
+namespace {
+
+// Keeps log() finite for saturated predictions.
+constexpr float kEpsilon = 1e-7f;
+
+float Sigmoid(float z) {
+  return 1.0f / (1.0f + std::exp(-z));
+}
+
+}  // namespace
+
+LogisticRegressionModel::LogisticRegressionModel(size_t num_features)
+    : weights_(num_features, 0.0f), gradient_(num_features, 0.0f) {}
+
+LogisticRegressionModel::~LogisticRegressionModel() = default;
+
+size_t LogisticRegressionModel::GetNumberOfFeatures() const {
+  return weights_.size();
+}
+
+float LogisticRegressionModel::Predict(const float* features) const {
+  return Sigmoid(
+      vector_math::DotProduct(weights_.data(), features, weights_.size()) +
+      bias_);
+}
+
+float LogisticRegressionModel::TrainBatch(const TrainingExamples& examples,
+                                          size_t begin,
+                                          size_t end,
+                                          float learning_rate) {
+  DCHECK_EQ(examples.num_features, weights_.size());
+  DCHECK_LT(begin, end);
+  DCHECK_LE(end, examples.size());
+
+  std::fill(gradient_.begin(), gradient_.end(), 0.0f);
+  float bias_gradient = 0.0f;
+  float loss = 0.0f;
+
+  for (size_t i = begin; i < end; ++i) {
+    const float* features = examples.Features(i);
+    const float label = examples.labels[i];
+    const float prediction = Predict(features);
+    const float error = prediction - label;
+
+    vector_math::AddScaled(features, error, gradient_.size(),
+                           gradient_.data());
+    bias_gradient += error;
+
+    const float clamped_prediction =
+        std::clamp(prediction, kEpsilon, 1.0f - kEpsilon);
+    loss -= label * std::log(clamped_prediction) +
+            (1.0f - label) * std::log(1.0f - clamped_prediction);
+  }
+
+  const float batch_size = static_cast<float>(end - begin);
+  const float step = -learning_rate / batch_size;
+  vector_math::AddScaled(gradient_.data(), step, weights_.size(),
+                         weights_.data());
+  bias_ += step * bias_gradient;
+
+  return loss / batch_size;
+}
+
+std::vector<float> LogisticRegressionModel::GetParameters() const {
+  std::vector<float> parameters = weights_;
+  parameters.push_back(bias_);
+  return parameters;
+}
+
+bool LogisticRegressionModel::SetParameters(
+    const std::vector<float>& parameters) {
+  if (parameters.size() != weights_.size() + 1) {
+    return false;
+  }
+
+  std::copy(parameters.begin(), parameters.end() - 1, weights_.begin());
+  bias_ = parameters.back();
+  return true;
+}
+
+}  // namespace brave_federated
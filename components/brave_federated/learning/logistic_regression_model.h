@@ -0,0 +1,45 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_LOGISTIC_REGRESSION_MODEL_H_
+#define BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_LOGISTIC_REGRESSION_MODEL_H_
+
+#include <vector>
+
+#include "brave/components/brave_federated/learning/model.h"
+
+namespace brave_federated {
+
+// Binary logistic regression trained with mini-batch SGD. Gradients for a
+// batch are accumulated into a scratch buffer and applied once per batch.
+class LogisticRegressionModel final : public Model {
+ public:
+  explicit LogisticRegressionModel(size_t num_features);
+  ~LogisticRegressionModel() override;
+
+  LogisticRegressionModel(const LogisticRegressionModel&) = delete;
+  LogisticRegressionModel& operator=(const LogisticRegressionModel&) = delete;
+
+  // Model:
+  size_t GetNumberOfFeatures() const override;
+  float Predict(const float* features) const override;
+  float TrainBatch(const TrainingExamples& examples,
+                   size_t begin,
+                   size_t end,
+                   float learning_rate) override;
+  // Returns the weights followed by the bias.
+  std::vector<float> GetParameters() const override;
+  bool SetParameters(const std::vector<float>& parameters) override;
+
+ private:
+  std::vector<float> weights_;
+  float bias_ = 0.0f;
+
+  std::vector<float> gradient_;
+};
+
+}  // namespace brave_federated
+
+#endif  // BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_LOGISTIC_REGRESSION_MODEL_H_
@@ -0,0 +1,63 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/brave_federated/learning/learning_test_util.h"
+#include "brave/components/brave_federated/learning/logistic_regression_model.h"
+#include "brave/components/brave_federated/learning/training_examples.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// npm run test -- brave_perftests --filter=LogisticRegressionModelPerfTest*
+
+namespace brave_federated {
+
+namespace {
+
+constexpr size_t kNumberOfExamples = 10000;
+constexpr size_t kBatchSize = 32;
+constexpr int kNumberOfEpochs = 10;
+
+}  // namespace
+
+class LogisticRegressionModelPerfTest
+    : public testing::TestWithParam<size_t> {};
+
+TEST_P(LogisticRegressionModelPerfTest, TrainingThroughput) {
+  const size_t num_features = GetParam();
+  std::vector<float> true_weights;
+  for (size_t i = 0; i < num_features; ++i) {
+    true_weights.push_back(i % 2 ? 1.0f : -1.0f);
+  }
+  const TrainingExamples examples =
+      BuildSyntheticTrainingExamples(kNumberOfExamples, true_weights, 0.0f);
+
+  perf_test::PerfResultReporter reporter(
+      "LogisticRegressionModel",
+      base::StringPrintf("%zu_features", num_features));
+  reporter.RegisterImportantMetric(".examples_per_second", "runs/s");
+
+  LogisticRegressionModel model(num_features);
+  base::ElapsedTimer timer;
+  for (int epoch = 0; epoch < kNumberOfEpochs; ++epoch) {
+    for (size_t begin = 0; begin < examples.size(); begin += kBatchSize) {
+      const size_t end = std::min(begin + kBatchSize, examples.size());
+      model.TrainBatch(examples, begin, end, /*learning_rate*/ 0.1f);
+    }
+  }
+  reporter.AddResult(".examples_per_second",
+                     kNumberOfExamples * kNumberOfEpochs /
+                         timer.Elapsed().InSecondsF());
+}
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         LogisticRegressionModelPerfTest,
+                         testing::Values(33, 256));
+
+}  // namespace brave_federated
@@ -0,0 +1,127 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_federated/learning/logistic_regression_model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "brave/components/brave_federated/learning/learning_test_util.h"
+#include "brave/components/brave_federated/learning/training_examples.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=LogisticRegressionModelTest*
+
+namespace brave_federated {
+
+namespace {
+
+constexpr size_t kNumberOfExamples = 2000;
+constexpr size_t kBatchSize = 32;
+constexpr int kNumberOfEpochs = 30;
+constexpr float kLearningRate = 0.5f;
+
+const std::vector<float> kTrueWeights = {2.0f, -3.0f, 0.5f, 1.5f, -1.0f};
+constexpr float kTrueBias = 0.25f;
+
+// Straightforward double precision mini-batch SGD used as the reference the
+// vectorized model is checked against.
+std::vector<double> TrainReferenceModel(const TrainingExamples& examples) {
+  std::vector<double> weights(examples.num_features, 0.0);
+  double bias = 0.0;
+
+  for (int epoch = 0; epoch < kNumberOfEpochs; ++epoch) {
+    for (size_t begin = 0; begin < examples.size(); begin += kBatchSize) {
+      const size_t end = std::min(begin + kBatchSize, examples.size());
+      std::vector<double> gradient(examples.num_features, 0.0);
+      double bias_gradient = 0.0;
+
+      for (size_t i = begin; i < end; ++i) {
+        double z = bias;
+        for (size_t j = 0; j < examples.num_features; ++j) {
+          z += weights[j] * examples.Features(i)[j];
+        }
+        const double error = 1.0 / (1.0 + std::exp(-z)) - examples.labels[i];
+        for (size_t j = 0; j < examples.num_features; ++j) {
+          gradient[j] += error * examples.Features(i)[j];
+        }
+        bias_gradient += error;
+      }
+
+      const double step = kLearningRate / (end - begin);
+      for (size_t j = 0; j < examples.num_features; ++j) {
+        weights[j] -= step * gradient[j];
+      }
+      bias -= step * bias_gradient;
+    }
+  }
+
+  weights.push_back(bias);
+  return weights;
+}
+
+float TrainModel(const TrainingExamples& examples,
+                 LogisticRegressionModel* model) {
+  float loss = 0.0f;
+  for (int epoch = 0; epoch < kNumberOfEpochs; ++epoch) {
+    for (size_t begin = 0; begin < examples.size(); begin += kBatchSize) {
+      const size_t end = std::min(begin + kBatchSize, examples.size());
+      loss = model->TrainBatch(examples, begin, end, kLearningRate);
+    }
+  }
+  return loss;
+}
+
+}  // namespace
+
+TEST(LogisticRegressionModelTest, PredictWithoutTraining) {
+  LogisticRegressionModel model(kTrueWeights.size());
+  const std::vector<float> features(kTrueWeights.size(), 1.0f);
+
+  EXPECT_FLOAT_EQ(0.5f, model.Predict(features.data()));
+  EXPECT_EQ(std::vector<float>(kTrueWeights.size() + 1, 0.0f),
+            model.GetParameters());
+}
+
+TEST(LogisticRegressionModelTest, MatchesReferenceImplementation) {
+  const TrainingExamples examples = BuildSyntheticTrainingExamples(
+      kNumberOfExamples, kTrueWeights, kTrueBias);
+
+  LogisticRegressionModel model(examples.num_features);
+  TrainModel(examples, &model);
+
+  const std::vector<float> parameters = model.GetParameters();
+  const std::vector<double> reference_parameters =
+      TrainReferenceModel(examples);
+  ASSERT_EQ(reference_parameters.size(), parameters.size());
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    EXPECT_NEAR(reference_parameters[i], parameters[i], 1e-2) << "index " << i;
+  }
+}
+
+TEST(LogisticRegressionModelTest, ConvergesOnSeparableData) {
+  const TrainingExamples examples = BuildSyntheticTrainingExamples(
+      kNumberOfExamples, kTrueWeights, kTrueBias);
+
+  LogisticRegressionModel model(examples.num_features);
+  const float first_loss = model.TrainBatch(examples, 0, kBatchSize,
+                                            kLearningRate);
+  const float last_loss = TrainModel(examples, &model);
+  EXPECT_LT(last_loss, first_loss);
+
+  size_t number_of_correct_predictions = 0;
+  for (size_t i = 0; i < examples.size(); ++i) {
+    const bool prediction = model.Predict(examples.Features(i)) > 0.5f;
+    if (prediction == (examples.labels[i] > 0.5f)) {
+      number_of_correct_predictions++;
+    }
+  }
+
+  // 5% of the labels are flipped, so a perfect model scores 95%.
+  EXPECT_GT(number_of_correct_predictions, examples.size() * 9 / 10);
+}
+
+}  // namespace brave_federated
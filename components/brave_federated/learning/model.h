@@ -0,0 +1,42 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_MODEL_H_
+#define BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_MODEL_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace brave_federated {
+
+struct TrainingExamples;
+
+// Interface for models which can be trained on device with mini-batch
+// gradient descent.
+class Model {
+ public:
+  virtual ~Model() = default;
+
+  virtual size_t GetNumberOfFeatures() const = 0;
+
+  virtual float Predict(const float* features) const = 0;
+
+  // Runs one gradient descent step over examples [|begin|, |end|) and returns
+  // the mean loss of the batch before the step.
+  virtual float TrainBatch(const TrainingExamples& examples,
+                           size_t begin,
+                           size_t end,
+                           float learning_rate) = 0;
+
+  virtual std::vector<float> GetParameters() const = 0;
+  // Replaces the parameters with ones returned by |GetParameters|, e.g. to
+  // continue training a previously trained model. Returns false if they do not
+  // fit the model.
+  virtual bool SetParameters(const std::vector<float>& parameters) = 0;
+};
+
+}  // namespace brave_federated
+
+#endif  // BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_MODEL_H_
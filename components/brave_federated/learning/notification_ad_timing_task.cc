@@ -0,0 +1,104 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_federated/learning/notification_ad_timing_task.h"
+
+#include <cmath>
+#include <vector>
+
+#include "brave/components/brave_federated/data_stores/columnar_data_store.h"
+#include "brave/components/brave_federated/learning/logistic_regression_model.h"
+#include "brave/components/brave_federated/notification_ad_task_constants.h"
+
+namespace brave_federated {
+
+NotificationAdTimingTask::NotificationAdTimingTask() = default;
+
+NotificationAdTimingTask::~NotificationAdTimingTask() = default;
+
+std::string NotificationAdTimingTask::GetName() const {
+  return kNotificationAdTaskName;
+}
+
+TrainingExamples NotificationAdTimingTask::BuildTrainingExamples(
+    const TrainingMatrix& training_matrix) const {
+  TrainingExamples examples;
+
+  const absl::optional<size_t> label_column = training_matrix.GetColumnIndex(
+      mojom::CovariateType::kNotificationAdEvent);
+  if (!label_column || training_matrix.num_rows == 0) {
+    return examples;
+  }
+
+  // No ad has been clicked yet, so there is nothing to learn from.
+  const absl::optional<float> clicked_code = training_matrix.GetCategoryCode(
+      mojom::CovariateType::kNotificationAdEvent,
+      kNotificationAdClickedEventValue);
+  if (!clicked_code) {
+    return examples;
+  }
+
+  const size_t num_columns = training_matrix.num_columns;
+  std::vector<double> sums(num_columns, 0.0);
+  std::vector<double> squared_sums(num_columns, 0.0);
+  std::vector<size_t> counts(num_columns, 0);
+  for (size_t row = 0; row < training_matrix.num_rows; ++row) {
+    const float* values = training_matrix.Row(row);
+    for (size_t column = 0; column < num_columns; ++column) {
+      if (std::isnan(values[column]))
+        continue;
+
+      sums[column] += values[column];
+      squared_sums[column] += values[column] * values[column];
+      counts[column]++;
+    }
+  }
+
+  std::vector<float> means(num_columns, 0.0f);
+  std::vector<float> inverse_deviations(num_columns, 1.0f);
+  for (size_t column = 0; column < num_columns; ++column) {
+    if (counts[column] == 0)
+      continue;
+
+    const double mean = sums[column] / counts[column];
+    const double variance = squared_sums[column] / counts[column] - mean * mean;
+    means[column] = static_cast<float>(mean);
+    if (variance > 0.0) {
+      inverse_deviations[column] =
+          static_cast<float>(1.0 / std::sqrt(variance));
+    }
+  }
+
+  examples.num_features = num_columns - 1;
+  examples.features.reserve(training_matrix.num_rows * examples.num_features);
+  examples.labels.reserve(training_matrix.num_rows);
+  for (size_t row = 0; row < training_matrix.num_rows; ++row) {
+    const float* values = training_matrix.Row(row);
+    if (std::isnan(values[*label_column]))
+      continue;
+
+    for (size_t column = 0; column < num_columns; ++column) {
+      if (column == *label_column)
+        continue;
+
+      // Standardized features with missing values imputed by the mean.
+      examples.features.push_back(
+          std::isnan(values[column])
+              ? 0.0f
+              : (values[column] - means[column]) * inverse_deviations[column]);
+    }
+    examples.labels.push_back(values[*label_column] == *clicked_code ? 1.0f
+                                                                     : 0.0f);
+  }
+
+  return examples;
+}
+
+std::unique_ptr<Model> NotificationAdTimingTask::CreateModel(
+    size_t num_features) const {
+  return std::make_unique<LogisticRegressionModel>(num_features);
+}
+
+}  // namespace brave_federated
@@ -0,0 +1,36 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_NOTIFICATION_AD_TIMING_TASK_H_
+#define BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_NOTIFICATION_AD_TIMING_TASK_H_
+
+#include <memory>
+#include <string>
+
+#include "brave/components/brave_federated/learning/training_task.h"
+
+namespace brave_federated {
+
+// Predicts whether a notification ad is clicked from the covariates logged
+// when it was served. Every other covariate is used as a standardized feature
+// and missing covariates are imputed with the column mean.
+class NotificationAdTimingTask final : public TrainingTask {
+ public:
+  NotificationAdTimingTask();
+  ~NotificationAdTimingTask() override;
+
+  NotificationAdTimingTask(const NotificationAdTimingTask&) = delete;
+  NotificationAdTimingTask& operator=(const NotificationAdTimingTask&) = delete;
+
+  // TrainingTask:
+  std::string GetName() const override;
+  TrainingExamples BuildTrainingExamples(
+      const TrainingMatrix& training_matrix) const override;
+  std::unique_ptr<Model> CreateModel(size_t num_features) const override;
+};
+
+}  // namespace brave_federated
+
+#endif  // BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_NOTIFICATION_AD_TIMING_TASK_H_
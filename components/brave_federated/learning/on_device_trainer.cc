@@ -0,0 +1,181 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_federated/learning/on_device_trainer.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/check.h"
+#include "base/logging.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "brave/components/brave_federated/data_stores/async_columnar_data_store.h"
+#include "brave/components/brave_federated/data_stores/columnar_data_store.h"
+#include "brave/components/brave_federated/learning/model.h"
+#include "brave/components/brave_federated/learning/training_task.h"
+
+namespace brave_federated {
+
+OnDeviceTrainer::OnDeviceTrainer(std::unique_ptr<TrainingTask> task,
+                                 AsyncColumnarDataStore* data_store,
+                                 EligibilityService* eligibility_service,
+                                 const TrainingConfig& config,
+                                 const TrainingBudget& budget)
+    : task_(std::move(task)),
+      data_store_(data_store),
+      eligibility_service_(eligibility_service),
+      config_(config),
+      budget_(budget),
+      training_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::TaskPriority::BEST_EFFORT,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {
+  DCHECK(task_);
+  DCHECK(data_store_);
+
+  if (eligibility_service_) {
+    eligibility_observation_.Observe(eligibility_service_.get());
+  }
+}
+
+OnDeviceTrainer::~OnDeviceTrainer() = default;
+
+void OnDeviceTrainer::Start(TrainingCallback callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK_EQ(State::kIdle, state_);
+
+  VLOG(1) << "Starting on-device training for " << task_->GetName();
+
+  callback_ = std::move(callback);
+  cpu_time_ = base::TimeDelta();
+  state_ = State::kLoading;
+
+  data_store_->LoadTrainingMatrix(
+      base::BindOnce(&OnDeviceTrainer::OnLoadTrainingMatrix,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void OnDeviceTrainer::Cancel() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (state_ == State::kIdle) {
+    return;
+  }
+
+  VLOG(1) << "Cancelled on-device training for " << task_->GetName();
+
+  // Drop the replies of any chunk which is still running.
+  weak_factory_.InvalidateWeakPtrs();
+  Finish(absl::nullopt);
+}
+
+void OnDeviceTrainer::SetInitialParameters(std::vector<float> parameters) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  initial_parameters_ = std::move(parameters);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool OnDeviceTrainer::IsEligible() const {
+  return !eligibility_service_ || eligibility_service_->IsEligibile();
+}
+
+void OnDeviceTrainer::OnLoadTrainingMatrix(TrainingMatrix training_matrix) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK_EQ(State::kLoading, state_);
+
+  TrainingExamples examples = task_->BuildTrainingExamples(training_matrix);
+  if (examples.empty()) {
+    VLOG(1) << "No training examples for " << task_->GetName();
+    Finish(absl::nullopt);
+    return;
+  }
+
+  std::unique_ptr<Model> model = task_->CreateModel(examples.num_features);
+  if (!initial_parameters_.empty() &&
+      !model->SetParameters(initial_parameters_)) {
+    VLOG(1) << "Discarded stale parameters for " << task_->GetName();
+    initial_parameters_.clear();
+  }
+
+  training_session_ = base::SequenceBound<TrainingSession>(
+      training_task_runner_, std::move(model), std::move(examples), config_);
+  state_ = State::kTraining;
+
+  MaybeRunNextChunk();
+}
+
+void OnDeviceTrainer::MaybeRunNextChunk() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!IsEligible()) {
+    VLOG(1) << "Paused on-device training for " << task_->GetName();
+    state_ = State::kPaused;
+    return;
+  }
+
+  state_ = State::kTraining;
+  training_session_.AsyncCall(&TrainingSession::RunChunk)
+      .WithArgs(budget_.chunk_cpu_time)
+      .Then(base::BindOnce(&OnDeviceTrainer::OnRunChunk,
+                           weak_factory_.GetWeakPtr()));
+}
+
+void OnDeviceTrainer::OnRunChunk(const TrainingProgress& progress) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  cpu_time_ += progress.cpu_time;
+
+  if (progress.is_complete || cpu_time_ >= budget_.max_cpu_time) {
+    training_session_.AsyncCall(&TrainingSession::GetResult)
+        .Then(base::BindOnce(&OnDeviceTrainer::OnGetResult,
+                             weak_factory_.GetWeakPtr()));
+    return;
+  }
+
+  chunk_timer_.Start(FROM_HERE, budget_.delay_between_chunks,
+                     base::BindOnce(&OnDeviceTrainer::MaybeRunNextChunk,
+                                    base::Unretained(this)));
+}
+
+void OnDeviceTrainer::OnGetResult(TrainingResult result) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  VLOG(1) << "Finished on-device training for " << task_->GetName()
+          << " after " << result.progress.epoch << " epochs with loss "
+          << result.progress.loss;
+
+  Finish(std::move(result));
+}
+
+void OnDeviceTrainer::Finish(absl::optional<TrainingResult> result) {
+  chunk_timer_.Stop();
+  training_session_.Reset();
+  state_ = State::kIdle;
+
+  if (callback_) {
+    std::move(callback_).Run(std::move(result));
+  }
+}
+
+void OnDeviceTrainer::OnEligibilityChanged(bool is_eligible) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (is_eligible) {
+    if (state_ == State::kPaused) {
+      MaybeRunNextChunk();
+    }
+    return;
+  }
+
+  // A chunk which is already running pauses once it completes.
+  if (chunk_timer_.IsRunning()) {
+    chunk_timer_.Stop();
+    state_ = State::kPaused;
+  }
+}
+
+}  // namespace brave_federated
@@ -0,0 +1,116 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_ON_DEVICE_TRAINER_H_
+#define BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_ON_DEVICE_TRAINER_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/scoped_observation.h"
+#include "base/sequence_checker.h"
+#include "base/threading/sequence_bound.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "brave/components/brave_federated/eligibility_service.h"
+#include "brave/components/brave_federated/eligibility_service_observer.h"
+#include "brave/components/brave_federated/learning/training_session.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace brave_federated {
+
+class AsyncColumnarDataStore;
+class TrainingTask;
+struct TrainingMatrix;
+
+struct TrainingBudget {
+  // CPU time of a single chunk of mini-batches.
+  base::TimeDelta chunk_cpu_time = base::Milliseconds(20);
+  // Delay between chunks, so that a training session never keeps a core busy.
+  base::TimeDelta delay_between_chunks = base::Milliseconds(200);
+  // Total CPU time after which a training session is stopped.
+  base::TimeDelta max_cpu_time = base::Seconds(10);
+};
+
+// Trains the model of a task on the covariates logged in its data store. The
+// model is trained on a best-effort thread pool sequence in short chunks which
+// only run while |EligibilityService| reports the device as eligible, and a
+// training session can be cancelled between any two chunks.
+class OnDeviceTrainer : public Observer {
+ public:
+  enum class State { kIdle, kLoading, kTraining, kPaused };
+
+  using TrainingCallback =
+      base::OnceCallback<void(absl::optional<TrainingResult>)>;
+
+  OnDeviceTrainer(std::unique_ptr<TrainingTask> task,
+                  AsyncColumnarDataStore* data_store,
+                  EligibilityService* eligibility_service,
+                  const TrainingConfig& config,
+                  const TrainingBudget& budget);
+  ~OnDeviceTrainer() override;
+
+  OnDeviceTrainer(const OnDeviceTrainer&) = delete;
+  OnDeviceTrainer& operator=(const OnDeviceTrainer&) = delete;
+
+  // Starts a training session. |callback| receives the trained parameters, or
+  // absl::nullopt if there was nothing to train on or the session was
+  // cancelled.
+  void Start(TrainingCallback callback);
+  void Cancel();
+
+  // Parameters of a previously trained model which the next training session
+  // continues from. Ignored if they do not fit the model of the task.
+  void SetInitialParameters(std::vector<float> parameters);
+
+  State GetState() const { return state_; }
+
+ private:
+  bool IsEligible() const;
+
+  void OnLoadTrainingMatrix(TrainingMatrix training_matrix);
+  void MaybeRunNextChunk();
+  void OnRunChunk(const TrainingProgress& progress);
+  void OnGetResult(TrainingResult result);
+  void Finish(absl::optional<TrainingResult> result);
+
+  // Observer:
+  void OnEligibilityChanged(bool is_eligible) override;
+
+  std::unique_ptr<TrainingTask> task_;
+  const raw_ptr<AsyncColumnarDataStore> data_store_ = nullptr;  // NOT OWNED
+  const raw_ptr<EligibilityService> eligibility_service_ =
+      nullptr;  // NOT OWNED
+  const TrainingConfig config_;
+  const TrainingBudget budget_;
+  std::vector<float> initial_parameters_;
+
+  scoped_refptr<base::SequencedTaskRunner> training_task_runner_;
+  base::SequenceBound<TrainingSession> training_session_;
+  base::OneShotTimer chunk_timer_;
+
+  State state_ = State::kIdle;
+  base::TimeDelta cpu_time_;
+  TrainingCallback callback_;
+
+  base::ScopedObservation<EligibilityService, Observer>
+      eligibility_observation_{this};
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<OnDeviceTrainer> weak_factory_{this};
+};
+
+}  // namespace brave_federated
+
+#endif  // BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_ON_DEVICE_TRAINER_H_
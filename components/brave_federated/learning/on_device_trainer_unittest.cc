@@ -0,0 +1,307 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_federated/learning/on_device_trainer.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/bind.h"
+#include "base/test/power_monitor_test.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_federated/data_stores/async_columnar_data_store.h"
+#include "brave/components/brave_federated/data_stores/columnar_data_store.h"
+#include "brave/components/brave_federated/learning/logistic_regression_model.h"
+#include "brave/components/brave_federated/eligibility_service.h"
+#include "brave/components/brave_federated/learning/training_task.h"
+#include "net/base/mock_network_change_notifier.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=OnDeviceTrainerTest*
+
+namespace brave_federated {
+
+namespace {
+
+constexpr int kNumberOfInstances = 500;
+
+// Learns whether the first covariate is larger than the second one.
+class TestTrainingTask final : public TrainingTask {
+ public:
+  std::string GetName() const override { return "test_training_task"; }
+
+  TrainingExamples BuildTrainingExamples(
+      const TrainingMatrix& training_matrix) const override {
+    TrainingExamples examples;
+    examples.num_features = 2;
+    for (size_t row = 0; row < training_matrix.num_rows; ++row) {
+      const float* values = training_matrix.Row(row);
+      examples.features.push_back(values[0]);
+      examples.features.push_back(values[1]);
+      examples.labels.push_back(values[0] > values[1] ? 1.0f : 0.0f);
+    }
+    return examples;
+  }
+
+  std::unique_ptr<Model> CreateModel(size_t num_features) const override {
+    return std::make_unique<LogisticRegressionModel>(num_features);
+  }
+};
+
+ColumnarDataStoreTask GetTestDataStoreTask() {
+  return ColumnarDataStoreTask(
+      0, "test_training_task",
+      {{mojom::CovariateType::kAverageClickthroughRate,
+        mojom::DataType::kDouble},
+       {mojom::CovariateType::kNotificationAdServedAt,
+        mojom::DataType::kDouble}},
+      kNumberOfInstances, base::Days(30));
+}
+
+mojom::CovariateInfoPtr BuildCovariate(mojom::CovariateType type,
+                                       double value) {
+  mojom::CovariateInfoPtr covariate = mojom::CovariateInfo::New();
+  covariate->type = type;
+  covariate->data_type = mojom::DataType::kDouble;
+  covariate->value = base::NumberToString(value);
+  return covariate;
+}
+
+}  // namespace
+
+class OnDeviceTrainerTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    data_store_ = std::make_unique<AsyncColumnarDataStore>(
+        GetTestDataStoreTask(),
+        temp_dir_.GetPath().Append(FILE_PATH_LITERAL("test_data_store")));
+
+    base::RunLoop run_loop;
+    data_store_->InitializeDatabase(
+        base::BindLambdaForTesting([&run_loop](bool success) {
+          EXPECT_TRUE(success);
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+  }
+
+  void PopulateDataStore() {
+    std::vector<TrainingInstance> training_instances;
+    for (int i = 0; i < kNumberOfInstances; ++i) {
+      TrainingInstance training_instance;
+      training_instance.push_back(
+          BuildCovariate(mojom::CovariateType::kAverageClickthroughRate,
+                         (i % 17) / 17.0));
+      training_instance.push_back(BuildCovariate(
+          mojom::CovariateType::kNotificationAdServedAt, (i % 13) / 13.0));
+      training_instances.push_back(std::move(training_instance));
+    }
+
+    base::RunLoop run_loop;
+    data_store_->AddTrainingInstances(
+        std::move(training_instances),
+        base::BindLambdaForTesting([&run_loop](bool success) {
+          EXPECT_TRUE(success);
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+  }
+
+  std::unique_ptr<OnDeviceTrainer> CreateTrainer(
+      const TrainingBudget& budget,
+      EligibilityService* eligibility_service = nullptr) {
+    TrainingConfig config;
+    config.number_of_epochs = 50;
+    return std::make_unique<OnDeviceTrainer>(
+        std::make_unique<TestTrainingTask>(), data_store_.get(),
+        eligibility_service, config, budget);
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<AsyncColumnarDataStore> data_store_;
+};
+
+TEST_F(OnDeviceTrainerTest, NoTrainingWithoutData) {
+  std::unique_ptr<OnDeviceTrainer> trainer = CreateTrainer(TrainingBudget());
+
+  base::RunLoop run_loop;
+  trainer->Start(base::BindLambdaForTesting(
+      [&run_loop](absl::optional<TrainingResult> result) {
+        EXPECT_FALSE(result);
+        run_loop.Quit();
+      }));
+  run_loop.Run();
+
+  EXPECT_EQ(OnDeviceTrainer::State::kIdle, trainer->GetState());
+}
+
+TEST_F(OnDeviceTrainerTest, TrainsInChunks) {
+  PopulateDataStore();
+
+  // A zero budget makes every chunk train a single mini-batch.
+  TrainingBudget budget;
+  budget.chunk_cpu_time = base::TimeDelta();
+  budget.max_cpu_time = base::TimeDelta::Max();
+  std::unique_ptr<OnDeviceTrainer> trainer = CreateTrainer(budget);
+
+  absl::optional<TrainingResult> training_result;
+  trainer->Start(base::BindLambdaForTesting(
+      [&training_result](absl::optional<TrainingResult> result) {
+        training_result = std::move(result);
+      }));
+  task_environment_.FastForwardUntilNoTasksRemain();
+
+  ASSERT_TRUE(training_result);
+  EXPECT_TRUE(training_result->progress.is_complete);
+  EXPECT_EQ(50, training_result->progress.epoch);
+  EXPECT_EQ(static_cast<size_t>(kNumberOfInstances),
+            training_result->number_of_examples);
+  ASSERT_EQ(3U, training_result->parameters.size());
+  // The label is x0 > x1, so the weights must have opposite signs.
+  EXPECT_GT(training_result->parameters[0], 0.0f);
+  EXPECT_LT(training_result->parameters[1], 0.0f);
+  EXPECT_EQ(OnDeviceTrainer::State::kIdle, trainer->GetState());
+}
+
+TEST_F(OnDeviceTrainerTest, Cancel) {
+  PopulateDataStore();
+
+  TrainingBudget budget;
+  budget.chunk_cpu_time = base::TimeDelta();
+  std::unique_ptr<OnDeviceTrainer> trainer = CreateTrainer(budget);
+
+  bool callback_was_run = false;
+  trainer->Start(base::BindLambdaForTesting(
+      [&callback_was_run](absl::optional<TrainingResult> result) {
+        EXPECT_FALSE(result);
+        callback_was_run = true;
+      }));
+  EXPECT_EQ(OnDeviceTrainer::State::kLoading, trainer->GetState());
+
+  trainer->Cancel();
+  EXPECT_TRUE(callback_was_run);
+  EXPECT_EQ(OnDeviceTrainer::State::kIdle, trainer->GetState());
+
+  // Replies of the cancelled session are dropped.
+  task_environment_.FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(OnDeviceTrainer::State::kIdle, trainer->GetState());
+}
+
+TEST_F(OnDeviceTrainerTest, StopsWhenCpuBudgetIsExhausted) {
+  PopulateDataStore();
+
+  TrainingBudget budget;
+  budget.chunk_cpu_time = base::TimeDelta();
+  budget.max_cpu_time = base::TimeDelta();
+  std::unique_ptr<OnDeviceTrainer> trainer = CreateTrainer(budget);
+
+  absl::optional<TrainingResult> training_result;
+  trainer->Start(base::BindLambdaForTesting(
+      [&training_result](absl::optional<TrainingResult> result) {
+        training_result = std::move(result);
+      }));
+  task_environment_.FastForwardUntilNoTasksRemain();
+
+  ASSERT_TRUE(training_result);
+  EXPECT_FALSE(training_result->progress.is_complete);
+  EXPECT_EQ(1U, training_result->progress.number_of_batches);
+}
+
+TEST_F(OnDeviceTrainerTest, ContinuesFromInitialParameters) {
+  PopulateDataStore();
+
+  TrainingBudget budget;
+  budget.chunk_cpu_time = base::TimeDelta();
+  budget.max_cpu_time = base::TimeDelta();
+  std::unique_ptr<OnDeviceTrainer> trainer = CreateTrainer(budget);
+  trainer->SetInitialParameters({10.0f, -10.0f, 0.0f});
+
+  absl::optional<TrainingResult> training_result;
+  trainer->Start(base::BindLambdaForTesting(
+      [&training_result](absl::optional<TrainingResult> result) {
+        training_result = std::move(result);
+      }));
+  task_environment_.FastForwardUntilNoTasksRemain();
+
+  // A single mini-batch barely moves the initial parameters.
+  ASSERT_TRUE(training_result);
+  ASSERT_EQ(3U, training_result->parameters.size());
+  EXPECT_GT(training_result->parameters[0], 9.0f);
+  EXPECT_LT(training_result->parameters[1], -9.0f);
+}
+
+TEST_F(OnDeviceTrainerTest, IgnoresInitialParametersOfAnotherModel) {
+  PopulateDataStore();
+
+  TrainingBudget budget;
+  budget.chunk_cpu_time = base::TimeDelta();
+  budget.max_cpu_time = base::TimeDelta();
+  std::unique_ptr<OnDeviceTrainer> trainer = CreateTrainer(budget);
+  trainer->SetInitialParameters({10.0f, -10.0f, 10.0f, 0.0f});
+
+  absl::optional<TrainingResult> training_result;
+  trainer->Start(base::BindLambdaForTesting(
+      [&training_result](absl::optional<TrainingResult> result) {
+        training_result = std::move(result);
+      }));
+  task_environment_.FastForwardUntilNoTasksRemain();
+
+  ASSERT_TRUE(training_result);
+  ASSERT_EQ(3U, training_result->parameters.size());
+  EXPECT_LT(training_result->parameters[0], 1.0f);
+}
+
+TEST_F(OnDeviceTrainerTest, PausesAndResumesWithEligibility) {
+  PopulateDataStore();
+
+  base::test::ScopedPowerMonitorTestSource power_monitor_source;
+  power_monitor_source.GeneratePowerStateEvent(/*on_battery_power*/ false);
+  net::test::ScopedMockNetworkChangeNotifier network_change_notifier;
+  network_change_notifier.mock_network_change_notifier()->SetConnectionType(
+      net::NetworkChangeNotifier::CONNECTION_WIFI);
+  EligibilityService eligibility_service;
+  ASSERT_TRUE(eligibility_service.IsEligibile());
+
+  TrainingBudget budget;
+  budget.chunk_cpu_time = base::TimeDelta();
+  budget.max_cpu_time = base::TimeDelta::Max();
+  std::unique_ptr<OnDeviceTrainer> trainer =
+      CreateTrainer(budget, &eligibility_service);
+
+  absl::optional<TrainingResult> training_result;
+  trainer->Start(base::BindLambdaForTesting(
+      [&training_result](absl::optional<TrainingResult> result) {
+        training_result = std::move(result);
+      }));
+  task_environment_.FastForwardBy(budget.delay_between_chunks * 3);
+  EXPECT_EQ(OnDeviceTrainer::State::kTraining, trainer->GetState());
+
+  power_monitor_source.GeneratePowerStateEvent(/*on_battery_power*/ true);
+  task_environment_.FastForwardBy(budget.delay_between_chunks * 3);
+  EXPECT_EQ(OnDeviceTrainer::State::kPaused, trainer->GetState());
+
+  // No chunks run while the device is not eligible.
+  task_environment_.FastForwardBy(base::Hours(1));
+  EXPECT_EQ(OnDeviceTrainer::State::kPaused, trainer->GetState());
+  EXPECT_FALSE(training_result);
+
+  power_monitor_source.GeneratePowerStateEvent(/*on_battery_power*/ false);
+  task_environment_.FastForwardUntilNoTasksRemain();
+
+  ASSERT_TRUE(training_result);
+  EXPECT_TRUE(training_result->progress.is_complete);
+  EXPECT_EQ(OnDeviceTrainer::State::kIdle, trainer->GetState());
+}
+
+}  // namespace brave_federated
@@ -0,0 +1,18 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_federated/learning/training_examples.h"
+
+namespace brave_federated {
+
+TrainingExamples::TrainingExamples() = default;
+
+TrainingExamples::TrainingExamples(TrainingExamples&&) = default;
+
+TrainingExamples& TrainingExamples::operator=(TrainingExamples&&) = default;
+
+TrainingExamples::~TrainingExamples() = default;
+
+}  // namespace brave_federated
@@ -0,0 +1,35 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_TRAINING_EXAMPLES_H_
+#define BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_TRAINING_EXAMPLES_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace brave_federated {
+
+// Labelled examples ready for training. |features| is row-major with
+// |num_features| values per example and |labels| holds one value per example.
+struct TrainingExamples {
+  TrainingExamples();
+  TrainingExamples(TrainingExamples&&);
+  TrainingExamples& operator=(TrainingExamples&&);
+  ~TrainingExamples();
+
+  size_t size() const { return labels.size(); }
+  bool empty() const { return labels.empty(); }
+  const float* Features(size_t example) const {
+    return &features[example * num_features];
+  }
+
+  size_t num_features = 0;
+  std::vector<float> features;
+  std::vector<float> labels;
+};
+
+}  // namespace brave_federated
+
+#endif  // BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_TRAINING_EXAMPLES_H_
@@ -0,0 +1,105 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_federated/learning/training_session.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/check_op.h"
+#include "base/time/time.h"
+#include "brave/components/brave_federated/learning/model.h"
+
+namespace brave_federated {
+
+namespace {
+
+// Thread time is not available on every platform, in which case wall time is
+// used as an upper bound of CPU time.
+class CpuTimer {
+ public:
+  CpuTimer()
+      : use_thread_ticks_(base::ThreadTicks::IsSupported()),
+        thread_start_(use_thread_ticks_ ? base::ThreadTicks::Now()
+                                        : base::ThreadTicks()),
+        wall_start_(base::TimeTicks::Now()) {}
+
+  base::TimeDelta Elapsed() const {
+    return use_thread_ticks_ ? base::ThreadTicks::Now() - thread_start_
+                             : base::TimeTicks::Now() - wall_start_;
+  }
+
+ private:
+  const bool use_thread_ticks_;
+  const base::ThreadTicks thread_start_;
+  const base::TimeTicks wall_start_;
+};
+
+}  // namespace
+
+TrainingResult::TrainingResult() = default;
+
+TrainingResult::TrainingResult(const TrainingResult&) = default;
+
+TrainingResult& TrainingResult::operator=(const TrainingResult&) = default;
+
+TrainingResult::~TrainingResult() = default;
+
+TrainingSession::TrainingSession(std::unique_ptr<Model> model,
+                                 TrainingExamples examples,
+                                 const TrainingConfig& config)
+    : model_(std::move(model)),
+      examples_(std::move(examples)),
+      config_(config) {
+  DCHECK(model_);
+  DCHECK_EQ(model_->GetNumberOfFeatures(), examples_.num_features);
+  DCHECK_GT(config_.batch_size, 0U);
+
+  progress_.is_complete = examples_.empty() || config_.number_of_epochs <= 0;
+}
+
+TrainingSession::~TrainingSession() = default;
+
+TrainingProgress TrainingSession::RunChunk(base::TimeDelta cpu_budget) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  const CpuTimer timer;
+  while (!progress_.is_complete) {
+    const size_t begin = next_example_;
+    const size_t end = std::min(begin + config_.batch_size, examples_.size());
+    epoch_loss_ +=
+        model_->TrainBatch(examples_, begin, end, config_.learning_rate);
+    epoch_batches_++;
+    progress_.number_of_batches++;
+
+    next_example_ = end;
+    if (next_example_ == examples_.size()) {
+      progress_.loss = static_cast<float>(epoch_loss_ / epoch_batches_);
+      progress_.epoch++;
+      progress_.is_complete = progress_.epoch >= config_.number_of_epochs;
+      next_example_ = 0;
+      epoch_loss_ = 0.0;
+      epoch_batches_ = 0;
+    }
+
+    if (timer.Elapsed() >= cpu_budget)
+      break;
+  }
+
+  progress_.cpu_time = timer.Elapsed();
+  return progress_;
+}
+
+TrainingResult TrainingSession::GetResult() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  TrainingResult result;
+  result.parameters = model_->GetParameters();
+  result.number_of_examples = examples_.size();
+  result.progress = progress_;
+  return result;
+}
+
+}  // namespace brave_federated
@@ -0,0 +1,80 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_TRAINING_SESSION_H_
+#define BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_TRAINING_SESSION_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "brave/components/brave_federated/learning/training_examples.h"
+
+namespace brave_federated {
+
+class Model;
+
+struct TrainingConfig {
+  size_t batch_size = 32;
+  int number_of_epochs = 20;
+  float learning_rate = 0.1f;
+};
+
+struct TrainingProgress {
+  int epoch = 0;
+  size_t number_of_batches = 0;
+  // Mean loss of the batches trained in the last completed epoch.
+  float loss = 0.0f;
+  bool is_complete = false;
+  // CPU time spent by the chunk which reported this progress.
+  base::TimeDelta cpu_time;
+};
+
+struct TrainingResult {
+  TrainingResult();
+  TrainingResult(const TrainingResult&);
+  TrainingResult& operator=(const TrainingResult&);
+  ~TrainingResult();
+
+  std::vector<float> parameters;
+  size_t number_of_examples = 0;
+  TrainingProgress progress;
+};
+
+// Owns a model and its examples on a background sequence and trains it in
+// chunks, so that training can be paused or abandoned between chunks.
+class TrainingSession {
+ public:
+  TrainingSession(std::unique_ptr<Model> model,
+                  TrainingExamples examples,
+                  const TrainingConfig& config);
+  ~TrainingSession();
+
+  TrainingSession(const TrainingSession&) = delete;
+  TrainingSession& operator=(const TrainingSession&) = delete;
+
+  // Trains mini-batches until roughly |cpu_budget| of thread time has been
+  // used or all epochs are complete.
+  TrainingProgress RunChunk(base::TimeDelta cpu_budget);
+
+  TrainingResult GetResult() const;
+
+ private:
+  std::unique_ptr<Model> model_;
+  const TrainingExamples examples_;
+  const TrainingConfig config_;
+
+  TrainingProgress progress_;
+  size_t next_example_ = 0;
+  double epoch_loss_ = 0.0;
+  size_t epoch_batches_ = 0;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace brave_federated
+
+#endif  // BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_TRAINING_SESSION_H_
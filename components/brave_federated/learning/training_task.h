@@ -0,0 +1,35 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_TRAINING_TASK_H_
+#define BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_TRAINING_TASK_H_
+
+#include <memory>
+#include <string>
+
+#include "brave/components/brave_federated/learning/training_examples.h"
+
+namespace brave_federated {
+
+class Model;
+struct TrainingMatrix;
+
+// A federated task turns the raw covariates logged in its data store into
+// labelled examples and creates the model that is trained on them.
+class TrainingTask {
+ public:
+  virtual ~TrainingTask() = default;
+
+  virtual std::string GetName() const = 0;
+
+  virtual TrainingExamples BuildTrainingExamples(
+      const TrainingMatrix& training_matrix) const = 0;
+
+  virtual std::unique_ptr<Model> CreateModel(size_t num_features) const = 0;
+};
+
+}  // namespace brave_federated
+
+#endif  // BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_TRAINING_TASK_H_
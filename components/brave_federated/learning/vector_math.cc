@@ -0,0 +1,108 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_federated/learning/vector_math.h"
+
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <xmmintrin.h>
+#elif defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#endif
+
+namespace brave_federated {
+namespace vector_math {
+
+namespace {
+
+float DotProductScalar(const float* lhs, const float* rhs, size_t size) {
+  float sum = 0.0f;
+  for (size_t i = 0; i < size; ++i) {
+    sum += lhs[i] * rhs[i];
+  }
+  return sum;
+}
+
+void AddScaledScalar(const float* src, float scale, size_t size, float* dest) {
+  for (size_t i = 0; i < size; ++i) {
+    dest[i] += scale * src[i];
+  }
+}
+
+}  // namespace
+
+#if defined(ARCH_CPU_X86_FAMILY)
+
+float DotProduct(const float* lhs, const float* rhs, size_t size) {
+  const size_t vector_size = size - size % 4;
+  __m128 sum = _mm_setzero_ps();
+  for (size_t i = 0; i < vector_size; i += 4) {
+    sum = _mm_add_ps(sum,
+                     _mm_mul_ps(_mm_loadu_ps(lhs + i), _mm_loadu_ps(rhs + i)));
+  }
+
+  // Horizontal sum of the four lanes.
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+
+  return _mm_cvtss_f32(sum) + DotProductScalar(lhs + vector_size,
+                                               rhs + vector_size,
+                                               size - vector_size);
+}
+
+void AddScaled(const float* src, float scale, size_t size, float* dest) {
+  const size_t vector_size = size - size % 4;
+  const __m128 scale_vector = _mm_set1_ps(scale);
+  for (size_t i = 0; i < vector_size; i += 4) {
+    _mm_storeu_ps(dest + i,
+                  _mm_add_ps(_mm_loadu_ps(dest + i),
+                             _mm_mul_ps(_mm_loadu_ps(src + i), scale_vector)));
+  }
+
+  AddScaledScalar(src + vector_size, scale, size - vector_size,
+                  dest + vector_size);
+}
+
+#elif defined(ARCH_CPU_ARM64)
+
+float DotProduct(const float* lhs, const float* rhs, size_t size) {
+  const size_t vector_size = size - size % 4;
+  float32x4_t sum = vdupq_n_f32(0.0f);
+  for (size_t i = 0; i < vector_size; i += 4) {
+    sum = vmlaq_f32(sum, vld1q_f32(lhs + i), vld1q_f32(rhs + i));
+  }
+
+  return vaddvq_f32(sum) + DotProductScalar(lhs + vector_size,
+                                            rhs + vector_size,
+                                            size - vector_size);
+}
+
+void AddScaled(const float* src, float scale, size_t size, float* dest) {
+  const size_t vector_size = size - size % 4;
+  const float32x4_t scale_vector = vdupq_n_f32(scale);
+  for (size_t i = 0; i < vector_size; i += 4) {
+    vst1q_f32(dest + i,
+              vmlaq_f32(vld1q_f32(dest + i), vld1q_f32(src + i), scale_vector));
+  }
+
+  AddScaledScalar(src + vector_size, scale, size - vector_size,
+                  dest + vector_size);
+}
+
+#else
+
+float DotProduct(const float* lhs, const float* rhs, size_t size) {
+  return DotProductScalar(lhs, rhs, size);
+}
+
+void AddScaled(const float* src, float scale, size_t size, float* dest) {
+  AddScaledScalar(src, scale, size, dest);
+}
+
+#endif
+
+}  // namespace vector_math
+}  // namespace brave_federated
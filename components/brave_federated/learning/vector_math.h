@@ -0,0 +1,24 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_VECTOR_MATH_H_
+#define BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_VECTOR_MATH_H_
+
+#include <cstddef>
+
+namespace brave_federated {
+namespace vector_math {
+
+// Returns the dot product of |lhs| and |rhs|, which must both hold |size|
+// values.
+float DotProduct(const float* lhs, const float* rhs, size_t size);
+
+// Adds |scale| * |src| to |dest| in place, i.e. |dest| += |scale| * |src|.
+void AddScaled(const float* src, float scale, size_t size, float* dest);
+
+}  // namespace vector_math
+}  // namespace brave_federated
+
+#endif  // BRAVE_COMPONENTS_BRAVE_FEDERATED_LEARNING_VECTOR_MATH_H_
@@ -0,0 +1,62 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_federated/learning/vector_math.h"
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveFederatedVectorMathTest*
+
+namespace brave_federated {
+
+namespace {
+
+std::vector<float> BuildVector(size_t size, float offset) {
+  std::vector<float> values;
+  for (size_t i = 0; i < size; ++i) {
+    values.push_back(offset + 0.5f * i);
+  }
+  return values;
+}
+
+}  // namespace
+
+// Sizes which are not a multiple of the SIMD width exercise the scalar tail.
+TEST(BraveFederatedVectorMathTest, DotProduct) {
+  for (size_t size = 0; size <= 17; ++size) {
+    const std::vector<float> lhs = BuildVector(size, 1.0f);
+    const std::vector<float> rhs = BuildVector(size, -2.0f);
+
+    float expected_dot_product = 0.0f;
+    for (size_t i = 0; i < size; ++i) {
+      expected_dot_product += lhs[i] * rhs[i];
+    }
+
+    EXPECT_FLOAT_EQ(expected_dot_product,
+                    vector_math::DotProduct(lhs.data(), rhs.data(), size))
+        << "size " << size;
+  }
+}
+
+TEST(BraveFederatedVectorMathTest, AddScaled) {
+  for (size_t size = 0; size <= 17; ++size) {
+    const std::vector<float> src = BuildVector(size, 1.0f);
+    std::vector<float> dest = BuildVector(size, 3.0f);
+
+    std::vector<float> expected_dest = dest;
+    for (size_t i = 0; i < size; ++i) {
+      expected_dest[i] += -0.25f * src[i];
+    }
+
+    vector_math::AddScaled(src.data(), -0.25f, size, dest.data());
+    for (size_t i = 0; i < size; ++i) {
+      EXPECT_FLOAT_EQ(expected_dest[i], dest[i]) << "size " << size;
+    }
+  }
+}
+
+}  // namespace brave_federated
@@ -16,6 +16,11 @@ constexpr int kFeaturesPerEvent = 30;
 constexpr int kMaxNumberOfRecords = kMaxEvents * kFeaturesPerEvent;
 constexpr base::TimeDelta kMaxRetentionDays = base::Days(30);
 
+// Value of the |kNotificationAdEvent| covariate for clicked ads, as streamed
+// from |ads::mojom::NotificationAdEventType::kClicked|.
+constexpr char kNotificationAdClickedEventValue[] =
+    "NotificationAdEventType::kClicked";
+
 }  // namespace brave_federated
 
 #endif  // BRAVE_COMPONENTS_BRAVE_FEDERATED_NOTIFICATION_AD_TASK_CONSTANTS_H_
@@ -37,6 +37,7 @@
 #include "bat/ads/pref_names.h"
 #include "bat/ledger/global_constants.h"
 #include "bat/ledger/public/ledger_database.h"
+#include "bat/ledger/public/media_link_filter.h"
 #include "brave/browser/brave_ads/ads_service_factory.h"
 #include "brave/browser/ui/webui/brave_rewards_source.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
@@ -101,6 +102,10 @@ constexpr int kDiagnosticLogKeepNumLines = 20000;
 constexpr int kDiagnosticLogMaxFileSize = 10 * (1024 * 1024);
 constexpr char pref_prefix[] = "brave.rewards";
 
+// Resource loads are sent to the ledger in batches, at most this long after
+// they complete.
+constexpr base::TimeDelta kXHRLoadFlushDelay = base::Milliseconds(500);
+
 std::string URLMethodToRequestType(ledger::type::UrlMethod method) {
   switch (method) {
     case ledger::type::UrlMethod::GET:
@@ -325,6 +330,9 @@ RewardsServiceImpl::RewardsServiceImpl(Profile* profile)
                             kDiagnosticLogMaxFileSize,
                             kDiagnosticLogKeepNumLines)),
       notification_service_(new RewardsNotificationServiceImpl(profile)),
+      xhr_load_batcher_(kXHRLoadFlushDelay,
+                        base::BindRepeating(&RewardsServiceImpl::SendXHRLoads,
+                                            base::Unretained(this))),
       next_timer_id_(0) {
   // Set up the rewards data source
   content::URLDataSource::Add(profile_,
@@ -677,6 +685,8 @@ void RewardsServiceImpl::OnUnload(SessionID tab_id) {
     return;
   }
 
+  xhr_load_batcher_.Flush(tab_id);
+
   bat_ledger_->OnUnload(tab_id.id(), GetCurrentTimestamp());
 }
 
@@ -760,6 +770,11 @@ void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
     return;
   }
 
+  if (!ledger::ShouldProcessMediaLink(url.spec(), first_party_url.spec(),
+                                      referrer.spec())) {
+    return;
+  }
+
   base::flat_map<std::string, std::string> parts;
 
   for (net::QueryIterator it(url); !it.IsAtEnd(); it.Advance()) {
@@ -770,12 +785,20 @@ void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
   data->path = url.spec();
   data->tab_id = tab_id.id();
 
-  bat_ledger_->OnXHRLoad(tab_id.id(),
-                         url.spec(),
-                         parts,
-                         first_party_url.spec(),
-                         referrer.spec(),
-                         std::move(data));
+  xhr_load_batcher_.Add(
+      tab_id, bat_ledger::mojom::XHRLoad::New(
+                  url.spec(), std::move(parts), first_party_url.spec(),
+                  referrer.spec(), std::move(data)));
+}
+
+void RewardsServiceImpl::SendXHRLoads(
+    SessionID tab_id,
+    std::vector<bat_ledger::mojom::XHRLoadPtr> loads) {
+  if (!Connected()) {
+    return;
+  }
+
+  bat_ledger_->OnXHRLoads(tab_id.id(), std::move(loads));
 }
 
 void RewardsServiceImpl::OnRestorePublishers(
@@ -825,6 +848,8 @@ void RewardsServiceImpl::Shutdown() {
 
   url_loaders_.clear();
 
+  xhr_load_batcher_.FlushAll();
+
   bat_ledger_.reset();
   RewardsService::Shutdown();
 }
@@ -29,6 +29,7 @@
 #include "brave/components/brave_rewards/browser/diagnostic_log.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
 #include "brave/components/brave_rewards/browser/rewards_service_private_observer.h"
+#include "brave/components/brave_rewards/browser/xhr_load_batcher.h"
 #include "brave/components/brave_rewards/common/rewards_flags.h"
 #include "brave/components/greaselion/browser/buildflags/buildflags.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
@@ -453,6 +454,9 @@ class RewardsServiceImpl : public RewardsService,
   void StopNotificationTimers();
   void OnNotificationTimerFired();
 
+  void SendXHRLoads(SessionID tab_id,
+                    std::vector<bat_ledger::mojom::XHRLoadPtr> loads);
+
   void MaybeShowNotificationAddFunds();
   bool ShouldShowNotificationAddFunds() const;
   void ShowNotificationAddFunds(bool sufficient);
@@ -787,6 +791,7 @@ class RewardsServiceImpl : public RewardsService,
       current_media_fetchers_;
   std::unique_ptr<base::OneShotTimer> notification_startup_timer_;
   std::unique_ptr<base::RepeatingTimer> notification_periodic_timer_;
+  XHRLoadBatcher xhr_load_batcher_;
   PrefChangeRegistrar profile_pref_change_registrar_;
 
   uint32_t next_timer_id_;
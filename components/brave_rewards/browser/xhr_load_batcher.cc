@@ -0,0 +1,51 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/xhr_load_batcher.h"
+
+#include <utility>
+
+namespace brave_rewards {
+
+XHRLoadBatcher::XHRLoadBatcher(base::TimeDelta flush_delay,
+                               SendLoadsCallback send_loads)
+    : flush_delay_(flush_delay), send_loads_(std::move(send_loads)) {}
+
+XHRLoadBatcher::~XHRLoadBatcher() = default;
+
+void XHRLoadBatcher::Add(SessionID tab_id,
+                         bat_ledger::mojom::XHRLoadPtr load) {
+  pending_loads_[tab_id].push_back(std::move(load));
+
+  if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE, flush_delay_, this,
+                       &XHRLoadBatcher::FlushAll);
+  }
+}
+
+void XHRLoadBatcher::Flush(SessionID tab_id) {
+  const auto iter = pending_loads_.find(tab_id);
+  if (iter == pending_loads_.end()) {
+    return;
+  }
+
+  std::vector<bat_ledger::mojom::XHRLoadPtr> loads = std::move(iter->second);
+  pending_loads_.erase(iter);
+
+  send_loads_.Run(tab_id, std::move(loads));
+}
+
+void XHRLoadBatcher::FlushAll() {
+  flush_timer_.Stop();
+
+  std::map<SessionID, std::vector<bat_ledger::mojom::XHRLoadPtr>> loads;
+  loads.swap(pending_loads_);
+
+  for (auto& [tab_id, tab_loads] : loads) {
+    send_loads_.Run(tab_id, std::move(tab_loads));
+  }
+}
+
+}  // namespace brave_rewards
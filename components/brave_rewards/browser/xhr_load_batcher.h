@@ -0,0 +1,54 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_XHR_LOAD_BATCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_XHR_LOAD_BATCHER_H_
+
+#include <map>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
+#include "components/sessions/core/session_id.h"
+
+namespace brave_rewards {
+
+// Queues the resource loads of each tab which may be attributed to media
+// publishers, so that they are sent to the ledger in one call per tab at most
+// every |flush_delay|.
+class XHRLoadBatcher {
+ public:
+  using SendLoadsCallback = base::RepeatingCallback<void(
+      SessionID,
+      std::vector<bat_ledger::mojom::XHRLoadPtr>)>;
+
+  XHRLoadBatcher(base::TimeDelta flush_delay, SendLoadsCallback send_loads);
+  ~XHRLoadBatcher();
+
+  XHRLoadBatcher(const XHRLoadBatcher&) = delete;
+  XHRLoadBatcher& operator=(const XHRLoadBatcher&) = delete;
+
+  // Queues |load| until the next flush.
+  void Add(SessionID tab_id, bat_ledger::mojom::XHRLoadPtr load);
+
+  // Sends the loads queued for |tab_id| right away, e.g. when it is unloaded.
+  void Flush(SessionID tab_id);
+  // Sends the loads queued for all tabs right away, e.g. on shutdown.
+  void FlushAll();
+
+ private:
+  const base::TimeDelta flush_delay_;
+  SendLoadsCallback send_loads_;
+
+  std::map<SessionID, std::vector<bat_ledger::mojom::XHRLoadPtr>>
+      pending_loads_;
+  base::OneShotTimer flush_timer_;
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_XHR_LOAD_BATCHER_H_
@@ -0,0 +1,114 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/xhr_load_batcher.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/containers/flat_map.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=XHRLoadBatcherTest*
+
+namespace brave_rewards {
+
+namespace {
+
+constexpr base::TimeDelta kFlushDelay = base::Milliseconds(500);
+
+bat_ledger::mojom::XHRLoadPtr BuildLoad(const std::string& url) {
+  return bat_ledger::mojom::XHRLoad::New(
+      url, base::flat_map<std::string, std::string>(), "", "",
+      ledger::mojom::VisitData::New());
+}
+
+}  // namespace
+
+class XHRLoadBatcherTest : public testing::Test {
+ public:
+  XHRLoadBatcherTest()
+      : batcher_(kFlushDelay,
+                 base::BindRepeating(&XHRLoadBatcherTest::SendLoads,
+                                     base::Unretained(this))) {}
+
+ protected:
+  void SendLoads(SessionID tab_id,
+                 std::vector<bat_ledger::mojom::XHRLoadPtr> loads) {
+    std::vector<std::string> urls;
+    for (const auto& load : loads)
+      urls.push_back(load->url);
+    sent_loads_.emplace_back(tab_id, std::move(urls));
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  std::vector<std::pair<SessionID, std::vector<std::string>>> sent_loads_;
+  XHRLoadBatcher batcher_;
+};
+
+TEST_F(XHRLoadBatcherTest, SendsLoadsPerTabAfterDelay) {
+  const SessionID tab_1 = SessionID::FromSerializedValue(1);
+  const SessionID tab_2 = SessionID::FromSerializedValue(2);
+  batcher_.Add(tab_1, BuildLoad("https://a.com/1"));
+  batcher_.Add(tab_2, BuildLoad("https://b.com/1"));
+  batcher_.Add(tab_1, BuildLoad("https://a.com/2"));
+
+  task_environment_.FastForwardBy(kFlushDelay - base::Milliseconds(1));
+  EXPECT_TRUE(sent_loads_.empty());
+
+  task_environment_.FastForwardBy(base::Milliseconds(1));
+  ASSERT_EQ(2u, sent_loads_.size());
+  EXPECT_EQ(tab_1, sent_loads_[0].first);
+  EXPECT_EQ(std::vector<std::string>({"https://a.com/1", "https://a.com/2"}),
+            sent_loads_[0].second);
+  EXPECT_EQ(tab_2, sent_loads_[1].first);
+  EXPECT_EQ(std::vector<std::string>({"https://b.com/1"}),
+            sent_loads_[1].second);
+
+  // Nothing is sent again until more loads are queued.
+  task_environment_.FastForwardBy(kFlushDelay);
+  EXPECT_EQ(2u, sent_loads_.size());
+}
+
+TEST_F(XHRLoadBatcherTest, FlushSendsOnlyThatTab) {
+  const SessionID tab_1 = SessionID::FromSerializedValue(1);
+  const SessionID tab_2 = SessionID::FromSerializedValue(2);
+  batcher_.Add(tab_1, BuildLoad("https://a.com/1"));
+  batcher_.Add(tab_2, BuildLoad("https://b.com/1"));
+
+  batcher_.Flush(tab_1);
+  ASSERT_EQ(1u, sent_loads_.size());
+  EXPECT_EQ(tab_1, sent_loads_[0].first);
+
+  // A tab without queued loads sends nothing.
+  batcher_.Flush(tab_1);
+  EXPECT_EQ(1u, sent_loads_.size());
+
+  task_environment_.FastForwardBy(kFlushDelay);
+  ASSERT_EQ(2u, sent_loads_.size());
+  EXPECT_EQ(tab_2, sent_loads_[1].first);
+}
+
+TEST_F(XHRLoadBatcherTest, FlushAllSendsEverythingRightAway) {
+  const SessionID tab_1 = SessionID::FromSerializedValue(1);
+  const SessionID tab_2 = SessionID::FromSerializedValue(2);
+  batcher_.Add(tab_1, BuildLoad("https://a.com/1"));
+  batcher_.Add(tab_2, BuildLoad("https://b.com/1"));
+
+  // As done on shutdown.
+  batcher_.FlushAll();
+  ASSERT_EQ(2u, sent_loads_.size());
+  EXPECT_EQ(tab_1, sent_loads_[0].first);
+  EXPECT_EQ(tab_2, sent_loads_[1].first);
+
+  task_environment_.FastForwardBy(kFlushDelay);
+  EXPECT_EQ(2u, sent_loads_.size());
+}
+
+}  // namespace brave_rewards
@@ -0,0 +1,159 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_search/browser/backup_results_service.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_functions.h"
+#include "net/base/load_flags.h"
+#include "net/http/http_response_headers.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+
+namespace {
+
+net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
+  return net::DefineNetworkTrafficAnnotation("brave_search_host", R"(
+      semantics {
+        sender: "Brave Search Host Controller"
+        description:
+          "This controller is used as a backup search "
+          "provider for users that have opted into this feature."
+        trigger:
+          "Triggered by Brave search if a user has opted in."
+        data:
+          "Local backup provider results."
+        destination: WEBSITE
+      }
+      policy {
+        cookies_allowed: NO
+        setting:
+          "You can enable or disable this feature on chrome://flags."
+        policy_exception_justification:
+          "Not implemented."
+      }
+    )");
+}
+
+const unsigned int kRetriesCountOnNetworkChange = 1;
+
+// User data key for BackupResultsService.
+const void* const kBackupResultsServiceUserDataKey =
+    &kBackupResultsServiceUserDataKey;
+
+}  // namespace
+
+namespace brave_search {
+
+BackupResultsService::PendingFetch::PendingFetch() = default;
+BackupResultsService::PendingFetch::PendingFetch(PendingFetch&&) = default;
+BackupResultsService::PendingFetch&
+BackupResultsService::PendingFetch::operator=(PendingFetch&&) = default;
+BackupResultsService::PendingFetch::~PendingFetch() = default;
+
+BackupResultsService::BackupResultsService(
+    scoped_refptr<network::SharedURLLoaderFactory> factory)
+    : shared_url_loader_factory_(std::move(factory)),
+      cache_(kMaxCacheEntries) {}
+
+BackupResultsService::~BackupResultsService() = default;
+
+// static
+BackupResultsService* BackupResultsService::GetOrCreate(
+    base::SupportsUserData* holder,
+    scoped_refptr<network::SharedURLLoaderFactory> factory) {
+  auto* self = static_cast<BackupResultsService*>(
+      holder->GetUserData(kBackupResultsServiceUserDataKey));
+  if (!self) {
+    self = new BackupResultsService(std::move(factory));
+    holder->SetUserData(kBackupResultsServiceUserDataKey,
+                        base::WrapUnique(self));
+  }
+  return self;
+}
+
+void BackupResultsService::FetchBackupResults(
+    const GURL& url,
+    const std::string& geo,
+    FetchBackupResultsCallback callback) {
+  // The x-geo header changes the results as much as the url does.
+  const std::string key = url.spec() + "\n" + geo;
+
+  auto cached = cache_.Get(key);
+  if (cached != cache_.end()) {
+    if (base::TimeTicks::Now() - cached->second.fetch_time < kCacheLifetime) {
+      base::UmaHistogramBoolean(kCacheHitHistogramName, true);
+      std::move(callback).Run(cached->second.body);
+      return;
+    }
+    cache_.Erase(cached);
+  }
+  base::UmaHistogramBoolean(kCacheHitHistogramName, false);
+
+  auto pending = pending_fetches_.find(key);
+  if (pending != pending_fetches_.end()) {
+    pending->second.callbacks.push_back(std::move(callback));
+    return;
+  }
+
+  auto request = std::make_unique<network::ResourceRequest>();
+  request->url = url;
+  request->load_flags = net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE;
+  request->credentials_mode = network::mojom::CredentialsMode::kOmit;
+  request->load_flags |= net::LOAD_DO_NOT_SAVE_COOKIES;
+  request->method = "GET";
+  request->headers.SetHeaderIfMissing("x-geo", geo);
+
+  PendingFetch& fetch = pending_fetches_[key];
+  fetch.url_loader = network::SimpleURLLoader::Create(
+      std::move(request), GetNetworkTrafficAnnotationTag());
+  fetch.url_loader->SetRetryOptions(
+      kRetriesCountOnNetworkChange,
+      network::SimpleURLLoader::RetryMode::RETRY_ON_NETWORK_CHANGE);
+  fetch.callbacks.push_back(std::move(callback));
+  fetch.start_time = base::TimeTicks::Now();
+  fetch.url_loader->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+      shared_url_loader_factory_.get(),
+      base::BindOnce(&BackupResultsService::OnURLLoaderComplete,
+                     weak_factory_.GetWeakPtr(), key));
+}
+
+void BackupResultsService::OnURLLoaderComplete(
+    const std::string& key,
+    std::unique_ptr<std::string> response_body) {
+  auto pending = pending_fetches_.find(key);
+  DCHECK(pending != pending_fetches_.end());
+  PendingFetch fetch = std::move(pending->second);
+  pending_fetches_.erase(pending);
+
+  const base::TimeTicks now = base::TimeTicks::Now();
+  base::UmaHistogramMediumTimes(kFetchTimeHistogramName,
+                                now - fetch.start_time);
+
+  // Only successful responses are cached, so that failures are retried.
+  const auto* response_info = fetch.url_loader->ResponseInfo();
+  const bool success = response_body && response_info &&
+                       response_info->headers &&
+                       response_info->headers->response_code() / 100 == 2;
+  if (success) {
+    cache_.Put(key, CacheEntry{*response_body, now});
+  }
+
+  const std::string body = response_body ? *response_body : std::string();
+  for (auto& callback : fetch.callbacks) {
+    std::move(callback).Run(body);
+  }
+}
+
+base::WeakPtr<BackupResultsService> BackupResultsService::GetWeakPtr() {
+  return weak_factory_.GetWeakPtr();
+}
+
+}  // namespace brave_search
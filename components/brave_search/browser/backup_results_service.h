@@ -0,0 +1,92 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BACKUP_RESULTS_SERVICE_H_
+#define BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BACKUP_RESULTS_SERVICE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/lru_cache.h"
+#include "base/memory/weak_ptr.h"
+#include "base/supports_user_data.h"
+#include "base/time/time.h"
+#include "url/gurl.h"
+
+namespace network {
+class SharedURLLoaderFactory;
+class SimpleURLLoader;
+}  // namespace network
+
+namespace brave_search {
+
+// Fetches backup results for Brave Search on behalf of all the fallback hosts
+// of a browser context. Recent results are cached, and concurrent requests
+// for the same results share a single fetch.
+class BackupResultsService : public base::SupportsUserData::Data {
+ public:
+  using FetchBackupResultsCallback =
+      base::OnceCallback<void(const std::string&)>;
+
+  static constexpr size_t kMaxCacheEntries = 16;
+  static constexpr base::TimeDelta kCacheLifetime = base::Minutes(5);
+
+  static constexpr char kFetchTimeHistogramName[] =
+      "Brave.Search.BackupResultsFetchTime";
+  static constexpr char kCacheHitHistogramName[] =
+      "Brave.Search.BackupResultsCacheHit";
+
+  explicit BackupResultsService(
+      scoped_refptr<network::SharedURLLoaderFactory> factory);
+  BackupResultsService(const BackupResultsService&) = delete;
+  BackupResultsService& operator=(const BackupResultsService&) = delete;
+  ~BackupResultsService() override;
+
+  // Returns the service of |holder|, which is usually a browser context,
+  // creating it with |factory| if needed.
+  static BackupResultsService* GetOrCreate(
+      base::SupportsUserData* holder,
+      scoped_refptr<network::SharedURLLoaderFactory> factory);
+
+  // Runs |callback| with the body of |url| fetched with the x-geo header set
+  // to |geo|, or with an empty string if the fetch failed.
+  void FetchBackupResults(const GURL& url,
+                          const std::string& geo,
+                          FetchBackupResultsCallback callback);
+
+  base::WeakPtr<BackupResultsService> GetWeakPtr();
+
+ private:
+  struct CacheEntry {
+    std::string body;
+    base::TimeTicks fetch_time;
+  };
+
+  struct PendingFetch {
+    PendingFetch();
+    PendingFetch(PendingFetch&&);
+    PendingFetch& operator=(PendingFetch&&);
+    ~PendingFetch();
+
+    std::unique_ptr<network::SimpleURLLoader> url_loader;
+    std::vector<FetchBackupResultsCallback> callbacks;
+    base::TimeTicks start_time;
+  };
+
+  void OnURLLoaderComplete(const std::string& key,
+                           std::unique_ptr<std::string> response_body);
+
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  base::LRUCache<std::string, CacheEntry> cache_;
+  std::map<std::string, PendingFetch> pending_fetches_;
+  base::WeakPtrFactory<BackupResultsService> weak_factory_{this};
+};
+
+}  // namespace brave_search
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BACKUP_RESULTS_SERVICE_H_
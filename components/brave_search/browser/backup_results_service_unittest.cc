@@ -0,0 +1,147 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_search/browser/backup_results_service.h"
+
+#include <memory>
+#include <string>
+
+#include "base/test/bind.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/task_environment.h"
+#include "brave/components/brave_search/browser/brave_search_fallback_host.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=BackupResultsServiceTest.*
+
+namespace brave_search {
+
+namespace {
+
+constexpr char kBackupURL[] = "https://backup.example.com/search?q=test";
+
+}  // namespace
+
+class BackupResultsServiceTest : public testing::Test {
+ public:
+  BackupResultsServiceTest()
+      : shared_url_loader_factory_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)),
+        service_(shared_url_loader_factory_) {}
+
+ protected:
+  // Starts fetching |url| and returns the body it was replied with, which
+  // stays empty until the reply.
+  std::unique_ptr<std::string> Fetch(const GURL& url,
+                                     const std::string& geo = "") {
+    auto body = std::make_unique<std::string>();
+    service_.FetchBackupResults(
+        url, geo,
+        base::BindLambdaForTesting(
+            [body = body.get()](const std::string& result) {
+              *body = result;
+            }));
+    return body;
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  network::TestURLLoaderFactory url_loader_factory_;
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  BackupResultsService service_;
+  base::HistogramTester histogram_tester_;
+};
+
+TEST_F(BackupResultsServiceTest, CachesResults) {
+  auto first = Fetch(GURL(kBackupURL));
+  EXPECT_EQ(1, url_loader_factory_.NumPending());
+  url_loader_factory_.SimulateResponseForPendingRequest(kBackupURL, "results");
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ("results", *first);
+  histogram_tester_.ExpectTotalCount(
+      BackupResultsService::kFetchTimeHistogramName, 1);
+
+  auto second = Fetch(GURL(kBackupURL));
+  EXPECT_EQ(0, url_loader_factory_.NumPending());
+  EXPECT_EQ("results", *second);
+  histogram_tester_.ExpectBucketCount(
+      BackupResultsService::kCacheHitHistogramName, true, 1);
+  histogram_tester_.ExpectBucketCount(
+      BackupResultsService::kCacheHitHistogramName, false, 1);
+}
+
+TEST_F(BackupResultsServiceTest, DeduplicatesPendingFetches) {
+  auto first = Fetch(GURL(kBackupURL));
+  auto second = Fetch(GURL(kBackupURL));
+  EXPECT_EQ(1, url_loader_factory_.NumPending());
+
+  url_loader_factory_.SimulateResponseForPendingRequest(kBackupURL, "results");
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ("results", *first);
+  EXPECT_EQ("results", *second);
+  histogram_tester_.ExpectTotalCount(
+      BackupResultsService::kFetchTimeHistogramName, 1);
+}
+
+TEST_F(BackupResultsServiceTest, KeysResultsByGeo) {
+  Fetch(GURL(kBackupURL), "1,1");
+  Fetch(GURL(kBackupURL), "2,2");
+  EXPECT_EQ(2, url_loader_factory_.NumPending());
+}
+
+TEST_F(BackupResultsServiceTest, ExpiresResults) {
+  Fetch(GURL(kBackupURL));
+  url_loader_factory_.SimulateResponseForPendingRequest(kBackupURL, "results");
+  task_environment_.RunUntilIdle();
+
+  task_environment_.FastForwardBy(BackupResultsService::kCacheLifetime);
+  auto body = Fetch(GURL(kBackupURL));
+  EXPECT_EQ(1, url_loader_factory_.NumPending());
+  EXPECT_EQ("", *body);
+}
+
+TEST_F(BackupResultsServiceTest, DoesNotCacheFailures) {
+  auto first = Fetch(GURL(kBackupURL));
+  url_loader_factory_.SimulateResponseForPendingRequest(
+      kBackupURL, "error", net::HTTP_INTERNAL_SERVER_ERROR);
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ("", *first);
+
+  Fetch(GURL(kBackupURL));
+  EXPECT_EQ(1, url_loader_factory_.NumPending());
+}
+
+TEST_F(BackupResultsServiceTest, FallbackHostFetchesThroughService) {
+  BraveSearchFallbackHost::SetBackupProviderForTest(
+      GURL("https://backup.example.com/search"));
+  BraveSearchFallbackHost first_host(service_.GetWeakPtr());
+  BraveSearchFallbackHost second_host(service_.GetWeakPtr());
+
+  std::string first_body;
+  std::string second_body;
+  first_host.FetchBackupResults(
+      "test", "", "", "", false,
+      base::BindLambdaForTesting(
+          [&](const std::string& result) { first_body = result; }));
+  second_host.FetchBackupResults(
+      "test", "", "", "", false,
+      base::BindLambdaForTesting(
+          [&](const std::string& result) { second_body = result; }));
+  EXPECT_EQ(1, url_loader_factory_.NumPending());
+
+  url_loader_factory_.SimulateResponseForPendingRequest(kBackupURL, "results");
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ("results", first_body);
+  EXPECT_EQ("results", second_body);
+
+  BraveSearchFallbackHost::SetBackupProviderForTest(GURL());
+}
+
+}  // namespace brave_search
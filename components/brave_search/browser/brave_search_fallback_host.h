@@ -6,29 +6,23 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BRAVE_SEARCH_FALLBACK_HOST_H_
 #define BRAVE_COMPONENTS_BRAVE_SEARCH_BROWSER_BRAVE_SEARCH_FALLBACK_HOST_H_
 
-#include <list>
-#include <map>
-#include <memory>
 #include <string>
 
 #include "base/memory/weak_ptr.h"
 #include "brave/components/brave_search/common/brave_search_fallback.mojom.h"
 #include "url/gurl.h"
 
-namespace network {
-class SharedURLLoaderFactory;
-class SimpleURLLoader;
-}  // namespace network
-
 namespace brave_search {
 
+class BackupResultsService;
+
 class BraveSearchFallbackHost final
     : public brave_search::mojom::BraveSearchFallback {
  public:
   BraveSearchFallbackHost(const BraveSearchFallbackHost&) = delete;
   BraveSearchFallbackHost& operator=(const BraveSearchFallbackHost&) = delete;
   explicit BraveSearchFallbackHost(
-      scoped_refptr<network::SharedURLLoaderFactory> factory);
+      base::WeakPtr<BackupResultsService> backup_results_service);
   ~BraveSearchFallbackHost() override;
 
   void FetchBackupResults(const std::string& query_string,
@@ -47,20 +41,7 @@ class BraveSearchFallbackHost final
   static void SetBackupProviderForTest(const GURL&);
 
  private:
-  using SimpleURLLoaderList =
-      std::list<std::unique_ptr<network::SimpleURLLoader>>;
-  using URLRequestCallback =
-      base::OnceCallback<void(const int,
-                              const std::string&,
-                              const std::map<std::string, std::string>&)>;
-
-  void OnURLLoaderComplete(
-      SimpleURLLoaderList::iterator iter,
-      BraveSearchFallbackHost::FetchBackupResultsCallback callback,
-      const std::unique_ptr<std::string> response_body);
-  SimpleURLLoaderList url_loaders_;
-  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
-  base::WeakPtrFactory<BraveSearchFallbackHost> weak_factory_;
+  base::WeakPtr<BackupResultsService> backup_results_service_;
 };
 
 }  // namespace brave_search
@@ -15,8 +15,9 @@
 namespace brave_shields {
 
 AdBlockCustomFiltersProvider::AdBlockCustomFiltersProvider(
-    PrefService* local_state)
-    : local_state_(local_state) {}
+    PrefService* local_state,
+    const base::FilePath& engine_cache_path)
+    : local_state_(local_state), engine_cache_path_(engine_cache_path) {}
 
 AdBlockCustomFiltersProvider::~AdBlockCustomFiltersProvider() {}
 
@@ -55,4 +56,8 @@ void AdBlockCustomFiltersProvider::LoadDATBuffer(
       FROM_HERE, base::BindOnce(std::move(cb), false, std::move(buffer)));
 }
 
+base::FilePath AdBlockCustomFiltersProvider::GetEngineCachePath() const {
+  return engine_cache_path_;
+}
+
 }  // namespace brave_shields
@@ -9,6 +9,7 @@
 #include <string>
 
 #include "base/callback.h"
+#include "base/files/file_path.h"
 #include "base/sequence_checker.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/brave_shields/browser/ad_block_filters_provider.h"
@@ -21,7 +22,8 @@ namespace brave_shields {
 
 class AdBlockCustomFiltersProvider : public AdBlockFiltersProvider {
  public:
-  explicit AdBlockCustomFiltersProvider(PrefService* local_state);
+  AdBlockCustomFiltersProvider(PrefService* local_state,
+                               const base::FilePath& engine_cache_path);
   ~AdBlockCustomFiltersProvider() override;
   AdBlockCustomFiltersProvider(const AdBlockCustomFiltersProvider&) = delete;
   AdBlockCustomFiltersProvider& operator=(const AdBlockCustomFiltersProvider&) =
@@ -34,8 +36,11 @@ class AdBlockCustomFiltersProvider : public AdBlockFiltersProvider {
       base::OnceCallback<void(bool deserialize,
                               const DATFileDataBuffer& dat_buf)>) override;
 
+  base::FilePath GetEngineCachePath() const override;
+
  private:
   PrefService* local_state_;
+  const base::FilePath engine_cache_path_;
 
   SEQUENCE_CHECKER(sequence_checker_);
 };
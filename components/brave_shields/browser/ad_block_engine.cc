@@ -13,12 +13,21 @@
 
 #include "base/bind.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
 #include "base/json/json_reader.h"
+#include "base/logging.h"
 #include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/timer/elapsed_timer.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "crypto/secure_hash.h"
+#include "crypto/sha2.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/origin.h"
@@ -27,6 +36,25 @@ using namespace net::registry_controlled_domains;  // NOLINT
 
 namespace {
 
+constexpr char kCachedEngineLoadTimeHistogramName[] =
+    "Brave.Adblock.EngineLoadTime.Cached";
+constexpr char kSourceEngineLoadTimeHistogramName[] =
+    "Brave.Adblock.EngineLoadTime.Source";
+
+// Identifies the engine compiled from |filters| by the current adblock-rust
+// version. Serialized engines can only be read by the version that wrote them,
+// so caches from other versions are recompiled.
+std::string GetEngineCacheKey(const DATFileDataBuffer& filters) {
+  std::unique_ptr<crypto::SecureHash> hash =
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  const std::string version = adblock::GetVersion();
+  hash->Update(version.c_str(), version.size() + 1);
+  hash->Update(filters.data(), filters.size());
+  uint8_t digest[crypto::kSHA256Length];
+  hash->Finish(digest, sizeof(digest));
+  return base::HexEncode(digest, sizeof(digest)) + "\n";
+}
+
 std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
   std::string filter_option = "";
   switch (resource_type) {
@@ -204,6 +232,47 @@ absl::optional<adblock::FilterListMetadata> AdBlockEngine::Load(
   }
 }
 
+absl::optional<adblock::FilterListMetadata> AdBlockEngine::LoadWithEngineCache(
+    const DATFileDataBuffer& filters,
+    const base::FilePath& cache_path,
+    const std::string& resources_json) {
+  base::ElapsedTimer timer;
+
+  // The cache holds the cache key followed by the serialized engine.
+  const std::string cache_key = GetEngineCacheKey(filters);
+  std::string cache;
+  if (base::ReadFileToString(cache_path, &cache) &&
+      base::StartsWith(cache, cache_key)) {
+    auto client = std::make_unique<adblock::Engine>();
+    if (client->deserialize(cache.data() + cache_key.size(),
+                            cache.size() - cache_key.size())) {
+      UpdateAdBlockClient(std::move(client), resources_json);
+      base::UmaHistogramMediumTimes(kCachedEngineLoadTimeHistogramName,
+                                    timer.Elapsed());
+      return absl::nullopt;
+    }
+  }
+
+  auto metadata_and_engine = adblock::engineFromBufferWithMetadata(
+      reinterpret_cast<const char*>(filters.data()), filters.size());
+  // Serialized before resources are added, as those are loaded separately.
+  const std::vector<unsigned char> serialized =
+      metadata_and_engine.second->serialize();
+  UpdateAdBlockClient(std::move(metadata_and_engine.second), resources_json);
+  base::UmaHistogramMediumTimes(kSourceEngineLoadTimeHistogramName,
+                                timer.Elapsed());
+
+  if (!serialized.empty()) {
+    cache = cache_key;
+    cache.append(serialized.begin(), serialized.end());
+    if (!base::ImportantFileWriter::WriteFileAtomically(cache_path, cache)) {
+      VLOG(1) << "Failed to cache adblock engine at " << cache_path;
+    }
+  }
+
+  return std::move(metadata_and_engine.first);
+}
+
 void AdBlockEngine::UpdateAdBlockClient(
     std::unique_ptr<adblock::Engine> ad_block_client,
     const std::string& resources_json) {
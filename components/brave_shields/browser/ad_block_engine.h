@@ -14,6 +14,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list_types.h"
 #include "base/values.h"
@@ -74,6 +75,15 @@ class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
       const DATFileDataBuffer& dat_buf,
       const std::string& resources_json);
 
+  // Deserializes the engine cached at |cache_path| if it was compiled from
+  // |filters| by the current adblock-rust version. Otherwise compiles
+  // |filters| and caches the result at |cache_path|. List metadata is only
+  // returned when |filters| had to be compiled.
+  absl::optional<adblock::FilterListMetadata> LoadWithEngineCache(
+      const DATFileDataBuffer& filters,
+      const base::FilePath& cache_path,
+      const std::string& resources_json);
+
   class TestObserver : public base::CheckedObserver {
    public:
     virtual void OnEngineUpdated() = 0;
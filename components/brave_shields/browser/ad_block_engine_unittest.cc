@@ -0,0 +1,115 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "brave/components/brave_shields/common/adblock_domain_resolver.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=AdBlockEngineTest.*
+
+namespace brave_shields {
+
+namespace {
+
+constexpr char kCachedHistogramName[] = "Brave.Adblock.EngineLoadTime.Cached";
+constexpr char kSourceHistogramName[] = "Brave.Adblock.EngineLoadTime.Source";
+
+DATFileDataBuffer ToBuffer(const std::string& filters) {
+  return DATFileDataBuffer(filters.begin(), filters.end());
+}
+
+}  // namespace
+
+class AdBlockEngineTest : public testing::Test {
+ public:
+  AdBlockEngineTest() = default;
+  ~AdBlockEngineTest() override = default;
+
+  void SetUp() override {
+    adblock::SetDomainResolver(AdBlockServiceDomainResolver);
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    cache_path_ = temp_dir_.GetPath().AppendASCII("engine.dat");
+  }
+
+ protected:
+  bool ShouldBlock(AdBlockEngine* engine, const std::string& url) {
+    bool did_match_rule = false;
+    bool did_match_exception = false;
+    bool did_match_important = false;
+    std::string mock_data_url;
+    engine->ShouldStartRequest(GURL(url), blink::mojom::ResourceType::kScript,
+                               "example.com", false, &did_match_rule,
+                               &did_match_exception, &did_match_important,
+                               &mock_data_url);
+    return did_match_rule && !did_match_exception;
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath cache_path_;
+  base::HistogramTester histogram_tester_;
+};
+
+TEST_F(AdBlockEngineTest, LoadWithEngineCache) {
+  const DATFileDataBuffer filters =
+      ToBuffer("! Title: Test list\n||ads.example.org^\n");
+
+  auto engine = std::make_unique<AdBlockEngine>();
+  auto metadata = engine->LoadWithEngineCache(filters, cache_path_, "[]");
+  ASSERT_TRUE(metadata);
+  EXPECT_EQ("Test list", metadata->title);
+  EXPECT_TRUE(base::PathExists(cache_path_));
+  EXPECT_TRUE(ShouldBlock(engine.get(), "https://ads.example.org/ad.js"));
+  histogram_tester_.ExpectTotalCount(kSourceHistogramName, 1);
+  histogram_tester_.ExpectTotalCount(kCachedHistogramName, 0);
+
+  // The same filters are deserialized from the cache.
+  engine = std::make_unique<AdBlockEngine>();
+  EXPECT_FALSE(engine->LoadWithEngineCache(filters, cache_path_, "[]"));
+  EXPECT_TRUE(ShouldBlock(engine.get(), "https://ads.example.org/ad.js"));
+  histogram_tester_.ExpectTotalCount(kSourceHistogramName, 1);
+  histogram_tester_.ExpectTotalCount(kCachedHistogramName, 1);
+}
+
+TEST_F(AdBlockEngineTest, LoadWithEngineCacheRecompilesChangedFilters) {
+  auto engine = std::make_unique<AdBlockEngine>();
+  engine->LoadWithEngineCache(ToBuffer("||ads.example.org^\n"), cache_path_,
+                              "[]");
+
+  engine = std::make_unique<AdBlockEngine>();
+  EXPECT_TRUE(engine->LoadWithEngineCache(ToBuffer("||ads.example.net^\n"),
+                                          cache_path_, "[]"));
+  EXPECT_FALSE(ShouldBlock(engine.get(), "https://ads.example.org/ad.js"));
+  EXPECT_TRUE(ShouldBlock(engine.get(), "https://ads.example.net/ad.js"));
+  histogram_tester_.ExpectTotalCount(kSourceHistogramName, 2);
+  histogram_tester_.ExpectTotalCount(kCachedHistogramName, 0);
+}
+
+TEST_F(AdBlockEngineTest, LoadWithCorruptEngineCache) {
+  const DATFileDataBuffer filters = ToBuffer("||ads.example.org^\n");
+  auto engine = std::make_unique<AdBlockEngine>();
+  engine->LoadWithEngineCache(filters, cache_path_, "[]");
+
+  // Keep the cache key but truncate the serialized engine.
+  std::string cache;
+  ASSERT_TRUE(base::ReadFileToString(cache_path_, &cache));
+  ASSERT_TRUE(base::WriteFile(cache_path_, cache.substr(0, 70)));
+
+  engine = std::make_unique<AdBlockEngine>();
+  EXPECT_TRUE(engine->LoadWithEngineCache(filters, cache_path_, "[]"));
+  EXPECT_TRUE(ShouldBlock(engine.get(), "https://ads.example.org/ad.js"));
+  histogram_tester_.ExpectTotalCount(kSourceHistogramName, 2);
+}
+
+}  // namespace brave_shields
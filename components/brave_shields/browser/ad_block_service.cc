@@ -80,16 +80,20 @@ void AdBlockService::SourceProviderObserver::OnResourcesLoaded(
   } else {
     auto engine_load_callback = base::BindOnce(
         [](base::WeakPtr<AdBlockEngine> engine, bool deserialize,
-           DATFileDataBuffer dat_buf, const std::string& resources_json)
+           DATFileDataBuffer dat_buf, const base::FilePath& cache_path,
+           const std::string& resources_json)
             -> absl::optional<adblock::FilterListMetadata> {
-          if (engine) {
-            return engine->Load(deserialize, std::move(dat_buf),
-                                resources_json);
-          } else {
+          if (!engine) {
             return absl::nullopt;
           }
+          if (!deserialize && !cache_path.empty()) {
+            return engine->LoadWithEngineCache(std::move(dat_buf), cache_path,
+                                               resources_json);
+          }
+          return engine->Load(deserialize, std::move(dat_buf), resources_json);
         },
-        adblock_engine_, deserialize_, std::move(dat_buf_), resources_json);
+        adblock_engine_, deserialize_, std::move(dat_buf_),
+        filters_provider_->GetEngineCachePath(), resources_json);
     task_runner_->PostTaskAndReplyWithResult(
         FROM_HERE, std::move(engine_load_callback),
         base::BindOnce(&SourceProviderObserver::OnEngineReplaced,
@@ -306,6 +310,7 @@ AdBlockService::AdBlockService(
     std::string locale,
     component_updater::ComponentUpdateService* cus,
     scoped_refptr<base::SequencedTaskRunner> task_runner,
+    const base::FilePath& profile_dir,
     std::unique_ptr<AdBlockSubscriptionServiceManager>
         subscription_service_manager)
     : local_state_(local_state),
@@ -323,7 +328,7 @@ AdBlockService::AdBlockService(
           component_update_service_);
   custom_filters_provider_ =
       std::make_unique<brave_shields::AdBlockCustomFiltersProvider>(
-          local_state_);
+          local_state_, profile_dir.Append(kCustomFiltersEngineCache));
 }
 
 AdBlockService::~AdBlockService() {}
@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 
+#include "base/files/file_path.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
@@ -96,6 +97,7 @@ class AdBlockService {
       std::string locale,
       component_updater::ComponentUpdateService* cus,
       scoped_refptr<base::SequencedTaskRunner> task_runner,
+      const base::FilePath& profile_dir,
       std::unique_ptr<AdBlockSubscriptionServiceManager> manager);
   AdBlockService(const AdBlockService&) = delete;
   AdBlockService& operator=(const AdBlockService&) = delete;
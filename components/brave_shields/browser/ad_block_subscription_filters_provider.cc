@@ -9,6 +9,7 @@
 
 #include "base/logging.h"
 #include "base/task/thread_pool.h"
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/components/brave_shields/common/pref_names.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_task_traits.h"
@@ -32,4 +33,8 @@ void AdBlockSubscriptionFiltersProvider::LoadDATBuffer(
       base::BindOnce(std::move(cb), false));
 }
 
+base::FilePath AdBlockSubscriptionFiltersProvider::GetEngineCachePath() const {
+  return list_file_.DirName().Append(kCustomSubscriptionEngineCache);
+}
+
 }  // namespace brave_shields
@@ -31,6 +31,8 @@ class AdBlockSubscriptionFiltersProvider : public AdBlockFiltersProvider {
       base::OnceCallback<void(bool deserialize,
                               const DATFileDataBuffer& dat_buf)>) override;
 
+  base::FilePath GetEngineCachePath() const override;
+
  private:
   base::FilePath list_file_;
 
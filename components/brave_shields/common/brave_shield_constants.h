@@ -39,6 +39,15 @@ const char kObsoleteFingerprinting[] = "fingerprinting";
 const base::FilePath::CharType kCustomSubscriptionListText[] =
     FILE_PATH_LITERAL("list_text.txt");
 
+// Filename for the compiled engine cached next to a filter list subscription
+const base::FilePath::CharType kCustomSubscriptionEngineCache[] =
+    FILE_PATH_LITERAL("list_engine.dat");
+
+// Filename for the compiled engine of the custom filters, in the profile
+// directory
+const base::FilePath::CharType kCustomFiltersEngineCache[] =
+    FILE_PATH_LITERAL("AdBlockCustomFiltersEngine.dat");
+
 const char kCookieListUuid[] = "AC023D22-AE88-4060-A978-4FEEEC4221693";
 
 constexpr webui::LocalizedString kLocalizedStrings[] = {
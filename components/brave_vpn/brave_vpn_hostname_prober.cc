@@ -0,0 +1,125 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_vpn/brave_vpn_hostname_prober.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "net/base/load_flags.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+#include "url/gurl.h"
+#include "url/url_constants.h"
+
+namespace brave_vpn {
+
+namespace {
+
+// Weight of the latest measurement in the moving average.
+constexpr double kLatencyWeight = 0.3;
+
+// Latency used for hostnames which failed to respond in time.
+constexpr base::TimeDelta kFailedProbeLatency =
+    BraveVPNHostnameProber::kProbeTimeout * 2;
+
+net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
+  return net::DefineNetworkTrafficAnnotation("brave_vpn_hostname_prober", R"(
+      semantics {
+        sender: "Brave VPN Service"
+        description:
+          "This service measures how fast Brave VPN servers respond to pick "
+          "the fastest one of the selected region."
+        trigger:
+          "Triggered by user connecting the Brave VPN. Probing stops once "
+          "the connection is established."
+        data:
+          "None"
+        destination: WEBSITE
+      }
+      policy {
+        cookies_allowed: NO
+        policy_exception_justification:
+          "Not implemented."
+      }
+    )");
+}
+
+}  // namespace
+
+BraveVPNHostnameProber::BraveVPNHostnameProber(
+    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
+    : url_loader_factory_(url_loader_factory) {}
+
+BraveVPNHostnameProber::~BraveVPNHostnameProber() = default;
+
+void BraveVPNHostnameProber::Probe(const std::vector<std::string>& hostnames,
+                                   base::OnceClosure callback) {
+  Cancel();
+  if (hostnames.empty()) {
+    std::move(callback).Run();
+    return;
+  }
+
+  callback_ = std::move(callback);
+  for (const auto& hostname : hostnames) {
+    auto request = std::make_unique<network::ResourceRequest>();
+    request->url = GURL(std::string(url::kHttpsScheme) + "://" + hostname);
+    request->method = "HEAD";
+    request->load_flags = net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE |
+                          net::LOAD_DO_NOT_SAVE_COOKIES;
+    request->credentials_mode = network::mojom::CredentialsMode::kOmit;
+
+    auto iter = url_loaders_.insert(
+        url_loaders_.begin(),
+        network::SimpleURLLoader::Create(std::move(request),
+                                         GetNetworkTrafficAnnotationTag()));
+    iter->get()->SetAllowHttpErrorResults(true);
+    iter->get()->SetTimeoutDuration(kProbeTimeout);
+    iter->get()->DownloadHeadersOnly(
+        url_loader_factory_.get(),
+        base::BindOnce(&BraveVPNHostnameProber::OnProbed,
+                       weak_ptr_factory_.GetWeakPtr(), iter, hostname,
+                       base::TimeTicks::Now()));
+  }
+}
+
+void BraveVPNHostnameProber::Cancel() {
+  url_loaders_.clear();
+  callback_.Reset();
+}
+
+void BraveVPNHostnameProber::OnProbed(
+    SimpleURLLoaderList::iterator iter,
+    const std::string& hostname,
+    base::TimeTicks start_time,
+    scoped_refptr<net::HttpResponseHeaders> headers) {
+  url_loaders_.erase(iter);
+
+  // Any response, even an error page, means the server could be reached.
+  const base::TimeDelta latency =
+      headers ? base::TimeTicks::Now() - start_time : kFailedProbeLatency;
+  VLOG(2) << __func__ << " : " << hostname << " responded in " << latency;
+  UpdateLatency(hostname, latency);
+
+  if (url_loaders_.empty() && callback_)
+    std::move(callback_).Run();
+}
+
+void BraveVPNHostnameProber::UpdateLatency(const std::string& hostname,
+                                           base::TimeDelta latency) {
+  auto iter = latencies_.find(hostname);
+  if (iter == latencies_.end()) {
+    latencies_[hostname] = latency;
+    return;
+  }
+
+  iter->second += (latency - iter->second) * kLatencyWeight;
+}
+
+}  // namespace brave_vpn
@@ -0,0 +1,76 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_VPN_BRAVE_VPN_HOSTNAME_PROBER_H_
+#define BRAVE_COMPONENTS_BRAVE_VPN_BRAVE_VPN_HOSTNAME_PROBER_H_
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "net/http/http_response_headers.h"
+
+namespace network {
+class SharedURLLoaderFactory;
+class SimpleURLLoader;
+}  // namespace network
+
+namespace brave_vpn {
+
+// Measures how long it takes to connect to VPN hostnames and get a response
+// from them, and keeps an exponentially weighted moving average of it per
+// hostname. All hostnames of a probe are measured in parallel and the probe
+// finishes within kProbeTimeout.
+class BraveVPNHostnameProber {
+ public:
+  static constexpr base::TimeDelta kProbeTimeout = base::Seconds(2);
+
+  explicit BraveVPNHostnameProber(
+      scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
+  ~BraveVPNHostnameProber();
+
+  BraveVPNHostnameProber(const BraveVPNHostnameProber&) = delete;
+  BraveVPNHostnameProber& operator=(const BraveVPNHostnameProber&) = delete;
+
+  // Probes |hostnames| and runs |callback| once all of them are measured.
+  // Calling it while a probe is in progress cancels that probe without
+  // running its callback.
+  void Probe(const std::vector<std::string>& hostnames,
+             base::OnceClosure callback);
+  void Cancel();
+  bool is_probing() const { return !url_loaders_.empty(); }
+
+  // Averaged latencies of the hostnames probed so far. Hostnames which failed
+  // to respond are penalized rather than dropped.
+  const base::flat_map<std::string, base::TimeDelta>& latencies() const {
+    return latencies_;
+  }
+
+ private:
+  using SimpleURLLoaderList =
+      std::list<std::unique_ptr<network::SimpleURLLoader>>;
+
+  void OnProbed(SimpleURLLoaderList::iterator iter,
+                const std::string& hostname,
+                base::TimeTicks start_time,
+                scoped_refptr<net::HttpResponseHeaders> headers);
+  void UpdateLatency(const std::string& hostname, base::TimeDelta latency);
+
+  scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
+  SimpleURLLoaderList url_loaders_;
+  base::OnceClosure callback_;
+  base::flat_map<std::string, base::TimeDelta> latencies_;
+  base::WeakPtrFactory<BraveVPNHostnameProber> weak_ptr_factory_{this};
+};
+
+}  // namespace brave_vpn
+
+#endif  // BRAVE_COMPONENTS_BRAVE_VPN_BRAVE_VPN_HOSTNAME_PROBER_H_
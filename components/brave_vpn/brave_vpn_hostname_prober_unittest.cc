@@ -0,0 +1,119 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_vpn/brave_vpn_hostname_prober.h"
+
+#include <memory>
+
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_vpn {
+
+namespace {
+constexpr char kHostA[] = "host-a.brave.com";
+constexpr char kHostB[] = "host-b.brave.com";
+constexpr char kHostAUrl[] = "https://host-a.brave.com/";
+constexpr char kHostBUrl[] = "https://host-b.brave.com/";
+}  // namespace
+
+class BraveVPNHostnameProberTest : public testing::Test {
+ public:
+  BraveVPNHostnameProberTest()
+      : shared_url_loader_factory_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)),
+        prober_(shared_url_loader_factory_) {}
+
+  void Probe(const std::vector<std::string>& hostnames) {
+    probed_ = false;
+    prober_.Probe(hostnames,
+                  base::BindLambdaForTesting([this]() { probed_ = true; }));
+  }
+
+  void Respond(const std::string& url) {
+    EXPECT_TRUE(url_loader_factory_.SimulateResponseForPendingRequest(url, ""));
+  }
+
+  base::TimeDelta latency(const std::string& hostname) const {
+    return prober_.latencies().at(hostname);
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  network::TestURLLoaderFactory url_loader_factory_;
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  BraveVPNHostnameProber prober_;
+  bool probed_ = false;
+};
+
+TEST_F(BraveVPNHostnameProberTest, ProbesHostnamesInParallel) {
+  Probe({kHostA, kHostB});
+  EXPECT_TRUE(prober_.is_probing());
+  EXPECT_EQ(2, url_loader_factory_.NumPending());
+
+  task_environment_.FastForwardBy(base::Milliseconds(100));
+  Respond(kHostBUrl);
+  EXPECT_FALSE(probed_);
+
+  task_environment_.FastForwardBy(base::Milliseconds(200));
+  Respond(kHostAUrl);
+  EXPECT_TRUE(probed_);
+  EXPECT_FALSE(prober_.is_probing());
+
+  EXPECT_EQ(base::Milliseconds(300), latency(kHostA));
+  EXPECT_EQ(base::Milliseconds(100), latency(kHostB));
+}
+
+TEST_F(BraveVPNHostnameProberTest, AveragesLatencies) {
+  Probe({kHostA});
+  task_environment_.FastForwardBy(base::Milliseconds(100));
+  Respond(kHostAUrl);
+  EXPECT_EQ(base::Milliseconds(100), latency(kHostA));
+
+  Probe({kHostA});
+  task_environment_.FastForwardBy(base::Milliseconds(200));
+  Respond(kHostAUrl);
+  EXPECT_TRUE(probed_);
+  EXPECT_EQ(base::Milliseconds(130), latency(kHostA));
+}
+
+TEST_F(BraveVPNHostnameProberTest, PenalizesHostnamesWhichDoNotRespond) {
+  Probe({kHostA, kHostB});
+  task_environment_.FastForwardBy(base::Milliseconds(100));
+  Respond(kHostAUrl);
+  EXPECT_FALSE(probed_);
+
+  task_environment_.FastForwardBy(BraveVPNHostnameProber::kProbeTimeout);
+  EXPECT_TRUE(probed_);
+  EXPECT_EQ(base::Milliseconds(100), latency(kHostA));
+  EXPECT_LT(BraveVPNHostnameProber::kProbeTimeout, latency(kHostB));
+}
+
+TEST_F(BraveVPNHostnameProberTest, CancelsPreviousProbe) {
+  bool first_probed = false;
+  prober_.Probe({kHostA}, base::BindLambdaForTesting(
+                              [&first_probed]() { first_probed = true; }));
+  Probe({kHostB});
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(1, url_loader_factory_.NumPending());
+
+  Respond(kHostBUrl);
+  EXPECT_TRUE(probed_);
+  EXPECT_FALSE(first_probed);
+  EXPECT_EQ(0u, prober_.latencies().count(kHostA));
+}
+
+TEST_F(BraveVPNHostnameProberTest, ProbeWithoutHostnames) {
+  Probe({});
+  EXPECT_TRUE(probed_);
+  EXPECT_FALSE(prober_.is_probing());
+}
+
+}  // namespace brave_vpn
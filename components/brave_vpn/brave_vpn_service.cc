@@ -23,6 +23,7 @@
 
 #if !BUILDFLAG(IS_ANDROID)
 #include "base/bind.h"
+#include "base/callback_helpers.h"
 #include "base/command_line.h"
 #include "base/logging.h"
 #include "base/notreached.h"
@@ -124,6 +125,8 @@ BraveVpnService::BraveVpnService(
 #if !BUILDFLAG(IS_ANDROID)
   auto* cmd = base::CommandLine::ForCurrentProcess();
   is_simulation_ = cmd->HasSwitch(switches::kBraveVPNSimulation);
+  hostname_prober_ =
+      std::make_unique<BraveVPNHostnameProber>(url_loader_factory);
   observed_.Observe(GetBraveVPNConnectionAPI());
 
   GetBraveVPNConnectionAPI()->set_target_vpn_entry_name(kBraveVPNEntryName);
@@ -245,6 +248,11 @@ void BraveVpnService::UpdateAndNotifyConnectionStateChange(
           << state;
 
   connection_state_ = state;
+  // Probes finishing once connected would be measured through the tunnel and
+  // skew the latencies of hostnames for the next connection.
+  if (connection_state_ == ConnectionState::CONNECTED)
+    hostname_prober_->Cancel();
+
   for (const auto& obs : observers_)
     obs->OnConnectionStateChanged(connection_state_);
 }
@@ -708,6 +716,8 @@ void BraveVpnService::FetchHostnamesForRegion(const std::string& name) {
   VLOG(2) << __func__;
   // Hostname will be replaced with latest one.
   hostname_.reset();
+  hostnames_.clear();
+  hostname_prober_->Cancel();
 
   // Unretained is safe here becasue this class owns request helper.
   GetHostnamesForRegion(base::BindOnce(&BraveVpnService::OnFetchHostnames,
@@ -754,7 +764,8 @@ void BraveVpnService::ParseAndCacheHostnames(
     return;
   }
 
-  hostname_ = PickBestHostname(hostnames);
+  hostnames_ = hostnames;
+  hostname_ = PickBestHostname(hostnames_, hostname_prober_->latencies());
   if (hostname_->hostname.empty()) {
     VLOG(2) << __func__ << " : got empty hostnames list for " << region;
     UpdateAndNotifyConnectionStateChange(ConnectionState::CONNECT_FAILED);
@@ -771,6 +782,11 @@ void BraveVpnService::ParseAndCacheHostnames(
     return;
   }
 
+  // Measure hostnames while fetching the subscriber credential, which doesn't
+  // depend on the hostname, so that the fastest one can be used for the
+  // profile credential. Connecting never waits longer than the fetch for them.
+  hostname_prober_->Probe(GetHostnamesToProbe(hostnames_), base::DoNothing());
+
   // Get subscriber credentials and then get EAP credentials with it to create
   // OS VPN entry.
   VLOG(2) << __func__ << " : request subscriber credential:"
@@ -800,6 +816,16 @@ void BraveVpnService::OnGetSubscriberCredentialV12(
   VLOG(2) << __func__ << " : received subscriber credential";
   // TODO(bsclifton): consider storing `subscriber_credential` for
   // support ticket use-case (see `CreateSupportTicket`).
+  if (hostname_prober_->is_probing()) {
+    // Keep the hostname picked when the hostnames were fetched, from the
+    // capacity score and earlier measurements.
+    VLOG(2) << __func__ << " : hostnames are still being probed";
+    hostname_prober_->Cancel();
+  } else if (!hostnames_.empty()) {
+    hostname_ = PickBestHostname(hostnames_, hostname_prober_->latencies());
+    VLOG(2) << __func__ << " : Picked " << hostname_->hostname;
+  }
+
   GetProfileCredentials(
       base::BindOnce(&BraveVpnService::OnGetProfileCredentials,
                      base::Unretained(this)),
@@ -1071,6 +1097,7 @@ void BraveVpnService::Shutdown() {
 #if !BUILDFLAG(IS_ANDROID)
   observed_.Reset();
   receivers_.Clear();
+  hostname_prober_->Cancel();
 #endif  // !BUILDFLAG(IS_ANDROID)
 }
 
@@ -36,6 +36,7 @@
 #include "base/timer/timer.h"
 #include "brave/components/brave_vpn/brave_vpn_connection_info.h"
 #include "brave/components/brave_vpn/brave_vpn_data_types.h"
+#include "brave/components/brave_vpn/brave_vpn_hostname_prober.h"
 #include "brave/components/brave_vpn/brave_vpn_os_connection_api.h"
 #include "mojo/public/cpp/bindings/receiver_set.h"
 #endif  // !BUILDFLAG(IS_ANDROID)
@@ -258,6 +259,9 @@ class BraveVpnService :
 #if !BUILDFLAG(IS_ANDROID)
   std::vector<mojom::Region> regions_;
   std::unique_ptr<Hostname> hostname_;
+  // Hostnames of the region we are connecting or connected to.
+  std::vector<Hostname> hostnames_;
+  std::unique_ptr<BraveVPNHostnameProber> hostname_prober_;
   BraveVPNConnectionInfo connection_info_;
   bool cancel_connecting_ = false;
   mojom::ConnectionState connection_state_ =
@@ -6,6 +6,7 @@
 #include "brave/components/brave_vpn/brave_vpn_service_helper.h"
 
 #include <algorithm>
+#include <limits>
 
 #include "base/base64.h"
 #include "base/notreached.h"
@@ -86,24 +87,62 @@ base::Value GetValueFromRegion(const mojom::Region& region) {
 }
 
 std::unique_ptr<Hostname> PickBestHostname(
-    const std::vector<Hostname>& hostnames) {
+    const std::vector<Hostname>& hostnames,
+    const base::flat_map<std::string, base::TimeDelta>& latencies) {
   std::vector<Hostname> filtered_hostnames;
   std::copy_if(hostnames.begin(), hostnames.end(),
                std::back_inserter(filtered_hostnames),
                [](const Hostname& hostname) { return !hostname.is_offline; });
 
-  std::sort(filtered_hostnames.begin(), filtered_hostnames.end(),
-            [](const Hostname& a, const Hostname& b) {
-              return a.capacity_score > b.capacity_score;
-            });
+  // Latencies are compared in coarse steps, so that measurement noise doesn't
+  // outweigh the capacity score. Hostnames which weren't probed come last.
+  constexpr base::TimeDelta kLatencyStep = base::Milliseconds(25);
+  auto latency_step = [&latencies](const Hostname& hostname) -> int64_t {
+    auto iter = latencies.find(hostname.hostname);
+    if (iter == latencies.end())
+      return std::numeric_limits<int64_t>::max();
+    return iter->second.IntDiv(kLatencyStep);
+  };
+
+  std::stable_sort(filtered_hostnames.begin(), filtered_hostnames.end(),
+                   [&latency_step](const Hostname& a, const Hostname& b) {
+                     const int64_t a_step = latency_step(a);
+                     const int64_t b_step = latency_step(b);
+                     if (a_step != b_step)
+                       return a_step < b_step;
+                     return a.capacity_score > b.capacity_score;
+                   });
 
   if (filtered_hostnames.empty())
     return std::make_unique<Hostname>();
 
-  // Pick highest capacity score.
+  // Pick the fastest one, or the highest capacity score among equally fast
+  // ones.
   return std::make_unique<Hostname>(filtered_hostnames[0]);
 }
 
+std::vector<std::string> GetHostnamesToProbe(
+    const std::vector<Hostname>& hostnames) {
+  std::vector<Hostname> filtered_hostnames;
+  std::copy_if(hostnames.begin(), hostnames.end(),
+               std::back_inserter(filtered_hostnames),
+               [](const Hostname& hostname) { return !hostname.is_offline; });
+
+  std::stable_sort(filtered_hostnames.begin(), filtered_hostnames.end(),
+                   [](const Hostname& a, const Hostname& b) {
+                     return a.capacity_score > b.capacity_score;
+                   });
+
+  constexpr size_t kMaxHostnamesToProbe = 5;
+  std::vector<std::string> hostnames_to_probe;
+  for (const auto& hostname : filtered_hostnames) {
+    if (hostnames_to_probe.size() == kMaxHostnamesToProbe)
+      break;
+    hostnames_to_probe.push_back(hostname.hostname);
+  }
+  return hostnames_to_probe;
+}
+
 std::vector<Hostname> ParseHostnames(const base::Value::List& hostnames_value) {
   std::vector<Hostname> hostnames;
   for (const auto& value : hostnames_value) {
@@ -10,6 +10,8 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/time/time.h"
 #include "base/values.h"
 #include "brave/components/brave_vpn/mojom/brave_vpn.mojom.h"
 
@@ -21,7 +23,13 @@ bool ValidateCachedRegionData(const base::Value::List& region_value);
 std::string GetBraveVPNPaymentsEnv(const std::string& env);
 
 base::Value GetValueFromRegion(const mojom::Region& region);
+// Picks the online hostname with the lowest probed latency, preferring the
+// highest capacity score among equally fast ones.
 std::unique_ptr<Hostname> PickBestHostname(
+    const std::vector<Hostname>& hostnames,
+    const base::flat_map<std::string, base::TimeDelta>& latencies = {});
+// Returns the online hostnames with the highest capacity scores.
+std::vector<std::string> GetHostnamesToProbe(
     const std::vector<Hostname>& hostnames);
 std::vector<Hostname> ParseHostnames(const base::Value::List& hostnames);
 std::vector<mojom::Region> ParseRegionList(
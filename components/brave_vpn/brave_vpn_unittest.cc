@@ -238,6 +238,10 @@ class BraveVPNServiceTest : public testing::Test {
 
   std::unique_ptr<Hostname>& hostname() { return service_->hostname_; }
 
+  BraveVPNHostnameProber& hostname_prober() {
+    return *service_->hostname_prober_;
+  }
+
   bool& cancel_connecting() { return service_->cancel_connecting_; }
 
   ConnectionState& connection_state() { return service_->connection_state_; }
@@ -560,6 +564,78 @@ TEST_F(BraveVPNServiceTest, HostnamesTest) {
   EXPECT_FALSE(hostname());
 }
 
+TEST_F(BraveVPNServiceTest, PickFastestHostnameTest) {
+  absl::optional<base::Value> value =
+      base::JSONReader::Read(GetHostnamesData());
+  ASSERT_TRUE(value && value->is_list());
+  std::vector<Hostname> hostnames = ParseHostnames(value->GetList());
+
+  // Probed hostnames are preferred over not probed ones.
+  EXPECT_EQ("host-3.brave.com",
+            PickBestHostname(hostnames,
+                             {{"host-3.brave.com", base::Milliseconds(300)}})
+                ->hostname);
+
+  // Fastest hostname is picked.
+  EXPECT_EQ("host-4.brave.com",
+            PickBestHostname(hostnames,
+                             {{"host-2.brave.com", base::Milliseconds(300)},
+                              {"host-4.brave.com", base::Milliseconds(100)}})
+                ->hostname);
+
+  // Highest capacity score is picked among equally fast hostnames.
+  EXPECT_EQ("host-2.brave.com",
+            PickBestHostname(hostnames,
+                             {{"host-1.brave.com", base::Milliseconds(101)},
+                              {"host-2.brave.com", base::Milliseconds(102)}})
+                ->hostname);
+}
+
+TEST_F(BraveVPNServiceTest, HostnameProbeTest) {
+  skus_credential() = "test_credentials";
+  connection_state() = ConnectionState::CONNECTING;
+  OnFetchHostnames("region-a", GetHostnamesData(), true);
+  EXPECT_TRUE(hostname_prober().is_probing());
+
+  // Hostnames probed before the subscriber credential arrives are used to pick
+  // the hostname for the profile credential.
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(hostname_prober().is_probing());
+  EXPECT_TRUE(hostname_prober().latencies().contains("host-2.brave.com"));
+
+  OnGetSubscriberCredentialV12("subscriber_credential", true);
+  EXPECT_TRUE(hostname());
+}
+
+TEST_F(BraveVPNServiceTest, DoNotWaitForHostnameProbeTest) {
+  skus_credential() = "test_credentials";
+  connection_state() = ConnectionState::CONNECTING;
+  OnFetchHostnames("region-a", GetHostnamesData(), true);
+  EXPECT_TRUE(hostname_prober().is_probing());
+
+  // Outstanding probes are cancelled and the capacity pick is kept.
+  OnGetSubscriberCredentialV12("subscriber_credential", true);
+  EXPECT_FALSE(hostname_prober().is_probing());
+  EXPECT_EQ("host-2.brave.com", hostname()->hostname);
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(hostname_prober().latencies().empty());
+}
+
+TEST_F(BraveVPNServiceTest, CancelHostnameProbeWhenConnectedTest) {
+  skus_credential() = "test_credentials";
+  connection_state() = ConnectionState::CONNECTING;
+  OnFetchHostnames("region-a", GetHostnamesData(), true);
+  EXPECT_TRUE(hostname_prober().is_probing());
+
+  // Probes finishing through the tunnel are not measured.
+  UpdateAndNotifyConnectionStateChange(ConnectionState::CONNECTED);
+  EXPECT_FALSE(hostname_prober().is_probing());
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(hostname_prober().latencies().empty());
+}
+
 TEST_F(BraveVPNServiceTest, LoadPurchasedStateTest) {
   std::string env = skus::GetDefaultEnvironment();
   std::string domain = skus::GetDomain("vpn", env);
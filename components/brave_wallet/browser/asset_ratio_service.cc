@@ -10,9 +10,13 @@
 #include <utility>
 
 #include "base/base64.h"
+#include "base/containers/contains.h"
 #include "base/environment.h"
 #include "base/json/json_writer.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/ranges/algorithm.h"
 #include "base/strings/stringprintf.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/constants/brave_services_key.h"
 #include "net/base/load_flags.h"
@@ -84,6 +88,37 @@ std::string TimeFrameKeyToString(
   return timeframe_key;
 }
 
+// Result of looking up prices in the cache. Used for metrics so that the
+// values must not be renumbered.
+enum class PriceCacheResult {
+  kHit = 0,
+  kStaleHit = 1,
+  kMiss = 2,
+  kMaxValue = kMiss
+};
+
+void RecordPriceCacheResult(const char* histogram_name,
+                            PriceCacheResult result) {
+  base::UmaHistogramEnumeration(histogram_name, result);
+}
+
+std::string GetCacheKey(const std::string& asset,
+                        const std::string& vs_asset,
+                        brave_wallet::mojom::AssetPriceTimeframe timeframe) {
+  return asset + "/" + vs_asset + "/" + TimeFrameKeyToString(timeframe);
+}
+
+base::flat_map<std::string, std::string> GetPriceRequestHeaders() {
+  base::flat_map<std::string, std::string> request_headers;
+  std::unique_ptr<base::Environment> env(base::Environment::Create());
+  std::string brave_key(BUILDFLAG(BRAVE_SERVICES_KEY));
+  if (env->HasVar("BRAVE_SERVICES_KEY")) {
+    env->GetVar("BRAVE_SERVICES_KEY", &brave_key);
+  }
+  request_headers["x-brave-key"] = std::move(brave_key);
+  return request_headers;
+}
+
 std::vector<std::string> VectorToLowerCase(const std::vector<std::string>& v) {
   std::vector<std::string> v_lower(v.size());
   std::transform(v.begin(), v.end(), v_lower.begin(),
@@ -99,11 +134,40 @@ namespace brave_wallet {
 
 GURL AssetRatioService::base_url_for_test_;
 
+AssetRatioService::PriceRequest::PriceRequest(
+    std::vector<std::string> from_assets,
+    std::vector<std::string> to_assets,
+    GetPriceCallback callback)
+    : from_assets(std::move(from_assets)),
+      to_assets(std::move(to_assets)),
+      callback(std::move(callback)) {}
+AssetRatioService::PriceRequest::PriceRequest(PriceRequest&&) = default;
+AssetRatioService::PriceRequest& AssetRatioService::PriceRequest::operator=(
+    PriceRequest&&) = default;
+AssetRatioService::PriceRequest::~PriceRequest() = default;
+
+AssetRatioService::PriceBatch::PriceBatch() = default;
+AssetRatioService::PriceBatch::PriceBatch(PriceBatch&&) = default;
+AssetRatioService::PriceBatch& AssetRatioService::PriceBatch::operator=(
+    PriceBatch&&) = default;
+AssetRatioService::PriceBatch::~PriceBatch() = default;
+
+AssetRatioService::CachedPriceHistory::CachedPriceHistory() = default;
+AssetRatioService::CachedPriceHistory::CachedPriceHistory(
+    CachedPriceHistory&&) = default;
+AssetRatioService::CachedPriceHistory&
+AssetRatioService::CachedPriceHistory::operator=(CachedPriceHistory&&) =
+    default;
+AssetRatioService::CachedPriceHistory::~CachedPriceHistory() = default;
+
 AssetRatioService::AssetRatioService(
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
     : api_request_helper_(new api_request_helper::APIRequestHelper(
           GetNetworkTrafficAnnotationTag(),
           url_loader_factory)),
+      price_cache_(kMaxPriceCacheEntries),
+      price_history_cache_(kMaxPriceHistoryCacheEntries),
+      token_info_cache_(kMaxTokenInfoCacheEntries),
       weak_ptr_factory_(this) {}
 
 AssetRatioService::~AssetRatioService() {}
@@ -237,21 +301,126 @@ void AssetRatioService::GetPrice(
     GetPriceCallback callback) {
   std::vector<std::string> from_assets_lower = VectorToLowerCase(from_assets);
   std::vector<std::string> to_assets_lower = VectorToLowerCase(to_assets);
-  auto internal_callback = base::BindOnce(
-      &AssetRatioService::OnGetPrice, weak_ptr_factory_.GetWeakPtr(),
-      from_assets_lower, to_assets_lower, std::move(callback));
 
-  base::flat_map<std::string, std::string> request_headers;
-  std::unique_ptr<base::Environment> env(base::Environment::Create());
-  std::string brave_key(BUILDFLAG(BRAVE_SERVICES_KEY));
-  if (env->HasVar("BRAVE_SERVICES_KEY")) {
-    env->GetVar("BRAVE_SERVICES_KEY", &brave_key);
+  std::vector<brave_wallet::mojom::AssetPricePtr> prices;
+  bool stale = false;
+  if (GetCachedPrices(from_assets_lower, to_assets_lower, timeframe, &prices,
+                      &stale)) {
+    RecordPriceCacheResult(
+        "Brave.Wallet.AssetRatio.PriceCacheResult",
+        stale ? PriceCacheResult::kStaleHit : PriceCacheResult::kHit);
+    if (stale) {
+      QueuePriceRequest(from_assets_lower, to_assets_lower, timeframe,
+                        base::DoNothing());
+    }
+    std::move(callback).Run(true, std::move(prices));
+    return;
   }
-  request_headers["x-brave-key"] = std::move(brave_key);
 
-  api_request_helper_->Request(
-      "GET", GetPriceURL(from_assets_lower, to_assets_lower, timeframe), "", "",
-      true, std::move(internal_callback), request_headers);
+  RecordPriceCacheResult("Brave.Wallet.AssetRatio.PriceCacheResult",
+                         PriceCacheResult::kMiss);
+  QueuePriceRequest(std::move(from_assets_lower), std::move(to_assets_lower),
+                    timeframe, std::move(callback));
+}
+
+bool AssetRatioService::GetCachedPrices(
+    const std::vector<std::string>& from_assets,
+    const std::vector<std::string>& to_assets,
+    mojom::AssetPriceTimeframe timeframe,
+    std::vector<mojom::AssetPricePtr>* prices,
+    bool* stale) {
+  DCHECK(prices);
+  DCHECK(stale);
+  if (from_assets.empty() || to_assets.empty()) {
+    return false;
+  }
+
+  const base::TimeTicks now = base::TimeTicks::Now();
+  std::vector<mojom::AssetPricePtr> cached_prices;
+  *stale = false;
+  // Same order as ParseAssetPrice.
+  for (const auto& from_asset : from_assets) {
+    for (const auto& to_asset : to_assets) {
+      const auto iter =
+          price_cache_.Get(GetCacheKey(from_asset, to_asset, timeframe));
+      if (iter == price_cache_.end()) {
+        return false;
+      }
+
+      const base::TimeDelta age = now - iter->second.fetched_at;
+      if (age >= kPriceStaleTtl) {
+        return false;
+      }
+      if (age >= kPriceCacheTtl) {
+        *stale = true;
+      }
+      cached_prices.push_back(iter->second.price.Clone());
+    }
+  }
+
+  *prices = std::move(cached_prices);
+  return true;
+}
+
+void AssetRatioService::QueuePriceRequest(
+    std::vector<std::string> from_assets,
+    std::vector<std::string> to_assets,
+    mojom::AssetPriceTimeframe timeframe,
+    GetPriceCallback callback) {
+  // Share a request which is already on its way and covers all the prices.
+  for (auto& [batch_id, batch] : in_flight_price_batches_) {
+    if (batch.timeframe == timeframe &&
+        base::ranges::all_of(from_assets,
+                             [&batch](const std::string& asset) {
+                               return base::Contains(batch.from_assets, asset);
+                             }) &&
+        base::ranges::all_of(to_assets, [&batch](const std::string& asset) {
+          return base::Contains(batch.to_assets, asset);
+        })) {
+      batch.requests.emplace_back(std::move(from_assets), std::move(to_assets),
+                                  std::move(callback));
+      return;
+    }
+  }
+
+  // Otherwise combine it with the other calls made in the same task into a
+  // single multi-asset request.
+  PriceBatch& batch = pending_price_batches_[timeframe];
+  if (batch.requests.empty()) {
+    batch.timeframe = timeframe;
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&AssetRatioService::SendPriceBatch,
+                                  weak_ptr_factory_.GetWeakPtr(), timeframe));
+  }
+  batch.from_assets.insert(from_assets.begin(), from_assets.end());
+  batch.to_assets.insert(to_assets.begin(), to_assets.end());
+  batch.requests.emplace_back(std::move(from_assets), std::move(to_assets),
+                              std::move(callback));
+}
+
+void AssetRatioService::SendPriceBatch(mojom::AssetPriceTimeframe timeframe) {
+  auto iter = pending_price_batches_.find(timeframe);
+  if (iter == pending_price_batches_.end()) {
+    return;
+  }
+
+  PriceBatch batch = std::move(iter->second);
+  pending_price_batches_.erase(iter);
+
+  const std::vector<std::string> from_assets(batch.from_assets.begin(),
+                                             batch.from_assets.end());
+  const std::vector<std::string> to_assets(batch.to_assets.begin(),
+                                           batch.to_assets.end());
+  const uint64_t batch_id = next_price_batch_id_++;
+  in_flight_price_batches_.emplace(batch_id, std::move(batch));
+
+  auto internal_callback =
+      base::BindOnce(&AssetRatioService::OnGetPrice,
+                     weak_ptr_factory_.GetWeakPtr(), batch_id);
+  api_request_helper_->Request("GET",
+                               GetPriceURL(from_assets, to_assets, timeframe),
+                               "", "", true, std::move(internal_callback),
+                               GetPriceRequestHeaders());
 }
 
 void AssetRatioService::OnGetSardineAuthToken(
@@ -281,23 +450,41 @@ void AssetRatioService::OnGetSardineAuthToken(
 }
 
 void AssetRatioService::OnGetPrice(
-    std::vector<std::string> from_assets,
-    std::vector<std::string> to_assets,
-    GetPriceCallback callback,
+    uint64_t batch_id,
     const int status,
     const std::string& body,
     const base::flat_map<std::string, std::string>& headers) {
-  std::vector<brave_wallet::mojom::AssetPricePtr> prices;
-  if (status < 200 || status > 299) {
-    std::move(callback).Run(false, std::move(prices));
-    return;
-  }
-  if (!ParseAssetPrice(body, from_assets, to_assets, &prices)) {
-    std::move(callback).Run(false, std::move(prices));
+  auto iter = in_flight_price_batches_.find(batch_id);
+  if (iter == in_flight_price_batches_.end()) {
     return;
   }
 
-  std::move(callback).Run(true, std::move(prices));
+  PriceBatch batch = std::move(iter->second);
+  in_flight_price_batches_.erase(iter);
+
+  base::UmaHistogramCounts100("Brave.Wallet.AssetRatio.PriceBatchRequestCount",
+                              batch.requests.size());
+
+  const bool success = status >= 200 && status <= 299;
+  const base::TimeTicks now = base::TimeTicks::Now();
+  for (auto& request : batch.requests) {
+    // Parse per request so that an asset missing from the response only fails
+    // the callers which asked for it.
+    std::vector<brave_wallet::mojom::AssetPricePtr> prices;
+    if (!success || !ParseAssetPrice(body, request.from_assets,
+                                     request.to_assets, &prices)) {
+      std::move(request.callback)
+          .Run(false, std::vector<brave_wallet::mojom::AssetPricePtr>());
+      continue;
+    }
+
+    for (const auto& price : prices) {
+      price_cache_.Put(GetCacheKey(price->from_asset, price->to_asset,
+                                   batch.timeframe),
+                       CachedPrice{now, price.Clone()});
+    }
+    std::move(request.callback).Run(true, std::move(prices));
+  }
 }
 
 void AssetRatioService::GetPriceHistory(
@@ -307,30 +494,92 @@ void AssetRatioService::GetPriceHistory(
     GetPriceHistoryCallback callback) {
   std::string asset_lower = base::ToLowerASCII(asset);
   std::string vs_asset_lower = base::ToLowerASCII(vs_asset);
+
+  const auto iter = price_history_cache_.Get(
+      GetCacheKey(asset_lower, vs_asset_lower, timeframe));
+  if (iter != price_history_cache_.end()) {
+    const base::TimeDelta age =
+        base::TimeTicks::Now() - iter->second.fetched_at;
+    if (age < kPriceHistoryStaleTtl) {
+      const bool stale = age >= kPriceHistoryCacheTtl;
+      RecordPriceCacheResult(
+          "Brave.Wallet.AssetRatio.PriceHistoryCacheResult",
+          stale ? PriceCacheResult::kStaleHit : PriceCacheResult::kHit);
+      std::vector<brave_wallet::mojom::AssetTimePricePtr> values;
+      for (const auto& value : iter->second.values) {
+        values.push_back(value.Clone());
+      }
+      if (stale) {
+        RequestPriceHistory(asset_lower, vs_asset_lower, timeframe,
+                            base::DoNothing());
+      }
+      std::move(callback).Run(true, std::move(values));
+      return;
+    }
+  }
+
+  RecordPriceCacheResult("Brave.Wallet.AssetRatio.PriceHistoryCacheResult",
+                         PriceCacheResult::kMiss);
+  RequestPriceHistory(asset_lower, vs_asset_lower, timeframe,
+                      std::move(callback));
+}
+
+void AssetRatioService::RequestPriceHistory(
+    const std::string& asset,
+    const std::string& vs_asset,
+    mojom::AssetPriceTimeframe timeframe,
+    GetPriceHistoryCallback callback) {
+  const std::string cache_key = GetCacheKey(asset, vs_asset, timeframe);
+  auto& callbacks = in_flight_price_history_requests_[cache_key];
+  callbacks.push_back(std::move(callback));
+  if (callbacks.size() > 1) {
+    return;
+  }
+
   auto internal_callback =
       base::BindOnce(&AssetRatioService::OnGetPriceHistory,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(callback));
+                     weak_ptr_factory_.GetWeakPtr(), cache_key);
   api_request_helper_->Request(
-      "GET", GetPriceHistoryURL(asset_lower, vs_asset_lower, timeframe), "", "",
-      true, std::move(internal_callback));
+      "GET", GetPriceHistoryURL(asset, vs_asset, timeframe), "", "", true,
+      std::move(internal_callback));
 }
 
 void AssetRatioService::OnGetPriceHistory(
-    GetPriceHistoryCallback callback,
+    const std::string& cache_key,
     const int status,
     const std::string& body,
     const base::flat_map<std::string, std::string>& headers) {
-  std::vector<brave_wallet::mojom::AssetTimePricePtr> values;
-  if (status < 200 || status > 299) {
-    std::move(callback).Run(false, std::move(values));
+  auto iter = in_flight_price_history_requests_.find(cache_key);
+  if (iter == in_flight_price_history_requests_.end()) {
     return;
   }
-  if (!ParseAssetPriceHistory(body, &values)) {
-    std::move(callback).Run(false, std::move(values));
+
+  std::vector<GetPriceHistoryCallback> callbacks = std::move(iter->second);
+  in_flight_price_history_requests_.erase(iter);
+
+  std::vector<brave_wallet::mojom::AssetTimePricePtr> values;
+  if (status < 200 || status > 299 || !ParseAssetPriceHistory(body, &values)) {
+    for (auto& callback : callbacks) {
+      std::move(callback).Run(
+          false, std::vector<brave_wallet::mojom::AssetTimePricePtr>());
+    }
     return;
   }
 
-  std::move(callback).Run(true, std::move(values));
+  CachedPriceHistory cached;
+  cached.fetched_at = base::TimeTicks::Now();
+  for (const auto& value : values) {
+    cached.values.push_back(value.Clone());
+  }
+  price_history_cache_.Put(cache_key, std::move(cached));
+
+  for (auto& callback : callbacks) {
+    std::vector<brave_wallet::mojom::AssetTimePricePtr> callback_values;
+    for (const auto& value : values) {
+      callback_values.push_back(value.Clone());
+    }
+    std::move(callback).Run(true, std::move(callback_values));
+  }
 }
 
 // static
@@ -346,25 +595,51 @@ GURL AssetRatioService::GetTokenInfoURL(const std::string& contract_address) {
 
 void AssetRatioService::GetTokenInfo(const std::string& contract_address,
                                      GetTokenInfoCallback callback) {
+  const std::string contract_address_lower =
+      base::ToLowerASCII(contract_address);
+  const auto iter = token_info_cache_.Get(contract_address_lower);
+  if (iter != token_info_cache_.end()) {
+    std::move(callback).Run(iter->second.Clone());
+    return;
+  }
+
+  auto& callbacks = in_flight_token_info_requests_[contract_address_lower];
+  callbacks.push_back(std::move(callback));
+  if (callbacks.size() > 1) {
+    return;
+  }
+
   auto internal_callback =
       base::BindOnce(&AssetRatioService::OnGetTokenInfo,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  api_request_helper_->Request("GET", GetTokenInfoURL(contract_address), "", "",
-                               true, std::move(internal_callback));
+                     weak_ptr_factory_.GetWeakPtr(), contract_address_lower);
+  api_request_helper_->Request("GET", GetTokenInfoURL(contract_address_lower),
+                               "", "", true, std::move(internal_callback));
 }
 
 void AssetRatioService::OnGetTokenInfo(
-    GetTokenInfoCallback callback,
+    const std::string& contract_address,
     const int status,
     const std::string& body,
     const base::flat_map<std::string, std::string>& headers) {
-  if (status < 200 || status > 299) {
-    std::move(callback).Run(nullptr);
+  auto iter = in_flight_token_info_requests_.find(contract_address);
+  if (iter == in_flight_token_info_requests_.end()) {
     return;
   }
 
-  std::move(callback).Run(
-      ParseTokenInfo(body, mojom::kMainnetChainId, mojom::CoinType::ETH));
+  std::vector<GetTokenInfoCallback> callbacks = std::move(iter->second);
+  in_flight_token_info_requests_.erase(iter);
+
+  mojom::BlockchainTokenPtr token;
+  if (status >= 200 && status <= 299) {
+    token = ParseTokenInfo(body, mojom::kMainnetChainId, mojom::CoinType::ETH);
+  }
+  if (token) {
+    token_info_cache_.Put(contract_address, token.Clone());
+  }
+
+  for (auto& callback : callbacks) {
+    std::move(callback).Run(token.Clone());
+  }
 }
 
 }  // namespace brave_wallet
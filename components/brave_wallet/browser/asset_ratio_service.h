@@ -6,12 +6,15 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ASSET_RATIO_SERVICE_H_
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ASSET_RATIO_SERVICE_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "base/callback.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
+#include "base/containers/lru_cache.h"
 #include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
@@ -85,7 +88,78 @@ class AssetRatioService : public KeyedService, public mojom::AssetRatioService {
   void SetAPIRequestHelperForTesting(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
 
+  // Prices are served from the cache for |kPriceCacheTtl|. Older prices, up
+  // to |kPriceStaleTtl|, are still served but trigger a refresh.
+  static constexpr base::TimeDelta kPriceCacheTtl = base::Minutes(1);
+  static constexpr base::TimeDelta kPriceStaleTtl = base::Minutes(10);
+  static constexpr base::TimeDelta kPriceHistoryCacheTtl = base::Minutes(5);
+  static constexpr base::TimeDelta kPriceHistoryStaleTtl = base::Hours(1);
+  // The least recently used entries are evicted beyond these sizes.
+  static constexpr size_t kMaxPriceCacheEntries = 256;
+  static constexpr size_t kMaxPriceHistoryCacheEntries = 32;
+  static constexpr size_t kMaxTokenInfoCacheEntries = 64;
+
  private:
+  // A GetPrice call waiting on the network.
+  struct PriceRequest {
+    PriceRequest(std::vector<std::string> from_assets,
+                 std::vector<std::string> to_assets,
+                 GetPriceCallback callback);
+    PriceRequest(PriceRequest&&);
+    PriceRequest& operator=(PriceRequest&&);
+    ~PriceRequest();
+
+    std::vector<std::string> from_assets;
+    std::vector<std::string> to_assets;
+    GetPriceCallback callback;
+  };
+
+  // Price requests for one timeframe which are fetched together using a
+  // single multi-asset request.
+  struct PriceBatch {
+    PriceBatch();
+    PriceBatch(PriceBatch&&);
+    PriceBatch& operator=(PriceBatch&&);
+    ~PriceBatch();
+
+    mojom::AssetPriceTimeframe timeframe = mojom::AssetPriceTimeframe::Live;
+    base::flat_set<std::string> from_assets;
+    base::flat_set<std::string> to_assets;
+    std::vector<PriceRequest> requests;
+  };
+
+  struct CachedPrice {
+    base::TimeTicks fetched_at;
+    mojom::AssetPricePtr price;
+  };
+
+  struct CachedPriceHistory {
+    CachedPriceHistory();
+    CachedPriceHistory(CachedPriceHistory&&);
+    CachedPriceHistory& operator=(CachedPriceHistory&&);
+    ~CachedPriceHistory();
+
+    base::TimeTicks fetched_at;
+    std::vector<mojom::AssetTimePricePtr> values;
+  };
+
+  // Returns false if any of the requested prices is missing or expired.
+  // |stale| is set if any of them should be refreshed.
+  bool GetCachedPrices(const std::vector<std::string>& from_assets,
+                       const std::vector<std::string>& to_assets,
+                       mojom::AssetPriceTimeframe timeframe,
+                       std::vector<mojom::AssetPricePtr>* prices,
+                       bool* stale);
+  void QueuePriceRequest(std::vector<std::string> from_assets,
+                         std::vector<std::string> to_assets,
+                         mojom::AssetPriceTimeframe timeframe,
+                         GetPriceCallback callback);
+  void SendPriceBatch(mojom::AssetPriceTimeframe timeframe);
+  void RequestPriceHistory(const std::string& asset,
+                           const std::string& vs_asset,
+                           mojom::AssetPriceTimeframe timeframe,
+                           GetPriceHistoryCallback callback);
+
   void OnGetSardineAuthToken(
       const std::string& network,
       const std::string& address,
@@ -97,19 +171,17 @@ class AssetRatioService : public KeyedService, public mojom::AssetRatioService {
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
 
-  void OnGetPrice(std::vector<std::string> from_assets,
-                  std::vector<std::string> to_assets,
-                  GetPriceCallback callback,
+  void OnGetPrice(uint64_t batch_id,
                   const int status,
                   const std::string& body,
                   const base::flat_map<std::string, std::string>& headers);
   void OnGetPriceHistory(
-      GetPriceHistoryCallback callback,
+      const std::string& cache_key,
       const int status,
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
 
-  void OnGetTokenInfo(GetTokenInfoCallback callback,
+  void OnGetTokenInfo(const std::string& contract_address,
                       const int status,
                       const std::string& body,
                       const base::flat_map<std::string, std::string>& headers);
@@ -118,6 +190,24 @@ class AssetRatioService : public KeyedService, public mojom::AssetRatioService {
 
   static GURL base_url_for_test_;
   std::unique_ptr<api_request_helper::APIRequestHelper> api_request_helper_;
+
+  // Keyed by "<from>/<to>/<timeframe>".
+  base::LRUCache<std::string, CachedPrice> price_cache_;
+  base::flat_map<mojom::AssetPriceTimeframe, PriceBatch> pending_price_batches_;
+  std::map<uint64_t, PriceBatch> in_flight_price_batches_;
+  uint64_t next_price_batch_id_ = 0;
+
+  // Keyed by "<asset>/<vs_asset>/<timeframe>".
+  base::LRUCache<std::string, CachedPriceHistory> price_history_cache_;
+  std::map<std::string, std::vector<GetPriceHistoryCallback>>
+      in_flight_price_history_requests_;
+
+  // Keyed by lower case contract address. Token info doesn't change, so only
+  // successful lookups are cached and they don't expire.
+  base::LRUCache<std::string, mojom::BlockchainTokenPtr> token_info_cache_;
+  std::map<std::string, std::vector<GetTokenInfoCallback>>
+      in_flight_token_info_requests_;
+
   base::WeakPtrFactory<AssetRatioService> weak_ptr_factory_;
 };
 
@@ -6,7 +6,9 @@
 #include <memory>
 #include <utility>
 
+#include "base/strings/string_number_conversions.h"
 #include "base/test/bind.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/task_environment.h"
 #include "brave/components/brave_wallet/browser/asset_ratio_service.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
@@ -63,6 +65,7 @@ class AssetRatioServiceUnitTest : public testing::Test {
                       const std::string expected_header = "") {
     url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
         [&, content, expected_header](const network::ResourceRequest& request) {
+          request_count_++;
           url_loader_factory_.ClearResponses();
           std::string header;
           request.headers.GetHeader("Authorization", &header);
@@ -113,10 +116,12 @@ class AssetRatioServiceUnitTest : public testing::Test {
   }
 
  protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
   std::unique_ptr<AssetRatioService> asset_ratio_service_;
+  size_t request_count_ = 0;
 
  private:
-  base::test::TaskEnvironment task_environment_;
   network::TestURLLoaderFactory url_loader_factory_;
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
   data_decoder::test::InProcessDataDecoder in_process_data_decoder_;
@@ -284,6 +289,210 @@ TEST_F(AssetRatioServiceUnitTest, GetPriceUnexpectedResponse) {
   EXPECT_TRUE(callback_run);
 }
 
+TEST_F(AssetRatioServiceUnitTest, GetPriceCached) {
+  SetInterceptor(R"(
+      {
+        "payload":{
+          "bat":{"usd":0.55393, "usd_timeframe_change":9.523443444373276}
+        }
+      })");
+
+  for (int i = 0; i < 2; i++) {
+    bool callback_run = false;
+    asset_ratio_service_->GetPrice(
+        {"bat"}, {"usd"}, brave_wallet::mojom::AssetPriceTimeframe::Live,
+        base::BindLambdaForTesting(
+            [&](bool success,
+                std::vector<brave_wallet::mojom::AssetPricePtr> values) {
+              EXPECT_TRUE(success);
+              ASSERT_EQ(values.size(), 1u);
+              EXPECT_EQ(values[0]->price, "0.55393");
+              callback_run = true;
+            }));
+    base::RunLoop().RunUntilIdle();
+    EXPECT_TRUE(callback_run);
+  }
+  EXPECT_EQ(request_count_, 1u);
+
+  // Stale prices are served while they are refreshed.
+  task_environment_.FastForwardBy(AssetRatioService::kPriceCacheTtl);
+  bool callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat"}, {"usd"}, brave_wallet::mojom::AssetPriceTimeframe::Live,
+      base::BindLambdaForTesting(
+          [&](bool success,
+              std::vector<brave_wallet::mojom::AssetPricePtr> values) {
+            EXPECT_TRUE(success);
+            callback_run = true;
+          }));
+  EXPECT_TRUE(callback_run);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(request_count_, 2u);
+
+  // Expired prices are fetched again.
+  task_environment_.FastForwardBy(AssetRatioService::kPriceStaleTtl);
+  callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat"}, {"usd"}, brave_wallet::mojom::AssetPriceTimeframe::Live,
+      base::BindLambdaForTesting(
+          [&](bool success,
+              std::vector<brave_wallet::mojom::AssetPricePtr> values) {
+            EXPECT_TRUE(success);
+            callback_run = true;
+          }));
+  EXPECT_FALSE(callback_run);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_run);
+  EXPECT_EQ(request_count_, 3u);
+
+  // Other timeframes are cached separately.
+  SetInterceptor("{}");
+  callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"bat"}, {"usd"}, brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindOnce(&OnGetPrice, &callback_run, false,
+                     std::vector<brave_wallet::mojom::AssetPricePtr>()));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(callback_run);
+  EXPECT_EQ(request_count_, 4u);
+}
+
+TEST_F(AssetRatioServiceUnitTest, GetPriceCoalescesRequests) {
+  base::HistogramTester histogram_tester;
+  SetInterceptor(R"(
+      {
+        "payload":{
+          "bat":{"usd":0.55393, "usd_timeframe_change":9.523443444373276},
+          "link":{"usd":83.77, "usd_timeframe_change":1.7646208048244043}
+        }
+      })");
+
+  // Concurrent single asset calls share one multi-asset request.
+  std::vector<std::string> prices;
+  for (const std::string asset : {"bat", "link", "bat"}) {
+    asset_ratio_service_->GetPrice(
+        {asset}, {"usd"}, brave_wallet::mojom::AssetPriceTimeframe::Live,
+        base::BindLambdaForTesting(
+            [&](bool success,
+                std::vector<brave_wallet::mojom::AssetPricePtr> values) {
+              EXPECT_TRUE(success);
+              ASSERT_EQ(values.size(), 1u);
+              prices.push_back(values[0]->price);
+            }));
+  }
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(prices,
+            std::vector<std::string>({"0.55393", "83.77", "0.55393"}));
+  EXPECT_EQ(request_count_, 1u);
+  histogram_tester.ExpectUniqueSample(
+      "Brave.Wallet.AssetRatio.PriceBatchRequestCount", 3, 1);
+
+  // An asset missing from the response only fails the calls asking for it.
+  SetInterceptor(R"(
+      {
+        "payload":{
+          "eth":{"usd":2000, "usd_timeframe_change":1}
+        }
+      })");
+  bool eth_callback_run = false;
+  bool btc_callback_run = false;
+  asset_ratio_service_->GetPrice(
+      {"ETH"}, {"usd"}, brave_wallet::mojom::AssetPriceTimeframe::Live,
+      base::BindLambdaForTesting(
+          [&](bool success,
+              std::vector<brave_wallet::mojom::AssetPricePtr> values) {
+            EXPECT_TRUE(success);
+            eth_callback_run = true;
+          }));
+  asset_ratio_service_->GetPrice(
+      {"btc"}, {"usd"}, brave_wallet::mojom::AssetPriceTimeframe::Live,
+      base::BindOnce(&OnGetPrice, &btc_callback_run, false,
+                     std::vector<brave_wallet::mojom::AssetPricePtr>()));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(eth_callback_run);
+  EXPECT_TRUE(btc_callback_run);
+  EXPECT_EQ(request_count_, 2u);
+}
+
+TEST_F(AssetRatioServiceUnitTest, GetPriceCacheIsBounded) {
+  std::string payload;
+  std::vector<std::string> assets;
+  for (size_t i = 0; i <= AssetRatioService::kMaxPriceCacheEntries; i++) {
+    const std::string asset = "asset" + base::NumberToString(i);
+    payload += (i ? "," : "") + ("\"" + asset) +
+               "\":{\"usd\":1, \"usd_timeframe_change\":1}";
+    assets.push_back(asset);
+  }
+  SetInterceptor("{\"payload\":{" + payload + "}}");
+
+  auto get_price = [&](const std::vector<std::string>& from_assets) {
+    bool callback_run = false;
+    asset_ratio_service_->GetPrice(
+        from_assets, {"usd"}, brave_wallet::mojom::AssetPriceTimeframe::Live,
+        base::BindLambdaForTesting(
+            [&](bool success,
+                std::vector<brave_wallet::mojom::AssetPricePtr> values) {
+              EXPECT_TRUE(success);
+              EXPECT_EQ(values.size(), from_assets.size());
+              callback_run = true;
+            }));
+    base::RunLoop().RunUntilIdle();
+    EXPECT_TRUE(callback_run);
+  };
+
+  get_price({assets.front()});
+  get_price({assets.back()});
+  EXPECT_EQ(request_count_, 2u);
+
+  // Caching one price more than the cache holds evicts the least recently
+  // used one.
+  get_price(std::vector<std::string>(assets.begin() + 1, assets.end()));
+  EXPECT_EQ(request_count_, 3u);
+  get_price({assets.back()});
+  EXPECT_EQ(request_count_, 3u);
+  get_price({assets.front()});
+  EXPECT_EQ(request_count_, 4u);
+}
+
+TEST_F(AssetRatioServiceUnitTest, GetPriceHistoryCached) {
+  SetInterceptor(R"({
+    "payload": {
+      "prices":[[1622733088498,0.8201346624954003]],
+      "market_caps":[[1622733088498,1223507580.6431894]],
+      "total_volumes":[[1622733088498,163426906.34500873]]
+    }
+  })");
+
+  int callbacks_run = 0;
+  for (int i = 0; i < 2; i++) {
+    asset_ratio_service_->GetPriceHistory(
+        "bat", "usd", brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+        base::BindLambdaForTesting(
+            [&](bool success,
+                std::vector<brave_wallet::mojom::AssetTimePricePtr> values) {
+              EXPECT_TRUE(success);
+              EXPECT_EQ(values.size(), 1u);
+              callbacks_run++;
+            }));
+  }
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(callbacks_run, 2);
+  EXPECT_EQ(request_count_, 1u);
+
+  asset_ratio_service_->GetPriceHistory(
+      "BAT", "USD", brave_wallet::mojom::AssetPriceTimeframe::OneDay,
+      base::BindLambdaForTesting(
+          [&](bool success,
+              std::vector<brave_wallet::mojom::AssetTimePricePtr> values) {
+            EXPECT_TRUE(success);
+            EXPECT_EQ(values.size(), 1u);
+            callbacks_run++;
+          }));
+  EXPECT_EQ(callbacks_run, 3);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(request_count_, 1u);
+}
+
 TEST_F(AssetRatioServiceUnitTest, GetPriceHistory) {
   SetInterceptor(R"({
       "payload": {
@@ -392,6 +601,13 @@ TEST_F(AssetRatioServiceUnitTest, GetTokenInfoURL) {
 }
 
 TEST_F(AssetRatioServiceUnitTest, GetTokenInfo) {
+  // Failed lookups are not cached.
+  SetInterceptor("unexpected response");
+  GetTokenInfo("0xdac17f958d2ee523a2206206994597c13d831ec7", nullptr);
+
+  SetErrorInterceptor("error");
+  GetTokenInfo("0xdac17f958d2ee523a2206206994597c13d831ec7", nullptr);
+
   SetInterceptor(R"(
     {
       "payload": {
@@ -431,12 +647,49 @@ TEST_F(AssetRatioServiceUnitTest, GetTokenInfo) {
       mojom::BlockchainToken::New("0xdAC17F958D2ee523a2206206994597C13D831ec7",
                                   "Tether USD", "", true, false, "USDT", 6,
                                   true, "", "", "0x1", mojom::CoinType::ETH));
+  EXPECT_EQ(request_count_, 2u);
 
-  SetInterceptor("unexpected response");
-  GetTokenInfo("0xdac17f958d2ee523a2206206994597c13d831ec7", nullptr);
-
+  // Successful lookups are served from the cache, whatever the case of the
+  // contract address.
   SetErrorInterceptor("error");
-  GetTokenInfo("0xdac17f958d2ee523a2206206994597c13d831ec7", nullptr);
+  GetTokenInfo(
+      "0xdAC17F958D2ee523a2206206994597C13D831ec7",
+      mojom::BlockchainToken::New("0xdAC17F958D2ee523a2206206994597C13D831ec7",
+                                  "Tether USD", "", true, false, "USDT", 6,
+                                  true, "", "", "0x1", mojom::CoinType::ETH));
+}
+
+TEST_F(AssetRatioServiceUnitTest, GetTokenInfoCoalescesRequests) {
+  SetInterceptor(R"(
+    {
+      "payload": {
+        "status": "1",
+        "message": "OK",
+        "result": [{
+          "contractAddress": "0xdac17f958d2ee523a2206206994597c13d831ec7",
+          "tokenName": "Tether USD",
+          "symbol": "USDT",
+          "divisor": "6",
+          "tokenType": "ERC20",
+          "blueCheckmark": "true"
+        }]
+      }
+    }
+  )");
+
+  int callback_count = 0;
+  for (int i = 0; i < 3; i++) {
+    asset_ratio_service_->GetTokenInfo(
+        "0xdac17f958d2ee523a2206206994597c13d831ec7",
+        base::BindLambdaForTesting([&](mojom::BlockchainTokenPtr token) {
+          ASSERT_TRUE(token);
+          EXPECT_EQ(token->symbol, "USDT");
+          callback_count++;
+        }));
+  }
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(callback_count, 3);
+  EXPECT_EQ(request_count_, 1u);
 }
 
 }  // namespace brave_wallet
@@ -22,4 +22,8 @@ bool BlockTracker::IsRunning() const {
   return timer_.IsRunning();
 }
 
+base::TimeDelta BlockTracker::GetInterval() const {
+  return timer_.GetCurrentDelay();
+}
+
 }  // namespace brave_wallet
@@ -713,6 +713,8 @@ constexpr char kSolanaFeeRecipient[] =
     "8eekKfUAGSJbq3CdA2TmHb8tKuyzd5gtEas3MYAtXzrT";
 
 constexpr int64_t kBlockTrackerDefaultTimeInSeconds = 20;
+// Lower bound of the polling interval adapted to a chain's block time.
+constexpr int64_t kBlockTrackerMinTimeInSeconds = 2;
 
 constexpr char kPolygonMainnetEndpoint[] = "https://mainnet-polygon.brave.com/";
 
@@ -5,6 +5,8 @@
 
 #include "brave/components/brave_wallet/browser/eth_block_tracker.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "base/bind.h"
@@ -24,6 +26,16 @@ void EthBlockTracker::Start(base::TimeDelta interval) {
                                    weak_factory_.GetWeakPtr()));
 }
 
+absl::optional<base::TimeDelta> EthBlockTracker::GetAverageBlockTime() const {
+  if (current_block_ <= first_block_)
+    return absl::nullopt;
+  const uint256_t blocks =
+      std::min(current_block_ - first_block_,
+               uint256_t(std::numeric_limits<int32_t>::max()));
+  return (current_block_time_ - first_block_time_) /
+         static_cast<int64_t>(blocks);
+}
+
 void EthBlockTracker::AddObserver(EthBlockTracker::Observer* observer) {
   observers_.AddObserver(observer);
 }
@@ -47,16 +59,30 @@ void EthBlockTracker::SendGetBlockNumber(
 }
 
 void EthBlockTracker::GetBlockNumber() {
+  // The network can change while the request is in flight, so the block is
+  // attributed to the chain it was requested from.
   json_rpc_service_->GetBlockNumber(base::BindOnce(
-      &EthBlockTracker::OnGetBlockNumber, weak_factory_.GetWeakPtr()));
+      &EthBlockTracker::OnGetBlockNumber, weak_factory_.GetWeakPtr(),
+      json_rpc_service_->GetChainId(mojom::CoinType::ETH)));
 }
 
-void EthBlockTracker::OnGetBlockNumber(uint256_t block_num,
+void EthBlockTracker::OnGetBlockNumber(const std::string& chain_id,
+                                       uint256_t block_num,
                                        mojom::ProviderError error,
                                        const std::string& error_message) {
   if (error == mojom::ProviderError::kSuccess) {
     if (current_block_ != block_num) {
+      const base::TimeTicks now = base::TimeTicks::Now();
+      // Start measuring the block time over again when the chain changed,
+      // since block numbers of different chains are unrelated.
+      if (first_block_time_.is_null() || chain_id != chain_id_ ||
+          block_num < current_block_) {
+        chain_id_ = chain_id;
+        first_block_ = block_num;
+        first_block_time_ = now;
+      }
       current_block_ = block_num;
+      current_block_time_ = now;
       for (auto& observer : observers_)
         observer.OnNewBlock(block_num);
     }
@@ -12,9 +12,11 @@
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
+#include "base/time/time.h"
 #include "brave/components/brave_wallet/browser/block_tracker.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_wallet {
 
@@ -43,6 +45,10 @@ class EthBlockTracker : public BlockTracker {
 
   uint256_t GetCurrentBlock() const { return current_block_; }
 
+  // Returns the average time between the blocks seen so far, once more than
+  // one was seen.
+  absl::optional<base::TimeDelta> GetAverageBlockTime() const;
+
   void CheckForLatestBlock(
       base::OnceCallback<void(uint256_t block_num,
                               mojom::ProviderError error,
@@ -54,11 +60,18 @@ class EthBlockTracker : public BlockTracker {
                               mojom::ProviderError error,
                               const std::string& error_message)>);
   void GetBlockNumber();
-  void OnGetBlockNumber(uint256_t block_num,
+  void OnGetBlockNumber(const std::string& chain_id,
+                        uint256_t block_num,
                         mojom::ProviderError error,
                         const std::string& error_message);
 
   uint256_t current_block_ = 0;
+  // The first block seen on |chain_id_| and when, and when |current_block_|
+  // was seen.
+  std::string chain_id_;
+  uint256_t first_block_ = 0;
+  base::TimeTicks first_block_time_;
+  base::TimeTicks current_block_time_;
   base::ObserverList<Observer> observers_;
 
   base::WeakPtrFactory<EthBlockTracker> weak_factory_;
@@ -155,6 +155,66 @@ TEST_F(EthBlockTrackerUnitTest, GetBlockNumber) {
   EXPECT_EQ(tracker.GetCurrentBlock(), uint256_t(3));
 }
 
+TEST_F(EthBlockTrackerUnitTest, GetAverageBlockTime) {
+  EthBlockTracker tracker(json_rpc_service_.get());
+  url_loader_factory_.SetInterceptor(
+      base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
+        url_loader_factory_.ClearResponses();
+        url_loader_factory_.AddResponse(request.url.spec(),
+                                        GetResponseString());
+      }));
+
+  response_block_num_ = 10;
+  tracker.Start(base::Seconds(5));
+  task_environment_.FastForwardBy(base::Seconds(5));
+  EXPECT_FALSE(tracker.GetAverageBlockTime());
+  task_environment_.FastForwardBy(base::Seconds(5));
+  EXPECT_FALSE(tracker.GetAverageBlockTime());
+
+  // Two blocks in 10 seconds.
+  response_block_num_ = 12;
+  task_environment_.FastForwardBy(base::Seconds(5));
+  EXPECT_EQ(tracker.GetAverageBlockTime(), base::Seconds(5));
+
+  response_block_num_ = 15;
+  task_environment_.FastForwardBy(base::Seconds(5));
+  EXPECT_EQ(tracker.GetAverageBlockTime(), base::Seconds(3));
+
+  // Going back, like when switching chains, starts measuring over again.
+  response_block_num_ = 2;
+  task_environment_.FastForwardBy(base::Seconds(5));
+  EXPECT_FALSE(tracker.GetAverageBlockTime());
+}
+
+TEST_F(EthBlockTrackerUnitTest, GetAverageBlockTimeAfterChainSwitchUp) {
+  EthBlockTracker tracker(json_rpc_service_.get());
+  url_loader_factory_.SetInterceptor(
+      base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
+        url_loader_factory_.ClearResponses();
+        url_loader_factory_.AddResponse(request.url.spec(),
+                                        GetResponseString());
+      }));
+
+  response_block_num_ = 10;
+  tracker.Start(base::Seconds(5));
+  task_environment_.FastForwardBy(base::Seconds(5));
+  response_block_num_ = 11;
+  task_environment_.FastForwardBy(base::Seconds(5));
+  EXPECT_EQ(tracker.GetAverageBlockTime(), base::Seconds(5));
+
+  // A chain with a much higher block number must not count the jump as
+  // blocks mined since the first one.
+  ASSERT_TRUE(json_rpc_service_->SetNetwork(mojom::kGoerliChainId,
+                                            mojom::CoinType::ETH));
+  response_block_num_ = 7000000;
+  task_environment_.FastForwardBy(base::Seconds(5));
+  EXPECT_FALSE(tracker.GetAverageBlockTime());
+
+  response_block_num_ = 7000001;
+  task_environment_.FastForwardBy(base::Seconds(5));
+  EXPECT_EQ(tracker.GetAverageBlockTime(), base::Seconds(5));
+}
+
 TEST_F(EthBlockTrackerUnitTest, GetBlockNumberInvalidResponseJSON) {
   EthBlockTracker tracker(json_rpc_service_.get());
   url_loader_factory_.SetInterceptor(
@@ -28,23 +28,42 @@ EthPendingTxTracker::EthPendingTxTracker(EthTxStateManager* tx_state_manager,
       weak_factory_(this) {}
 EthPendingTxTracker::~EthPendingTxTracker() = default;
 
-bool EthPendingTxTracker::UpdatePendingTransactions(size_t* num_pending) {
+bool EthPendingTxTracker::UpdatePendingTransactions(uint256_t block_num,
+                                                    size_t* num_pending) {
   base::Lock* nonce_lock = nonce_tracker_->GetLock();
   if (!nonce_lock->Try())
     return false;
 
+  if (block_num != checked_block_) {
+    checked_block_ = block_num;
+    checked_tx_ids_.clear();
+  }
+
+  UpdateConfirmedNonces();
   auto pending_transactions = tx_state_manager_->GetTransactionsByStatus(
       mojom::TransactionStatus::Submitted, absl::nullopt);
+  std::vector<std::string> ids;
+  std::vector<std::string> tx_hashes;
   for (const auto& pending_transaction : pending_transactions) {
     if (IsNonceTaken(static_cast<const EthTxMeta&>(*pending_transaction))) {
       DropTransaction(pending_transaction.get());
       continue;
     }
-    std::string id = pending_transaction->id();
-    json_rpc_service_->GetTransactionReceipt(
-        pending_transaction->tx_hash(),
-        base::BindOnce(&EthPendingTxTracker::OnGetTxReceipt,
-                       weak_factory_.GetWeakPtr(), std::move(id)));
+    // Receipts only change with new blocks.
+    if (checked_tx_ids_.contains(pending_transaction->id()))
+      continue;
+    ids.push_back(pending_transaction->id());
+    tx_hashes.push_back(pending_transaction->tx_hash());
+    // Marked when requested, so that updates at this block don't fetch them
+    // again while the request is in flight.
+    if (block_num != 0)
+      checked_tx_ids_.insert(pending_transaction->id());
+  }
+  if (!tx_hashes.empty()) {
+    json_rpc_service_->GetTransactionReceipts(
+        tx_hashes,
+        base::BindOnce(&EthPendingTxTracker::OnGetTxReceipts,
+                       weak_factory_.GetWeakPtr(), block_num, std::move(ids)));
   }
 
   nonce_lock->Release();
@@ -72,30 +91,44 @@ void EthPendingTxTracker::ResubmitPendingTransactions() {
 void EthPendingTxTracker::Reset() {
   network_nonce_map_.clear();
   dropped_blocks_counter_.clear();
+  confirmed_nonces_.clear();
+  checked_block_ = 0;
+  checked_tx_ids_.clear();
 }
 
-void EthPendingTxTracker::OnGetTxReceipt(std::string id,
-                                         TransactionReceipt receipt,
-                                         mojom::ProviderError error,
-                                         const std::string& error_message) {
-  if (error != mojom::ProviderError::kSuccess)
-    return;
+void EthPendingTxTracker::OnGetTxReceipts(
+    uint256_t block_num,
+    std::vector<std::string> ids,
+    std::vector<absl::optional<TransactionReceipt>> receipts,
+    mojom::ProviderError error,
+    const std::string& error_message) {
   base::Lock* nonce_lock = nonce_tracker_->GetLock();
-  if (!nonce_lock->Try())
-    return;
-
-  std::unique_ptr<EthTxMeta> meta = tx_state_manager_->GetEthTx(id);
-  if (!meta) {
-    nonce_lock->Release();
+  if (error != mojom::ProviderError::kSuccess || !nonce_lock->Try()) {
+    // Check them again on the next update.
+    if (block_num == checked_block_) {
+      for (const auto& id : ids)
+        checked_tx_ids_.erase(id);
+    }
     return;
   }
-  if (receipt.status) {
-    meta->set_tx_receipt(receipt);
-    meta->set_status(mojom::TransactionStatus::Confirmed);
-    meta->set_confirmed_time(base::Time::Now());
-    tx_state_manager_->AddOrUpdateTx(*meta);
-  } else if (ShouldTxDropped(*meta)) {
-    DropTransaction(meta.get());
+  DCHECK_EQ(ids.size(), receipts.size());
+
+  for (size_t i = 0; i < ids.size(); ++i) {
+    // Not mined yet.
+    if (!receipts[i])
+      continue;
+
+    std::unique_ptr<EthTxMeta> meta = tx_state_manager_->GetEthTx(ids[i]);
+    if (!meta)
+      continue;
+    if (receipts[i]->status) {
+      meta->set_tx_receipt(*receipts[i]);
+      meta->set_status(mojom::TransactionStatus::Confirmed);
+      meta->set_confirmed_time(base::Time::Now());
+      tx_state_manager_->AddOrUpdateTx(*meta);
+    } else if (ShouldTxDropped(*meta)) {
+      DropTransaction(meta.get());
+    }
   }
 
   nonce_lock->Release();
@@ -116,17 +149,27 @@ void EthPendingTxTracker::OnSendRawTransaction(
     mojom::ProviderError error,
     const std::string& error_message) {}
 
-bool EthPendingTxTracker::IsNonceTaken(const EthTxMeta& meta) {
+void EthPendingTxTracker::UpdateConfirmedNonces() {
+  std::vector<std::pair<std::string, uint256_t>> confirmed_nonces;
   auto confirmed_transactions = tx_state_manager_->GetTransactionsByStatus(
       mojom::TransactionStatus::Confirmed, absl::nullopt);
   for (const auto& confirmed_transaction : confirmed_transactions) {
     auto* eth_confirmed_transaction =
         static_cast<EthTxMeta*>(confirmed_transaction.get());
-    if (eth_confirmed_transaction->tx()->nonce() == meta.tx()->nonce() &&
-        eth_confirmed_transaction->id() != meta.id())
-      return true;
+    const auto nonce = eth_confirmed_transaction->tx()->nonce();
+    if (nonce)
+      confirmed_nonces.emplace_back(eth_confirmed_transaction->from(), *nonce);
   }
-  return false;
+  confirmed_nonces_ = base::flat_set<std::pair<std::string, uint256_t>>(
+      std::move(confirmed_nonces));
+}
+
+bool EthPendingTxTracker::IsNonceTaken(const EthTxMeta& meta) {
+  // Nonces are per account, and a submitted transaction is never confirmed,
+  // so any confirmed transaction with the same nonce is another one.
+  const auto nonce = meta.tx()->nonce();
+  return nonce &&
+         confirmed_nonces_.contains(std::make_pair(meta.from(), *nonce));
 }
 
 bool EthPendingTxTracker::ShouldTxDropped(const EthTxMeta& meta) {
@@ -7,8 +7,11 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_PENDING_TX_TRACKER_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
@@ -31,7 +34,10 @@ class EthPendingTxTracker {
   EthPendingTxTracker(const EthPendingTxTracker&) = delete;
   EthPendingTxTracker operator=(const EthPendingTxTracker&) = delete;
 
-  bool UpdatePendingTransactions(size_t* num_pending);
+  // Fetches the receipts of the submitted transactions in a single batch
+  // request, skipping the ones already checked at |block_num|. A |block_num|
+  // of 0 means the latest block is unknown and checks all of them.
+  bool UpdatePendingTransactions(uint256_t block_num, size_t* num_pending);
   void ResubmitPendingTransactions();
   void Reset();
 
@@ -40,10 +46,11 @@ class EthPendingTxTracker {
   FRIEND_TEST_ALL_PREFIXES(EthPendingTxTrackerUnitTest, ShouldTxDropped);
   FRIEND_TEST_ALL_PREFIXES(EthPendingTxTrackerUnitTest, DropTransaction);
 
-  void OnGetTxReceipt(std::string id,
-                      TransactionReceipt receipt,
-                      mojom::ProviderError error,
-                      const std::string& error_message);
+  void OnGetTxReceipts(uint256_t block_num,
+                       std::vector<std::string> ids,
+                       std::vector<absl::optional<TransactionReceipt>> receipts,
+                       mojom::ProviderError error,
+                       const std::string& error_message);
   void OnGetNetworkNonce(std::string address,
                          uint256_t result,
                          mojom::ProviderError error,
@@ -52,6 +59,7 @@ class EthPendingTxTracker {
                             mojom::ProviderError error,
                             const std::string& error_message);
 
+  void UpdateConfirmedNonces();
   bool IsNonceTaken(const EthTxMeta&);
   bool ShouldTxDropped(const EthTxMeta&);
 
@@ -61,6 +69,12 @@ class EthPendingTxTracker {
   base::flat_map<std::string, uint256_t> network_nonce_map_;
   // (txHash, count)
   base::flat_map<std::string, uint8_t> dropped_blocks_counter_;
+  // (address, nonce) of the confirmed transactions, refreshed once per update
+  // rather than once per pending transaction.
+  base::flat_set<std::pair<std::string, uint256_t>> confirmed_nonces_;
+  // Ids of the transactions whose receipt was requested at |checked_block_|.
+  uint256_t checked_block_ = 0;
+  base::flat_set<std::string> checked_tx_ids_;
 
   raw_ptr<EthTxStateManager> tx_state_manager_ = nullptr;
   raw_ptr<JsonRpcService> json_rpc_service_ = nullptr;
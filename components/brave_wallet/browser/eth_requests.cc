@@ -260,6 +260,21 @@ std::string eth_getTransactionReceipt(const std::string& transaction_hash) {
   return GetJsonRpc1Param("eth_getTransactionReceipt", transaction_hash);
 }
 
+std::string eth_getTransactionReceipts(
+    const std::vector<std::string>& transaction_hashes) {
+  base::Value batch(base::Value::Type::LIST);
+  for (size_t i = 0; i < transaction_hashes.size(); ++i) {
+    base::Value params(base::Value::Type::LIST);
+    params.Append(base::Value(transaction_hashes[i]));
+    base::Value dictionary =
+        GetJsonRpcDictionary("eth_getTransactionReceipt", &params);
+    // Responses to a batch can come back in any order.
+    dictionary.SetKey("id", base::Value(static_cast<int>(i)));
+    batch.Append(std::move(dictionary));
+  }
+  return GetJSON(batch);
+}
+
 std::string eth_getUncleByBlockHashAndIndex(const std::string& transaction_hash,
                                             const std::string& uncle_index) {
   return GetJsonRpc2Params("eth_getUncleByBlockHashAndIndex", transaction_hash,
@@ -147,6 +147,10 @@ std::string eth_getTransactionByBlockNumberAndIndex(
     const std::string& transaction_index);
 // Returns the receipt of a transaction by transaction hash.
 std::string eth_getTransactionReceipt(const std::string& transaction_hash);
+// Returns a batch of eth_getTransactionReceipt requests, identified by their
+// position in |transaction_hashes|.
+std::string eth_getTransactionReceipts(
+    const std::vector<std::string>& transaction_hashes);
 // Returns information about a uncle of a block by hash and uncle index
 // position.
 std::string eth_getUncleByBlockHashAndIndex(
@@ -233,6 +233,15 @@ TEST(EthRequestUnitTest, eth_getTransactionReceipt) {
       R"({"id":1,"jsonrpc":"2.0","method":"eth_getTransactionReceipt","params":["0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238"]})");  // NOLINT
 }
 
+TEST(EthRequestUnitTest, eth_getTransactionReceipts) {
+  const std::vector<std::string> tx_hashes = {
+      "0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238",
+      "0xc6ef2fc5426d6ad6fd9e2a26abeab0aa2411b7ab17f30a99d3cb96aed1d1055b"};
+  ASSERT_EQ(
+      eth_getTransactionReceipts(tx_hashes),
+      R"([{"id":0,"jsonrpc":"2.0","method":"eth_getTransactionReceipt","params":["0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238"]},{"id":1,"jsonrpc":"2.0","method":"eth_getTransactionReceipt","params":["0xc6ef2fc5426d6ad6fd9e2a26abeab0aa2411b7ab17f30a99d3cb96aed1d1055b"]}])");  // NOLINT
+}
+
 TEST(EthRequestUnitTest, eth_getUncleByBlockHashAndIndex) {
   ASSERT_EQ(
       eth_getUncleByBlockHashAndIndex(
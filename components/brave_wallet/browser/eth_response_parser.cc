@@ -7,6 +7,7 @@
 
 #include <utility>
 
+#include "base/json/json_reader.h"
 #include "base/strings/string_number_conversions.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_abi_decoder.h"
@@ -19,6 +20,83 @@ namespace brave_wallet {
 
 namespace eth {
 
+namespace {
+
+bool ParseTransactionReceiptResult(const base::Value::Dict& result,
+                                   TransactionReceipt* receipt) {
+  if (const auto* transaction_hash = result.FindString("transactionHash"))
+    receipt->transaction_hash = *transaction_hash;
+  else
+    return false;
+
+  if (const auto* transaction_index = result.FindString("transactionIndex")) {
+    if (!HexValueToUint256(*transaction_index, &receipt->transaction_index))
+      return false;
+  } else {
+    return false;
+  }
+
+  if (const auto* block_number = result.FindString("blockNumber")) {
+    if (!HexValueToUint256(*block_number, &receipt->block_number))
+      return false;
+  } else {
+    return false;
+  }
+
+  if (const auto* block_hash = result.FindString("blockHash"))
+    receipt->block_hash = *block_hash;
+  else
+    return false;
+
+  std::string cumulative_gas_used;
+  if (const auto* cumulative_gas_used =
+          result.FindString("cumulativeGasUsed")) {
+    if (!HexValueToUint256(*cumulative_gas_used, &receipt->cumulative_gas_used))
+      return false;
+  } else {
+    return false;
+  }
+
+  if (const auto* gas_used = result.FindString("gasUsed")) {
+    if (!HexValueToUint256(*gas_used, &receipt->gas_used))
+      return false;
+  } else {
+    return false;
+  }
+
+  // contractAddress can be null
+  if (const auto* contract_address = result.FindString("contractAddress")) {
+    receipt->contract_address = *contract_address;
+  }
+
+  // TODO(darkdh): logs
+#if 0
+  const base::Value::List* logs = result.FindList("logs");
+  if (!logs)
+    return false;
+  for (const std::string& entry : *logs)
+    receipt->logs.push_back(entry);
+#endif
+
+  if (const auto* logs_bloom = result.FindString("logsBloom"))
+    receipt->logs_bloom = *logs_bloom;
+  else
+    return false;
+
+  if (const auto* status = result.FindString("status")) {
+    uint32_t status_int = 0;
+    if (!base::HexStringToUInt(*status, &status_int))
+      return false;
+    receipt->status = status_int == 1;
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace
+
 bool ParseStringResult(const std::string& json, std::string* value) {
   DCHECK(value);
 
@@ -157,72 +235,36 @@ bool ParseEthGetTransactionReceipt(const std::string& json,
   if (!result)
     return false;
 
-  if (const auto* transaction_hash = result->FindString("transactionHash"))
-    receipt->transaction_hash = *transaction_hash;
-  else
-    return false;
-
-  if (const auto* transaction_index = result->FindString("transactionIndex")) {
-    if (!HexValueToUint256(*transaction_index, &receipt->transaction_index))
-      return false;
-  } else {
-    return false;
-  }
-
-  if (const auto* block_number = result->FindString("blockNumber")) {
-    if (!HexValueToUint256(*block_number, &receipt->block_number))
-      return false;
-  } else {
-    return false;
-  }
-
-  if (const auto* block_hash = result->FindString("blockHash"))
-    receipt->block_hash = *block_hash;
-  else
-    return false;
-
-  std::string cumulative_gas_used;
-  if (const auto* cumulative_gas_used =
-          result->FindString("cumulativeGasUsed")) {
-    if (!HexValueToUint256(*cumulative_gas_used, &receipt->cumulative_gas_used))
-      return false;
-  } else {
-    return false;
-  }
+  return ParseTransactionReceiptResult(*result, receipt);
+}
 
-  if (const auto* gas_used = result->FindString("gasUsed")) {
-    if (!HexValueToUint256(*gas_used, &receipt->gas_used))
-      return false;
-  } else {
+bool ParseEthGetTransactionReceipts(
+    const std::string& json,
+    size_t count,
+    std::vector<absl::optional<TransactionReceipt>>* receipts) {
+  DCHECK(receipts);
+
+  absl::optional<base::Value> records_v = base::JSONReader::Read(
+      json, base::JSON_PARSE_CHROMIUM_EXTENSIONS |
+                base::JSONParserOptions::JSON_PARSE_RFC);
+  if (!records_v || !records_v->is_list()) {
+    LOG(ERROR) << "Invalid response, could not parse JSON, JSON is: " << json;
     return false;
   }
 
-  // contractAddress can be null
-  if (const auto* contract_address = result->FindString("contractAddress")) {
-    receipt->contract_address = *contract_address;
-  }
-
-  // TODO(darkdh): logs
-#if 0
-  const base::Value::List* logs = result->FindList("logs");
-  if (!logs)
-    return false;
-  for (const std::string& entry : *logs)
-    receipt->logs.push_back(entry);
-#endif
-
-  if (const auto* logs_bloom = result->FindString("logsBloom"))
-    receipt->logs_bloom = *logs_bloom;
-  else
-    return false;
-
-  if (const auto* status = result->FindString("status")) {
-    uint32_t status_int = 0;
-    if (!base::HexStringToUInt(*status, &status_int))
-      return false;
-    receipt->status = status_int == 1;
-  } else {
-    return false;
+  receipts->assign(count, absl::nullopt);
+  for (const auto& response : records_v->GetList()) {
+    const auto* response_dict = response.GetIfDict();
+    if (!response_dict)
+      continue;
+    // Unknown and still pending transactions have a null result.
+    const auto id = response_dict->FindInt("id");
+    const auto* result = response_dict->FindDict("result");
+    if (!id || *id < 0 || static_cast<size_t>(*id) >= count || !result)
+      continue;
+    TransactionReceipt receipt;
+    if (ParseTransactionReceiptResult(*result, &receipt))
+      (*receipts)[*id] = std::move(receipt);
   }
 
   return true;
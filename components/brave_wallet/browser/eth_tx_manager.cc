@@ -884,12 +884,26 @@ void EthTxManager::OnNewBlock(uint256_t block_num) {
 
 void EthTxManager::UpdatePendingTransactions() {
   size_t num_pending;
-  if (pending_tx_tracker_->UpdatePendingTransactions(&num_pending)) {
+  if (pending_tx_tracker_->UpdatePendingTransactions(
+          GetEthBlockTracker()->GetCurrentBlock(), &num_pending)) {
     known_no_pending_tx_ = num_pending == 0;
     CheckIfBlockTrackerShouldRun();
   }
 }
 
+base::TimeDelta EthTxManager::GetBlockTrackerInterval() {
+  const base::TimeDelta default_interval = TxManager::GetBlockTrackerInterval();
+  const auto block_time = GetEthBlockTracker()->GetAverageBlockTime();
+  if (known_no_pending_tx_ || !block_time)
+    return default_interval;
+  // While transactions are pending, poll twice per block so that they are
+  // confirmed soon after being mined. Whole seconds keep the timer from being
+  // restarted on every small change of the average.
+  return std::clamp(base::Seconds((*block_time / 2).InSeconds()),
+                    base::Seconds(kBlockTrackerMinTimeInSeconds),
+                    default_interval);
+}
+
 void EthTxManager::SpeedupOrCancelTransaction(
     const std::string& tx_meta_id,
     bool cancel,
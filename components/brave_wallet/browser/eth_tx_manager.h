@@ -217,6 +217,7 @@ class EthTxManager : public TxManager, public EthBlockTracker::Observer {
       AddUnapprovedTransactionCallback callback,
       mojom::GasEstimation1559Ptr gas_estimation);
   void UpdatePendingTransactions() override;
+  base::TimeDelta GetBlockTrackerInterval() override;
 
   void ContinueSpeedupOrCancelTransaction(
       const std::string& from,
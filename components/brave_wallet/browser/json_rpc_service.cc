@@ -5,16 +5,21 @@
 
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
+#include "base/barrier_callback.h"
 #include "base/base64.h"
 #include "base/bind.h"
 #include "base/environment.h"
+#include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "base/no_destructor.h"
 #include "base/notreached.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/time/default_tick_clock.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_data_builder.h"
@@ -63,6 +68,27 @@ constexpr char kDomainPattern[] =
 constexpr char kUDPattern[] =
     "(?:[a-z0-9-]+)\\.(?:crypto|x|coin|nft|dao|wallet|888|blockchain|bitcoin)";
 
+// Returns the method of a batch of JSON-RPC requests which all call the same
+// one, so that it can be sent as the X-Eth-Method header too.
+absl::optional<std::string> GetEthJsonBatchMethod(const std::string& json) {
+  absl::optional<base::Value> batch = base::JSONReader::Read(
+      json, base::JSON_PARSE_CHROMIUM_EXTENSIONS |
+                base::JSONParserOptions::JSON_PARSE_RFC);
+  if (!batch || !batch->is_list() || batch->GetList().empty())
+    return absl::nullopt;
+
+  absl::optional<std::string> method;
+  for (const auto& request : batch->GetList()) {
+    const auto* request_dict = request.GetIfDict();
+    const std::string* request_method =
+        request_dict ? request_dict->FindString("method") : nullptr;
+    if (!request_method || (method && *method != *request_method))
+      return absl::nullopt;
+    method = *request_method;
+  }
+  return method;
+}
+
 net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
   return net::DefineNetworkTrafficAnnotation("json_rpc_service", R"(
       semantics {
@@ -95,6 +121,87 @@ constexpr char kAccountNotCreatedError[] = "could not find account";
 
 namespace brave_wallet {
 
+namespace {
+
+constexpr size_t kMaxDecentralizedDnsCacheSize = 256;
+
+bool IsZeroAddress(const std::string& address) {
+  const std::vector<uint8_t> bytes = EthAddress::FromHex(address).bytes();
+  return !bytes.empty() && std::all_of(bytes.cbegin(), bytes.cend(),
+                                       [](uint8_t byte) { return byte == 0; });
+}
+
+// Returns the unexpired resolution of |domain| in |cache|, or nullptr.
+template <class Cache>
+const typename Cache::mapped_type* FindCachedResolution(
+    Cache* cache,
+    const std::string& domain,
+    base::TimeTicks now) {
+  auto iter = cache->find(domain);
+  if (iter == cache->end()) {
+    return nullptr;
+  }
+
+  if (now >= iter->second.expires_at) {
+    cache->erase(iter);
+    return nullptr;
+  }
+
+  return &iter->second;
+}
+
+template <class Cache>
+void AddCachedResolution(Cache* cache,
+                         const std::string& domain,
+                         typename Cache::mapped_type resolution,
+                         base::TimeTicks now) {
+  if (cache->size() >= kMaxDecentralizedDnsCacheSize) {
+    base::EraseIf(*cache, [now](const auto& item) {
+      return now >= item.second.expires_at;
+    });
+  }
+
+  if (cache->size() >= kMaxDecentralizedDnsCacheSize) {
+    cache->erase(std::min_element(
+        cache->begin(), cache->end(), [](const auto& lhs, const auto& rhs) {
+          return lhs.second.expires_at < rhs.second.expires_at;
+        }));
+  }
+
+  cache->insert_or_assign(domain, std::move(resolution));
+}
+
+using IndexedTxReceipt = std::pair<size_t, absl::optional<TransactionReceipt>>;
+
+void OnGetIndexedTransactionReceipt(
+    size_t index,
+    base::RepeatingCallback<void(IndexedTxReceipt)> barrier_callback,
+    TransactionReceipt receipt,
+    mojom::ProviderError error,
+    const std::string& error_message) {
+  // Unknown and still pending transactions don't have a receipt.
+  if (error != mojom::ProviderError::kSuccess) {
+    barrier_callback.Run({index, absl::nullopt});
+    return;
+  }
+
+  barrier_callback.Run({index, std::move(receipt)});
+}
+
+void MergeTransactionReceipts(
+    JsonRpcService::GetTxReceiptsCallback callback,
+    size_t count,
+    std::vector<IndexedTxReceipt> indexed_receipts) {
+  std::vector<absl::optional<TransactionReceipt>> receipts(count);
+  for (auto& indexed_receipt : indexed_receipts)
+    receipts[indexed_receipt.first] = std::move(indexed_receipt.second);
+
+  std::move(callback).Run(std::move(receipts), mojom::ProviderError::kSuccess,
+                          "");
+}
+
+}  // namespace
+
 JsonRpcService::JsonRpcService(
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
     PrefService* prefs)
@@ -106,6 +213,7 @@ JsonRpcService::JsonRpcService(
               unstoppable_domains::MultichainCalls<std::string>>()),
       ud_resolve_dns_calls_(
           std::make_unique<unstoppable_domains::MultichainCalls<GURL>>()),
+      clock_(base::DefaultTickClock::GetInstance()),
       prefs_(prefs),
       weak_ptr_factory_(this) {
   if (!SetNetwork(GetCurrentChainId(prefs_, mojom::CoinType::ETH),
@@ -127,6 +235,16 @@ void JsonRpcService::SetAPIRequestHelperForTesting(
 
 JsonRpcService::~JsonRpcService() {}
 
+void JsonRpcService::ClearDecentralizedDnsCache() {
+  ud_resolve_dns_cache_.clear();
+  ens_content_hash_cache_.clear();
+  ens_resolver_cache_.clear();
+}
+
+void JsonRpcService::SetClockForTesting(const base::TickClock* clock) {
+  clock_ = clock;
+}
+
 // static
 void JsonRpcService::MigrateMultichainNetworks(PrefService* prefs) {
   // custom networks
@@ -192,6 +310,9 @@ void JsonRpcService::RequestInternal(
     } else if (method == kEthBlockNumber) {
       request_headers["X-Eth-Block"] = "true";
     }
+  } else if (auto batch_method = GetEthJsonBatchMethod(json_payload)) {
+    if (net::HttpUtil::IsValidHeaderValue(*batch_method))
+      request_headers["X-Eth-Method"] = *batch_method;
   }
 
   std::unique_ptr<base::Environment> env(base::Environment::Create());
@@ -912,6 +1033,62 @@ void JsonRpcService::OnGetTransactionReceipt(
   std::move(callback).Run(receipt, mojom::ProviderError::kSuccess, "");
 }
 
+void JsonRpcService::GetTransactionReceipts(
+    const std::vector<std::string>& tx_hashes,
+    GetTxReceiptsCallback callback) {
+  const GURL& network_url = network_urls_[mojom::CoinType::ETH];
+  if (networks_without_batch_support_.contains(network_url)) {
+    GetTransactionReceiptsIndividually(tx_hashes, std::move(callback));
+    return;
+  }
+
+  auto internal_callback = base::BindOnce(
+      &JsonRpcService::OnGetTransactionReceipts, weak_ptr_factory_.GetWeakPtr(),
+      std::move(callback), tx_hashes, network_url);
+  RequestInternal(eth::eth_getTransactionReceipts(tx_hashes), true,
+                  network_url, std::move(internal_callback));
+}
+
+void JsonRpcService::OnGetTransactionReceipts(
+    GetTxReceiptsCallback callback,
+    const std::vector<std::string>& tx_hashes,
+    const GURL& network_url,
+    const int status,
+    const std::string& body,
+    const base::flat_map<std::string, std::string>& headers) {
+  std::vector<absl::optional<TransactionReceipt>> receipts;
+  if (status >= 200 && status <= 299 &&
+      eth::ParseEthGetTransactionReceipts(body, tx_hashes.size(), &receipts)) {
+    std::move(callback).Run(std::move(receipts),
+                            mojom::ProviderError::kSuccess, "");
+    return;
+  }
+
+  // Some nodes reject batch requests or don't answer them with a list.
+  if ((status >= 200 && status <= 299) || (status >= 400 && status <= 499)) {
+    networks_without_batch_support_.insert(network_url);
+    GetTransactionReceiptsIndividually(tx_hashes, std::move(callback));
+    return;
+  }
+
+  std::move(callback).Run(std::move(receipts),
+                          mojom::ProviderError::kInternalError,
+                          l10n_util::GetStringUTF8(IDS_WALLET_INTERNAL_ERROR));
+}
+
+void JsonRpcService::GetTransactionReceiptsIndividually(
+    const std::vector<std::string>& tx_hashes,
+    GetTxReceiptsCallback callback) {
+  const auto barrier_callback = base::BarrierCallback<IndexedTxReceipt>(
+      tx_hashes.size(), base::BindOnce(&MergeTransactionReceipts,
+                                       std::move(callback), tx_hashes.size()));
+  for (size_t i = 0; i < tx_hashes.size(); ++i) {
+    GetTransactionReceipt(
+        tx_hashes[i],
+        base::BindOnce(&OnGetIndexedTransactionReceipt, i, barrier_callback));
+  }
+}
+
 void JsonRpcService::SendRawTransaction(const std::string& signed_tx,
                                         SendRawTxCallback callback) {
   auto internal_callback =
@@ -1051,6 +1228,15 @@ void JsonRpcService::OnGetERC20TokenAllowance(
 
 void JsonRpcService::EnsRegistryGetResolver(const std::string& domain,
                                             StringResultCallback callback) {
+  const auto* cached_resolver =
+      FindCachedResolution(&ens_resolver_cache_, domain, clock_->NowTicks());
+  if (cached_resolver) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback), cached_resolver->result,
+                                  mojom::ProviderError::kSuccess, ""));
+    return;
+  }
+
   const std::string contract_address =
       GetEnsRegistryContractAddress(brave_wallet::mojom::kMainnetChainId);
   if (contract_address.empty()) {
@@ -1077,15 +1263,16 @@ void JsonRpcService::EnsRegistryGetResolver(const std::string& domain,
     return;
   }
 
-  auto internal_callback =
-      base::BindOnce(&JsonRpcService::OnEnsRegistryGetResolver,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(callback));
+  auto internal_callback = base::BindOnce(
+      &JsonRpcService::OnEnsRegistryGetResolver,
+      weak_ptr_factory_.GetWeakPtr(), domain, std::move(callback));
   RequestInternal(
       eth::eth_call("", contract_address, "", "", "", data, "latest"), true,
       network_url, std::move(internal_callback));
 }
 
 void JsonRpcService::OnEnsRegistryGetResolver(
+    const std::string& domain,
     StringResultCallback callback,
     int status,
     const std::string& body,
@@ -1108,63 +1295,93 @@ void JsonRpcService::OnEnsRegistryGetResolver(
     return;
   }
 
+  // Domains without a resolver are not cached here, as they might be
+  // registered at any time.
+  if (!IsZeroAddress(resolver_address)) {
+    const base::TimeTicks now = clock_->NowTicks();
+    AddCachedResolution(&ens_resolver_cache_, domain,
+                        {resolver_address, mojom::ProviderError::kSuccess, "",
+                         now + kEnsResolverCacheTtl},
+                        now);
+  }
+
   std::move(callback).Run(resolver_address, mojom::ProviderError::kSuccess, "");
 }
 
 void JsonRpcService::EnsResolverGetContentHash(const std::string& domain,
                                                StringResultCallback callback) {
-  auto internal_callback = base::BindOnce(
-      &JsonRpcService::ContinueEnsResolverGetContentHash,
-      weak_ptr_factory_.GetWeakPtr(), domain, std::move(callback));
+  const auto* cached_content_hash = FindCachedResolution(
+      &ens_content_hash_cache_, domain, clock_->NowTicks());
+  if (cached_content_hash) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(callback),
+                                  cached_content_hash->result,
+                                  cached_content_hash->error,
+                                  cached_content_hash->error_message));
+    return;
+  }
+
+  auto& callbacks = ens_content_hash_calls_[domain];
+  callbacks.push_back(std::move(callback));
+  if (callbacks.size() > 1) {
+    // The content hash of |domain| is already being resolved.
+    return;
+  }
+
+  auto internal_callback =
+      base::BindOnce(&JsonRpcService::ContinueEnsResolverGetContentHash,
+                     weak_ptr_factory_.GetWeakPtr(), domain);
   EnsRegistryGetResolver(domain, std::move(internal_callback));
 }
 
 void JsonRpcService::ContinueEnsResolverGetContentHash(
     const std::string& domain,
-    StringResultCallback callback,
     const std::string& resolver_address,
     mojom::ProviderError error,
     const std::string& error_message) {
   if (error != mojom::ProviderError::kSuccess || resolver_address.empty()) {
-    std::move(callback).Run("", error, error_message);
+    FinishEnsResolverGetContentHash(domain, "", error, error_message,
+                                    /* no_record */ false);
     return;
   }
 
   std::string data;
   if (!ens::ContentHash(domain, &data)) {
-    std::move(callback).Run(
-        "", mojom::ProviderError::kInvalidParams,
-        l10n_util::GetStringUTF8(IDS_WALLET_INVALID_PARAMETERS));
+    FinishEnsResolverGetContentHash(
+        domain, "", mojom::ProviderError::kInvalidParams,
+        l10n_util::GetStringUTF8(IDS_WALLET_INVALID_PARAMETERS),
+        /* no_record */ false);
     return;
   }
 
   GURL network_url = GetNetworkURL(prefs_, brave_wallet::mojom::kMainnetChainId,
                                    mojom::CoinType::ETH);
   if (!network_url.is_valid()) {
-    std::move(callback).Run(
-        "", mojom::ProviderError::kInvalidParams,
-        l10n_util::GetStringUTF8(IDS_WALLET_INVALID_PARAMETERS));
+    FinishEnsResolverGetContentHash(
+        domain, "", mojom::ProviderError::kInvalidParams,
+        l10n_util::GetStringUTF8(IDS_WALLET_INVALID_PARAMETERS),
+        /* no_record */ false);
     return;
   }
 
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnEnsResolverGetContentHash,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(callback));
+                     weak_ptr_factory_.GetWeakPtr(), domain);
   RequestInternal(
       eth::eth_call("", resolver_address, "", "", "", data, "latest"), true,
       network_url, std::move(internal_callback));
 }
 
 void JsonRpcService::OnEnsResolverGetContentHash(
-    StringResultCallback callback,
+    const std::string& domain,
     int status,
     const std::string& body,
     const base::flat_map<std::string, std::string>& headers) {
-  DCHECK(callback);
   if (status < 200 || status > 299) {
-    std::move(callback).Run(
-        "", mojom::ProviderError::kInternalError,
-        l10n_util::GetStringUTF8(IDS_WALLET_INTERNAL_ERROR));
+    FinishEnsResolverGetContentHash(
+        domain, "", mojom::ProviderError::kInternalError,
+        l10n_util::GetStringUTF8(IDS_WALLET_INTERNAL_ERROR),
+        /* no_record */ false);
     return;
   }
 
@@ -1174,11 +1391,45 @@ void JsonRpcService::OnEnsResolverGetContentHash(
     mojom::ProviderError error;
     std::string error_message;
     ParseErrorResult<mojom::ProviderError>(body, &error, &error_message);
-    std::move(callback).Run("", error, error_message);
+    // A result which is not a content hash means that the resolver, or the
+    // zero address if the domain is not registered, has no record for it.
+    const bool no_record = ParseSingleStringResult(body).has_value();
+    FinishEnsResolverGetContentHash(domain, "", error, error_message,
+                                    no_record);
+    return;
+  }
+
+  FinishEnsResolverGetContentHash(domain, content_hash,
+                                  mojom::ProviderError::kSuccess, "",
+                                  /* no_record */ false);
+}
+
+void JsonRpcService::FinishEnsResolverGetContentHash(
+    const std::string& domain,
+    const std::string& content_hash,
+    mojom::ProviderError error,
+    const std::string& error_message,
+    bool no_record) {
+  if (error == mojom::ProviderError::kSuccess || no_record) {
+    const base::TimeTicks now = clock_->NowTicks();
+    const base::TimeDelta ttl = error == mojom::ProviderError::kSuccess
+                                    ? kDnsResolutionCacheTtl
+                                    : kDnsNoResolutionCacheTtl;
+    AddCachedResolution(&ens_content_hash_cache_, domain,
+                        {content_hash, error, error_message, now + ttl}, now);
+  }
+
+  auto iter = ens_content_hash_calls_.find(domain);
+  if (iter == ens_content_hash_calls_.end()) {
     return;
   }
 
-  std::move(callback).Run(content_hash, mojom::ProviderError::kSuccess, "");
+  std::vector<StringResultCallback> callbacks = std::move(iter->second);
+  ens_content_hash_calls_.erase(iter);
+
+  for (auto& callback : callbacks) {
+    std::move(callback).Run(content_hash, error, error_message);
+  }
 }
 
 void JsonRpcService::EnsGetEthAddr(const std::string& domain,
@@ -1250,6 +1501,16 @@ void JsonRpcService::OnEnsGetEthAddr(
 void JsonRpcService::UnstoppableDomainsResolveDns(
     const std::string& domain,
     UnstoppableDomainsResolveDnsCallback callback) {
+  const auto* cached_url =
+      FindCachedResolution(&ud_resolve_dns_cache_, domain, clock_->NowTicks());
+  if (cached_url) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(std::move(callback), cached_url->result,
+                       cached_url->error, cached_url->error_message));
+    return;
+  }
+
   if (ud_resolve_dns_calls_->HasCall(domain)) {
     ud_resolve_dns_calls_->AddCallback(domain, std::move(callback));
     return;
@@ -1271,6 +1532,12 @@ void JsonRpcService::UnstoppableDomainsResolveDns(
     return;
   }
 
+  // Callbacks are run in order, so the resolution is cached before it is
+  // passed to any caller.
+  ud_resolve_dns_calls_->AddCallback(
+      domain,
+      base::BindOnce(&JsonRpcService::CacheUnstoppableDomainsResolveDns,
+                     weak_ptr_factory_.GetWeakPtr(), domain));
   ud_resolve_dns_calls_->AddCallback(domain, std::move(callback));
   for (const auto& chain_id : ud_resolve_dns_calls_->GetChains()) {
     auto internal_callback =
@@ -1316,6 +1583,24 @@ void JsonRpcService::OnUnstoppableDomainsResolveDns(
   ud_resolve_dns_calls_->SetResult(domain, chain_id, std::move(resolved_url));
 }
 
+void JsonRpcService::CacheUnstoppableDomainsResolveDns(
+    const std::string& domain,
+    const GURL& url,
+    mojom::ProviderError error,
+    const std::string& error_message) {
+  if (error != mojom::ProviderError::kSuccess) {
+    return;
+  }
+
+  // A successful resolution without a url means that no chain has a record
+  // for |domain|.
+  const base::TimeTicks now = clock_->NowTicks();
+  const base::TimeDelta ttl =
+      url.is_valid() ? kDnsResolutionCacheTtl : kDnsNoResolutionCacheTtl;
+  AddCachedResolution(&ud_resolve_dns_cache_, domain,
+                      {url, error, error_message, now + ttl}, now);
+}
+
 void JsonRpcService::UnstoppableDomainsGetEthAddr(
     const std::string& domain,
     UnstoppableDomainsGetEthAddrCallback callback) {
@@ -2066,6 +2351,8 @@ void JsonRpcService::Reset() {
   SetNetwork(GetCurrentChainId(prefs_, mojom::CoinType::ETH),
              mojom::CoinType::ETH);
 
+  ClearDecentralizedDnsCache();
+
   add_chain_pending_requests_.clear();
   switch_chain_requests_.clear();
   // Reject pending suggest token requests when network changed.
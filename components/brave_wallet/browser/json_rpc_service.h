@@ -14,8 +14,10 @@
 
 #include "base/callback.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list_threadsafe.h"
+#include "base/time/time.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/solana_transaction.h"
@@ -30,6 +32,10 @@
 #include "url/gurl.h"
 #include "url/origin.h"
 
+namespace base {
+class TickClock;
+}  // namespace base
+
 namespace network {
 class SharedURLLoaderFactory;
 class SimpleURLLoader;
@@ -135,6 +141,15 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
   void GetTransactionReceipt(const std::string& tx_hash,
                              GetTxReceiptCallback callback);
 
+  // Fetches the receipts of |tx_hashes| in a single batch request. Receipts
+  // are in the order of |tx_hashes|, and unset for pending transactions.
+  using GetTxReceiptsCallback = base::OnceCallback<void(
+      std::vector<absl::optional<TransactionReceipt>> results,
+      mojom::ProviderError error,
+      const std::string& error_message)>;
+  void GetTransactionReceipts(const std::vector<std::string>& tx_hashes,
+                              GetTxReceiptsCallback callback);
+
   using SendRawTxCallback =
       base::OnceCallback<void(const std::string& tx_hash,
                               mojom::ProviderError error,
@@ -168,6 +183,15 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
   void EnsGetEthAddr(const std::string& domain,
                      EnsGetEthAddrCallback callback) override;
 
+  // Decentralized DNS resolutions are cached for |kDnsResolutionCacheTtl|,
+  // and domains without a record for |kDnsNoResolutionCacheTtl|. ENS resolver
+  // addresses rarely change, so they are cached for |kEnsResolverCacheTtl|.
+  static constexpr base::TimeDelta kDnsResolutionCacheTtl = base::Minutes(5);
+  static constexpr base::TimeDelta kDnsNoResolutionCacheTtl = base::Minutes(1);
+  static constexpr base::TimeDelta kEnsResolverCacheTtl = base::Hours(1);
+  void ClearDecentralizedDnsCache();
+  void SetClockForTesting(const base::TickClock* clock);
+
   bool SetNetwork(const std::string& chain_id,
                   mojom::CoinType coin,
                   bool silent = false);
@@ -424,6 +448,17 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
       const int status,
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
+  void OnGetTransactionReceipts(
+      GetTxReceiptsCallback callback,
+      const std::vector<std::string>& tx_hashes,
+      const GURL& network_url,
+      const int status,
+      const std::string& body,
+      const base::flat_map<std::string, std::string>& headers);
+  // Fallback for nodes which don't support batch requests.
+  void GetTransactionReceiptsIndividually(
+      const std::vector<std::string>& tx_hashes,
+      GetTxReceiptsCallback callback);
   void OnSendRawTransaction(
       SendRawTxCallback callback,
       const int status,
@@ -454,27 +489,40 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
 
+  void CacheUnstoppableDomainsResolveDns(const std::string& domain,
+                                         const GURL& url,
+                                         mojom::ProviderError error,
+                                         const std::string& error_message);
+
   void EnsRegistryGetResolver(const std::string& domain,
                               StringResultCallback callback);
 
   void OnEnsRegistryGetResolver(
+      const std::string& domain,
       StringResultCallback callback,
       int status,
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
 
   void ContinueEnsResolverGetContentHash(const std::string& domain,
-                                         StringResultCallback callback,
                                          const std::string& resolver_address,
                                          mojom::ProviderError error,
                                          const std::string& error_message);
 
   void OnEnsResolverGetContentHash(
-      StringResultCallback callback,
+      const std::string& domain,
       int status,
       const std::string& body,
       const base::flat_map<std::string, std::string>& headers);
 
+  // Runs the callbacks waiting for the content hash of |domain|. |no_record|
+  // is set if the resolver answered, but has no content hash for |domain|.
+  void FinishEnsResolverGetContentHash(const std::string& domain,
+                                       const std::string& content_hash,
+                                       mojom::ProviderError error,
+                                       const std::string& error_message,
+                                       bool no_record);
+
   void ContinueEnsGetEthAddr(const std::string& domain,
                              StringResultCallback callback,
                              const std::string& resolver_address,
@@ -623,6 +671,9 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
 
   std::unique_ptr<api_request_helper::APIRequestHelper> api_request_helper_;
   base::flat_map<mojom::CoinType, GURL> network_urls_;
+  // Networks which rejected a batch of eth_getTransactionReceipt calls, so
+  // that receipts are fetched one by one right away.
+  base::flat_set<GURL> networks_without_batch_support_;
   // <mojom::CoinType, chain_id>
   base::flat_map<mojom::CoinType, std::string> chain_ids_;
   // <chain_id, mojom::AddChainRequest>
@@ -638,6 +689,25 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
   std::unique_ptr<unstoppable_domains::MultichainCalls<GURL>>
       ud_resolve_dns_calls_;
 
+  template <class ResultType>
+  struct CachedResolution {
+    ResultType result;
+    mojom::ProviderError error = mojom::ProviderError::kSuccess;
+    std::string error_message;
+    base::TimeTicks expires_at;
+  };
+
+  // domain -> resolution
+  base::flat_map<std::string, CachedResolution<GURL>> ud_resolve_dns_cache_;
+  base::flat_map<std::string, CachedResolution<std::string>>
+      ens_content_hash_cache_;
+  base::flat_map<std::string, CachedResolution<std::string>>
+      ens_resolver_cache_;
+  // domain -> callbacks waiting for the content hash in flight.
+  base::flat_map<std::string, std::vector<StringResultCallback>>
+      ens_content_hash_calls_;
+  const base::TickClock* clock_;
+
   mojo::RemoteSet<mojom::JsonRpcServiceObserver> observers_;
 
   mojo::ReceiverSet<mojom::JsonRpcService> receivers_;
@@ -17,6 +17,7 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/test/bind.h"
 #include "base/test/mock_callback.h"
+#include "base/test/simple_test_tick_clock.h"
 #include "base/test/task_environment.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
@@ -1206,6 +1207,7 @@ TEST_F(JsonRpcServiceUnitTest, EnsResolverGetContentHash) {
   EXPECT_TRUE(callback_called);
 
   callback_called = false;
+  json_rpc_service_->ClearDecentralizedDnsCache();
   SetHTTPRequestTimeoutInterceptor();
   json_rpc_service_->EnsResolverGetContentHash(
       "brantly.eth",
@@ -1246,6 +1248,102 @@ TEST_F(JsonRpcServiceUnitTest, EnsGetEthAddr) {
   base::RunLoop().RunUntilIdle();
 }
 
+TEST_F(JsonRpcServiceUnitTest, EnsResolverGetContentHash_Cache) {
+  base::SimpleTestTickClock clock;
+  json_rpc_service_->SetClockForTesting(&clock);
+  SetUDENSInterceptor(mojom::kMainnetChainId);
+
+  base::MockCallback<JsonRpcService::StringResultCallback> callback;
+  EXPECT_CALL(callback, Run(testing::Not(testing::IsEmpty()),
+                            mojom::ProviderError::kSuccess, ""))
+      .Times(2);
+  // Concurrent calls share a single resolution.
+  json_rpc_service_->EnsResolverGetContentHash("brantly.eth", callback.Get());
+  json_rpc_service_->EnsResolverGetContentHash("brantly.eth", callback.Get());
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+  EXPECT_EQ(2u, url_loader_factory_.total_requests());
+
+  // The content hash is cached.
+  SetHTTPRequestTimeoutInterceptor();
+  EXPECT_CALL(callback, Run(testing::Not(testing::IsEmpty()),
+                            mojom::ProviderError::kSuccess, ""));
+  json_rpc_service_->EnsResolverGetContentHash("brantly.eth", callback.Get());
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+  EXPECT_EQ(2u, url_loader_factory_.total_requests());
+
+  // Once it expires, only the content hash is requested again as the resolver
+  // address is still cached. Errors are not cached.
+  clock.Advance(JsonRpcService::kDnsResolutionCacheTtl);
+  EXPECT_CALL(callback,
+              Run("", mojom::ProviderError::kInternalError,
+                  l10n_util::GetStringUTF8(IDS_WALLET_INTERNAL_ERROR)))
+      .Times(2);
+  json_rpc_service_->EnsResolverGetContentHash("brantly.eth", callback.Get());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(3u, url_loader_factory_.total_requests());
+  json_rpc_service_->EnsResolverGetContentHash("brantly.eth", callback.Get());
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+  EXPECT_EQ(4u, url_loader_factory_.total_requests());
+}
+
+TEST_F(JsonRpcServiceUnitTest, EnsResolverGetContentHash_NoRecordCache) {
+  base::SimpleTestTickClock clock;
+  json_rpc_service_->SetClockForTesting(&clock);
+
+  // The domain is not registered, so its resolver is the zero address, which
+  // has no content hash.
+  GURL network_url = AddInfuraProjectId(
+      GetNetworkURL(prefs(), mojom::kMainnetChainId, mojom::CoinType::ETH));
+  url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+      [&, network_url](const network::ResourceRequest& request) {
+        base::StringPiece request_string(request.request_body->elements()
+                                             ->at(0)
+                                             .As<network::DataElementBytes>()
+                                             .AsStringPiece());
+        url_loader_factory_.ClearResponses();
+        if (request_string.find(GetFunctionHash("resolver(bytes32)")) !=
+            std::string::npos) {
+          url_loader_factory_.AddResponse(
+              network_url.spec(),
+              "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":"
+              "\"0x0000000000000000000000000000000000000000000000000000000000"
+              "000000\"}");
+        } else {
+          url_loader_factory_.AddResponse(
+              network_url.spec(),
+              "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0x\"}");
+        }
+      }));
+
+  base::MockCallback<JsonRpcService::StringResultCallback> callback;
+  EXPECT_CALL(callback,
+              Run("", mojom::ProviderError::kParsingError,
+                  l10n_util::GetStringUTF8(IDS_WALLET_PARSING_ERROR)))
+      .Times(2);
+  json_rpc_service_->EnsResolverGetContentHash("unregistered.eth",
+                                               callback.Get());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(2u, url_loader_factory_.total_requests());
+  json_rpc_service_->EnsResolverGetContentHash("unregistered.eth",
+                                               callback.Get());
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+  EXPECT_EQ(2u, url_loader_factory_.total_requests());
+
+  // The zero address resolver is not cached.
+  clock.Advance(JsonRpcService::kDnsNoResolutionCacheTtl);
+  EXPECT_CALL(callback,
+              Run("", mojom::ProviderError::kParsingError,
+                  l10n_util::GetStringUTF8(IDS_WALLET_PARSING_ERROR)));
+  json_rpc_service_->EnsResolverGetContentHash("unregistered.eth",
+                                               callback.Get());
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(4u, url_loader_factory_.total_requests());
+}
+
 TEST_F(JsonRpcServiceUnitTest, AddEthereumChainApproved) {
   mojom::NetworkInfo chain("0x111", "chain_name", {"https://url1.com"},
                            {"https://url1.com"}, {"https://url1.com"}, "symbol",
@@ -2248,6 +2346,7 @@ TEST_F(UnstoppableDomainsUnitTest, ResolveDns_PolygonResult) {
   base::RunLoop().RunUntilIdle();
   testing::Mock::VerifyAndClearExpectations(&callback);
 
+  json_rpc_service_->ClearDecentralizedDnsCache();
   EXPECT_CALL(callback, Run(GURL("https://brave.com"),
                             mojom::ProviderError::kSuccess, ""));
   json_rpc_service_->UnstoppableDomainsResolveDns("brave.crypto",
@@ -2257,6 +2356,7 @@ TEST_F(UnstoppableDomainsUnitTest, ResolveDns_PolygonResult) {
   base::RunLoop().RunUntilIdle();
   testing::Mock::VerifyAndClearExpectations(&callback);
 
+  json_rpc_service_->ClearDecentralizedDnsCache();
   EXPECT_CALL(callback, Run(GURL("https://brave.com"),
                             mojom::ProviderError::kSuccess, ""));
   json_rpc_service_->UnstoppableDomainsResolveDns("brave.crypto",
@@ -2277,6 +2377,7 @@ TEST_F(UnstoppableDomainsUnitTest, ResolveDns_FallbackToEthMainnet) {
   base::RunLoop().RunUntilIdle();
   testing::Mock::VerifyAndClearExpectations(&callback);
 
+  json_rpc_service_->ClearDecentralizedDnsCache();
   EXPECT_CALL(callback, Run(GURL("https://brave.com"),
                             mojom::ProviderError::kSuccess, ""));
   json_rpc_service_->UnstoppableDomainsResolveDns("brave.crypto",
@@ -2352,6 +2453,55 @@ TEST_F(UnstoppableDomainsUnitTest, ResolveDns_ManyCalls) {
   base::RunLoop().RunUntilIdle();
 }
 
+TEST_F(UnstoppableDomainsUnitTest, ResolveDns_Cache) {
+  base::SimpleTestTickClock clock;
+  json_rpc_service_->SetClockForTesting(&clock);
+
+  base::MockCallback<ResolveDnsCallback> callback;
+  EXPECT_CALL(callback, Run(GURL("https://brave.com"),
+                            mojom::ProviderError::kSuccess, ""))
+      .Times(2);
+  json_rpc_service_->UnstoppableDomainsResolveDns("brave.crypto",
+                                                  callback.Get());
+  SetEthResponse(DnsIpfsResponse());
+  SetPolygonResponse(DnsBraveResponse());
+  base::RunLoop().RunUntilIdle();
+
+  json_rpc_service_->UnstoppableDomainsResolveDns("brave.crypto",
+                                                  callback.Get());
+  EXPECT_EQ(0, url_loader_factory_.NumPending());
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+
+  // Domains without a record are cached for a shorter time.
+  clock.Advance(JsonRpcService::kDnsResolutionCacheTtl);
+  EXPECT_CALL(callback, Run(GURL(), mojom::ProviderError::kSuccess, ""))
+      .Times(2);
+  json_rpc_service_->UnstoppableDomainsResolveDns("brave.crypto",
+                                                  callback.Get());
+  EXPECT_EQ(2, url_loader_factory_.NumPending());
+  SetEthResponse(DnsEmptyResponse());
+  SetPolygonResponse(DnsEmptyResponse());
+  base::RunLoop().RunUntilIdle();
+
+  json_rpc_service_->UnstoppableDomainsResolveDns("brave.crypto",
+                                                  callback.Get());
+  EXPECT_EQ(0, url_loader_factory_.NumPending());
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+
+  clock.Advance(JsonRpcService::kDnsNoResolutionCacheTtl);
+  EXPECT_CALL(callback,
+              Run(GURL(), mojom::ProviderError::kInternalError,
+                  l10n_util::GetStringUTF8(IDS_WALLET_INTERNAL_ERROR)));
+  json_rpc_service_->UnstoppableDomainsResolveDns("brave.crypto",
+                                                  callback.Get());
+  EXPECT_EQ(2, url_loader_factory_.NumPending());
+  SetEthResponse("");
+  SetPolygonResponse("");
+  base::RunLoop().RunUntilIdle();
+}
+
 TEST_F(JsonRpcServiceUnitTest, GetIsEip1559) {
   bool callback_called = false;
   GURL expected_network =
@@ -9,12 +9,14 @@
 #include <utility>
 
 #include "base/base64.h"
+#include "base/bind.h"
 #include "base/hash/hash.h"
 #include "base/logging.h"
 #include "base/strings/strcat.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "base/value_iterators.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
@@ -30,6 +32,7 @@
 #include "brave/components/brave_wallet/common/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/common/eth_address.h"
 #include "brave/components/brave_wallet/common/hex_utils.h"
+#include "brave/components/brave_wallet/common/mem_utils.h"
 #include "brave/components/brave_wallet/common/solana_utils.h"
 #include "components/grit/brave_components_strings.h"
 #include "components/prefs/pref_change_registrar.h"
@@ -121,6 +124,7 @@ const int kPbkdf2KeySize = 256;
 const char kRootPath[] = "m/44'/{coin}'";
 const char kPasswordEncryptorSalt[] = "password_encryptor_salt";
 const char kPasswordEncryptorNonce[] = "password_encryptor_nonce";
+const char kPasswordEncryptorHkdf[] = "password_encryptor_hkdf";
 const char kEncryptedMnemonic[] = "encrypted_mnemonic";
 const char kBackupComplete[] = "backup_complete";
 const char kAccountMetas[] = "account_metas";
@@ -137,6 +141,26 @@ const char kSelectedAccount[] = "selected_account";
 const int kDiscoveryAttempts = 20;
 const char kKeyringNotFound[] = "";
 
+// PBKDF2 is slow on purpose, so these run on a worker thread.
+std::unique_ptr<PasswordEncryptor> DeriveEncryptorFromPassword(
+    const std::string& password,
+    const std::vector<uint8_t>& salt) {
+  return PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
+      password, salt, kPbkdf2Iterations, kPbkdf2KeySize);
+}
+
+// Returns an encryptor for each keyring id of |salts|.
+base::flat_map<std::string, std::unique_ptr<PasswordEncryptor>>
+DeriveEncryptorsFromPassword(
+    const std::string& password,
+    const base::flat_map<std::string, std::vector<uint8_t>>& salts) {
+  base::flat_map<std::string, std::unique_ptr<PasswordEncryptor>> encryptors;
+  for (const auto& [keyring_id, salt] : salts) {
+    encryptors[keyring_id] = DeriveEncryptorFromPassword(password, salt);
+  }
+  return encryptors;
+}
+
 std::string GetRootPath(const std::string& keyring_id) {
   std::string root(kRootPath);
   auto coin = GetCoinForKeyring(keyring_id);
@@ -594,6 +618,11 @@ HDKeyring* KeyringService::ResumeKeyring(const std::string& keyring_id,
     return nullptr;
   }
 
+  return ResumeKeyringInternal(keyring_id);
+}
+
+HDKeyring* KeyringService::ResumeKeyringInternal(
+    const std::string& keyring_id) {
   const std::string mnemonic = GetMnemonicForKeyringImpl(keyring_id);
   bool is_legacy_brave_wallet = false;
   const base::Value* value =
@@ -1631,6 +1660,7 @@ absl::optional<std::string> KeyringService::GetFilecoinSelectedAccount(
 }
 
 void KeyringService::Lock() {
+  CancelPendingUnlock();
   if (IsLocked(mojom::kDefaultKeyringId))
     return;
 
@@ -1658,38 +1688,77 @@ bool KeyringService::IsHardwareAccount(const std::string& address) const {
 
 void KeyringService::Unlock(const std::string& password,
                             KeyringService::UnlockCallback callback) {
-  if (!ResumeKeyring(mojom::kDefaultKeyringId, password)) {
+  CancelPendingUnlock();
+
+  std::vector<uint8_t> salt(kSaltSize);
+  if (password.empty() ||
+      !GetPrefInBytesForKeyring(kPasswordEncryptorSalt, &salt,
+                                mojom::kDefaultKeyringId)) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  // Only the default keyring needs a key derived from the password, other
+  // keyrings use a subkey of it unless they were encrypted before with a key
+  // of their own.
+  base::flat_map<std::string, std::vector<uint8_t>> salts;
+  salts[mojom::kDefaultKeyringId] = std::move(salt);
+  for (const auto& keyring_id : GetNonDefaultKeyringIdsToUnlock()) {
+    std::vector<uint8_t> keyring_salt(kSaltSize);
+    if (!IsKeyringUsingHkdf(keyring_id) &&
+        HasEncryptedDataForKeyring(keyring_id) &&
+        GetPrefInBytesForKeyring(kPasswordEncryptorSalt, &keyring_salt,
+                                 keyring_id)) {
+      salts[keyring_id] = std::move(keyring_salt);
+    }
+  }
+
+  pending_unlock_callback_ = std::move(callback);
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&DeriveEncryptorsFromPassword, password,
+                     std::move(salts)),
+      base::BindOnce(&KeyringService::OnUnlockEncryptorsDerived,
+                     unlock_weak_factory_.GetWeakPtr(), password));
+}
+
+void KeyringService::OnUnlockEncryptorsDerived(
+    const std::string& password,
+    base::flat_map<std::string, std::unique_ptr<PasswordEncryptor>>
+        encryptors) {
+  UnlockCallback callback = std::move(pending_unlock_callback_);
+
+  encryptors_[mojom::kDefaultKeyringId] =
+      std::move(encryptors[mojom::kDefaultKeyringId]);
+  if (!ResumeKeyringInternal(mojom::kDefaultKeyringId)) {
     encryptors_.erase(mojom::kDefaultKeyringId);
     std::move(callback).Run(false);
     return;
   }
 
-  if (IsFilecoinEnabled()) {
-    if (!ResumeKeyring(mojom::kFilecoinKeyringId, password)) {
-      // If Filecoin keyring doesnt exist we keep encryptor pre-created
-      // to be able to lazily create keyring later
-      if (IsKeyringExist(mojom::kFilecoinKeyringId)) {
-        VLOG(1) << __func__ << " Unable to unlock filecoin keyring";
-        encryptors_.erase(mojom::kFilecoinKeyringId);
-        std::move(callback).Run(false);
-        return;
-      }
+  for (const auto& keyring_id : GetNonDefaultKeyringIdsToUnlock()) {
+    auto it = encryptors.find(keyring_id);
+    const bool has_own_key = it != encryptors.end();
+    if (has_own_key) {
+      encryptors_[keyring_id] = std::move(it->second);
     }
 
-    if (!ResumeKeyring(mojom::kFilecoinTestnetKeyringId, password)) {
-      if (IsKeyringExist(mojom::kFilecoinTestnetKeyringId)) {
-        VLOG(1) << __func__ << " Unable to unlock filecoin testnet keyring";
-        encryptors_.erase(mojom::kFilecoinTestnetKeyringId);
-        std::move(callback).Run(false);
-        return;
+    if ((has_own_key || CreateEncryptorForKeyring(password, keyring_id)) &&
+        ResumeKeyringInternal(keyring_id)) {
+      if (has_own_key && !MigrateKeyringToHkdf(keyring_id)) {
+        VLOG(1) << __func__ << " Unable to migrate " << keyring_id
+                << " keyring";
       }
+      continue;
     }
-  }
 
-  if (IsSolanaEnabled() && !ResumeKeyring(mojom::kSolanaKeyringId, password)) {
-    if (IsKeyringExist(mojom::kSolanaKeyringId)) {
-      VLOG(1) << __func__ << " Unable to unlock Solana keyring";
-      encryptors_.erase(mojom::kSolanaKeyringId);
+    // If keyring doesnt exist we keep encryptor pre-created to be able to
+    // lazily create keyring later
+    if (IsKeyringExist(keyring_id)) {
+      VLOG(1) << __func__ << " Unable to unlock " << keyring_id << " keyring";
+      encryptors_.erase(keyring_id);
       std::move(callback).Run(false);
       return;
     }
@@ -1705,6 +1774,26 @@ void KeyringService::Unlock(const std::string& password,
   std::move(callback).Run(true);
 }
 
+void KeyringService::CancelPendingUnlock() {
+  unlock_weak_factory_.InvalidateWeakPtrs();
+  if (pending_unlock_callback_) {
+    std::move(pending_unlock_callback_).Run(false);
+  }
+}
+
+std::vector<std::string> KeyringService::GetNonDefaultKeyringIdsToUnlock()
+    const {
+  std::vector<std::string> keyring_ids;
+  if (IsFilecoinEnabled()) {
+    keyring_ids.push_back(mojom::kFilecoinKeyringId);
+    keyring_ids.push_back(mojom::kFilecoinTestnetKeyringId);
+  }
+  if (IsSolanaEnabled()) {
+    keyring_ids.push_back(mojom::kSolanaKeyringId);
+  }
+  return keyring_ids;
+}
+
 void KeyringService::OnAutoLockFired() {
   Lock();
 }
@@ -1714,6 +1803,7 @@ void KeyringService::IsLocked(IsLockedCallback callback) {
 }
 
 void KeyringService::Reset(bool notify_observer) {
+  CancelPendingUnlock();
   StopAutoLockTimer();
   encryptors_.clear();
   keyrings_.clear();
@@ -1789,11 +1879,101 @@ bool KeyringService::CreateEncryptorForKeyring(const std::string& password,
     crypto::RandBytes(salt);
     SetPrefInBytesForKeyring(kPasswordEncryptorSalt, salt, id);
   }
-  encryptors_[id] = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
-      password, salt, kPbkdf2Iterations, kPbkdf2KeySize);
+
+  // Non default keyrings use a subkey of the default keyring key, so that
+  // PBKDF2 runs once per password. Keyrings which were encrypted with a key of
+  // their own keep it until they are migrated on unlock.
+  if (id != mojom::kDefaultKeyringId) {
+    if (!IsLocked(mojom::kDefaultKeyringId) &&
+        (IsKeyringUsingHkdf(id) || !HasEncryptedDataForKeyring(id))) {
+      encryptors_[id] =
+          encryptors_[mojom::kDefaultKeyringId]->DeriveKeyUsingHkdf(salt, id);
+      SetPrefForKeyring(prefs_, kPasswordEncryptorHkdf, base::Value(true), id);
+      return encryptors_[id] != nullptr;
+    }
+    if (IsKeyringUsingHkdf(id))
+      return false;
+  }
+
+  encryptors_[id] = DeriveEncryptorFromPassword(password, salt);
   return encryptors_[id] != nullptr;
 }
 
+bool KeyringService::IsKeyringUsingHkdf(const std::string& id) const {
+  const base::Value* value =
+      GetPrefForKeyring(prefs_, kPasswordEncryptorHkdf, id);
+  return value && value->GetIfBool().value_or(false);
+}
+
+bool KeyringService::HasEncryptedDataForKeyring(const std::string& id) const {
+  return IsKeyringCreated(id) ||
+         !GetImportedAccountsForKeyring(prefs_, id).empty();
+}
+
+bool KeyringService::MigrateKeyringToHkdf(const std::string& id) {
+  DCHECK_NE(id, mojom::kDefaultKeyringId);
+  if (IsLocked(mojom::kDefaultKeyringId) || IsLocked(id) ||
+      IsKeyringUsingHkdf(id)) {
+    return false;
+  }
+
+  std::vector<uint8_t> salt(kSaltSize);
+  if (!GetPrefInBytesForKeyring(kPasswordEncryptorSalt, &salt, id))
+    return false;
+  std::unique_ptr<PasswordEncryptor> encryptor =
+      encryptors_[mojom::kDefaultKeyringId]->DeriveKeyUsingHkdf(salt, id);
+  if (!encryptor)
+    return false;
+
+  // Re-encrypt everything which was encrypted with the old key before storing
+  // anything, so that a failure leaves the keyring untouched.
+  const std::vector<uint8_t> nonce = GetOrCreateNonceForKeyring(id);
+  auto reencrypt = [&](base::span<const uint8_t> ciphertext,
+                       std::vector<uint8_t>* new_ciphertext) {
+    std::vector<uint8_t> plaintext;
+    bool result = encryptors_[id]->Decrypt(ciphertext, nonce, &plaintext) &&
+                  encryptor->Encrypt(plaintext, nonce, new_ciphertext);
+    SecureZeroData(plaintext.data(), plaintext.size());
+    return result;
+  };
+
+  std::vector<uint8_t> encrypted_mnemonic;
+  std::vector<uint8_t> new_encrypted_mnemonic;
+  const bool has_mnemonic =
+      GetPrefInBytesForKeyring(kEncryptedMnemonic, &encrypted_mnemonic, id);
+  if (has_mnemonic && !reencrypt(encrypted_mnemonic, &new_encrypted_mnemonic))
+    return false;
+
+  base::Value imported_accounts(base::Value::Type::LIST);
+  const base::Value* value = GetPrefForKeyring(prefs_, kImportedAccounts, id);
+  const bool has_imported_accounts = value != nullptr;
+  if (has_imported_accounts)
+    imported_accounts = value->Clone();
+  for (auto& imported_account : imported_accounts.GetList()) {
+    const std::string* encrypted_private_key =
+        imported_account.FindStringKey(kEncryptedPrivateKey);
+    std::string private_key_decoded;
+    if (!encrypted_private_key ||
+        !base::Base64Decode(*encrypted_private_key, &private_key_decoded)) {
+      continue;
+    }
+    std::vector<uint8_t> new_encrypted_private_key;
+    if (!reencrypt(ToSpan(private_key_decoded), &new_encrypted_private_key))
+      return false;
+    imported_account.SetStringKey(
+        kEncryptedPrivateKey, base::Base64Encode(new_encrypted_private_key));
+  }
+
+  if (has_mnemonic)
+    SetPrefInBytesForKeyring(kEncryptedMnemonic, new_encrypted_mnemonic, id);
+  if (has_imported_accounts)
+    SetPrefForKeyring(prefs_, kImportedAccounts, std::move(imported_accounts),
+                      id);
+  SetPrefForKeyring(prefs_, kPasswordEncryptorHkdf, base::Value(true), id);
+  encryptors_[id] = std::move(encryptor);
+  return true;
+}
+
 bool KeyringService::CreateKeyringInternal(const std::string& keyring_id,
                                            const std::string& mnemonic,
                                            bool is_legacy_brave_wallet) {
@@ -2099,10 +2279,19 @@ void KeyringService::ValidatePassword(const std::string& password,
     return;
   }
 
-  // TODO(apaymyshev): move this call(and other ones in this file) to background
-  // thread.
-  auto encryptor = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
-      password, salt, kPbkdf2Iterations, kPbkdf2KeySize);
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&DeriveEncryptorFromPassword, password, std::move(salt)),
+      base::BindOnce(&KeyringService::OnValidatePasswordEncryptorDerived,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(callback)));
+}
+
+void KeyringService::OnValidatePasswordEncryptorDerived(
+    ValidatePasswordCallback callback,
+    std::unique_ptr<PasswordEncryptor> encryptor) {
+  const std::string keyring_id = mojom::kDefaultKeyringId;
   if (!encryptor) {
     std::move(callback).Run(false);
     return;
@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
@@ -280,6 +281,8 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, ImportFilecoinAccounts);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, PreCreateEncryptors);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, HardwareAccounts);
+  FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, UnlockMigratesToHkdf);
+  FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, LockCancelsPendingUnlock);
 
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceAccountDiscoveryUnitTest,
                            AccountDiscovery);
@@ -350,6 +353,12 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   std::vector<uint8_t> GetOrCreateNonceForKeyring(const std::string& id);
   bool CreateEncryptorForKeyring(const std::string& password,
                                  const std::string& id);
+  // Whether the key of keyring |id| is derived from the default keyring key.
+  bool IsKeyringUsingHkdf(const std::string& id) const;
+  bool HasEncryptedDataForKeyring(const std::string& id) const;
+  // Re-encrypts keyring |id|, unlocked with a key derived from the password,
+  // with a key derived from the default keyring key.
+  bool MigrateKeyringToHkdf(const std::string& id);
   bool CreateKeyringInternal(const std::string& keyring_id,
                              const std::string& mnemonic,
                              bool is_legacy_brave_wallet);
@@ -366,6 +375,19 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   // It's used to reconstruct same default keyring between browser relaunch
   HDKeyring* ResumeKeyring(const std::string& keyring_id,
                            const std::string& password);
+  // Same as ResumeKeyring with an encryptor already created.
+  HDKeyring* ResumeKeyringInternal(const std::string& keyring_id);
+
+  void OnUnlockEncryptorsDerived(
+      const std::string& password,
+      base::flat_map<std::string, std::unique_ptr<PasswordEncryptor>>
+          encryptors);
+  // Runs the callback of an unlock still deriving keys with false.
+  void CancelPendingUnlock();
+  std::vector<std::string> GetNonDefaultKeyringIdsToUnlock() const;
+  void OnValidatePasswordEncryptorDerived(
+      ValidatePasswordCallback callback,
+      std::unique_ptr<PasswordEncryptor> encryptor);
 
   void NotifyAccountsChanged();
   void StopAutoLockTimer();
@@ -395,11 +417,14 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   raw_ptr<JsonRpcService> json_rpc_service_;
   raw_ptr<PrefService> prefs_ = nullptr;
   bool request_unlock_pending_ = false;
+  UnlockCallback pending_unlock_callback_;
 
   mojo::RemoteSet<mojom::KeyringServiceObserver> observers_;
   mojo::ReceiverSet<mojom::KeyringService> receivers_;
 
   base::WeakPtrFactory<KeyringService> discovery_weak_factory_{this};
+  base::WeakPtrFactory<KeyringService> unlock_weak_factory_{this};
+  base::WeakPtrFactory<KeyringService> weak_ptr_factory_{this};
 
   KeyringService(const KeyringService&) = delete;
   KeyringService& operator=(const KeyringService&) = delete;
@@ -9,6 +9,7 @@
 
 #include "brave/components/brave_wallet/common/mem_utils.h"
 #include "crypto/aead.h"
+#include "crypto/hkdf.h"
 #include "crypto/openssl_util.h"
 #include "third_party/boringssl/src/include/openssl/evp.h"
 
@@ -43,6 +44,16 @@ PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
   return rv == 1 ? std::move(encryptor) : nullptr;
 }
 
+std::unique_ptr<PasswordEncryptor> PasswordEncryptor::DeriveKeyUsingHkdf(
+    base::span<const uint8_t> salt,
+    base::StringPiece info) const {
+  std::vector<uint8_t> key = crypto::HkdfSha256(
+      key_, salt, base::as_bytes(base::make_span(info)), key_.size());
+  std::unique_ptr<PasswordEncryptor> encryptor(new PasswordEncryptor(key));
+  SecureZeroData(key.data(), key.size());
+  return encryptor;
+}
+
 bool PasswordEncryptor::Encrypt(base::span<const uint8_t> plaintext,
                                 base::span<const uint8_t> nonce,
                                 std::vector<uint8_t>* ciphertext) {
@@ -12,6 +12,7 @@
 
 #include "base/containers/span.h"
 #include "base/gtest_prod_util.h"
+#include "base/strings/string_piece.h"
 
 namespace brave_wallet {
 
@@ -27,6 +28,12 @@ class PasswordEncryptor {
       size_t iterations,
       size_t key_size_in_bits);
 
+  // Derives a key of the same size from this key for |info| using HKDF with
+  // SHA 256 digest, so that one password derived key can serve several uses.
+  std::unique_ptr<PasswordEncryptor> DeriveKeyUsingHkdf(
+      base::span<const uint8_t> salt,
+      base::StringPiece info) const;
+
   bool Encrypt(base::span<const uint8_t> plaintext,
                base::span<const uint8_t> nonce,
                std::vector<uint8_t>* ciphertext);
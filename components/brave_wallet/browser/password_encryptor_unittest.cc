@@ -31,6 +31,34 @@ TEST(PasswordEncryptorUnitTest, DeriveKeyFromPasswordUsingPbkdf2) {
             nullptr);
 }
 
+TEST(PasswordEncryptorUnitTest, DeriveKeyUsingHkdf) {
+  std::unique_ptr<PasswordEncryptor> encryptor =
+      PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
+          "password", ToSpan("salt"), 100, 256);
+  std::unique_ptr<PasswordEncryptor> subkey_encryptor =
+      encryptor->DeriveKeyUsingHkdf(ToSpan("salt2"), "info");
+  ASSERT_NE(subkey_encryptor, nullptr);
+
+  const std::vector<uint8_t> nonce(12, 0xAB);
+  std::vector<uint8_t> ciphertext;
+  EXPECT_TRUE(subkey_encryptor->Encrypt(ToSpan("bravo"), nonce, &ciphertext));
+  std::vector<uint8_t> plaintext;
+  EXPECT_FALSE(encryptor->Decrypt(ciphertext, nonce, &plaintext));
+
+  // Same inputs derive the same key
+  plaintext.clear();
+  EXPECT_TRUE(encryptor->DeriveKeyUsingHkdf(ToSpan("salt2"), "info")
+                  ->Decrypt(ciphertext, nonce, &plaintext));
+  EXPECT_EQ(std::string(plaintext.begin(), plaintext.end()), "bravo");
+
+  // Different salt or info derive another key
+  plaintext.clear();
+  EXPECT_FALSE(encryptor->DeriveKeyUsingHkdf(ToSpan("salt3"), "info")
+                   ->Decrypt(ciphertext, nonce, &plaintext));
+  EXPECT_FALSE(encryptor->DeriveKeyUsingHkdf(ToSpan("salt2"), "info2")
+                   ->Decrypt(ciphertext, nonce, &plaintext));
+}
+
 TEST(PasswordEncryptorUnitTest, EncryptAndDecrypt) {
   std::unique_ptr<PasswordEncryptor> encryptor =
       PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
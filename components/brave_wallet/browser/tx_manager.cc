@@ -94,12 +94,20 @@ void TxManager::CheckIfBlockTrackerShouldRun() {
   bool locked = keyring_service_->IsLocked();
   bool running = block_tracker_->IsRunning();
   if (!locked && !running) {
-    block_tracker_->Start(base::Seconds(kBlockTrackerDefaultTimeInSeconds));
+    block_tracker_->Start(GetBlockTrackerInterval());
   } else if ((locked || known_no_pending_tx_) && running) {
     block_tracker_->Stop();
+  } else if (running) {
+    const base::TimeDelta interval = GetBlockTrackerInterval();
+    if (block_tracker_->GetInterval() != interval)
+      block_tracker_->Start(interval);
   }
 }
 
+base::TimeDelta TxManager::GetBlockTrackerInterval() {
+  return base::Seconds(kBlockTrackerDefaultTimeInSeconds);
+}
+
 void TxManager::OnTransactionStatusChanged(mojom::TransactionInfoPtr tx_info) {
   tx_service_->OnTransactionStatusChanged(tx_info->Clone());
 }
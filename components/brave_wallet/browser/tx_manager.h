@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 
+#include "base/time/time.h"
 #include "brave/components/brave_wallet/browser/tx_state_manager.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "mojo/public/cpp/bindings/receiver.h"
@@ -77,6 +78,8 @@ class TxManager : public TxStateManager::Observer,
 
  protected:
   void CheckIfBlockTrackerShouldRun();
+  // Returns how often the block tracker should poll for the latest block.
+  virtual base::TimeDelta GetBlockTrackerInterval();
   virtual void UpdatePendingTransactions() = 0;
 
   std::unique_ptr<TxStateManager> tx_state_manager_;
@@ -14,6 +14,7 @@
 #include "base/no_destructor.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/single_thread_task_runner.h"
 #include "base/trace_event/trace_event.h"
 #include "brave/components/brave_shields/common/features.h"
 #include "brave/components/content_settings/renderer/brave_content_settings_agent_impl.h"
@@ -24,6 +25,7 @@
 #include "gin/function_template.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 #include "third_party/blink/public/common/browser_interface_broker_proxy.h"
+#include "third_party/blink/public/platform/task_type.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_css_origin.h"
 #include "third_party/blink/public/web/web_document.h"
@@ -78,6 +80,10 @@ const char kCosmeticFilteringInitScript[] =
          window.content_cosmetic.generichide = %s;
        })";
 
+// Selectors found by the content_cosmetic script keep arriving while the page
+// mutates, so they are injected at most once per frame at 60Hz.
+constexpr base::TimeDelta kStylesheetFlushInterval = base::Seconds(1) / 60;
+
 const char kHideSelectorsInjectScript[] =
     R"((function() {
           let nextIndex =
@@ -143,7 +149,13 @@ CosmeticFiltersJSHandler::CosmeticFiltersJSHandler(
     const int32_t isolated_world_id)
     : render_frame_(render_frame),
       isolated_world_id_(isolated_world_id),
-      enabled_1st_party_cf_(false) {
+      enabled_1st_party_cf_(false),
+      hide_rules_batcher_(
+          render_frame->GetTaskRunner(blink::TaskType::kInternalDefault),
+          kStylesheetFlushInterval,
+          base::BindRepeating(
+              &CosmeticFiltersJSHandler::InjectPendingStylesheet,
+              base::Unretained(this))) {
   EnsureConnected();
 }
 
@@ -266,6 +278,7 @@ bool CosmeticFiltersJSHandler::ProcessURL(
   resources_dict_ = absl::nullopt;
   url_ = url;
   enabled_1st_party_cf_ = false;
+  hide_rules_batcher_.Reset();
 
   // Trivially, don't make exceptions for malformed URLs.
   if (!EnsureConnected() || url_.is_empty() || !url_.is_valid())
@@ -364,7 +377,6 @@ void CosmeticFiltersJSHandler::ApplyRules(bool de_amp_enabled) {
 
 void CosmeticFiltersJSHandler::CSSRulesRoutine(
     const base::Value::Dict& resources_dict) {
-  blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
   const auto* cf_exceptions_list = resources_dict.FindList("exceptions");
   if (cf_exceptions_list) {
     for (const auto& item : *cf_exceptions_list) {
@@ -385,34 +397,17 @@ void CosmeticFiltersJSHandler::CSSRulesRoutine(
     // treat `hide_selectors` the same as `force_hide_selectors` if aggressive
     // mode is enabled.
     if (enabled_1st_party_cf_) {
-      for (auto& selector : *hide_selectors_list) {
-        DCHECK(selector.is_string());
-        stylesheet += selector.GetString() + "{display:none !important}";
-      }
+      hide_rules_batcher_.AppendHideRules(*hide_selectors_list, &stylesheet);
     } else {
-      std::string json_selectors;
-      base::JSONWriter::Write(*hide_selectors_list, &json_selectors);
-      if (json_selectors.empty()) {
-        json_selectors = "[]";
-      }
-      // Building a script for stylesheet modifications
-      std::string new_selectors_script = base::StringPrintf(
-          kHideSelectorsInjectScript, json_selectors.c_str());
-      web_frame->ExecuteScriptInIsolatedWorld(
-          isolated_world_id_,
-          blink::WebScriptSource(
-              blink::WebString::FromUTF8(new_selectors_script)),
-          blink::BackForwardCacheAware::kAllow);
+      InjectScriptHideSelectors(*hide_selectors_list);
     }
   }
 
   const auto* force_hide_selectors_list =
       resources_dict.FindList("force_hide_selectors");
   if (force_hide_selectors_list) {
-    for (auto& selector : *force_hide_selectors_list) {
-      DCHECK(selector.is_string());
-      stylesheet += selector.GetString() + "{display:none !important}";
-    }
+    hide_rules_batcher_.AppendHideRules(*force_hide_selectors_list,
+                                        &stylesheet);
   }
 
   const auto* style_selectors_dictionary =
@@ -446,55 +441,67 @@ void CosmeticFiltersJSHandler::OnHiddenClassIdSelectors(base::Value result) {
 
   DCHECK(result.is_dict());
 
-  base::Value* hide_selectors = result.FindListKey("hide_selectors");
+  const base::Value::List* hide_selectors =
+      result.GetDict().FindList("hide_selectors");
   DCHECK(hide_selectors);
 
-  base::Value* force_hide_selectors =
-      result.FindListKey("force_hide_selectors");
+  const base::Value::List* force_hide_selectors =
+      result.GetDict().FindList("force_hide_selectors");
   DCHECK(force_hide_selectors);
 
-  if (force_hide_selectors->GetList().size() != 0) {
-    std::string stylesheet = "";
-    for (auto& selector : force_hide_selectors->GetList()) {
-      DCHECK(selector.is_string());
-      stylesheet += selector.GetString() + "{display:none !important}";
-    }
-    InjectStylesheet(stylesheet);
-  }
+  std::string stylesheet;
+  hide_rules_batcher_.AppendHideRules(*force_hide_selectors, &stylesheet);
 
   // If its a vetted engine AND we're not in aggressive
   // mode, don't check elements from the default engine (in hide_selectors).
-  if (!enabled_1st_party_cf_ && IsVettedSearchEngine(url_))
+  if (!enabled_1st_party_cf_ && IsVettedSearchEngine(url_)) {
+    hide_rules_batcher_.QueueStylesheet(stylesheet);
     return;
+  }
 
   if (enabled_1st_party_cf_) {
-    std::string stylesheet = "";
-    for (auto& selector : hide_selectors->GetList()) {
-      DCHECK(selector.is_string());
-      stylesheet += selector.GetString() + "{display:none !important}";
-    }
-    InjectStylesheet(stylesheet);
+    hide_rules_batcher_.AppendHideRules(*hide_selectors, &stylesheet);
+    hide_rules_batcher_.QueueStylesheet(stylesheet);
   } else {
-    blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*hide_selectors, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
-    // Building a script for stylesheet modifications
-    std::string new_selectors_script =
-        base::StringPrintf(kHideSelectorsInjectScript, json_selectors.c_str());
-    if (hide_selectors->GetList().size() != 0) {
-      web_frame->ExecuteScriptInIsolatedWorld(
-          isolated_world_id_,
-          blink::WebScriptSource(
-              blink::WebString::FromUTF8(new_selectors_script)),
-          blink::BackForwardCacheAware::kAllow);
-    }
+    hide_rules_batcher_.QueueStylesheet(stylesheet);
+    InjectScriptHideSelectors(*hide_selectors);
+    ExecuteObservingBundleEntryPoint();
+  }
+}
+
+void CosmeticFiltersJSHandler::InjectScriptHideSelectors(
+    const base::Value::List& selectors) {
+  // Rules in the content_cosmetic stylesheet can be removed again once the
+  // script finds first party content, so selectors can't take the user
+  // stylesheet path here. Skipping those the script already has at least
+  // saves compiling a script for batches without new selectors.
+  const base::Value::List new_selectors =
+      hide_rules_batcher_.FilterScriptHideSelectors(selectors);
+  if (new_selectors.empty())
+    return;
 
-    if (!enabled_1st_party_cf_)
-      ExecuteObservingBundleEntryPoint();
+  std::string json_selectors;
+  if (!base::JSONWriter::Write(new_selectors, &json_selectors) ||
+      json_selectors.empty()) {
+    return;
   }
+
+  // Building a script for stylesheet modifications
+  std::string new_selectors_script =
+      base::StringPrintf(kHideSelectorsInjectScript, json_selectors.c_str());
+  render_frame_->GetWebFrame()->ExecuteScriptInIsolatedWorld(
+      isolated_world_id_,
+      blink::WebScriptSource(blink::WebString::FromUTF8(new_selectors_script)),
+      blink::BackForwardCacheAware::kAllow);
+}
+
+bool CosmeticFiltersJSHandler::InjectPendingStylesheet(
+    const std::string& stylesheet) {
+  if (render_frame_->GetWebFrame()->IsProvisional())
+    return false;
+
+  InjectStylesheet(stylesheet);
+  return true;
 }
 
 void CosmeticFiltersJSHandler::ExecuteObservingBundleEntryPoint() {
@@ -12,7 +12,9 @@
 
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
+#include "brave/components/cosmetic_filters/renderer/hide_rules_batcher.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "mojo/public/cpp/bindings/remote.h"
@@ -70,6 +72,11 @@ class CosmeticFiltersJSHandler {
 
   void InjectStylesheet(const std::string& stylesheet);
 
+  void InjectScriptHideSelectors(const base::Value::List& selectors);
+  // Called by |hide_rules_batcher_| with the coalesced rules of the
+  // |OnHiddenClassIdSelectors| batches.
+  bool InjectPendingStylesheet(const std::string& stylesheet);
+
   bool generichide_ = false;
 
   raw_ptr<content::RenderFrame> render_frame_ = nullptr;
@@ -84,6 +91,8 @@ class CosmeticFiltersJSHandler {
   // True if the content_cosmetic.bundle.js has injected in the current frame.
   bool bundle_injected_ = false;
 
+  HideRulesBatcher hide_rules_batcher_;
+
   base::WeakPtrFactory<CosmeticFiltersJSHandler> weak_ptr_factory_{this};
 };
 
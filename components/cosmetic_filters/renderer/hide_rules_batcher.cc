@@ -0,0 +1,110 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/cosmetic_filters/renderer/hide_rules_batcher.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/check.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/trace_event/trace_event.h"
+
+namespace cosmetic_filters {
+
+namespace {
+
+const char kHideRule[] = "{display:none !important}";
+
+}  // namespace
+
+HideRulesBatcher::HideRulesBatcher(
+    scoped_refptr<base::SequencedTaskRunner> task_runner,
+    base::TimeDelta flush_interval,
+    InjectStylesheetCallback inject_stylesheet)
+    : task_runner_(std::move(task_runner)),
+      flush_interval_(flush_interval),
+      inject_stylesheet_(std::move(inject_stylesheet)) {}
+
+HideRulesBatcher::~HideRulesBatcher() = default;
+
+void HideRulesBatcher::Reset() {
+  stylesheet_hide_selectors_.clear();
+  script_hide_selectors_.clear();
+  pending_stylesheet_.clear();
+}
+
+void HideRulesBatcher::AppendHideRules(const base::Value::List& selectors,
+                                       std::string* stylesheet) {
+  DCHECK(stylesheet);
+
+  for (const auto& selector : selectors) {
+    DCHECK(selector.is_string());
+    const std::string& selector_string = selector.GetString();
+    if (!stylesheet_hide_selectors_.insert(selector_string).second)
+      continue;
+
+    *stylesheet += selector_string + kHideRule;
+  }
+}
+
+base::Value::List HideRulesBatcher::FilterScriptHideSelectors(
+    const base::Value::List& selectors) {
+  base::Value::List new_selectors;
+  for (const auto& selector : selectors) {
+    if (!selector.is_string() ||
+        !script_hide_selectors_.insert(selector.GetString()).second) {
+      continue;
+    }
+
+    new_selectors.Append(selector.GetString());
+  }
+
+  return new_selectors;
+}
+
+void HideRulesBatcher::QueueStylesheet(const std::string& stylesheet) {
+  if (stylesheet.empty())
+    return;
+
+  pending_stylesheet_ += stylesheet;
+  ScheduleFlush();
+}
+
+void HideRulesBatcher::ScheduleFlush() {
+  if (flush_scheduled_)
+    return;
+
+  flush_scheduled_ = true;
+  const base::TimeDelta delay =
+      std::max(base::TimeDelta(),
+               last_flush_ + flush_interval_ - base::TimeTicks::Now());
+  task_runner_->PostDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&HideRulesBatcher::FlushPendingStylesheet,
+                     weak_ptr_factory_.GetWeakPtr()),
+      delay);
+}
+
+void HideRulesBatcher::FlushPendingStylesheet() {
+  flush_scheduled_ = false;
+  last_flush_ = base::TimeTicks::Now();
+
+  if (pending_stylesheet_.empty())
+    return;
+
+  TRACE_EVENT1("brave.adblock", "FlushPendingStylesheet", "size",
+               pending_stylesheet_.size());
+  if (!inject_stylesheet_.Run(pending_stylesheet_)) {
+    // Retry even if no further rules arrive for this document.
+    ScheduleFlush();
+    return;
+  }
+
+  pending_stylesheet_.clear();
+}
+
+}  // namespace cosmetic_filters
@@ -0,0 +1,81 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_HIDE_RULES_BATCHER_H_
+#define BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_HIDE_RULES_BATCHER_H_
+
+#include <string>
+#include <unordered_set>
+
+#include "base/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/values.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace cosmetic_filters {
+
+// Keeps track of the hide selectors applied to the current document, and
+// coalesces the hide rules that keep arriving while the page mutates into a
+// single user stylesheet per |flush_interval|.
+class HideRulesBatcher {
+ public:
+  // Injects a user stylesheet. Returns false if the frame can't take it yet,
+  // in which case the rules stay pending and the flush is retried after
+  // |flush_interval|.
+  using InjectStylesheetCallback =
+      base::RepeatingCallback<bool(const std::string&)>;
+
+  HideRulesBatcher(scoped_refptr<base::SequencedTaskRunner> task_runner,
+                   base::TimeDelta flush_interval,
+                   InjectStylesheetCallback inject_stylesheet);
+  ~HideRulesBatcher();
+
+  HideRulesBatcher(const HideRulesBatcher&) = delete;
+  HideRulesBatcher& operator=(const HideRulesBatcher&) = delete;
+
+  // Forgets the selectors of the previous document.
+  void Reset();
+
+  // Appends a hide rule for each of |selectors| not hidden yet in the current
+  // document to |stylesheet|.
+  void AppendHideRules(const base::Value::List& selectors,
+                       std::string* stylesheet);
+  // Returns the selectors not passed to the content_cosmetic script yet in the
+  // current document, or an empty list.
+  base::Value::List FilterScriptHideSelectors(
+      const base::Value::List& selectors);
+
+  // Injects |stylesheet| together with all the rules queued until the next
+  // flush.
+  void QueueStylesheet(const std::string& stylesheet);
+
+ private:
+  void ScheduleFlush();
+  void FlushPendingStylesheet();
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  const base::TimeDelta flush_interval_;
+  InjectStylesheetCallback inject_stylesheet_;
+
+  // Selectors hidden by a user stylesheet in the current document.
+  std::unordered_set<std::string> stylesheet_hide_selectors_;
+  // Selectors passed to the content_cosmetic script in the current document,
+  // which takes care of unhiding first party content.
+  std::unordered_set<std::string> script_hide_selectors_;
+  std::string pending_stylesheet_;
+  bool flush_scheduled_ = false;
+  base::TimeTicks last_flush_;
+
+  base::WeakPtrFactory<HideRulesBatcher> weak_ptr_factory_{this};
+};
+
+}  // namespace cosmetic_filters
+
+#endif  // BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_HIDE_RULES_BATCHER_H_
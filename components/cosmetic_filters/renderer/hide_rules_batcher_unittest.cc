@@ -0,0 +1,156 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/cosmetic_filters/renderer/hide_rules_batcher.h"
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/test/task_environment.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=HideRulesBatcherTest*
+
+namespace cosmetic_filters {
+
+namespace {
+
+constexpr base::TimeDelta kFlushInterval = base::Milliseconds(16);
+
+base::Value::List ToList(const std::vector<std::string>& selectors) {
+  base::Value::List list;
+  for (const auto& selector : selectors)
+    list.Append(selector);
+  return list;
+}
+
+}  // namespace
+
+class HideRulesBatcherTest : public testing::Test {
+ public:
+  HideRulesBatcherTest()
+      : batcher_(base::SequencedTaskRunnerHandle::Get(),
+                 kFlushInterval,
+                 base::BindRepeating(&HideRulesBatcherTest::InjectStylesheet,
+                                     base::Unretained(this))) {}
+
+ protected:
+  bool InjectStylesheet(const std::string& stylesheet) {
+    if (!can_inject_)
+      return false;
+    injected_stylesheets_.push_back(stylesheet);
+    return true;
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  bool can_inject_ = true;
+  std::vector<std::string> injected_stylesheets_;
+  HideRulesBatcher batcher_;
+};
+
+TEST_F(HideRulesBatcherTest, AppendsEachSelectorOnce) {
+  std::string stylesheet;
+  batcher_.AppendHideRules(ToList({".ad", "#banner", ".ad"}), &stylesheet);
+  EXPECT_EQ(".ad{display:none !important}#banner{display:none !important}",
+            stylesheet);
+
+  stylesheet.clear();
+  batcher_.AppendHideRules(ToList({"#banner", ".promo"}), &stylesheet);
+  EXPECT_EQ(".promo{display:none !important}", stylesheet);
+
+  // A new document starts over.
+  batcher_.Reset();
+  stylesheet.clear();
+  batcher_.AppendHideRules(ToList({".ad"}), &stylesheet);
+  EXPECT_EQ(".ad{display:none !important}", stylesheet);
+}
+
+TEST_F(HideRulesBatcherTest, FiltersScriptHideSelectors) {
+  EXPECT_EQ(ToList({".ad", "#banner"}),
+            batcher_.FilterScriptHideSelectors(ToList({".ad", "#banner"})));
+  EXPECT_EQ(ToList({".promo"}), batcher_.FilterScriptHideSelectors(
+                                    ToList({"#banner", ".promo", ".ad"})));
+  EXPECT_TRUE(batcher_.FilterScriptHideSelectors(ToList({".ad"})).empty());
+
+  // Selectors hidden by a user stylesheet are tracked separately, since the
+  // script can unhide its own.
+  std::string stylesheet;
+  batcher_.AppendHideRules(ToList({".ad"}), &stylesheet);
+  EXPECT_FALSE(stylesheet.empty());
+
+  batcher_.Reset();
+  EXPECT_EQ(ToList({".ad"}),
+            batcher_.FilterScriptHideSelectors(ToList({".ad"})));
+}
+
+TEST_F(HideRulesBatcherTest, CoalescesStylesheetsWithinInterval) {
+  batcher_.QueueStylesheet(".a{display:none !important}");
+  batcher_.QueueStylesheet("");
+  batcher_.QueueStylesheet(".b{display:none !important}");
+  EXPECT_TRUE(injected_stylesheets_.empty());
+
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ((std::vector<std::string>{".a{display:none !important}"
+                                      ".b{display:none !important}"}),
+            injected_stylesheets_);
+
+  // The next batch waits for the rest of the interval.
+  batcher_.QueueStylesheet(".c{display:none !important}");
+  task_environment_.FastForwardBy(kFlushInterval / 2);
+  EXPECT_EQ(1u, injected_stylesheets_.size());
+  batcher_.QueueStylesheet(".d{display:none !important}");
+  task_environment_.FastForwardBy(kFlushInterval / 2);
+  EXPECT_EQ((std::vector<std::string>{".a{display:none !important}"
+                                      ".b{display:none !important}",
+                                      ".c{display:none !important}"
+                                      ".d{display:none !important}"}),
+            injected_stylesheets_);
+
+  // Nothing queued, nothing injected.
+  task_environment_.FastForwardBy(kFlushInterval * 2);
+  EXPECT_EQ(2u, injected_stylesheets_.size());
+}
+
+TEST_F(HideRulesBatcherTest, KeepsRulesUntilFrameCanTakeThem) {
+  can_inject_ = false;
+  batcher_.QueueStylesheet(".a{display:none !important}");
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(injected_stylesheets_.empty());
+
+  can_inject_ = true;
+  batcher_.QueueStylesheet(".b{display:none !important}");
+  task_environment_.FastForwardBy(kFlushInterval);
+  EXPECT_EQ((std::vector<std::string>{".a{display:none !important}"
+                                      ".b{display:none !important}"}),
+            injected_stylesheets_);
+}
+
+TEST_F(HideRulesBatcherTest, RetriesFlushWithoutFurtherRules) {
+  can_inject_ = false;
+  batcher_.QueueStylesheet(".a{display:none !important}");
+  task_environment_.FastForwardBy(kFlushInterval * 3);
+  EXPECT_TRUE(injected_stylesheets_.empty());
+
+  can_inject_ = true;
+  task_environment_.FastForwardBy(kFlushInterval);
+  EXPECT_EQ((std::vector<std::string>{".a{display:none !important}"}),
+            injected_stylesheets_);
+
+  // Nothing is left to retry.
+  task_environment_.FastForwardBy(kFlushInterval * 2);
+  EXPECT_EQ(1u, injected_stylesheets_.size());
+}
+
+TEST_F(HideRulesBatcherTest, ResetDropsPendingRules) {
+  batcher_.QueueStylesheet(".a{display:none !important}");
+  batcher_.Reset();
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(injected_stylesheets_.empty());
+}
+
+}  // namespace cosmetic_filters
@@ -270,12 +270,15 @@ void GreaselionDownloadService::LoadDirectlyFromResourcePath() {
       base::BindOnce(&brave_component_updater::GetDATFileAsString,
                      dat_file_path),
       base::BindOnce(&GreaselionDownloadService::OnDATFileDataReady,
-                     weak_factory_.GetWeakPtr()));
+                     weak_factory_.GetWeakPtr(), component_version_));
 }
 
-void GreaselionDownloadService::OnDATFileDataReady(std::string contents) {
+void GreaselionDownloadService::OnDATFileDataReady(
+    const std::string& rules_version,
+    std::string contents) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   rules_.clear();
+  rules_version_ = rules_version;
   if (contents.empty()) {
     LOG(ERROR) << "Could not obtain Greaselion configuration";
     return;
@@ -321,6 +324,12 @@ void GreaselionDownloadService::OnComponentReady(
     return;
   }
   resource_dir_ = install_dir.AppendASCII(kGreaselionConfigFileVersion);
+  absl::optional<base::Value> manifest_value = base::JSONReader::Read(manifest);
+  const std::string* version =
+      manifest_value && manifest_value->is_dict()
+          ? manifest_value->GetDict().FindString("version")
+          : nullptr;
+  component_version_ = version ? *version : std::string();
   LoadDirectlyFromResourcePath();
 }
 
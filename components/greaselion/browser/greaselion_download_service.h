@@ -106,6 +106,9 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
   ~GreaselionDownloadService() override;
 
   std::vector<std::unique_ptr<GreaselionRule>>* rules();
+  // Version of the component that |rules()| were loaded from. Empty if they
+  // were loaded from a local path, whose files can change in place.
+  const std::string& rules_version() const { return rules_version_; }
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
 
   // implementation of LocalDataFilesObserver
@@ -126,7 +129,8 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
  private:
   friend class ::GreaselionServiceTest;
 
-  void OnDATFileDataReady(std::string contents);
+  void OnDATFileDataReady(const std::string& rules_version,
+                          std::string contents);
   void OnDevModeLocalFileChanged(bool error);
   void LoadOnTaskRunner();
   void LoadDirectlyFromResourcePath();
@@ -134,6 +138,8 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
   base::ObserverList<Observer> observers_;
   std::vector<std::unique_ptr<GreaselionRule>> rules_;
   base::FilePath resource_dir_;
+  std::string component_version_;
+  std::string rules_version_;
   bool is_dev_mode_ = false;
   scoped_refptr<base::SequencedTaskRunner> dev_mode_task_runner_;
   std::unique_ptr<base::FilePathWatcher> dev_mode_path_watcher_;
@@ -6,7 +6,10 @@
 #include "brave/components/greaselion/browser/greaselion_service_impl.h"
 
 #include <stddef.h>
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -16,11 +19,14 @@
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/json/json_file_value_serializer.h"
+#include "base/no_destructor.h"
 #include "base/one_shot_event.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/task_runner_util.h"
@@ -33,6 +39,7 @@
 #include "brave/components/version_info//version_info.h"
 #include "chrome/browser/extensions/extension_service.h"
 #include "components/version_info/version_info.h"
+#include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 #include "extensions/browser/computed_hashes.h"
 #include "extensions/browser/extension_registry.h"
@@ -60,40 +67,13 @@ bool ShouldComputeHashesForResource(
   return !components.empty() && components[0] != extensions::kMetadataFolder;
 }
 
-// Wraps a Greaselion rule in a component. The component is stored as
-// an unpacked extension in the user data dir. Returns a valid
-// extension that the caller should take ownership of, or nullptr.
-//
-// NOTE: This function does file IO and should not be called on the UI thread.
-absl::optional<greaselion::GreaselionServiceImpl::GreaselionConvertedExtension>
-ConvertGreaselionRuleToExtensionOnTaskRunner(
-    const greaselion::GreaselionRule& rule,
-    const base::FilePath& install_dir) {
-  base::FilePath install_temp_dir =
-      extensions::file_util::GetInstallTempDir(install_dir);
-  if (install_temp_dir.empty()) {
-    LOG(ERROR) << "Could not get path to profile temp directory";
-    return absl::nullopt;
-  }
-
-  base::ScopedTempDir temp_dir;
-  if (!temp_dir.CreateUniqueTempDirUnderPath(install_temp_dir)) {
-    LOG(ERROR) << "Could not create Greaselion temp directory";
-    return absl::nullopt;
-  }
-
-  // Create the manifest
-  base::Value::Dict root;
-
-  // manifest version is always 2
-  // see kModernManifestVersion in src/extensions/common/extension.cc
-  root.SetByDottedPath(extensions::manifest_keys::kManifestVersion, 2);
+constexpr char kCacheDirectoryName[] = "Cache";
 
-  // Create the public key.
-  // Greaselion scripts are not signed, but the public key for an extension
-  // doubles as its unique identity, and we need one of those, so we add the
-  // rule name to a known Brave domain and hash the result to create a
-  // public key.
+// Greaselion scripts are not signed, but the public key for an extension
+// doubles as its unique identity, and we need one of those, so we add the
+// rule name to a known Brave domain and hash the result to create a
+// public key.
+std::string GetPublicKey(const greaselion::GreaselionRule& rule) {
   char raw[crypto::kSHA256Length] = {0};
   std::string key;
   std::string script_name = rule.name();
@@ -109,11 +89,99 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
                              raw, crypto::kSHA256Length);
   }
   base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
+  return key;
+}
+
+void UpdateHash(crypto::SecureHash* hash, const std::string& data) {
+  const uint64_t size = data.size();
+  hash->Update(&size, sizeof(size));
+  hash->Update(data.data(), data.size());
+}
+
+// Returns a key that changes whenever anything the converted extension is
+// built from changes, or an empty string if the rule's files can't be read.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+std::string ComputeCacheKey(const greaselion::GreaselionRule& rule,
+                            const std::string& browser_version) {
+  std::unique_ptr<crypto::SecureHash> hash =
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  UpdateHash(hash.get(), rule.name());
+  UpdateHash(hash.get(), GetPublicKey(rule));
+  UpdateHash(hash.get(), rule.run_at());
+  for (const auto& url_pattern : rule.url_patterns())
+    UpdateHash(hash.get(), url_pattern);
+
+  for (const auto& script : rule.scripts()) {
+    std::string contents;
+    if (!base::ReadFileToString(script, &contents)) {
+      LOG(ERROR) << "Could not read Greaselion script at path: "
+                 << script.LossyDisplayName();
+      return std::string();
+    }
+    UpdateHash(hash.get(), script.BaseName().AsUTF8Unsafe());
+    UpdateHash(hash.get(), contents);
+  }
+
+  if (!rule.messages().empty()) {
+    std::vector<base::FilePath> message_files;
+    base::FileEnumerator enumerator(rule.messages(), true,
+                                    base::FileEnumerator::FILES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      message_files.push_back(path);
+    }
+    std::sort(message_files.begin(), message_files.end());
+
+    for (const auto& path : message_files) {
+      base::FilePath relative_path;
+      std::string contents;
+      if (!rule.messages().AppendRelativePath(path, &relative_path) ||
+          !base::ReadFileToString(path, &contents)) {
+        LOG(ERROR) << "Could not read Greaselion messages at path: "
+                   << path.LossyDisplayName();
+        return std::string();
+      }
+      UpdateHash(hash.get(), relative_path.AsUTF8Unsafe());
+      UpdateHash(hash.get(), contents);
+    }
+  }
+
+  uint8_t digest[crypto::kSHA256Length];
+  hash->Finish(digest, sizeof(digest));
+
+  return browser_version + "_" +
+         base::ToLowerASCII(base::HexEncode(digest, sizeof(digest)));
+}
 
-  root.SetByDottedPath(extensions::manifest_keys::kName, script_name);
+// Fills in the keys missing from |keys|, which has one entry per rule.
+std::vector<std::string> ComputeCacheKeysOnTaskRunner(
+    const std::vector<greaselion::GreaselionRule>& rules,
+    std::vector<std::string> keys,
+    const std::string& browser_version) {
+  DCHECK_EQ(rules.size(), keys.size());
+  for (size_t i = 0; i < rules.size(); ++i) {
+    if (keys[i].empty())
+      keys[i] = ComputeCacheKey(rules[i], browser_version);
+  }
+  return keys;
+}
+
+// Writes the unpacked extension for a Greaselion rule to |extension_dir|.
+bool WriteGreaselionExtension(const greaselion::GreaselionRule& rule,
+                              const base::FilePath& extension_dir) {
+  // Create the manifest
+  base::Value::Dict root;
+
+  // manifest version is always 2
+  // see kModernManifestVersion in src/extensions/common/extension.cc
+  root.SetByDottedPath(extensions::manifest_keys::kManifestVersion, 2);
+
+  root.SetByDottedPath(extensions::manifest_keys::kName, rule.name());
   root.SetByDottedPath(extensions::manifest_keys::kVersion, "1.0");
   root.SetByDottedPath(extensions::manifest_keys::kDescription, "");
-  root.SetByDottedPath(extensions::manifest_keys::kPublicKey, key);
+  root.SetByDottedPath(extensions::manifest_keys::kPublicKey,
+                       GetPublicKey(rule));
   root.SetByDottedPath("incognito",
                        extensions::manifest_values::kIncognitoNotAllowed);
 
@@ -146,7 +214,7 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
            std::move(content_scripts));
 
   base::FilePath manifest_path =
-      temp_dir.GetPath().Append(extensions::kManifestFilename);
+      extension_dir.Append(extensions::kManifestFilename);
   JSONFileValueSerializer serializer(manifest_path);
   // If you read the header file for this function, it says not to use it
   // outside unit tests because it writes to disk (which blocks the thread). I
@@ -155,61 +223,122 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   // files to disk.
   if (!serializer.Serialize(base::Value(std::move(root)))) {
     LOG(ERROR) << "Could not write Greaselion manifest";
-    return absl::nullopt;
+    return false;
   }
 
   // Copy the messages directory to our extension directory.
   if (!rule.messages().empty()) {
-    if (!base::CopyDirectory(
-            rule.messages(),
-            temp_dir.GetPath().AppendASCII("_locales"), true)) {
+    if (!base::CopyDirectory(rule.messages(),
+                             extension_dir.AppendASCII("_locales"), true)) {
       LOG(ERROR) << "Could not copy Greaselion messages directory at path: "
                  << rule.messages().LossyDisplayName();
-      return absl::nullopt;
+      return false;
     }
   }
 
   // Copy the script files to our extension directory.
   for (auto script : rule.scripts()) {
-    if (!base::CopyFile(script,
-                        temp_dir.GetPath().Append(script.BaseName()))) {
+    if (!base::CopyFile(script, extension_dir.Append(script.BaseName()))) {
       LOG(ERROR) << "Could not copy Greaselion script at path: "
-          << script.LossyDisplayName();
-      return absl::nullopt;
+                 << script.LossyDisplayName();
+      return false;
     }
   }
 
-  std::string error;
-  scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
-      temp_dir.GetPath(), ManifestLocation::kComponent, Extension::NO_FLAGS,
-      &error);
-  if (!extension.get()) {
-    LOG(ERROR) << "Could not load Greaselion extension";
-    LOG(ERROR) << error;
-    return absl::nullopt;
-  }
-
   // Calculate and write computed hashes.
   absl::optional<extensions::ComputedHashes::Data> computed_hashes_data =
       extensions::ComputedHashes::Compute(
-          extension->path(),
-          extension_misc::kContentVerificationDefaultBlockSize,
+          extension_dir, extension_misc::kContentVerificationDefaultBlockSize,
           extensions::IsCancelledCallback(),
           base::BindRepeating(&ShouldComputeHashesForResource));
   if (computed_hashes_data) {
     extensions::ComputedHashes(std::move(*computed_hashes_data))
         .WriteToFile(
-            extensions::file_util::GetComputedHashesPath(extension->path()));
+            extensions::file_util::GetComputedHashesPath(extension_dir));
+  }
+
+  return true;
+}
+
+// Wraps a Greaselion rule in a component. The component is stored as an
+// unpacked extension in the cache directory under |cache_key|, and reused from
+// there if it already exists. Returns a valid extension that the caller should
+// take ownership of, or nullptr.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+absl::optional<greaselion::GreaselionServiceImpl::GreaselionConvertedExtension>
+ConvertGreaselionRuleToExtensionOnTaskRunner(
+    const greaselion::GreaselionRule& rule,
+    const std::string& cache_key,
+    const base::FilePath& install_dir) {
+  const base::FilePath extension_dir =
+      greaselion::GreaselionServiceImpl::GetCacheDirectory(install_dir)
+          .AppendASCII(cache_key);
+  if (!base::PathExists(extension_dir.Append(extensions::kManifestFilename))) {
+    base::FilePath install_temp_dir =
+        extensions::file_util::GetInstallTempDir(install_dir);
+    if (install_temp_dir.empty()) {
+      LOG(ERROR) << "Could not get path to profile temp directory";
+      return absl::nullopt;
+    }
+
+    base::ScopedTempDir temp_dir;
+    if (!temp_dir.CreateUniqueTempDirUnderPath(install_temp_dir)) {
+      LOG(ERROR) << "Could not create Greaselion temp directory";
+      return absl::nullopt;
+    }
+
+    if (!WriteGreaselionExtension(rule, temp_dir.GetPath()))
+      return absl::nullopt;
+
+    // Moving the complete extension into place keeps the cache consistent if
+    // the browser exits midway. The move fails if another profile got there
+    // first, in which case its identical copy is used.
+    if (!base::CreateDirectory(extension_dir.DirName()) ||
+        !base::Move(temp_dir.GetPath(), extension_dir)) {
+      if (!base::PathExists(
+              extension_dir.Append(extensions::kManifestFilename))) {
+        LOG(ERROR) << "Could not move Greaselion extension to cache";
+        return absl::nullopt;
+      }
+    } else {
+      temp_dir.Take();
+    }
   }
 
-  // Take ownership of this temporary directory; the service will delete it on
-  // exit
-  return std::make_pair(extension, temp_dir.Take());
+  std::string error;
+  scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
+      extension_dir, ManifestLocation::kComponent, Extension::NO_FLAGS, &error);
+  if (!extension.get()) {
+    LOG(ERROR) << "Could not load Greaselion extension";
+    LOG(ERROR) << error;
+    return absl::nullopt;
+  }
+
+  return std::make_pair(extension, extension_dir);
 }
 
-void DeleteExtensionDirs(const std::vector<base::FilePath>& extension_dirs) {
-  for (const auto& extension_dir : extension_dirs) {
-    base::DeletePathRecursively(extension_dir);
+// Cache keys of the rules each profile's service currently wants or has
+// loaded. The cache directory is shared by all profiles.
+std::map<const greaselion::GreaselionServiceImpl*, std::set<std::string>>&
+GetCacheKeysInUse() {
+  static base::NoDestructor<
+      std::map<const greaselion::GreaselionServiceImpl*, std::set<std::string>>>
+      cache_keys_in_use;
+  return *cache_keys_in_use;
+}
+
+// Deletes cached extensions that no profile wants anymore, including those
+// converted by other browser versions or from older rules.
+void PruneCacheOnTaskRunner(const base::FilePath& install_dir,
+                            const std::set<std::string>& cache_keys_in_use) {
+  base::FileEnumerator enumerator(
+      greaselion::GreaselionServiceImpl::GetCacheDirectory(install_dir), false,
+      base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    if (!cache_keys_in_use.count(path.BaseName().AsUTF8Unsafe()))
+      base::DeletePathRecursively(path);
   }
 }
 
@@ -247,10 +376,15 @@ GreaselionServiceImpl::GreaselionServiceImpl(
 GreaselionServiceImpl::~GreaselionServiceImpl() {}
 
 void GreaselionServiceImpl::Shutdown() {
+  GetCacheKeysInUse().erase(this);
   download_service_->RemoveObserver(this);
   extension_registry_->RemoveObserver(this);
-  task_runner_->PostTask(FROM_HERE,
-                         base::BindOnce(&DeleteExtensionDirs, extension_dirs_));
+}
+
+// static
+base::FilePath GreaselionServiceImpl::GetCacheDirectory(
+    const base::FilePath& install_directory) {
+  return install_directory.AppendASCII(kCacheDirectoryName);
 }
 
 bool GreaselionServiceImpl::IsGreaselionExtension(const std::string& id) {
@@ -269,70 +403,135 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
     return;
   }
   update_in_progress_ = true;
-  if (greaselion_extensions_.empty()) {
-    // No Greaselion extensions are currently installed, so we can move on to
-    // the install phase immediately.
+  all_rules_installed_successfully_ = true;
+  pending_installs_ = 0;
+
+  std::vector<GreaselionRule> rules;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    if (rule->Matches(state_, browser_version_) &&
+        rule->has_unknown_preconditions() == false) {
+      rules.push_back(*rule);
+    }
+  }
+
+  // The files of a component version don't change, so the keys of its rules
+  // are only computed once.
+  const std::string& rules_version = download_service_->rules_version();
+  if (rules_version.empty() || rules_version != cache_keys_rules_version_) {
+    cache_keys_rules_version_ = rules_version;
+    cache_keys_by_rule_name_.clear();
+  }
+  std::vector<std::string> known_cache_keys;
+  known_cache_keys.reserve(rules.size());
+  for (const auto& rule : rules) {
+    auto it = cache_keys_by_rule_name_.find(rule.name());
+    known_cache_keys.push_back(it != cache_keys_by_rule_name_.end()
+                                   ? it->second
+                                   : std::string());
+  }
+
+  // Cache keys hash the rule's files, so they are computed on the extension
+  // file task runner, which was passed in in the constructor.
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&ComputeCacheKeysOnTaskRunner, rules,
+                     std::move(known_cache_keys),
+                     browser_version_.GetString()),
+      base::BindOnce(&GreaselionServiceImpl::OnCacheKeysComputed,
+                     weak_factory_.GetWeakPtr(), rules));
+}
+
+void GreaselionServiceImpl::OnCacheKeysComputed(
+    std::vector<GreaselionRule> rules,
+    std::vector<std::string> cache_keys) {
+  DCHECK(update_in_progress_);
+  DCHECK_EQ(rules.size(), cache_keys.size());
+
+  std::map<std::string, GreaselionRule> wanted_rules;
+  std::set<std::string>& cache_keys_in_use = GetCacheKeysInUse()[this];
+  cache_keys_in_use.clear();
+  for (size_t i = 0; i < rules.size(); ++i) {
+    if (cache_keys[i].empty()) {
+      all_rules_installed_successfully_ = false;
+      continue;
+    }
+    if (!cache_keys_rules_version_.empty())
+      cache_keys_by_rule_name_[rules[i].name()] = cache_keys[i];
+    cache_keys_in_use.insert(cache_keys[i]);
+    wanted_rules.emplace(cache_keys[i], rules[i]);
+  }
+  // Loaded extensions keep reading from their directory until they are
+  // unloaded, which for unwanted ones only happens below.
+  for (const auto& extension : extension_cache_keys_)
+    cache_keys_in_use.insert(extension.second);
+
+  // Conversions for the wanted rules run after this on the same task runner,
+  // so they recreate anything pruned while they were queued.
+  std::set<std::string> all_cache_keys_in_use;
+  for (const auto& service_cache_keys : GetCacheKeysInUse()) {
+    all_cache_keys_in_use.insert(service_cache_keys.second.begin(),
+                                 service_cache_keys.second.end());
+  }
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&PruneCacheOnTaskRunner, install_directory_,
+                                std::move(all_cache_keys_in_use)));
+
+  // Only extensions whose rule stopped matching or changed are unloaded, and
+  // only rules that aren't loaded yet are installed.
+  pending_unloads_.clear();
+  for (const auto& extension : extension_cache_keys_) {
+    if (wanted_rules.erase(extension.second) == 0)
+      pending_unloads_.push_back(extension.first);
+  }
+
+  rules_to_install_.clear();
+  for (auto& wanted_rule : wanted_rules)
+    rules_to_install_.emplace_back(wanted_rule.first, wanted_rule.second);
+
+  if (pending_unloads_.empty()) {
     CreateAndInstallExtensions();
     return;
   }
 
-  // Make a copy of greaselion_extensions_ to iterate while the original vector
+  // Make a copy of pending_unloads_ to iterate while the original vector
   // changes.
-  std::vector<extensions::ExtensionId> extensions = greaselion_extensions_;
+  std::vector<extensions::ExtensionId> extensions = pending_unloads_;
   for (auto id : extensions) {
-    // We need to unload all the Greaselion extensions that are already
-    // installed. OnExtensionUnloaded will be called on each extension, where we
-    // will update the greaselion_extensions_ set. Once it's empty, that
-    // callback will call CreateAndInstallExtensions().
+    // OnExtensionUnloaded will be called on each extension, where we will
+    // update pending_unloads_. Once it's empty, that callback will call
+    // CreateAndInstallExtensions().
     extension_service_->UnloadExtension(
         id, extensions::UnloadedExtensionReason::UPDATE);
   }
 }
 
 void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
+  DCHECK(pending_unloads_.empty());
   DCHECK(update_in_progress_);
-  all_rules_installed_successfully_ = true;
-  pending_installs_ = 0;
 
-  // At this point, any GL extensions that were previously loaded have now been
-  // unloaded. We can now clean up their corresponding temp folders.
-  if (!extension_dirs_.empty()) {
-    task_runner_->PostTask(
-        FROM_HERE,
-        base::BindOnce(&DeleteExtensionDirs, std::move(extension_dirs_)));
-  }
-
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
-    }
-  }
+  std::vector<std::pair<std::string, GreaselionRule>> rules;
+  std::swap(rules, rules_to_install_);
+  pending_installs_ = rules.size();
   if (!pending_installs_) {
-    // no rules match, nothing else to do
+    // no rules changed, nothing else to do
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      GreaselionRule rule_copy(*rule);
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule_copy, install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
-    }
+  for (const auto& rule : rules) {
+    // Convert script file to component extension. This must run on extension
+    // file task runner, which was passed in in the constructor.
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
+                       rule.second, rule.first, install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr(), rule.first));
   }
 }
 
 void GreaselionServiceImpl::PostConvert(
+    const std::string& cache_key,
     absl::optional<GreaselionConvertedExtension> converted_extension) {
   if (!converted_extension) {
     all_rules_installed_successfully_ = false;
@@ -341,7 +540,7 @@ void GreaselionServiceImpl::PostConvert(
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
     greaselion_extensions_.push_back(converted_extension->first->id());
-    extension_dirs_.push_back(converted_extension->second);
+    extension_cache_keys_[converted_extension->first->id()] = cache_key;
     extension_system_->ready().Post(
         FROM_HERE, base::BindOnce(&GreaselionServiceImpl::Install,
                                   weak_factory_.GetWeakPtr(),
@@ -379,7 +578,14 @@ void GreaselionServiceImpl::OnExtensionUnloaded(
     return;
   }
   greaselion_extensions_.erase(index);
-  if (update_in_progress_ && greaselion_extensions_.empty()) {
+  extension_cache_keys_.erase(extension->id());
+
+  auto pending_index = std::find(pending_unloads_.begin(),
+                                 pending_unloads_.end(), extension->id());
+  if (pending_index == pending_unloads_.end())
+    return;
+  pending_unloads_.erase(pending_index);
+  if (update_in_progress_ && pending_unloads_.empty()) {
     // It's time!
     CreateAndInstallExtensions();
   }
@@ -429,6 +635,7 @@ void GreaselionServiceImpl::SetBrowserVersionForTesting(
     const base::Version& version) {
   CHECK(version.IsValid());
   browser_version_ = version;
+  cache_keys_by_rule_name_.clear();
   UpdateInstalledExtensions();
 }
 
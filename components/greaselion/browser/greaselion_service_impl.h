@@ -71,10 +71,18 @@ class GreaselionServiceImpl : public GreaselionService,
   using GreaselionConvertedExtension =
       std::pair<scoped_refptr<extensions::Extension>, base::FilePath>;
 
+  // Converted extensions are cached here, keyed by a hash of their rule and
+  // the browser version, so that they are only built once.
+  static base::FilePath GetCacheDirectory(
+      const base::FilePath& install_directory);
+
  private:
   void SetBrowserVersionForTesting(const base::Version& version) override;
+  void OnCacheKeysComputed(std::vector<GreaselionRule> rules,
+                           std::vector<std::string> cache_keys);
   void CreateAndInstallExtensions();
   void PostConvert(
+      const std::string& cache_key,
       absl::optional<GreaselionConvertedExtension> converted_extension);
   void Install(scoped_refptr<extensions::Extension> extension);
   void MaybeNotifyObservers();
@@ -98,7 +106,13 @@ class GreaselionServiceImpl : public GreaselionService,
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<GreaselionService::Observer> observers_;
   std::vector<extensions::ExtensionId> greaselion_extensions_;
-  std::vector<base::FilePath> extension_dirs_;
+  // Cache key of the rule each loaded extension was converted from.
+  std::map<extensions::ExtensionId, std::string> extension_cache_keys_;
+  // Cache keys of the rules of |cache_keys_rules_version_|, by rule name.
+  std::map<std::string, std::string> cache_keys_by_rule_name_;
+  std::string cache_keys_rules_version_;
+  std::vector<extensions::ExtensionId> pending_unloads_;
+  std::vector<std::pair<std::string, GreaselionRule>> rules_to_install_;
   base::Version browser_version_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 };
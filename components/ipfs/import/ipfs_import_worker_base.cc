@@ -11,7 +11,6 @@
 #include "base/files/file_util.h"
 #include "base/guid.h"
 #include "base/strings/strcat.h"
-#include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/task_runner_util.h"
@@ -42,6 +41,10 @@
 
 namespace {
 
+// The node answers from its local blockstore only, so this is a safety net
+// for a busy node rather than for network lookups.
+constexpr base::TimeDelta kNodeContentCheckTimeout = base::Seconds(10);
+
 // Return a date string formatted as "YYYY-MM-DD".
 std::string TimeFormatDate(const base::Time& time) {
   base::Time::Exploded exploded_time;
@@ -80,7 +83,19 @@ void IpfsImportWorkerBase::ImportFile(const base::FilePath upload_file_path,
                                       const std::string& mime_type,
                                       const std::string& filename) {
   data_->filename = filename;
+  CalculateFileCid(
+      upload_file_path,
+      base::BindOnce(&IpfsImportWorkerBase::CheckNodeHasContent,
+                     weak_factory_.GetWeakPtr(),
+                     base::BindOnce(&IpfsImportWorkerBase::StartFileUpload,
+                                    weak_factory_.GetWeakPtr(),
+                                    upload_file_path, mime_type, filename)));
+}
 
+void IpfsImportWorkerBase::StartFileUpload(
+    const base::FilePath& upload_file_path,
+    const std::string& mime_type,
+    const std::string& filename) {
   auto upload_callback = base::BindOnce(&IpfsImportWorkerBase::UploadData,
                                         weak_factory_.GetWeakPtr());
 
@@ -93,9 +108,19 @@ void IpfsImportWorkerBase::ImportFile(const base::FilePath upload_file_path,
 }
 
 void IpfsImportWorkerBase::ImportFolder(const base::FilePath folder_path) {
+  data_->filename = folder_path.BaseName().MaybeAsASCII();
+  CalculateFolderCid(
+      folder_path,
+      base::BindOnce(&IpfsImportWorkerBase::CheckNodeHasContent,
+                     weak_factory_.GetWeakPtr(),
+                     base::BindOnce(&IpfsImportWorkerBase::StartFolderUpload,
+                                    weak_factory_.GetWeakPtr(), folder_path)));
+}
+
+void IpfsImportWorkerBase::StartFolderUpload(
+    const base::FilePath& folder_path) {
   auto upload_callback = base::BindOnce(&IpfsImportWorkerBase::UploadData,
                                         weak_factory_.GetWeakPtr());
-  data_->filename = folder_path.BaseName().MaybeAsASCII();
   CreateRequestForFolder(folder_path, blob_context_getter_factory_,
                          std::move(upload_callback));
 }
@@ -117,6 +142,52 @@ void IpfsImportWorkerBase::ImportText(const std::string& text,
                        std::move(upload_callback));
 }
 
+void IpfsImportWorkerBase::CheckNodeHasContent(
+    base::OnceClosure upload_callback,
+    absl::optional<UnixFSNode> node) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!node || !server_endpoint_.is_valid())
+    return std::move(upload_callback).Run();
+
+  GURL url = net::AppendQueryParameter(
+      server_endpoint_.Resolve(kImportStatPath), "arg",
+      "/ipfs/" + node->GetCid());
+  url = net::AppendQueryParameter(url, "with-local", "true");
+  url = net::AppendQueryParameter(url, "offline", "true");
+
+  DCHECK(!url_loader_);
+  url_loader_ = CreateURLLoader(url, "POST");
+  url_loader_->SetTimeoutDuration(kNodeContentCheckTimeout);
+  url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
+      url_loader_factory_,
+      base::BindOnce(&IpfsImportWorkerBase::OnNodeContentChecked,
+                     weak_factory_.GetWeakPtr(), std::move(upload_callback),
+                     *node));
+}
+
+void IpfsImportWorkerBase::OnNodeContentChecked(
+    base::OnceClosure upload_callback,
+    const UnixFSNode& node,
+    std::unique_ptr<std::string> response_body) {
+  int error_code = url_loader_->NetError();
+  int response_code = -1;
+  if (url_loader_->ResponseInfo() && url_loader_->ResponseInfo()->headers)
+    response_code = url_loader_->ResponseInfo()->headers->response_code();
+  url_loader_.reset();
+
+  bool local = false;
+  bool success = (error_code == net::OK && response_code == net::HTTP_OK);
+  if (success && response_body &&
+      IPFSJSONParser::GetFilesStatLocalFromJSON(*response_body, &local) &&
+      local) {
+    data_->hash = node.GetCid();
+    data_->size = static_cast<int64_t>(node.cumulative_size);
+    CreateBraveDirectory();
+    return;
+  }
+  std::move(upload_callback).Run();
+}
+
 void IpfsImportWorkerBase::UploadData(
     std::unique_ptr<network::ResourceRequest> request) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -129,58 +200,70 @@ void IpfsImportWorkerBase::UploadData(
                                        "stream-channels", "true");
   url = net::AppendQueryParameter(url, "wrap-with-directory", "true");
   url = net::AppendQueryParameter(url, "pin", "false");
-  url = net::AppendQueryParameter(url, "progress", "false");
 
   DCHECK(!url_loader_);
   url_loader_ = CreateURLLoader(url, "POST", std::move(request));
-
-  url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
-      url_loader_factory_,
-      base::BindOnce(&IpfsImportWorkerBase::OnImportAddComplete,
-                     weak_factory_.GetWeakPtr()));
+  url_loader_->DownloadAsStream(url_loader_factory_, this);
 }
 
-bool IpfsImportWorkerBase::ParseResponseBody(const std::string& response_body,
-                                             ipfs::ImportedData* data) {
-  DCHECK(data);
-  std::vector<std::string> parts = base::SplitString(
-      response_body, "\n", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
-  if (!parts.size())
-    return IPFSJSONParser::GetImportResponseFromJSON(response_body, data);
-  for (const auto& item : parts) {
-    if (item.front() != '{' || item.back() != '}')
-      continue;
-    ipfs::ImportedData imported_item;
-    if (IPFSJSONParser::GetImportResponseFromJSON(item, &imported_item)) {
-      if (imported_item.filename != data->filename)
-        continue;
-      data->hash = imported_item.hash;
-      data->size = imported_item.size;
-      return true;
-    }
+void IpfsImportWorkerBase::OnDataReceived(base::StringPiece string_piece,
+                                          base::OnceClosure resume) {
+  pending_response_.append(string_piece.data(), string_piece.size());
+  size_t line_start = 0;
+  for (size_t line_end = pending_response_.find('\n');
+       line_end != std::string::npos;
+       line_end = pending_response_.find('\n', line_start)) {
+    ParseResponseLine(base::StringPiece(pending_response_)
+                          .substr(line_start, line_end - line_start));
+    line_start = line_end + 1;
   }
-  return false;
+  pending_response_.erase(0, line_start);
+  std::move(resume).Run();
 }
 
-void IpfsImportWorkerBase::OnImportAddComplete(
-    std::unique_ptr<std::string> response_body) {
+void IpfsImportWorkerBase::OnComplete(bool success) {
+  ParseResponseLine(pending_response_);
+  pending_response_.clear();
+
   int error_code = url_loader_->NetError();
   int response_code = -1;
   if (url_loader_->ResponseInfo() && url_loader_->ResponseInfo()->headers)
     response_code = url_loader_->ResponseInfo()->headers->response_code();
-
-  bool success = (error_code == net::OK && response_code == net::HTTP_OK);
-  if (success) {
-    success = ParseResponseBody(*response_body, data_.get());
-  }
   url_loader_.reset();
+
+  success =
+      success && (error_code == net::OK && response_code == net::HTTP_OK);
   if (success && !data_->hash.empty()) {
     CreateBraveDirectory();
     return;
   }
+  data_->hash.clear();
+  data_->size = -1;
   NotifyImportCompleted(IPFS_IMPORT_ERROR_ADD_FAILED);
 }
 
+void IpfsImportWorkerBase::OnRetry(base::OnceClosure start_retry) {
+  pending_response_.clear();
+  data_->hash.clear();
+  data_->size = -1;
+  std::move(start_retry).Run();
+}
+
+void IpfsImportWorkerBase::ParseResponseLine(base::StringPiece line) {
+  line = base::TrimWhitespaceASCII(line, base::TRIM_ALL);
+  if (line.empty() || line.front() != '{' || line.back() != '}')
+    return;
+
+  const std::string json(line);
+  ipfs::ImportedData imported_item;
+  if (!IPFSJSONParser::GetImportResponseFromJSON(json, &imported_item) ||
+      imported_item.filename != data_->filename) {
+    return;
+  }
+  data_->hash = imported_item.hash;
+  data_->size = imported_item.size;
+}
+
 void IpfsImportWorkerBase::CreateBraveDirectory() {
   DCHECK(!url_loader_);
   GURL url = net::AppendQueryParameter(
@@ -17,10 +17,14 @@
 #include "base/files/file_util.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/scoped_refptr.h"
+#include "base/strings/string_piece.h"
 #include "brave/components/ipfs/blob_context_getter_factory.h"
 #include "brave/components/ipfs/import/imported_data.h"
+#include "brave/components/ipfs/import/unixfs_cid.h"
 #include "brave/components/ipfs/ipfs_network_utils.h"
 #include "components/version_info/channel.h"
+#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace network {
@@ -39,18 +43,21 @@ namespace ipfs {
 // Worker:
 //   1. Worker prepares a blob block of data to import
 // IpfsImportWorkerBase:
-//   2. Sends blob to ifps using IPFS api (/api/v0/add)
-//   3. Creates target directory for import using IPFS api(/api/v0/files/mkdir)
-//   4. Moves objects to target directory using IPFS api(/api/v0/files/cp)
-//   5. Publishes objects under passed IPNS key(/api/v0/name/publish)
-class IpfsImportWorkerBase {
+//   2. Computes the CID of files and folders locally and skips the upload
+//      if the node already has all of its blocks (/api/v0/files/stat)
+//   3. Sends blob to ifps using IPFS api (/api/v0/add) and reads the
+//      response as a stream of NDJSON entries
+//   4. Creates target directory for import using IPFS api(/api/v0/files/mkdir)
+//   5. Moves objects to target directory using IPFS api(/api/v0/files/cp)
+//   6. Publishes objects under passed IPNS key(/api/v0/name/publish)
+class IpfsImportWorkerBase : public network::SimpleURLLoaderStreamConsumer {
  public:
   IpfsImportWorkerBase(BlobContextGetterFactory* blob_context_getter_factory,
                        network::mojom::URLLoaderFactory* url_loader_factory,
                        const GURL& endpoint,
                        ImportCompletedCallback callback,
                        const std::string& key = std::string());
-  virtual ~IpfsImportWorkerBase();
+  ~IpfsImportWorkerBase() override;
 
   IpfsImportWorkerBase(const IpfsImportWorkerBase&) = delete;
   IpfsImportWorkerBase& operator=(const IpfsImportWorkerBase&) = delete;
@@ -68,17 +75,30 @@ class IpfsImportWorkerBase {
   virtual void NotifyImportCompleted(ipfs::ImportState state);
 
  private:
+  void StartFileUpload(const base::FilePath& upload_file_path,
+                       const std::string& mime_type,
+                       const std::string& filename);
+  void StartFolderUpload(const base::FilePath& folder_path);
+  void CheckNodeHasContent(base::OnceClosure upload_callback,
+                           absl::optional<UnixFSNode> node);
+  void OnNodeContentChecked(base::OnceClosure upload_callback,
+                            const UnixFSNode& node,
+                            std::unique_ptr<std::string> response_body);
+
   void UploadData(std::unique_ptr<network::ResourceRequest> request);
 
-  void OnImportAddComplete(std::unique_ptr<std::string> response_body);
+  // network::SimpleURLLoaderStreamConsumer:
+  void OnDataReceived(base::StringPiece string_piece,
+                      base::OnceClosure resume) override;
+  void OnComplete(bool success) override;
+  void OnRetry(base::OnceClosure start_retry) override;
+  void ParseResponseLine(base::StringPiece line);
 
   void CreateBraveDirectory();
   void OnImportDirectoryCreated(const std::string& directory,
                                 std::unique_ptr<std::string> response_body);
   void CopyFilesToBraveDirectory();
   void OnImportFilesMoved(std::unique_ptr<std::string> response_body);
-  bool ParseResponseBody(const std::string& response_body,
-                         ipfs::ImportedData* data);
   void PublishContent();
   void OnContentPublished(std::unique_ptr<std::string> response_body);
   ImportCompletedCallback callback_;
@@ -89,6 +109,9 @@ class IpfsImportWorkerBase {
   std::unique_ptr<network::SimpleURLLoader> url_loader_;
   GURL server_endpoint_;
   std::string key_to_publish_;
+
+  // Incomplete trailing line of the add response.
+  std::string pending_response_;
   base::WeakPtrFactory<IpfsImportWorkerBase> weak_factory_;
 };
 
@@ -0,0 +1,354 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/import/unixfs_cid.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "base/barrier_callback.h"
+#include "base/files/file.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/task/thread_pool.h"
+#include "crypto/sha2.h"
+
+namespace {
+
+constexpr char kBase58Alphabet[] =
+    "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+// Multihash prefix of a sha2-256 digest.
+constexpr uint8_t kSha256MultihashCode = 0x12;
+constexpr uint8_t kSha256MultihashLength = 0x20;
+
+// Values of the UnixFS Data.DataType field.
+constexpr uint64_t kUnixFSDirectoryType = 1;
+constexpr uint64_t kUnixFSFileType = 2;
+
+constexpr int kVarintWireType = 0;
+constexpr int kLengthDelimitedWireType = 2;
+
+constexpr size_t kReadBufferSize = 4 * ipfs::kUnixFSChunkSize;
+
+constexpr base::TaskTraits kHashingTaskTraits = {
+    base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+    base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN};
+
+using FileNodeResult =
+    std::pair<base::FilePath, absl::optional<ipfs::UnixFSNode>>;
+
+struct FolderListing {
+  FolderListing() = default;
+  FolderListing(FolderListing&&) = default;
+  FolderListing& operator=(FolderListing&&) = default;
+  ~FolderListing() = default;
+
+  std::vector<base::FilePath> files;
+  std::vector<base::FilePath> directories;
+};
+
+void AppendVarint(uint64_t value, std::vector<uint8_t>* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  out->push_back(static_cast<uint8_t>(value));
+}
+
+void AppendVarintField(int field, uint64_t value, std::vector<uint8_t>* out) {
+  AppendVarint(field << 3 | kVarintWireType, out);
+  AppendVarint(value, out);
+}
+
+void AppendBytesField(int field,
+                      base::span<const uint8_t> bytes,
+                      std::vector<uint8_t>* out) {
+  AppendVarint(field << 3 | kLengthDelimitedWireType, out);
+  AppendVarint(bytes.size(), out);
+  out->insert(out->end(), bytes.begin(), bytes.end());
+}
+
+// Encodes the unixfs.pb Data message.
+std::vector<uint8_t> EncodeUnixFSData(
+    uint64_t type,
+    base::span<const uint8_t> data,
+    absl::optional<uint64_t> file_size,
+    const std::vector<uint64_t>& block_sizes) {
+  std::vector<uint8_t> out;
+  out.reserve(data.size() + 16 + block_sizes.size() * 4);
+  AppendVarintField(1, type, &out);
+  if (!data.empty())
+    AppendBytesField(2, data, &out);
+  if (file_size)
+    AppendVarintField(3, *file_size, &out);
+  for (const uint64_t block_size : block_sizes)
+    AppendVarintField(4, block_size, &out);
+  return out;
+}
+
+// Encodes the dag-pb PBNode message. The canonical encoding writes Links
+// ahead of Data and always includes the link name, even when empty.
+std::vector<uint8_t> EncodeDagPbNode(
+    const std::vector<std::pair<std::string, ipfs::UnixFSNode>>& links,
+    const std::vector<uint8_t>& data) {
+  std::vector<uint8_t> out;
+  out.reserve(data.size() + links.size() * 64 + 8);
+  std::vector<uint8_t> link;
+  for (const auto& [name, node] : links) {
+    link.clear();
+    AppendBytesField(1, node.multihash, &link);
+    AppendBytesField(2, base::as_bytes(base::make_span(name)), &link);
+    AppendVarintField(3, node.cumulative_size, &link);
+    AppendBytesField(2, link, &out);
+  }
+  AppendBytesField(1, data, &out);
+  return out;
+}
+
+ipfs::UnixFSNode HashBlock(const std::vector<uint8_t>& block,
+                           uint64_t links_size,
+                           uint64_t file_size) {
+  ipfs::UnixFSNode node;
+  node.multihash.reserve(crypto::kSHA256Length + 2);
+  node.multihash.push_back(kSha256MultihashCode);
+  node.multihash.push_back(kSha256MultihashLength);
+  const auto digest = crypto::SHA256Hash(block);
+  node.multihash.insert(node.multihash.end(), digest.begin(), digest.end());
+  node.cumulative_size = block.size() + links_size;
+  node.file_size = file_size;
+  return node;
+}
+
+ipfs::UnixFSNode BuildFileParentNode(
+    base::span<const ipfs::UnixFSNode> children) {
+  std::vector<std::pair<std::string, ipfs::UnixFSNode>> links;
+  links.reserve(children.size());
+  std::vector<uint64_t> block_sizes;
+  block_sizes.reserve(children.size());
+  uint64_t file_size = 0;
+  uint64_t links_size = 0;
+  for (const auto& child : children) {
+    links.emplace_back(std::string(), child);
+    block_sizes.push_back(child.file_size);
+    file_size += child.file_size;
+    links_size += child.cumulative_size;
+  }
+  const std::vector<uint8_t> data =
+      EncodeUnixFSData(kUnixFSFileType, {}, file_size, block_sizes);
+  return HashBlock(EncodeDagPbNode(links, data), links_size, file_size);
+}
+
+// Bitcoin style base58, see bitcoin-core's EncodeBase58.
+std::string EncodeBase58(base::span<const uint8_t> input) {
+  size_t zeroes = 0;
+  while (zeroes < input.size() && input[zeroes] == 0)
+    ++zeroes;
+  // log(256) / log(58), rounded up.
+  std::vector<uint8_t> digits((input.size() - zeroes) * 138 / 100 + 1);
+  size_t length = 0;
+  for (size_t i = zeroes; i < input.size(); ++i) {
+    int carry = input[i];
+    size_t j = 0;
+    for (auto it = digits.rbegin();
+         (carry != 0 || j < length) && it != digits.rend(); ++it, ++j) {
+      carry += 256 * (*it);
+      *it = carry % 58;
+      carry /= 58;
+    }
+    length = j;
+  }
+
+  std::string result(zeroes, kBase58Alphabet[0]);
+  result.reserve(zeroes + length);
+  for (auto it = digits.end() - length; it != digits.end(); ++it)
+    result += kBase58Alphabet[*it];
+  return result;
+}
+
+FolderListing EnumerateFolder(const base::FilePath& folder_path) {
+  FolderListing listing;
+  base::FileEnumerator file_enum(
+      folder_path, true,
+      base::FileEnumerator::FILES | base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath path = file_enum.Next(); !path.empty();
+       path = file_enum.Next()) {
+    if (base::IsLink(path))
+      continue;
+    if (file_enum.GetInfo().IsDirectory())
+      listing.directories.push_back(path);
+    else
+      listing.files.push_back(path);
+  }
+  return listing;
+}
+
+FileNodeResult BuildFileNodeResult(const base::FilePath& path) {
+  return FileNodeResult(path, ipfs::BuildUnixFSFileNode(path));
+}
+
+absl::optional<ipfs::UnixFSNode> BuildFolderNode(
+    const base::FilePath& folder_path,
+    std::vector<base::FilePath> directories,
+    std::vector<FileNodeResult> files) {
+  std::map<base::FilePath,
+           std::vector<std::pair<std::string, ipfs::UnixFSNode>>>
+      entries;
+  for (auto& [path, node] : files) {
+    if (!node)
+      return absl::nullopt;
+    entries[path.DirName()].emplace_back(path.BaseName().AsUTF8Unsafe(),
+                                         std::move(*node));
+  }
+
+  // Deeper directories go first so every directory is complete before it
+  // is linked from its parent.
+  std::sort(directories.begin(), directories.end(),
+            [](const base::FilePath& a, const base::FilePath& b) {
+              return a.GetComponents().size() > b.GetComponents().size();
+            });
+  for (const auto& directory : directories) {
+    ipfs::UnixFSNode node =
+        ipfs::BuildUnixFSDirectoryNode(std::move(entries[directory]));
+    entries.erase(directory);
+    entries[directory.DirName()].emplace_back(
+        directory.BaseName().AsUTF8Unsafe(), std::move(node));
+  }
+  return ipfs::BuildUnixFSDirectoryNode(std::move(entries[folder_path]));
+}
+
+void OnFolderFilesHashed(const base::FilePath& folder_path,
+                         std::vector<base::FilePath> directories,
+                         ipfs::UnixFSNodeCallback callback,
+                         std::vector<FileNodeResult> files) {
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kHashingTaskTraits,
+      base::BindOnce(&BuildFolderNode, folder_path, std::move(directories),
+                     std::move(files)),
+      std::move(callback));
+}
+
+void OnFolderEnumerated(const base::FilePath& folder_path,
+                        ipfs::UnixFSNodeCallback callback,
+                        FolderListing listing) {
+  auto barrier = base::BarrierCallback<FileNodeResult>(
+      listing.files.size(),
+      base::BindOnce(&OnFolderFilesHashed, folder_path,
+                     std::move(listing.directories), std::move(callback)));
+  for (const auto& path : listing.files) {
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, kHashingTaskTraits,
+        base::BindOnce(&BuildFileNodeResult, path), barrier);
+  }
+}
+
+}  // namespace
+
+namespace ipfs {
+
+UnixFSNode::UnixFSNode() = default;
+UnixFSNode::UnixFSNode(const UnixFSNode&) = default;
+UnixFSNode& UnixFSNode::operator=(const UnixFSNode&) = default;
+UnixFSNode::~UnixFSNode() = default;
+
+std::string UnixFSNode::GetCid() const {
+  return EncodeBase58(multihash);
+}
+
+UnixFSFileBuilder::UnixFSFileBuilder() {
+  chunk_.reserve(kUnixFSChunkSize);
+}
+
+UnixFSFileBuilder::~UnixFSFileBuilder() = default;
+
+void UnixFSFileBuilder::Append(base::span<const uint8_t> data) {
+  while (!data.empty()) {
+    const size_t size =
+        std::min(data.size(), kUnixFSChunkSize - chunk_.size());
+    chunk_.insert(chunk_.end(), data.begin(), data.begin() + size);
+    data = data.subspan(size);
+    if (chunk_.size() == kUnixFSChunkSize)
+      FlushChunk();
+  }
+}
+
+UnixFSNode UnixFSFileBuilder::Finish() {
+  if (!chunk_.empty() || leaves_.empty())
+    FlushChunk();
+
+  // Balanced layout: group up to kUnixFSMaxLinks nodes per parent, level by
+  // level, until a single root is left. A single leaf is the root itself.
+  std::vector<UnixFSNode> nodes = std::move(leaves_);
+  leaves_.clear();
+  while (nodes.size() > 1) {
+    std::vector<UnixFSNode> parents;
+    parents.reserve(nodes.size() / kUnixFSMaxLinks + 1);
+    base::span<const UnixFSNode> children(nodes);
+    while (!children.empty()) {
+      const size_t size = std::min(children.size(), kUnixFSMaxLinks);
+      parents.push_back(BuildFileParentNode(children.first(size)));
+      children = children.subspan(size);
+    }
+    nodes = std::move(parents);
+  }
+  return nodes.front();
+}
+
+void UnixFSFileBuilder::FlushChunk() {
+  const std::vector<uint8_t> data =
+      EncodeUnixFSData(kUnixFSFileType, chunk_, chunk_.size(), {});
+  leaves_.push_back(HashBlock(EncodeDagPbNode({}, data), 0, chunk_.size()));
+  chunk_.clear();
+}
+
+UnixFSNode BuildUnixFSDirectoryNode(
+    std::vector<std::pair<std::string, UnixFSNode>> entries) {
+  std::sort(entries.begin(), entries.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+  uint64_t links_size = 0;
+  for (const auto& entry : entries)
+    links_size += entry.second.cumulative_size;
+  const std::vector<uint8_t> data =
+      EncodeUnixFSData(kUnixFSDirectoryType, {}, absl::nullopt, {});
+  return HashBlock(EncodeDagPbNode(entries, data), links_size, 0);
+}
+
+absl::optional<UnixFSNode> BuildUnixFSFileNode(const base::FilePath& path) {
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid())
+    return absl::nullopt;
+
+  UnixFSFileBuilder builder;
+  std::vector<uint8_t> buffer(kReadBufferSize);
+  while (true) {
+    const int bytes_read =
+        file.ReadAtCurrentPos(reinterpret_cast<char*>(buffer.data()),
+                              static_cast<int>(buffer.size()));
+    if (bytes_read < 0)
+      return absl::nullopt;
+    if (bytes_read == 0)
+      break;
+    builder.Append(base::make_span(buffer).first(bytes_read));
+  }
+  return builder.Finish();
+}
+
+void CalculateFileCid(const base::FilePath& path,
+                      UnixFSNodeCallback callback) {
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kHashingTaskTraits,
+      base::BindOnce(&BuildUnixFSFileNode, path), std::move(callback));
+}
+
+void CalculateFolderCid(const base::FilePath& folder_path,
+                        UnixFSNodeCallback callback) {
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, kHashingTaskTraits,
+      base::BindOnce(&EnumerateFolder, folder_path),
+      base::BindOnce(&OnFolderEnumerated, folder_path, std::move(callback)));
+}
+
+}  // namespace ipfs
@@ -0,0 +1,87 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_IPFS_IMPORT_UNIXFS_CID_H_
+#define BRAVE_COMPONENTS_IPFS_IMPORT_UNIXFS_CID_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/span.h"
+#include "base/files/file_path.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace ipfs {
+
+// Leaf size of the node's default "size-262144" chunker.
+constexpr size_t kUnixFSChunkSize = 262144;
+// Maximum number of links of a node in the balanced DAG layout.
+constexpr size_t kUnixFSMaxLinks = 174;
+
+// Root of a UnixFS DAG as the node builds it for /api/v0/add with default
+// options: CIDv0, balanced layout and dag-pb leaves.
+struct UnixFSNode {
+  UnixFSNode();
+  UnixFSNode(const UnixFSNode&);
+  UnixFSNode& operator=(const UnixFSNode&);
+  ~UnixFSNode();
+
+  std::string GetCid() const;
+
+  // sha2-256 multihash of the root block.
+  std::vector<uint8_t> multihash;
+  // Size of all encoded blocks of the DAG, the Tsize of links to it.
+  uint64_t cumulative_size = 0;
+  // Bytes of file content, 0 for directories.
+  uint64_t file_size = 0;
+};
+
+// Builds the DAG of a file from content appended in pieces of any size.
+// Only the multihashes of the leaves are kept, so memory does not grow with
+// the chunk contents.
+class UnixFSFileBuilder {
+ public:
+  UnixFSFileBuilder();
+  ~UnixFSFileBuilder();
+
+  UnixFSFileBuilder(const UnixFSFileBuilder&) = delete;
+  UnixFSFileBuilder& operator=(const UnixFSFileBuilder&) = delete;
+
+  void Append(base::span<const uint8_t> data);
+  UnixFSNode Finish();
+
+ private:
+  void FlushChunk();
+
+  std::vector<uint8_t> chunk_;
+  std::vector<UnixFSNode> leaves_;
+};
+
+// Returns the directory node linking |entries| by name.
+UnixFSNode BuildUnixFSDirectoryNode(
+    std::vector<std::pair<std::string, UnixFSNode>> entries);
+
+// Reads |path| and returns its file node, blocking.
+absl::optional<UnixFSNode> BuildUnixFSFileNode(const base::FilePath& path);
+
+using UnixFSNodeCallback =
+    base::OnceCallback<void(absl::optional<UnixFSNode>)>;
+
+// Computes the node of the file at |path| on the thread pool.
+void CalculateFileCid(const base::FilePath& path, UnixFSNodeCallback callback);
+
+// Walks |folder_path| on the thread pool and hashes its files in parallel.
+// Symlinks are skipped, as they are when the folder is uploaded. Runs
+// |callback| with absl::nullopt if any file could not be read.
+void CalculateFolderCid(const base::FilePath& folder_path,
+                        UnixFSNodeCallback callback);
+
+}  // namespace ipfs
+
+#endif  // BRAVE_COMPONENTS_IPFS_IMPORT_UNIXFS_CID_H_
@@ -0,0 +1,104 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/ipfs/import/unixfs_cid.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// npm run test -- brave_perftests --filter=UnixFSCidPerfTest*
+
+namespace ipfs {
+
+namespace {
+
+constexpr int64_t kMegabyte = 1024 * 1024;
+constexpr int64_t kFileSize = 32 * kMegabyte;
+constexpr int kFilesPerDirectory = 16;
+
+// Writes |total_size| bytes of pseudo-random content as a tree of
+// |kFileSize| files, |kFilesPerDirectory| per directory.
+bool CreateTree(const base::FilePath& root, int64_t total_size) {
+  std::vector<char> buffer(kMegabyte);
+  uint32_t state = 1;
+  for (int64_t written = 0, index = 0; written < total_size; ++index) {
+    const base::FilePath directory = root.AppendASCII(
+        base::StringPrintf("dir%03d", static_cast<int>(
+                                          index / kFilesPerDirectory)));
+    if (!base::CreateDirectory(directory))
+      return false;
+    base::File file(directory.AppendASCII(base::StringPrintf(
+                        "file%03d", static_cast<int>(index))),
+                    base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+    if (!file.IsValid())
+      return false;
+    for (int64_t size = 0; size < kFileSize; size += kMegabyte) {
+      for (char& c : buffer) {
+        state = state * 1664525 + 1013904223;
+        c = static_cast<char>(state >> 24);
+      }
+      if (file.WriteAtCurrentPos(buffer.data(), buffer.size()) !=
+          static_cast<int>(buffer.size())) {
+        return false;
+      }
+    }
+    written += kFileSize;
+  }
+  return true;
+}
+
+}  // namespace
+
+class UnixFSCidPerfTest : public testing::TestWithParam<int64_t> {
+ protected:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_P(UnixFSCidPerfTest, FolderThroughput) {
+  const int64_t total_size = GetParam();
+  const base::FilePath root = temp_dir_.GetPath().AppendASCII("tree");
+  ASSERT_TRUE(CreateTree(root, total_size));
+
+  perf_test::PerfResultReporter reporter(
+      "UnixFSCid",
+      base::StringPrintf("%d_MiB", static_cast<int>(total_size / kMegabyte)));
+  reporter.RegisterImportantMetric(".folder_throughput", "MiB/s");
+
+  absl::optional<UnixFSNode> result;
+  base::RunLoop run_loop;
+  base::ElapsedTimer timer;
+  CalculateFolderCid(root, base::BindLambdaForTesting(
+                               [&](absl::optional<UnixFSNode> node) {
+                                 result = std::move(node);
+                                 run_loop.Quit();
+                               }));
+  run_loop.Run();
+  reporter.AddResult(".folder_throughput", static_cast<double>(total_size) /
+                                               kMegabyte /
+                                               timer.Elapsed().InSecondsF());
+
+  ASSERT_TRUE(result);
+  EXPECT_FALSE(result->GetCid().empty());
+}
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         UnixFSCidPerfTest,
+                         testing::Values(256 * kMegabyte, 4096 * kMegabyte));
+
+}  // namespace ipfs
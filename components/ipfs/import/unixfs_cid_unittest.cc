@@ -0,0 +1,172 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ipfs/import/unixfs_cid.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=UnixFSCidTest*
+
+namespace ipfs {
+
+namespace {
+
+// Known CIDs produced by `ipfs add` with default options.
+constexpr char kEmptyFileCid[] =
+    "QmbFMke1KXqnYyBBWxB74N4c5SBnJMVAiMNRcGu6x1AwQH";
+constexpr char kHelloWorldCid[] =
+    "QmT78zSuBmuS4z925WZfrqQ1qHaJ56DQaTfyMUF7F8ff5o";
+constexpr char kEmptyDirectoryCid[] =
+    "QmUNLLsPACCz1vLxQVkXqqLX5R1X345qqfHbsf67hvA3Nn";
+constexpr char kHelloDirectoryCid[] =
+    "QmfLiVjH2vujCVP2e75zyzBYmpcjktmDeU1YBz6Ct8BBsc";
+constexpr char kThreeMegabytesCid[] =
+    "Qmf5S8JCEUSRGf9EvC7y4ARoZSwcJfwwUxE72We8t8ARzf";
+
+constexpr char kHelloWorld[] = "hello world\n";
+
+std::vector<uint8_t> GetThreeMegabytes() {
+  std::vector<uint8_t> data;
+  data.reserve(3 * 1024 * 1024);
+  for (int i = 0; i < 3 * 4096; ++i) {
+    for (int j = 0; j < 256; ++j)
+      data.push_back(static_cast<uint8_t>(j));
+  }
+  return data;
+}
+
+UnixFSNode BuildNode(base::span<const uint8_t> data) {
+  UnixFSFileBuilder builder;
+  builder.Append(data);
+  return builder.Finish();
+}
+
+UnixFSNode BuildNode(const std::string& data) {
+  return BuildNode(base::as_bytes(base::make_span(data)));
+}
+
+}  // namespace
+
+class UnixFSCidTest : public testing::Test {
+ public:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  absl::optional<UnixFSNode> CalculateFolderCidAndWait(
+      const base::FilePath& folder_path) {
+    absl::optional<UnixFSNode> result;
+    base::RunLoop run_loop;
+    CalculateFolderCid(folder_path, base::BindLambdaForTesting(
+                                        [&](absl::optional<UnixFSNode> node) {
+                                          result = std::move(node);
+                                          run_loop.Quit();
+                                        }));
+    run_loop.Run();
+    return result;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(UnixFSCidTest, EmptyFile) {
+  const UnixFSNode node = BuildNode(std::string());
+  EXPECT_EQ(kEmptyFileCid, node.GetCid());
+  EXPECT_EQ(6U, node.cumulative_size);
+  EXPECT_EQ(0U, node.file_size);
+}
+
+TEST_F(UnixFSCidTest, SingleChunkFile) {
+  const UnixFSNode node = BuildNode(kHelloWorld);
+  EXPECT_EQ(kHelloWorldCid, node.GetCid());
+  EXPECT_EQ(20U, node.cumulative_size);
+  EXPECT_EQ(12U, node.file_size);
+}
+
+TEST_F(UnixFSCidTest, MultiChunkFile) {
+  const std::vector<uint8_t> data = GetThreeMegabytes();
+  const UnixFSNode node = BuildNode(data);
+  EXPECT_EQ(kThreeMegabytesCid, node.GetCid());
+  EXPECT_EQ(3146481U, node.cumulative_size);
+  EXPECT_EQ(data.size(), node.file_size);
+}
+
+TEST_F(UnixFSCidTest, AppendSizeDoesNotChangeCid) {
+  const std::vector<uint8_t> data = GetThreeMegabytes();
+  UnixFSFileBuilder builder;
+  base::span<const uint8_t> remaining(data);
+  while (!remaining.empty()) {
+    const size_t size = std::min<size_t>(remaining.size(), 100000);
+    builder.Append(remaining.first(size));
+    remaining = remaining.subspan(size);
+  }
+  EXPECT_EQ(kThreeMegabytesCid, builder.Finish().GetCid());
+}
+
+TEST_F(UnixFSCidTest, Directory) {
+  EXPECT_EQ(kEmptyDirectoryCid, BuildUnixFSDirectoryNode({}).GetCid());
+
+  const UnixFSNode node =
+      BuildUnixFSDirectoryNode({{"hello.txt", BuildNode(kHelloWorld)}});
+  EXPECT_EQ(kHelloDirectoryCid, node.GetCid());
+  EXPECT_EQ(75U, node.cumulative_size);
+}
+
+TEST_F(UnixFSCidTest, DirectoryLinksAreSortedByName) {
+  const UnixFSNode a = BuildNode("a");
+  const UnixFSNode b = BuildNode("b");
+  EXPECT_EQ(BuildUnixFSDirectoryNode({{"a", a}, {"b", b}}).GetCid(),
+            BuildUnixFSDirectoryNode({{"b", b}, {"a", a}}).GetCid());
+}
+
+TEST_F(UnixFSCidTest, BuildFileNode) {
+  const base::FilePath path = temp_dir_.GetPath().AppendASCII("hello.txt");
+  ASSERT_TRUE(base::WriteFile(path, kHelloWorld));
+
+  const absl::optional<UnixFSNode> node = BuildUnixFSFileNode(path);
+  ASSERT_TRUE(node);
+  EXPECT_EQ(kHelloWorldCid, node->GetCid());
+
+  EXPECT_FALSE(
+      BuildUnixFSFileNode(temp_dir_.GetPath().AppendASCII("missing.txt")));
+}
+
+TEST_F(UnixFSCidTest, CalculateFolderCid) {
+  const base::FilePath folder = temp_dir_.GetPath().AppendASCII("folder");
+  ASSERT_TRUE(base::CreateDirectory(folder));
+  ASSERT_TRUE(base::WriteFile(folder.AppendASCII("hello.txt"), kHelloWorld));
+
+  absl::optional<UnixFSNode> node = CalculateFolderCidAndWait(folder);
+  ASSERT_TRUE(node);
+  EXPECT_EQ(kHelloDirectoryCid, node->GetCid());
+
+  const base::FilePath empty = folder.AppendASCII("empty");
+  ASSERT_TRUE(base::CreateDirectory(empty));
+  const base::FilePath nested = folder.AppendASCII("nested");
+  ASSERT_TRUE(base::CreateDirectory(nested));
+  ASSERT_TRUE(base::WriteFile(nested.AppendASCII("hello.txt"), kHelloWorld));
+
+  const UnixFSNode expected = BuildUnixFSDirectoryNode(
+      {{"hello.txt", BuildNode(kHelloWorld)},
+       {"empty", BuildUnixFSDirectoryNode({})},
+       {"nested", BuildUnixFSDirectoryNode(
+                      {{"hello.txt", BuildNode(kHelloWorld)}})}});
+  node = CalculateFolderCidAndWait(folder);
+  ASSERT_TRUE(node);
+  EXPECT_EQ(expected.GetCid(), node->GetCid());
+  EXPECT_EQ(expected.cumulative_size, node->cumulative_size);
+}
+
+}  // namespace ipfs
@@ -309,6 +309,29 @@ bool IPFSJSONParser::GetImportResponseFromJSON(const std::string& json,
   return true;
 }
 
+// Parses the response of /api/v0/files/stat?with-local=true, e.g.
+// {"Hash":"Qm...","Size":0,"CumulativeSize":6,"Blocks":0,"Type":"file",
+//  "WithLocality":true,"Local":true,"SizeLocal":6}
+bool IPFSJSONParser::GetFilesStatLocalFromJSON(const std::string& json,
+                                               bool* local) {
+  DCHECK(local);
+  absl::optional<base::Value> records_v =
+      base::JSONReader::Read(json, base::JSON_PARSE_CHROMIUM_EXTENSIONS |
+                                       base::JSONParserOptions::JSON_PARSE_RFC);
+  if (!records_v || !records_v->is_dict()) {
+    VLOG(1) << "Invalid response, could not parse JSON, JSON is: " << json;
+    return false;
+  }
+
+  const auto& response_dict = records_v->GetDict();
+  absl::optional<bool> with_locality = response_dict.FindBool("WithLocality");
+  absl::optional<bool> local_value = response_dict.FindBool("Local");
+  if (!with_locality.value_or(false) || !local_value)
+    return false;
+  *local = *local_value;
+  return true;
+}
+
 // static
 // Response Format for /api/v0/key/list
 // {"Keys" : [
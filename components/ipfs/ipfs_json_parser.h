@@ -29,6 +29,7 @@ class IPFSJSONParser {
                                            std::string* error);
   static bool GetImportResponseFromJSON(const std::string& json,
                                         ipfs::ImportedData* data);
+  static bool GetFilesStatLocalFromJSON(const std::string& json, bool* local);
   static bool GetParseKeysFromJSON(
       const std::string& json,
       std::unordered_map<std::string, std::string>* keys);
@@ -166,6 +166,32 @@ TEST_F(IPFSJSONParserTest, GetImportResponseFromJSON) {
   ASSERT_EQ(failed2.size, -1);
 }
 
+TEST_F(IPFSJSONParserTest, GetFilesStatLocalFromJSON) {
+  bool local = false;
+  ASSERT_TRUE(IPFSJSONParser::GetFilesStatLocalFromJSON(R"({
+    "Hash":"QmT78zSuBmuS4z925WZfrqQ1qHaJ56DQaTfyMUF7F8ff5o",
+    "Size":12,
+    "CumulativeSize":20,
+    "Blocks":0,
+    "Type":"file",
+    "WithLocality":true,
+    "Local":true,
+    "SizeLocal":20
+    })",
+                                                        &local));
+  EXPECT_TRUE(local);
+
+  ASSERT_TRUE(IPFSJSONParser::GetFilesStatLocalFromJSON(
+      R"({"WithLocality":true,"Local":false,"SizeLocal":4})", &local));
+  EXPECT_FALSE(local);
+
+  local = true;
+  ASSERT_FALSE(IPFSJSONParser::GetFilesStatLocalFromJSON(
+      R"({"Hash":"QmT78zSuBmuS4z925WZfrqQ1qHaJ56DQaTfyMUF7F8ff5o"})", &local));
+  ASSERT_FALSE(IPFSJSONParser::GetFilesStatLocalFromJSON(R"()", &local));
+  EXPECT_TRUE(local);
+}
+
 TEST_F(IPFSJSONParserTest, GetParseKeysFromJSON) {
   std::unordered_map<std::string, std::string> parsed_keys;
   std::string response = R"({"Keys" : [)"
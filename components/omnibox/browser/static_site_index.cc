@@ -0,0 +1,115 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/omnibox/browser/static_site_index.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+namespace {
+
+// Packs the n-gram of |text| at |pos| and its length into a single key.
+uint32_t GramKey(const std::string& text, size_t pos, size_t length) {
+  uint32_t key = length;
+  for (size_t i = 0; i < length; ++i) {
+    key |= static_cast<uint32_t>(static_cast<uint8_t>(text[pos + i]))
+           << (8 * (i + 1));
+  }
+  return key;
+}
+
+}  // namespace
+
+StaticSiteIndex::StaticSiteIndex(const std::vector<std::string>& entries)
+    : entries_(entries) {
+  std::map<uint32_t, std::vector<size_t>> postings;
+  for (size_t id = 0; id < entries_.size(); ++id) {
+    const std::string& entry = entries_[id];
+    for (size_t length = 1; length <= kMaxGramLength; ++length) {
+      for (size_t pos = 0; pos + length <= entry.size(); ++pos) {
+        std::vector<size_t>& ids = postings[GramKey(entry, pos, length)];
+        if (ids.empty() || ids.back() != id)
+          ids.push_back(id);
+      }
+    }
+  }
+  postings_ = base::flat_map<uint32_t, std::vector<size_t>>(
+      std::make_move_iterator(postings.begin()),
+      std::make_move_iterator(postings.end()));
+}
+
+StaticSiteIndex::~StaticSiteIndex() = default;
+
+std::vector<size_t> StaticSiteIndex::FindContaining(
+    const std::string& text) const {
+  if (text.empty()) {
+    std::vector<size_t> all(entries_.size());
+    for (size_t id = 0; id < all.size(); ++id)
+      all[id] = id;
+    return all;
+  }
+
+  // Short queries are n-grams themselves, so their posting list is exact.
+  if (text.size() <= kMaxGramLength) {
+    auto it = postings_.find(GramKey(text, 0, text.size()));
+    return it == postings_.end() ? std::vector<size_t>() : it->second;
+  }
+
+  // Entries containing |text| contain all of its trigrams too. Intersect
+  // starting from the rarest one to keep the candidates few.
+  std::vector<const std::vector<size_t>*> lists;
+  for (size_t pos = 0; pos + kMaxGramLength <= text.size(); ++pos) {
+    auto it = postings_.find(GramKey(text, pos, kMaxGramLength));
+    if (it == postings_.end())
+      return std::vector<size_t>();
+    lists.push_back(&it->second);
+  }
+  std::sort(lists.begin(), lists.end(),
+            [](const std::vector<size_t>* a, const std::vector<size_t>* b) {
+              return a->size() < b->size();
+            });
+
+  std::vector<size_t> candidates = *lists[0];
+  for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+    std::vector<size_t> intersection;
+    std::set_intersection(candidates.begin(), candidates.end(),
+                          lists[i]->begin(), lists[i]->end(),
+                          std::back_inserter(intersection));
+    candidates.swap(intersection);
+  }
+  return FindContaining(text, candidates);
+}
+
+std::vector<size_t> StaticSiteIndex::FindContaining(
+    const std::string& text,
+    const std::vector<size_t>& candidates) const {
+  std::vector<size_t> matches;
+  for (size_t id : candidates) {
+    if (entries_[id].find(text) != std::string::npos)
+      matches.push_back(id);
+  }
+  return matches;
+}
+
+StaticSiteSearch::StaticSiteSearch(const StaticSiteIndex* index)
+    : index_(index) {}
+
+StaticSiteSearch::~StaticSiteSearch() = default;
+
+const std::vector<size_t>& StaticSiteSearch::Find(const std::string& text) {
+  // The posting list of a short query is cheaper than any narrowing.
+  const bool can_narrow = has_last_matches_ &&
+                          text.size() > StaticSiteIndex::kMaxGramLength &&
+                          text.find(last_text_) != std::string::npos;
+  if (!can_narrow) {
+    last_matches_ = index_->FindContaining(text);
+  } else if (text != last_text_) {
+    last_matches_ = index_->FindContaining(text, last_matches_);
+  }
+  has_last_matches_ = true;
+  last_text_ = text;
+  return last_matches_;
+}
@@ -0,0 +1,67 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_OMNIBOX_BROWSER_STATIC_SITE_INDEX_H_
+#define BRAVE_COMPONENTS_OMNIBOX_BROWSER_STATIC_SITE_INDEX_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/memory/raw_ptr.h"
+
+// Indexes every n-gram of up to three characters of a fixed list of lowercase
+// strings, so that the entries containing a query can be found without
+// scanning the whole list. Used by the providers of built-in site lists.
+class StaticSiteIndex {
+ public:
+  // Queries up to this length are answered by a single posting list.
+  static constexpr size_t kMaxGramLength = 3;
+
+  explicit StaticSiteIndex(const std::vector<std::string>& entries);
+  StaticSiteIndex(const StaticSiteIndex&) = delete;
+  StaticSiteIndex& operator=(const StaticSiteIndex&) = delete;
+  ~StaticSiteIndex();
+
+  // Returns the positions of the entries containing |text|, in the order of
+  // the list, which is the order the providers rank their matches in.
+  std::vector<size_t> FindContaining(const std::string& text) const;
+
+  // Same as above, but only checks |candidates|, which must be the result of
+  // a previous search for a substring of |text|.
+  std::vector<size_t> FindContaining(
+      const std::string& text,
+      const std::vector<size_t>& candidates) const;
+
+  size_t size() const { return entries_.size(); }
+
+ private:
+  std::vector<std::string> entries_;
+  // Sorted, duplicate free positions of the entries containing each n-gram.
+  base::flat_map<uint32_t, std::vector<size_t>> postings_;
+};
+
+// Searches a StaticSiteIndex as the user types, narrowing down the previous
+// matches instead of going back to the index when the query only grew.
+class StaticSiteSearch {
+ public:
+  explicit StaticSiteSearch(const StaticSiteIndex* index);
+  StaticSiteSearch(const StaticSiteSearch&) = delete;
+  StaticSiteSearch& operator=(const StaticSiteSearch&) = delete;
+  ~StaticSiteSearch();
+
+  // Returns the positions of the entries containing |text|, in list order.
+  const std::vector<size_t>& Find(const std::string& text);
+
+ private:
+  raw_ptr<const StaticSiteIndex> index_;
+  bool has_last_matches_ = false;
+  std::string last_text_;
+  std::vector<size_t> last_matches_;
+};
+
+#endif  // BRAVE_COMPONENTS_OMNIBOX_BROWSER_STATIC_SITE_INDEX_H_
@@ -0,0 +1,77 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "base/memory/scoped_refptr.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/omnibox/browser/brave_fake_autocomplete_provider_client.h"
+#include "brave/components/omnibox/browser/brave_omnibox_prefs.h"
+#include "brave/components/omnibox/browser/suggested_sites_provider.h"
+#include "brave/components/omnibox/browser/topsites_provider.h"
+#include "components/omnibox/browser/autocomplete_input.h"
+#include "components/omnibox/browser/test_scheme_classifier.h"
+#include "components/prefs/pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// npm run test -- brave_perftests --filter=StaticSiteProvidersPerfTest.*
+
+namespace {
+
+constexpr int kIterations = 100;
+
+// Typed one character at a time, as the omnibox sees them.
+const char* const kQueries[] = {"wikipedia.org", "bitcoin", "stackoverflow",
+                                "amaz", "xyzzy"};
+
+}  // namespace
+
+class StaticSiteProvidersPerfTest : public testing::Test {
+ public:
+  StaticSiteProvidersPerfTest() {
+    client_.GetPrefs()->SetBoolean(omnibox::kTopSiteSuggestionsEnabled, true);
+    client_.GetPrefs()->SetBoolean(
+        omnibox::kBraveSuggestedSiteSuggestionsEnabled, true);
+  }
+
+ protected:
+  // Returns the average time it takes |provider| to handle a keystroke.
+  double MeasureKeystrokes(AutocompleteProvider* provider) {
+    int keystrokes = 0;
+    base::ElapsedTimer timer;
+    for (int i = 0; i < kIterations; ++i) {
+      for (const char* query : kQueries) {
+        const std::u16string text = base::UTF8ToUTF16(query);
+        for (size_t length = 1; length <= text.size(); ++length) {
+          AutocompleteInput input(text.substr(0, length),
+                                  metrics::OmniboxEventProto::OTHER,
+                                  classifier_);
+          provider->Start(input, false);
+          ++keystrokes;
+        }
+      }
+    }
+    return timer.Elapsed().InMicrosecondsF() / keystrokes;
+  }
+
+  TestSchemeClassifier classifier_;
+  BraveFakeAutocompleteProviderClient client_;
+};
+
+TEST_F(StaticSiteProvidersPerfTest, Keystrokes) {
+  perf_test::PerfResultReporter reporter("StaticSiteProviders", "Keystrokes");
+  reporter.RegisterImportantMetric(".top_sites", "us/keystroke");
+  reporter.RegisterImportantMetric(".suggested_sites", "us/keystroke");
+
+  auto top_sites = base::MakeRefCounted<TopSitesProvider>(&client_);
+  reporter.AddResult(".top_sites", MeasureKeystrokes(top_sites.get()));
+
+  auto suggested_sites =
+      base::MakeRefCounted<SuggestedSitesProvider>(&client_);
+  reporter.AddResult(".suggested_sites",
+                     MeasureKeystrokes(suggested_sites.get()));
+}
@@ -0,0 +1,62 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/omnibox/browser/static_site_index.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=StaticSiteIndexTest.*
+
+namespace {
+
+const std::vector<std::string>& GetSites() {
+  static const std::vector<std::string> sites = {
+      "google.com", "mail.google.com", "youtube.com",
+      "goo.gl",     "gogole.com",      "tube.youtu.be",
+  };
+  return sites;
+}
+
+// Same as StaticSiteIndex::FindContaining, without the index.
+std::vector<size_t> Scan(const std::string& text) {
+  std::vector<size_t> matches;
+  for (size_t id = 0; id < GetSites().size(); ++id) {
+    if (GetSites()[id].find(text) != std::string::npos)
+      matches.push_back(id);
+  }
+  return matches;
+}
+
+}  // namespace
+
+TEST(StaticSiteIndexTest, FindContaining) {
+  StaticSiteIndex index(GetSites());
+  EXPECT_EQ(std::vector<size_t>({0, 1, 2, 3, 4, 5}), index.FindContaining(""));
+  EXPECT_EQ(std::vector<size_t>({0, 1, 3}), index.FindContaining("goo"));
+  EXPECT_EQ(std::vector<size_t>({0, 1}), index.FindContaining("google"));
+  EXPECT_EQ(std::vector<size_t>({2, 5}), index.FindContaining("tube"));
+  EXPECT_TRUE(index.FindContaining("googles").empty());
+  EXPECT_TRUE(index.FindContaining("x").empty());
+
+  // "tube.youtu.be" has all the trigrams of "youtube" but not the string.
+  EXPECT_EQ(std::vector<size_t>({2}), index.FindContaining("youtube"));
+
+  for (const char* text :
+       {"g", "go", "o.g", ".com", "le.com", "mail.", "\xc3\xa9"}) {
+    EXPECT_EQ(Scan(text), index.FindContaining(text)) << text;
+  }
+}
+
+TEST(StaticSiteIndexTest, SearchNarrowsAsTheQueryGrows) {
+  StaticSiteIndex index(GetSites());
+  StaticSiteSearch search(&index);
+  for (const char* text : {"g", "go", "goo", "goog", "googl", "google.",
+                           "googl", "oogle", "gole", "youtube.com"}) {
+    EXPECT_EQ(Scan(text), search.Find(text)) << text;
+  }
+}
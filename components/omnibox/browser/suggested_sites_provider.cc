@@ -5,9 +5,10 @@
 
 #include "brave/components/omnibox/browser/suggested_sites_provider.h"
 
-#include <algorithm>
+#include <string>
 #include <utility>
 
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/components/omnibox/browser/brave_omnibox_prefs.h"
@@ -22,8 +23,9 @@ const int SuggestedSitesProvider::kRelevance = 100;
 
 SuggestedSitesProvider::SuggestedSitesProvider(
     AutocompleteProviderClient* client)
-    : AutocompleteProvider(AutocompleteProvider::TYPE_SEARCH), client_(client) {
-}
+    : AutocompleteProvider(AutocompleteProvider::TYPE_SEARCH),
+      client_(client),
+      search_(&GetSuggestedSitesIndex()) {}
 
 void SuggestedSitesProvider::Start(const AutocompleteInput& input,
                                    bool minimal_changes) {
@@ -42,32 +44,37 @@ void SuggestedSitesProvider::Start(const AutocompleteInput& input,
 
   const std::string input_text =
       base::ToLowerASCII(base::UTF16ToUTF8(input.text()));
-  auto check_add_match =
-      [&](const SuggestedSitesMatch& match) {
+  const auto& suggested_sites = GetSuggestedSites();
+  for (size_t id : search_.Find(input_text)) {
+    const SuggestedSitesMatch& match = suggested_sites[id];
     // Don't bother matching until 4 chars, or less if it's an exact match
     if (input_text.length() < 4 &&
         match.match_string_.length() != input_text.length()) {
-      return;
+      continue;
     }
-    size_t foundPos = match.match_string_.find(input_text);
-    // We'd normally check for npos here but we want only people that
-    // really want these suggestions. Example don't suggest bitcoin and
-    // litecoin for just a coin search.
-    if (foundPos == 0) {
-      ACMatchClassifications styles =
-          StylesForSingleMatch(input_text,
-              base::UTF16ToASCII(match.display_));
-      AddMatch(match, styles);
-    }
-  };
-
-  const auto& suggested_sites = GetSuggestedSites();
-  std::for_each(suggested_sites.begin(), suggested_sites.end(),
-      check_add_match);
+    // The index also returns matches in the middle of the string, but we
+    // want only people that really want these suggestions. Example don't
+    // suggest bitcoin and litecoin for just a coin search.
+    if (!base::StartsWith(match.match_string_, input_text))
+      continue;
+    ACMatchClassifications styles =
+        StylesForSingleMatch(input_text, base::UTF16ToASCII(match.display_));
+    AddMatch(match, styles);
+  }
 }
 
 SuggestedSitesProvider::~SuggestedSitesProvider() {}
 
+const StaticSiteIndex& SuggestedSitesProvider::GetSuggestedSitesIndex() {
+  static const base::NoDestructor<StaticSiteIndex> index([this] {
+    std::vector<std::string> match_strings;
+    for (const auto& match : GetSuggestedSites())
+      match_strings.push_back(match.match_string_);
+    return match_strings;
+  }());
+  return *index;
+}
+
 // static
 ACMatchClassifications SuggestedSitesProvider::StylesForSingleMatch(
     const std::string &input_text,
@@ -11,6 +11,7 @@
 
 #include "base/compiler_specific.h"
 #include "base/memory/raw_ptr.h"
+#include "brave/components/omnibox/browser/static_site_index.h"
 #include "brave/components/omnibox/browser/suggested_sites_match.h"
 #include "components/omnibox/browser/autocomplete_match.h"
 #include "components/omnibox/browser/autocomplete_provider.h"
@@ -33,6 +34,9 @@ class SuggestedSitesProvider : public AutocompleteProvider {
   static const int kRelevance;
 
   const std::vector<SuggestedSitesMatch>& GetSuggestedSites();
+  // Returns the index of the match strings of GetSuggestedSites(), built on
+  // first use.
+  const StaticSiteIndex& GetSuggestedSitesIndex();
   void AddMatch(const SuggestedSitesMatch& match,
                 const ACMatchClassifications& styles);
 
@@ -41,6 +45,7 @@ class SuggestedSitesProvider : public AutocompleteProvider {
       const std::string &site);
 
   raw_ptr<AutocompleteProviderClient> client_ = nullptr;
+  StaticSiteSearch search_;
 };
 
 #endif  // BRAVE_COMPONENTS_OMNIBOX_BROWSER_SUGGESTED_SITES_PROVIDER_H_
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <string>
 
+#include "base/no_destructor.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/components/omnibox/browser/brave_omnibox_prefs.h"
@@ -23,8 +24,9 @@ const int TopSitesProvider::kRelevance = 100;
 
 
 TopSitesProvider::TopSitesProvider(AutocompleteProviderClient* client)
-    : AutocompleteProvider(AutocompleteProvider::TYPE_SEARCH), client_(client) {
-}
+    : AutocompleteProvider(AutocompleteProvider::TYPE_SEARCH),
+      client_(client),
+      search_(&GetIndex()) {}
 
 void TopSitesProvider::Start(const AutocompleteInput& input,
                             bool minimal_changes) {
@@ -42,16 +44,15 @@ void TopSitesProvider::Start(const AutocompleteInput& input,
   const std::string input_text =
       base::ToLowerASCII(base::UTF16ToUTF8(input.text()));
 
-  for (std::vector<std::string>::const_iterator i = top_sites_.begin();
-       (i != top_sites_.end()) && (matches_.size() < provider_max_matches());
-       ++i) {
-    const std::string &current_site = *i;
-    size_t foundPos = current_site.find(input_text);
-    if (std::string::npos != foundPos) {
-      ACMatchClassifications styles =
-          StylesForSingleMatch(input_text, current_site, foundPos);
-      AddMatch(base::ASCIIToUTF16(current_site), styles);
-    }
+  // The index returns the sites in list order, which is also their rank.
+  for (size_t id : search_.Find(input_text)) {
+    if (matches_.size() >= provider_max_matches())
+      break;
+    const std::string& current_site = top_sites_[id];
+    const size_t foundPos = current_site.find(input_text);
+    ACMatchClassifications styles =
+        StylesForSingleMatch(input_text, current_site, foundPos);
+    AddMatch(base::ASCIIToUTF16(current_site), styles);
   }
 
   for (size_t i = 0; i < matches_.size(); ++i) {
@@ -70,6 +71,12 @@ void TopSitesProvider::Start(const AutocompleteInput& input,
 
 TopSitesProvider::~TopSitesProvider() {}
 
+// static
+const StaticSiteIndex& TopSitesProvider::GetIndex() {
+  static const base::NoDestructor<StaticSiteIndex> index(top_sites_);
+  return *index;
+}
+
 // static
 ACMatchClassifications TopSitesProvider::StylesForSingleMatch(
     const std::string &input_text,
@@ -11,6 +11,7 @@
 
 #include "base/compiler_specific.h"
 #include "base/memory/raw_ptr.h"
+#include "brave/components/omnibox/browser/static_site_index.h"
 #include "components/omnibox/browser/autocomplete_match.h"
 #include "components/omnibox/browser/autocomplete_provider.h"
 
@@ -33,6 +34,9 @@ class TopSitesProvider : public AutocompleteProvider {
 
   static std::vector<std::string> top_sites_;
 
+  // Returns the index of |top_sites_|, built on first use.
+  static const StaticSiteIndex& GetIndex();
+
   void AddMatch(const std::u16string& match_string,
                 const ACMatchClassifications& styles);
 
@@ -42,6 +46,7 @@ class TopSitesProvider : public AutocompleteProvider {
       const size_t &foundPos);
 
   raw_ptr<AutocompleteProviderClient> client_ = nullptr;
+  StaticSiteSearch search_;
 };
 
 #endif  // BRAVE_COMPONENTS_OMNIBOX_BROWSER_TOPSITES_PROVIDER_H_
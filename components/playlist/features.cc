@@ -14,5 +14,11 @@ namespace features {
 
 const base::Feature kPlaylist{"Playlist", base::FEATURE_DISABLED_BY_DEFAULT};
 
+const base::FeatureParam<int> kPlaylistMaxConcurrentMediaDownloads{
+    &kPlaylist, kPlaylistMaxConcurrentMediaDownloadsName, 3};
+
+const base::FeatureParam<int> kPlaylistMaxMediaDownloadSegments{
+    &kPlaylist, kPlaylistMaxMediaDownloadSegmentsName, 2};
+
 }  // namespace features
 }  // namespace playlist
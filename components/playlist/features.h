@@ -6,13 +6,25 @@
 #ifndef BRAVE_COMPONENTS_PLAYLIST_FEATURES_H_
 #define BRAVE_COMPONENTS_PLAYLIST_FEATURES_H_
 
-namespace base {
-struct Feature;
-}  // namespace base
+#include "base/feature_list.h"
+#include "base/metrics/field_trial_params.h"
 
 namespace playlist {
 namespace features {
+
+constexpr char kPlaylistMaxConcurrentMediaDownloadsName[] =
+    "PlaylistMaxConcurrentMediaDownloads";
+constexpr char kPlaylistMaxMediaDownloadSegmentsName[] =
+    "PlaylistMaxMediaDownloadSegments";
+
 extern const base::Feature kPlaylist;
+// Number of playlist items whose media files are downloaded at once.
+extern const base::FeatureParam<int> kPlaylistMaxConcurrentMediaDownloads;
+// Number of ranges a single media file is split into when the server supports
+// range requests. Together with the above it stays within the per-host
+// connection limit.
+extern const base::FeatureParam<int> kPlaylistMaxMediaDownloadSegments;
+
 }  // namespace features
 }  // namespace playlist
 
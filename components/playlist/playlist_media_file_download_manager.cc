@@ -5,12 +5,16 @@
 
 #include "brave/components/playlist/playlist_media_file_download_manager.h"
 
+#include <algorithm>
 #include <utility>
 
+#include "base/barrier_closure.h"
 #include "base/files/file_path.h"
 #include "base/logging.h"
+#include "base/ranges/algorithm.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "base/values.h"
+#include "brave/components/playlist/features.h"
 #include "brave/components/playlist/playlist_constants.h"
 
 namespace playlist {
@@ -20,9 +24,14 @@ PlaylistMediaFileDownloadManager::PlaylistMediaFileDownloadManager(
     Delegate* delegate,
     const base::FilePath& base_dir)
     : base_dir_(base_dir), delegate_(delegate) {
-  // TODO(pilgrim) dynamically set file extensions based on format.
-  media_file_downloader_ = std::make_unique<PlaylistMediaFileDownloader>(
-      this, context, kMediaFileName);
+  const int max_downloads =
+      std::max(features::kPlaylistMaxConcurrentMediaDownloads.Get(), 1);
+  for (int i = 0; i < max_downloads; ++i) {
+    // TODO(pilgrim) dynamically set file extensions based on format.
+    media_file_downloaders_.push_back(
+        std::make_unique<PlaylistMediaFileDownloader>(this, context,
+                                                      kMediaFileName));
+  }
 }
 
 PlaylistMediaFileDownloadManager::~PlaylistMediaFileDownloadManager() = default;
@@ -31,46 +40,52 @@ void PlaylistMediaFileDownloadManager::GenerateMediaFileForPlaylistItem(
     const PlaylistItemInfo& playlist_item) {
   pending_media_file_creation_jobs_.push(playlist_item);
 
-  // If either media file controller is generating a playlist media file,
-  // delay the next playlist generation. It will be triggered when the current
-  // one is finished.
-  if (!IsCurrentDownloadingInProgress())
-    GenerateMediaFiles();
+  // If all downloaders are busy, the next playlist generation is triggered
+  // when one of them is finished.
+  GenerateMediaFiles();
 }
 
 void PlaylistMediaFileDownloadManager::CancelDownloadRequest(
-    const std::string& id) {
+    const std::string& id,
+    base::OnceClosure on_cancelled) {
   VLOG(2) << __func__ << " " << id;
 
-  // Cancel if currently downloading item is id.
+  // Cancel if the item is being downloaded.
   // Otherwise, GetNextPlaylistItemTarget() will drop canceled one.
-  if (GetCurrentDownloadingPlaylistItemID() == id) {
-    CancelCurrentDownloadingPlaylistItem();
-    GenerateMediaFiles();
+  auto* downloader = GetDownloaderForItem(id);
+  if (!downloader) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+                                                     std::move(on_cancelled));
     return;
   }
+
+  downloader->RequestCancelCurrentPlaylistGeneration(std::move(on_cancelled));
+  GenerateMediaFiles();
 }
 
-void PlaylistMediaFileDownloadManager::CancelAllDownloadRequests() {
-  CancelCurrentDownloadingPlaylistItem();
+void PlaylistMediaFileDownloadManager::CancelAllDownloadRequests(
+    base::OnceClosure on_cancelled) {
+  const base::RepeatingClosure barrier = base::BarrierClosure(
+      media_file_downloaders_.size(), std::move(on_cancelled));
+  for (auto& downloader : media_file_downloaders_)
+    downloader->RequestCancelCurrentPlaylistGeneration(barrier);
   pending_media_file_creation_jobs_ = {};
 }
 
 void PlaylistMediaFileDownloadManager::GenerateMediaFiles() {
-  if (IsCurrentDownloadingInProgress())
-    return;
+  while (!pending_media_file_creation_jobs_.empty()) {
+    auto* downloader = GetIdleDownloader();
+    if (!downloader)
+      return;
 
-  if (pending_media_file_creation_jobs_.empty())
-    return;
+    auto item = GetNextPlaylistItemTarget();
+    if (!item)
+      return;
 
-  current_item_ = GetNextPlaylistItemTarget();
-  if (!current_item_)
-    return;
+    VLOG(2) << __func__ << ": " << item->title;
 
-  VLOG(2) << __func__ << ": " << current_item_->title;
-
-  media_file_downloader_->DownloadMediaFileForPlaylistItem(*current_item_,
-                                                           base_dir_);
+    downloader->DownloadMediaFileForPlaylistItem(*item, base_dir_);
+  }
 }
 
 std::unique_ptr<PlaylistItemInfo>
@@ -79,27 +94,31 @@ PlaylistMediaFileDownloadManager::GetNextPlaylistItemTarget() {
     auto playlist_item(std::move(pending_media_file_creation_jobs_.front()));
     pending_media_file_creation_jobs_.pop();
 
-    if (delegate_->IsValidPlaylistItem(playlist_item.id))
+    if (delegate_->IsValidPlaylistItem(playlist_item.id) &&
+        !GetDownloaderForItem(playlist_item.id)) {
       return std::make_unique<PlaylistItemInfo>(std::move(playlist_item));
+    }
   }
 
   return nullptr;
 }
 
-std::string
-PlaylistMediaFileDownloadManager::GetCurrentDownloadingPlaylistItemID() const {
-  if (IsCurrentDownloadingInProgress())
-    return media_file_downloader_->current_playlist_id();
-
-  return {};
+PlaylistMediaFileDownloader*
+PlaylistMediaFileDownloadManager::GetIdleDownloader() {
+  auto it = base::ranges::find_if(
+      media_file_downloaders_,
+      [](const auto& downloader) { return !downloader->in_progress(); });
+  return it == media_file_downloaders_.end() ? nullptr : it->get();
 }
 
-void PlaylistMediaFileDownloadManager::CancelCurrentDownloadingPlaylistItem() {
-  media_file_downloader_->RequestCancelCurrentPlaylistGeneration();
-}
-
-bool PlaylistMediaFileDownloadManager::IsCurrentDownloadingInProgress() const {
-  return media_file_downloader_->in_progress();
+PlaylistMediaFileDownloader*
+PlaylistMediaFileDownloadManager::GetDownloaderForItem(const std::string& id) {
+  auto it = base::ranges::find_if(
+      media_file_downloaders_, [&id](const auto& downloader) {
+        return downloader->in_progress() &&
+               downloader->current_playlist_id() == id;
+      });
+  return it == media_file_downloaders_.end() ? nullptr : it->get();
 }
 
 void PlaylistMediaFileDownloadManager::OnMediaFileReady(
@@ -109,8 +128,6 @@ void PlaylistMediaFileDownloadManager::OnMediaFileReady(
 
   delegate_->OnMediaFileReady(id, media_file_path);
 
-  current_item_.reset();
-
   base::SequencedTaskRunnerHandle::Get()->PostTask(
       FROM_HERE,
       base::BindOnce(&PlaylistMediaFileDownloadManager::GenerateMediaFiles,
@@ -123,8 +140,6 @@ void PlaylistMediaFileDownloadManager::OnMediaFileGenerationFailed(
 
   delegate_->OnMediaFileGenerationFailed(id);
 
-  CancelCurrentDownloadingPlaylistItem();
-
   base::SequencedTaskRunnerHandle::Get()->PostTask(
       FROM_HERE,
       base::BindOnce(&PlaylistMediaFileDownloadManager::GenerateMediaFiles,
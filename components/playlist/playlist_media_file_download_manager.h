@@ -8,7 +8,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "base/callback.h"
 #include "base/containers/queue.h"
 #include "brave/components/playlist/playlist_media_file_downloader.h"
 
@@ -23,9 +25,9 @@ class BrowserContext;
 namespace playlist {
 
 // Download youtube playlist item's audio/video media files.
-// This handles one request at once. So, it has pending queue.
-// And PlaylistMediaFileDownloader does file download task.
-// TODO(simonhong): Download multiple media files simultaneously.
+// Up to features::kPlaylistMaxConcurrentMediaDownloads items are downloaded
+// at once, each by its own PlaylistMediaFileDownloader. Others wait in the
+// pending queue.
 class PlaylistMediaFileDownloadManager
     : public PlaylistMediaFileDownloader::Delegate {
  public:
@@ -54,8 +56,10 @@ class PlaylistMediaFileDownloadManager
       const PlaylistMediaFileDownloadManager&) = delete;
 
   void GenerateMediaFileForPlaylistItem(const PlaylistItemInfo& playlist_item);
-  void CancelDownloadRequest(const std::string& id);
-  void CancelAllDownloadRequests();
+  // |on_cancelled| runs once the partially downloaded files are deleted.
+  void CancelDownloadRequest(const std::string& id,
+                             base::OnceClosure on_cancelled);
+  void CancelAllDownloadRequests(base::OnceClosure on_cancelled);
 
  private:
   // PlaylistMediaFileDownloader::Delegate overrides:
@@ -65,17 +69,15 @@ class PlaylistMediaFileDownloadManager
 
   void GenerateMediaFiles();
   std::unique_ptr<PlaylistItemInfo> GetNextPlaylistItemTarget();
-  std::string GetCurrentDownloadingPlaylistItemID() const;
-  void CancelCurrentDownloadingPlaylistItem();
-  bool IsCurrentDownloadingInProgress() const;
+  PlaylistMediaFileDownloader* GetIdleDownloader();
+  PlaylistMediaFileDownloader* GetDownloaderForItem(const std::string& id);
 
   const base::FilePath base_dir_;
   raw_ptr<Delegate> delegate_;
   base::queue<PlaylistItemInfo> pending_media_file_creation_jobs_;
 
-  std::unique_ptr<PlaylistItemInfo> current_item_;
-
-  std::unique_ptr<PlaylistMediaFileDownloader> media_file_downloader_;
+  std::vector<std::unique_ptr<PlaylistMediaFileDownloader>>
+      media_file_downloaders_;
 
   base::WeakPtrFactory<PlaylistMediaFileDownloadManager> weak_factory_{this};
 };
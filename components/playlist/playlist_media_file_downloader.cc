@@ -17,8 +17,9 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/task_runner_util.h"
 #include "base/task/thread_pool.h"
-#include "brave/components/api_request_helper/api_request_helper.h"
+#include "brave/components/playlist/features.h"
 #include "brave/components/playlist/playlist_constants.h"
+#include "brave/components/playlist/playlist_range_downloader.h"
 #include "brave/components/playlist/playlist_types.h"
 #include "build/build_config.h"
 #include "content/public/browser/browser_context.h"
@@ -30,6 +31,9 @@
 namespace playlist {
 namespace {
 
+// Files smaller than this aren't split into range requests.
+constexpr int64_t kMinMediaDownloadSegmentSize = 4 * 1024 * 1024;
+
 net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTagForURLLoad() {
   return net::DefineNetworkTrafficAnnotation("playlist_service", R"(
       semantics {
@@ -57,9 +61,6 @@ PlaylistMediaFileDownloader::PlaylistMediaFileDownloader(
       url_loader_factory_(
           context->content::BrowserContext::GetDefaultStoragePartition()
               ->GetURLLoaderFactoryForBrowserProcess()),
-      request_helper_(std::make_unique<api_request_helper::APIRequestHelper>(
-          GetNetworkTrafficAnnotationTagForURLLoad(),
-          url_loader_factory_)),
       media_file_name_(media_file_name) {}
 
 PlaylistMediaFileDownloader::~PlaylistMediaFileDownloader() = default;
@@ -109,8 +110,8 @@ void PlaylistMediaFileDownloader::DownloadMediaFile(const GURL& url,
   VLOG(2) << __func__ << ": " << url.spec() << " at: " << index;
 
   const base::FilePath file_path = playlist_dir_path_.Append(media_file_name_);
-  request_helper_->Download(
-      url, {}, {}, true, file_path,
+  range_downloader_->Download(
+      url, file_path,
       base::BindOnce(&PlaylistMediaFileDownloader::OnMediaFileDownloaded,
                      base::Unretained(this), index));
 }
@@ -133,7 +134,9 @@ void PlaylistMediaFileDownloader::OnMediaFileDownloaded(int index,
   NotifySucceed(current_item_->id, path.AsUTF8Unsafe());
 }
 
-void PlaylistMediaFileDownloader::RequestCancelCurrentPlaylistGeneration() {
+void PlaylistMediaFileDownloader::RequestCancelCurrentPlaylistGeneration(
+    base::OnceClosure on_cancelled) {
+  range_downloader_->Cancel(std::move(on_cancelled));
   ResetDownloadStatus();
 }
 
@@ -149,8 +152,11 @@ base::SequencedTaskRunner* PlaylistMediaFileDownloader::task_runner() {
 void PlaylistMediaFileDownloader::ResetDownloadStatus() {
   in_progress_ = false;
   current_item_.reset();
-  request_helper_ = std::make_unique<api_request_helper::APIRequestHelper>(
-      GetNetworkTrafficAnnotationTagForURLLoad(), url_loader_factory_);
+  // Dropping an unfinished download keeps its partial file and resume map.
+  range_downloader_ = std::make_unique<PlaylistRangeDownloader>(
+      url_loader_factory_, GetNetworkTrafficAnnotationTagForURLLoad(),
+      task_runner(), features::kPlaylistMaxMediaDownloadSegments.Get(),
+      kMinMediaDownloadSegmentSize);
   playlist_dir_path_.clear();
 }
 
@@ -11,15 +11,12 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/values.h"
 #include "brave/components/playlist/playlist_types.h"
 
-namespace api_request_helper {
-class APIRequestHelper;
-}  // namespace api_request_helper
-
 namespace base {
 class FilePath;
 class SequencedTaskRunner;
@@ -31,13 +28,14 @@ class BrowserContext;
 
 namespace network {
 class SharedURLLoaderFactory;
-class SimpleURLLoader;
 }  // namespace network
 
 class GURL;
 
 namespace playlist {
 
+class PlaylistRangeDownloader;
+
 // Handle one Playlist at once.
 class PlaylistMediaFileDownloader {
  public:
@@ -65,7 +63,9 @@ class PlaylistMediaFileDownloader {
   void DownloadMediaFileForPlaylistItem(const PlaylistItemInfo& item,
                                         const base::FilePath& base_dir);
 
-  void RequestCancelCurrentPlaylistGeneration();
+  // Deletes the partially downloaded file. |on_cancelled| runs once it's
+  // gone.
+  void RequestCancelCurrentPlaylistGeneration(base::OnceClosure on_cancelled);
 
   bool in_progress() const { return in_progress_; }
   const std::string& current_playlist_id() const { return current_item_->id; }
@@ -83,7 +83,7 @@ class PlaylistMediaFileDownloader {
   raw_ptr<Delegate> delegate_ = nullptr;
 
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
-  std::unique_ptr<api_request_helper::APIRequestHelper> request_helper_;
+  std::unique_ptr<PlaylistRangeDownloader> range_downloader_;
 
   const base::FilePath::StringType media_file_name_;
 
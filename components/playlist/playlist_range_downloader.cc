@@ -0,0 +1,563 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/playlist/playlist_range_downloader.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/memory/raw_ptr.h"
+#include "base/ranges/algorithm.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "net/base/load_flags.h"
+#include "net/base/request_priority.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+
+namespace playlist {
+
+namespace {
+
+constexpr base::FilePath::CharType kResumeMapExtension[] =
+    FILE_PATH_LITERAL(".resume");
+
+constexpr char kUrlKey[] = "url";
+constexpr char kValidatorKey[] = "validator";
+constexpr char kTotalSizeKey[] = "total_size";
+constexpr char kSegmentsKey[] = "segments";
+constexpr char kStartKey[] = "start";
+constexpr char kEndKey[] = "end";
+constexpr char kReceivedKey[] = "received";
+
+constexpr size_t kMaxResumeMapSize = 64 * 1024;
+// How much has to be written before the resume map is saved again. At most
+// this much is downloaded twice after a crash.
+constexpr int64_t kResumeMapSaveInterval = 4 * 1024 * 1024;
+// A segment is restarted from what it has received so far this many times
+// before the download fails.
+constexpr int kMaxSegmentRetries = 3;
+
+// int64 values are stored as strings as base::Value only holds 32-bit ints.
+absl::optional<int64_t> FindInt64(const base::Value::Dict& dict,
+                                  base::StringPiece key) {
+  const std::string* value = dict.FindString(key);
+  int64_t result = 0;
+  if (!value || !base::StringToInt64(*value, &result))
+    return absl::nullopt;
+  return result;
+}
+
+std::string GetValidator(const net::HttpResponseHeaders& headers) {
+  std::string etag;
+  if (headers.GetNormalizedHeader("ETag", &etag) &&
+      !base::StartsWith(etag, "W/")) {
+    return etag;
+  }
+  std::string last_modified;
+  headers.GetNormalizedHeader("Last-Modified", &last_modified);
+  return last_modified;
+}
+
+}  // namespace
+
+PlaylistDownloadResumeMap::PlaylistDownloadResumeMap() = default;
+PlaylistDownloadResumeMap::PlaylistDownloadResumeMap(
+    const PlaylistDownloadResumeMap&) = default;
+PlaylistDownloadResumeMap& PlaylistDownloadResumeMap::operator=(
+    const PlaylistDownloadResumeMap&) = default;
+PlaylistDownloadResumeMap::~PlaylistDownloadResumeMap() = default;
+
+// static
+absl::optional<PlaylistDownloadResumeMap> PlaylistDownloadResumeMap::FromValue(
+    const base::Value& value) {
+  const base::Value::Dict* dict = value.GetIfDict();
+  if (!dict)
+    return absl::nullopt;
+
+  const std::string* url = dict->FindString(kUrlKey);
+  const std::string* validator = dict->FindString(kValidatorKey);
+  const absl::optional<int64_t> total_size = FindInt64(*dict, kTotalSizeKey);
+  const base::Value::List* segments = dict->FindList(kSegmentsKey);
+  if (!url || !validator || !total_size || !segments)
+    return absl::nullopt;
+
+  PlaylistDownloadResumeMap resume_map;
+  resume_map.url = *url;
+  resume_map.validator = *validator;
+  resume_map.total_size = *total_size;
+  for (const auto& segment_value : *segments) {
+    const base::Value::Dict* segment_dict = segment_value.GetIfDict();
+    if (!segment_dict)
+      return absl::nullopt;
+    const absl::optional<int64_t> start = FindInt64(*segment_dict, kStartKey);
+    const absl::optional<int64_t> end = FindInt64(*segment_dict, kEndKey);
+    const absl::optional<int64_t> received =
+        FindInt64(*segment_dict, kReceivedKey);
+    if (!start || !end || !received || *start < 0 || *end < *start ||
+        *end >= *total_size || *received < 0 ||
+        *received > *end - *start + 1) {
+      return absl::nullopt;
+    }
+    resume_map.segments.push_back({*start, *end, *received});
+  }
+  return resume_map;
+}
+
+base::Value PlaylistDownloadResumeMap::ToValue() const {
+  base::Value::List segments_list;
+  for (const auto& segment : segments) {
+    base::Value::Dict segment_dict;
+    segment_dict.Set(kStartKey, base::NumberToString(segment.start));
+    segment_dict.Set(kEndKey, base::NumberToString(segment.end));
+    segment_dict.Set(kReceivedKey, base::NumberToString(segment.received));
+    segments_list.Append(std::move(segment_dict));
+  }
+
+  base::Value::Dict dict;
+  dict.Set(kUrlKey, url);
+  dict.Set(kValidatorKey, validator);
+  dict.Set(kTotalSizeKey, base::NumberToString(total_size));
+  dict.Set(kSegmentsKey, std::move(segments_list));
+  return base::Value(std::move(dict));
+}
+
+// Owns the partially downloaded file. Lives on the file task runner.
+class PlaylistRangeDownloader::PartialFile {
+ public:
+  explicit PartialFile(const base::FilePath& path)
+      : path_(path), resume_map_path_(GetResumeMapPath(path)) {}
+  ~PartialFile() = default;
+
+  PartialFile(const PartialFile&) = delete;
+  PartialFile& operator=(const PartialFile&) = delete;
+
+  absl::optional<PlaylistDownloadResumeMap> ReadResumeMap() {
+    std::string json;
+    if (!base::ReadFileToStringWithMaxSize(resume_map_path_, &json,
+                                           kMaxResumeMapSize)) {
+      return absl::nullopt;
+    }
+    absl::optional<base::Value> value = base::JSONReader::Read(json);
+    if (!value)
+      return absl::nullopt;
+    return PlaylistDownloadResumeMap::FromValue(*value);
+  }
+
+  // Opens the file for writing the segments at their offsets. A resumed file
+  // must already have |total_size|, a new one is extended to it.
+  bool Open(int64_t total_size, bool resume) {
+    file_.Close();
+    file_.Initialize(path_,
+                     base::File::FLAG_OPEN_ALWAYS | base::File::FLAG_WRITE);
+    if (!file_.IsValid())
+      return false;
+    if (resume)
+      return file_.GetLength() == total_size;
+    return file_.SetLength(total_size);
+  }
+
+  bool Write(int64_t offset, const std::string& data) {
+    return file_.IsValid() &&
+           file_.Write(offset, data.data(), data.size()) ==
+               static_cast<int>(data.size());
+  }
+
+  void WriteResumeMap(const std::string& json) {
+    if (!base::ImportantFileWriter::WriteFileAtomically(resume_map_path_,
+                                                        json)) {
+      VLOG(1) << "Failed to write " << resume_map_path_;
+    }
+  }
+
+  // Called once every segment is written.
+  bool Finish() {
+    file_.Close();
+    return base::DeleteFile(resume_map_path_);
+  }
+
+  void Discard() {
+    file_.Close();
+    base::DeleteFile(resume_map_path_);
+    base::DeleteFile(path_);
+  }
+
+ private:
+  const base::FilePath path_;
+  const base::FilePath resume_map_path_;
+  base::File file_;
+};
+
+// Streams one segment into the partial file. The next chunk is only read
+// once the previous one is written, so memory use doesn't depend on how fast
+// the network is compared to the disk.
+class PlaylistRangeDownloader::SegmentLoader
+    : public network::SimpleURLLoaderStreamConsumer {
+ public:
+  SegmentLoader(PlaylistRangeDownloader* owner, size_t index)
+      : owner_(owner), index_(index) {}
+  ~SegmentLoader() override = default;
+
+  SegmentLoader(const SegmentLoader&) = delete;
+  SegmentLoader& operator=(const SegmentLoader&) = delete;
+
+  void Start() {
+    const PlaylistDownloadSegment& current = segment();
+    completed_ = false;
+    loader_ = owner_->CreateLoader(
+        owner_->url_,
+        base::StringPrintf("bytes=%" PRId64 "-%" PRId64,
+                           current.start + current.received, current.end),
+        owner_->resume_map_.validator);
+    loader_->SetOnResponseStartedCallback(base::BindOnce(
+        &SegmentLoader::OnResponseStarted, base::Unretained(this)));
+    loader_->DownloadAsStream(owner_->url_loader_factory_.get(), this);
+  }
+
+ private:
+  PlaylistDownloadSegment& segment() {
+    return owner_->resume_map_.segments[index_];
+  }
+
+  void OnResponseStarted(const GURL& final_url,
+                         const network::mojom::URLResponseHead& head) {
+    // Anything but a partial response to If-Range means the file changed
+    // since the other segments were written.
+    if (!head.headers ||
+        head.headers->response_code() != net::HTTP_PARTIAL_CONTENT) {
+      VLOG(1) << __func__ << ": range not honored for " << final_url;
+      owner_->OnSegmentFailed(/*content_changed=*/true);
+      // |this| is deleted.
+    }
+  }
+
+  void OnWritten(size_t size, base::OnceClosure resume, bool success) {
+    write_pending_ = false;
+    if (!success) {
+      owner_->OnSegmentFailed(/*content_changed=*/false);
+      return;
+    }
+
+    segment().received += size;
+    owner_->OnSegmentProgress(size);
+    if (completed_) {
+      HandleComplete();
+      return;
+    }
+    std::move(resume).Run();
+  }
+
+  void HandleComplete() {
+    if (segment().complete()) {
+      loader_.reset();
+      owner_->OnSegmentComplete();
+      return;
+    }
+
+    if (++retries_ > kMaxSegmentRetries) {
+      owner_->OnSegmentFailed(/*content_changed=*/false);
+      return;
+    }
+
+    VLOG(2) << __func__ << ": restarting segment " << index_ << " at "
+            << segment().received;
+    Start();
+  }
+
+  // network::SimpleURLLoaderStreamConsumer:
+  void OnDataReceived(base::StringPiece string_piece,
+                      base::OnceClosure resume) override {
+    const PlaylistDownloadSegment& current = segment();
+    const base::StringPiece data = string_piece.substr(
+        0, static_cast<size_t>(current.length() - current.received));
+    write_pending_ = true;
+    owner_->file_.AsyncCall(&PartialFile::Write)
+        .WithArgs(current.start + current.received, std::string(data))
+        .Then(base::BindOnce(&SegmentLoader::OnWritten,
+                             weak_factory_.GetWeakPtr(), data.size(),
+                             std::move(resume)));
+  }
+
+  void OnComplete(bool success) override {
+    VLOG_IF(2, !success) << __func__ << ": segment " << index_ << " failed "
+                         << loader_->NetError();
+    completed_ = true;
+    if (!write_pending_)
+      HandleComplete();
+  }
+
+  void OnRetry(base::OnceClosure start_retry) override {
+    // Segments are restarted by HandleComplete() from the received offset.
+    NOTREACHED();
+  }
+
+  raw_ptr<PlaylistRangeDownloader> owner_ = nullptr;
+  const size_t index_;
+  int retries_ = 0;
+  bool write_pending_ = false;
+  bool completed_ = false;
+  std::unique_ptr<network::SimpleURLLoader> loader_;
+
+  base::WeakPtrFactory<SegmentLoader> weak_factory_{this};
+};
+
+PlaylistRangeDownloader::PlaylistRangeDownloader(
+    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
+    const net::NetworkTrafficAnnotationTag& annotation_tag,
+    scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+    int max_segments,
+    int64_t min_segment_size)
+    : url_loader_factory_(std::move(url_loader_factory)),
+      annotation_tag_(annotation_tag),
+      file_task_runner_(std::move(file_task_runner)),
+      max_segments_(std::max(max_segments, 1)),
+      min_segment_size_(std::max<int64_t>(min_segment_size, 1)) {}
+
+PlaylistRangeDownloader::~PlaylistRangeDownloader() {
+  if (!segment_loaders_.empty())
+    SaveResumeMap();
+}
+
+// static
+base::FilePath PlaylistRangeDownloader::GetResumeMapPath(
+    const base::FilePath& path) {
+  return path.AddExtension(kResumeMapExtension);
+}
+
+void PlaylistRangeDownloader::Download(const GURL& url,
+                                       const base::FilePath& path,
+                                       DownloadCallback callback) {
+  DCHECK(!callback_) << "Only one download at once";
+
+  url_ = url;
+  path_ = path;
+  callback_ = std::move(callback);
+  resume_map_ = {};
+  unsaved_bytes_ = 0;
+
+  file_ = base::SequenceBound<PartialFile>(file_task_runner_, path_);
+  file_.AsyncCall(&PartialFile::ReadResumeMap)
+      .Then(base::BindOnce(&PlaylistRangeDownloader::OnResumeMapRead,
+                           weak_factory_.GetWeakPtr()));
+}
+
+void PlaylistRangeDownloader::Cancel(base::OnceClosure on_cancelled) {
+  // Drop the loaders first so that the destructor doesn't save the resume
+  // map again.
+  segment_loaders_.clear();
+  loader_.reset();
+  callback_.Reset();
+  weak_factory_.InvalidateWeakPtrs();
+
+  if (file_.is_null()) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(FROM_HERE,
+                                                     std::move(on_cancelled));
+    return;
+  }
+
+  // Queued behind the pending writes on the file task runner.
+  file_.AsyncCall(&PartialFile::Discard).Then(std::move(on_cancelled));
+  file_.Reset();
+}
+
+std::unique_ptr<network::SimpleURLLoader> PlaylistRangeDownloader::CreateLoader(
+    const GURL& url,
+    const std::string& range,
+    const std::string& if_range) const {
+  auto request = std::make_unique<network::ResourceRequest>();
+  request->url = url;
+  request->load_flags = net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE |
+                        net::LOAD_DO_NOT_SAVE_COOKIES;
+  request->credentials_mode = network::mojom::CredentialsMode::kOmit;
+  request->priority = net::IDLE;
+  if (!range.empty())
+    request->headers.SetHeader(net::HttpRequestHeaders::kRange, range);
+  if (!if_range.empty())
+    request->headers.SetHeader("If-Range", if_range);
+  return network::SimpleURLLoader::Create(std::move(request), annotation_tag_);
+}
+
+void PlaylistRangeDownloader::OnResumeMapRead(
+    absl::optional<PlaylistDownloadResumeMap> resume_map) {
+  if (!resume_map || resume_map->url != url_.spec() ||
+      resume_map->validator.empty() || resume_map->segments.empty()) {
+    ProbeRangeSupport();
+    return;
+  }
+
+  VLOG(2) << __func__ << ": resuming " << url_;
+  resume_map_ = std::move(*resume_map);
+  file_.AsyncCall(&PartialFile::Open)
+      .WithArgs(resume_map_.total_size, true)
+      .Then(base::BindOnce(&PlaylistRangeDownloader::OnFileOpened,
+                           weak_factory_.GetWeakPtr(), true));
+}
+
+void PlaylistRangeDownloader::ProbeRangeSupport() {
+  resume_map_ = {};
+  loader_ = CreateLoader(url_, "bytes=0-0", std::string());
+  loader_->DownloadHeadersOnly(
+      url_loader_factory_.get(),
+      base::BindOnce(&PlaylistRangeDownloader::OnProbeResponse,
+                     base::Unretained(this)));
+}
+
+void PlaylistRangeDownloader::OnProbeResponse(
+    scoped_refptr<net::HttpResponseHeaders> headers) {
+  loader_.reset();
+
+  int64_t first = 0;
+  int64_t last = 0;
+  int64_t total_size = 0;
+  std::string validator;
+  if (headers && headers->response_code() == net::HTTP_PARTIAL_CONTENT &&
+      headers->GetContentRangeFor206(&first, &last, &total_size) &&
+      total_size > 0) {
+    validator = GetValidator(*headers);
+  }
+
+  // Without a validator a resumed or parallel download could mix two
+  // versions of the file.
+  if (validator.empty()) {
+    VLOG(2) << __func__ << ": no range support for " << url_;
+    DownloadWholeFile();
+    return;
+  }
+
+  const int64_t count = std::clamp<int64_t>(total_size / min_segment_size_, 1,
+                                            max_segments_);
+  const int64_t segment_size = total_size / count;
+  resume_map_.url = url_.spec();
+  resume_map_.validator = validator;
+  resume_map_.total_size = total_size;
+  for (int64_t i = 0; i < count; ++i) {
+    const int64_t start = i * segment_size;
+    const int64_t end = i == count - 1 ? total_size - 1
+                                       : start + segment_size - 1;
+    resume_map_.segments.push_back({start, end, 0});
+  }
+
+  file_.AsyncCall(&PartialFile::Open)
+      .WithArgs(total_size, false)
+      .Then(base::BindOnce(&PlaylistRangeDownloader::OnFileOpened,
+                           weak_factory_.GetWeakPtr(), false));
+}
+
+void PlaylistRangeDownloader::OnFileOpened(bool resume, bool success) {
+  if (success) {
+    SaveResumeMap();
+    StartSegments();
+    return;
+  }
+
+  if (resume) {
+    // The partial file doesn't match its resume map, start over.
+    ProbeRangeSupport();
+    return;
+  }
+
+  VLOG(1) << __func__ << ": failed to open " << path_;
+  Complete(false);
+}
+
+void PlaylistRangeDownloader::StartSegments() {
+  for (size_t i = 0; i < resume_map_.segments.size(); ++i) {
+    if (!resume_map_.segments[i].complete())
+      segment_loaders_.push_back(std::make_unique<SegmentLoader>(this, i));
+  }
+
+  if (segment_loaders_.empty()) {
+    OnSegmentComplete();
+    return;
+  }
+
+  for (auto& segment_loader : segment_loaders_)
+    segment_loader->Start();
+}
+
+void PlaylistRangeDownloader::DownloadWholeFile() {
+  file_.AsyncCall(&PartialFile::Discard)
+      .Then(base::BindOnce(&PlaylistRangeDownloader::StartWholeFileDownload,
+                           weak_factory_.GetWeakPtr()));
+}
+
+void PlaylistRangeDownloader::StartWholeFileDownload() {
+  loader_ = CreateLoader(url_, std::string(), std::string());
+  loader_->DownloadToFile(
+      url_loader_factory_.get(),
+      base::BindOnce(&PlaylistRangeDownloader::OnWholeFileDownloaded,
+                     base::Unretained(this)),
+      path_);
+}
+
+void PlaylistRangeDownloader::OnWholeFileDownloaded(base::FilePath path) {
+  Complete(!path.empty());
+}
+
+void PlaylistRangeDownloader::OnSegmentProgress(int64_t bytes) {
+  unsaved_bytes_ += bytes;
+  if (unsaved_bytes_ >= kResumeMapSaveInterval)
+    SaveResumeMap();
+}
+
+void PlaylistRangeDownloader::OnSegmentComplete() {
+  if (!base::ranges::all_of(resume_map_.segments,
+                            &PlaylistDownloadSegment::complete)) {
+    return;
+  }
+
+  segment_loaders_.clear();
+  file_.AsyncCall(&PartialFile::Finish)
+      .Then(base::BindOnce(&PlaylistRangeDownloader::Complete,
+                           weak_factory_.GetWeakPtr()));
+}
+
+void PlaylistRangeDownloader::OnSegmentFailed(bool content_changed) {
+  if (content_changed)
+    file_.AsyncCall(&PartialFile::Discard);
+  else
+    SaveResumeMap();
+  Complete(false);
+}
+
+void PlaylistRangeDownloader::SaveResumeMap() {
+  std::string json;
+  if (!base::JSONWriter::Write(resume_map_.ToValue(), &json))
+    return;
+  unsaved_bytes_ = 0;
+  file_.AsyncCall(&PartialFile::WriteResumeMap).WithArgs(std::move(json));
+}
+
+void PlaylistRangeDownloader::Complete(bool success) {
+  segment_loaders_.clear();
+  loader_.reset();
+  base::SequencedTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&PlaylistRangeDownloader::RunCallback,
+                                weak_factory_.GetWeakPtr(),
+                                success ? path_ : base::FilePath()));
+}
+
+void PlaylistRangeDownloader::RunCallback(base::FilePath path) {
+  std::move(callback_).Run(std::move(path));
+}
+
+}  // namespace playlist
@@ -0,0 +1,150 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_PLAYLIST_PLAYLIST_RANGE_DOWNLOADER_H_
+#define BRAVE_COMPONENTS_PLAYLIST_PLAYLIST_RANGE_DOWNLOADER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/sequence_bound.h"
+#include "base/values.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "url/gurl.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace net {
+class HttpResponseHeaders;
+}  // namespace net
+
+namespace network {
+class SharedURLLoaderFactory;
+class SimpleURLLoader;
+}  // namespace network
+
+namespace playlist {
+
+// Byte range [start, end] of a media file and how much of it is on disk.
+struct PlaylistDownloadSegment {
+  int64_t length() const { return end - start + 1; }
+  bool complete() const { return received == length(); }
+
+  int64_t start = 0;
+  int64_t end = 0;
+  int64_t received = 0;
+};
+
+// Persisted next to a partially downloaded media file so that the download
+// continues where it stopped after a restart.
+struct PlaylistDownloadResumeMap {
+  PlaylistDownloadResumeMap();
+  PlaylistDownloadResumeMap(const PlaylistDownloadResumeMap&);
+  PlaylistDownloadResumeMap& operator=(const PlaylistDownloadResumeMap&);
+  ~PlaylistDownloadResumeMap();
+
+  static absl::optional<PlaylistDownloadResumeMap> FromValue(
+      const base::Value& value);
+  base::Value ToValue() const;
+
+  std::string url;
+  // Strong ETag or Last-Modified of the response the segments belong to. Sent
+  // as If-Range so that a changed file is never stitched together.
+  std::string validator;
+  int64_t total_size = 0;
+  std::vector<PlaylistDownloadSegment> segments;
+};
+
+// Downloads a media file with parallel range requests when the server
+// supports them, and as a single request otherwise. Requests are made at the
+// lowest priority so that they don't delay thumbnails and page loads.
+class PlaylistRangeDownloader {
+ public:
+  // Runs with the downloaded file, or an empty path on failure.
+  using DownloadCallback = base::OnceCallback<void(base::FilePath)>;
+
+  PlaylistRangeDownloader(
+      scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
+      const net::NetworkTrafficAnnotationTag& annotation_tag,
+      scoped_refptr<base::SequencedTaskRunner> file_task_runner,
+      int max_segments,
+      int64_t min_segment_size);
+  ~PlaylistRangeDownloader();
+
+  PlaylistRangeDownloader(const PlaylistRangeDownloader&) = delete;
+  PlaylistRangeDownloader& operator=(const PlaylistRangeDownloader&) = delete;
+
+  static base::FilePath GetResumeMapPath(const base::FilePath& path);
+
+  // Only one download at once. Destroying the downloader keeps the partial
+  // file and its resume map.
+  void Download(const GURL& url,
+                const base::FilePath& path,
+                DownloadCallback callback);
+
+  // Stops the download without running its callback and deletes the partial
+  // file and its resume map, so that it isn't resumed after a restart.
+  // |on_cancelled| runs once every pending write to the file has finished.
+  void Cancel(base::OnceClosure on_cancelled);
+
+ private:
+  class PartialFile;
+  class SegmentLoader;
+
+  std::unique_ptr<network::SimpleURLLoader> CreateLoader(
+      const GURL& url,
+      const std::string& range,
+      const std::string& if_range) const;
+
+  void OnResumeMapRead(absl::optional<PlaylistDownloadResumeMap> resume_map);
+  void ProbeRangeSupport();
+  void OnProbeResponse(scoped_refptr<net::HttpResponseHeaders> headers);
+  void OnFileOpened(bool resume, bool success);
+  void StartSegments();
+
+  void DownloadWholeFile();
+  void StartWholeFileDownload();
+  void OnWholeFileDownloaded(base::FilePath path);
+
+  // Called by SegmentLoader.
+  void OnSegmentProgress(int64_t bytes);
+  void OnSegmentComplete();
+  void OnSegmentFailed(bool content_changed);
+
+  void SaveResumeMap();
+  void Complete(bool success);
+  void RunCallback(base::FilePath path);
+
+  scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
+  const net::NetworkTrafficAnnotationTag annotation_tag_;
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  const int max_segments_;
+  const int64_t min_segment_size_;
+
+  GURL url_;
+  base::FilePath path_;
+  DownloadCallback callback_;
+
+  base::SequenceBound<PartialFile> file_;
+  PlaylistDownloadResumeMap resume_map_;
+  int64_t unsaved_bytes_ = 0;
+  std::unique_ptr<network::SimpleURLLoader> loader_;
+  std::vector<std::unique_ptr<SegmentLoader>> segment_loaders_;
+
+  base::WeakPtrFactory<PlaylistRangeDownloader> weak_factory_{this};
+};
+
+}  // namespace playlist
+
+#endif  // BRAVE_COMPONENTS_PLAYLIST_PLAYLIST_RANGE_DOWNLOADER_H_
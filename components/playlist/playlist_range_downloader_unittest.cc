@@ -0,0 +1,352 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/playlist/playlist_range_downloader.h"
+
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/run_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/thread_pool.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_byte_range.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_util.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/url_loader_completion_status.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_unit_tests --filter=PlaylistRangeDownloaderTest*
+
+namespace playlist {
+
+namespace {
+
+constexpr char kMediaUrl[] = "https://media.example.com/video.mp4";
+constexpr char kETag[] = "\"v1\"";
+constexpr int64_t kContentSize = 1024 * 1024 + 17;
+constexpr int64_t kMinSegmentSize = 256 * 1024;
+constexpr char kProbeRange[] = "bytes=0-0";
+
+std::string GetRange(int64_t first, int64_t last) {
+  return base::StringPrintf("bytes=%" PRId64 "-%" PRId64, first, last);
+}
+
+}  // namespace
+
+// Emulates a media server that supports range requests with an ETag
+// validator.
+class PlaylistRangeDownloaderTest : public testing::Test {
+ public:
+  PlaylistRangeDownloaderTest()
+      : shared_url_loader_factory_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)) {}
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("media_file.mp4");
+
+    content_.reserve(kContentSize);
+    for (int64_t i = 0; i < kContentSize; ++i)
+      content_.push_back(static_cast<char>((i * 7 + i / 251) & 0xff));
+
+    url_loader_factory_.SetInterceptor(base::BindRepeating(
+        &PlaylistRangeDownloaderTest::HandleRequest, base::Unretained(this)));
+  }
+
+  std::unique_ptr<PlaylistRangeDownloader> CreateDownloader(int max_segments) {
+    return std::make_unique<PlaylistRangeDownloader>(
+        shared_url_loader_factory_, TRAFFIC_ANNOTATION_FOR_TESTS,
+        base::ThreadPool::CreateSequencedTaskRunner({base::MayBlock()}),
+        max_segments, kMinSegmentSize);
+  }
+
+  base::FilePath Download(PlaylistRangeDownloader* downloader) {
+    base::FilePath result;
+    base::RunLoop run_loop;
+    downloader->Download(GURL(kMediaUrl), path_,
+                         base::BindLambdaForTesting([&](base::FilePath path) {
+                           result = std::move(path);
+                           run_loop.Quit();
+                         }));
+    run_loop.Run();
+    // Let the file task runner finish writing the resume map.
+    task_environment_.RunUntilIdle();
+    return result;
+  }
+
+  // Writes the first |received| bytes of each segment and the resume map.
+  void WritePartialFile(const PlaylistDownloadResumeMap& resume_map) {
+    std::string partial(kContentSize, '\0');
+    for (const auto& segment : resume_map.segments) {
+      partial.replace(segment.start, segment.received,
+                      content_.substr(segment.start, segment.received));
+    }
+    ASSERT_TRUE(base::WriteFile(path_, partial));
+
+    std::string json;
+    ASSERT_TRUE(base::JSONWriter::Write(resume_map.ToValue(), &json));
+    ASSERT_TRUE(base::WriteFile(resume_map_path(), json));
+  }
+
+  absl::optional<PlaylistDownloadResumeMap> ReadResumeMap() {
+    std::string json;
+    if (!base::ReadFileToString(resume_map_path(), &json))
+      return absl::nullopt;
+    absl::optional<base::Value> value = base::JSONReader::Read(json);
+    if (!value)
+      return absl::nullopt;
+    return PlaylistDownloadResumeMap::FromValue(*value);
+  }
+
+  std::string ReadFile() {
+    std::string contents;
+    EXPECT_TRUE(base::ReadFileToString(path_, &contents));
+    return contents;
+  }
+
+  base::FilePath resume_map_path() const {
+    return PlaylistRangeDownloader::GetResumeMapPath(path_);
+  }
+
+ protected:
+  void HandleRequest(const network::ResourceRequest& request) {
+    std::string range;
+    request.headers.GetHeader(net::HttpRequestHeaders::kRange, &range);
+    std::string if_range;
+    request.headers.GetHeader("If-Range", &if_range);
+    requested_ranges_.push_back(range);
+    // Leave the segment requests pending.
+    if (stall_segments_ && range != kProbeRange)
+      return;
+
+    std::vector<net::HttpByteRange> byte_ranges;
+    const bool partial = supports_ranges_ &&
+                         net::HttpUtil::ParseRangeHeader(range, &byte_ranges) &&
+                         byte_ranges.size() == 1 &&
+                         byte_ranges[0].ComputeBounds(kContentSize) &&
+                         (if_range.empty() || if_range == kETag);
+
+    std::string raw_headers;
+    std::string body;
+    if (partial) {
+      const int64_t first = byte_ranges[0].first_byte_position();
+      const int64_t last = byte_ranges[0].last_byte_position();
+      raw_headers = base::StringPrintf(
+          "HTTP/1.1 206 Partial Content\n"
+          "Content-Range: bytes %" PRId64 "-%" PRId64 "/%" PRId64 "\n"
+          "ETag: %s\n\n",
+          first, last, kContentSize, kETag);
+      body = content_.substr(first, last - first + 1);
+    } else {
+      raw_headers = "HTTP/1.1 200 OK\n\n";
+      body = content_;
+    }
+
+    auto head = network::mojom::URLResponseHead::New();
+    head->headers = base::MakeRefCounted<net::HttpResponseHeaders>(
+        net::HttpUtil::AssembleRawHeaders(raw_headers));
+    head->mime_type = "video/mp4";
+
+    network::URLLoaderCompletionStatus status;
+    if (partial && range != kProbeRange && truncated_responses_ > 0) {
+      --truncated_responses_;
+      body.resize(body.size() / 2);
+      status.error_code = net::ERR_CONNECTION_RESET;
+    }
+    status.decoded_body_length = body.size();
+    url_loader_factory_.AddResponse(
+        request.url, std::move(head), body, status, {},
+        network::TestURLLoaderFactory::kSendHeadersOnNetworkError);
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+  std::string content_;
+
+  bool supports_ranges_ = true;
+  bool stall_segments_ = false;
+  int truncated_responses_ = 0;
+  std::vector<std::string> requested_ranges_;
+};
+
+TEST_F(PlaylistRangeDownloaderTest, DownloadsSegmentsInParallel) {
+  auto downloader = CreateDownloader(4);
+  EXPECT_EQ(path_, Download(downloader.get()));
+  EXPECT_EQ(content_, ReadFile());
+  EXPECT_FALSE(base::PathExists(resume_map_path()));
+
+  const int64_t segment_size = kContentSize / 4;
+  EXPECT_EQ((std::vector<std::string>{
+                kProbeRange, GetRange(0, segment_size - 1),
+                GetRange(segment_size, 2 * segment_size - 1),
+                GetRange(2 * segment_size, 3 * segment_size - 1),
+                GetRange(3 * segment_size, kContentSize - 1)}),
+            requested_ranges_);
+}
+
+TEST_F(PlaylistRangeDownloaderTest, SegmentsHaveMinimumSize) {
+  auto downloader = CreateDownloader(64);
+  // The file only holds 4 segments of kMinSegmentSize.
+  EXPECT_EQ(path_, Download(downloader.get()));
+  EXPECT_EQ(content_, ReadFile());
+  EXPECT_EQ(5u, requested_ranges_.size());
+}
+
+TEST_F(PlaylistRangeDownloaderTest, RestartsTruncatedSegments) {
+  truncated_responses_ = 2;
+  auto downloader = CreateDownloader(2);
+  EXPECT_EQ(path_, Download(downloader.get()));
+  EXPECT_EQ(content_, ReadFile());
+  EXPECT_EQ(5u, requested_ranges_.size());
+}
+
+TEST_F(PlaylistRangeDownloaderTest, KeepsResumeMapWhenSegmentsFail) {
+  truncated_responses_ = 100;
+  auto downloader = CreateDownloader(2);
+  EXPECT_TRUE(Download(downloader.get()).empty());
+
+  const absl::optional<PlaylistDownloadResumeMap> resume_map = ReadResumeMap();
+  ASSERT_TRUE(resume_map);
+  EXPECT_EQ(kMediaUrl, resume_map->url);
+  EXPECT_EQ(kETag, resume_map->validator);
+  EXPECT_EQ(kContentSize, resume_map->total_size);
+  ASSERT_EQ(2u, resume_map->segments.size());
+  int64_t received = 0;
+  for (const auto& segment : resume_map->segments) {
+    EXPECT_FALSE(segment.complete());
+    received += segment.received;
+  }
+  EXPECT_GT(received, 0);
+}
+
+TEST_F(PlaylistRangeDownloaderTest, ResumesFromResumeMap) {
+  PlaylistDownloadResumeMap resume_map;
+  resume_map.url = kMediaUrl;
+  resume_map.validator = kETag;
+  resume_map.total_size = kContentSize;
+  resume_map.segments = {{0, 499999, 1000}, {500000, kContentSize - 1, 0}};
+  WritePartialFile(resume_map);
+
+  auto downloader = CreateDownloader(2);
+  EXPECT_EQ(path_, Download(downloader.get()));
+  EXPECT_EQ(content_, ReadFile());
+  EXPECT_FALSE(base::PathExists(resume_map_path()));
+
+  // No probe, and the received part isn't downloaded again.
+  EXPECT_EQ((std::vector<std::string>{GetRange(1000, 499999),
+                                      GetRange(500000, kContentSize - 1)}),
+            requested_ranges_);
+}
+
+TEST_F(PlaylistRangeDownloaderTest, DiscardsChangedFile) {
+  PlaylistDownloadResumeMap resume_map;
+  resume_map.url = kMediaUrl;
+  resume_map.validator = "\"v0\"";
+  resume_map.total_size = kContentSize;
+  resume_map.segments = {{0, kContentSize - 1, 1000}};
+  WritePartialFile(resume_map);
+
+  auto downloader = CreateDownloader(2);
+  EXPECT_TRUE(Download(downloader.get()).empty());
+  EXPECT_FALSE(base::PathExists(path_));
+  EXPECT_FALSE(base::PathExists(resume_map_path()));
+
+  // The next attempt starts over.
+  requested_ranges_.clear();
+  EXPECT_EQ(path_, Download(downloader.get()));
+  EXPECT_EQ(content_, ReadFile());
+  EXPECT_EQ(kProbeRange, requested_ranges_.front());
+}
+
+TEST_F(PlaylistRangeDownloaderTest, CancelDeletesResumeMap) {
+  stall_segments_ = true;
+  auto downloader = CreateDownloader(2);
+  downloader->Download(GURL(kMediaUrl), path_,
+                       base::BindOnce([](base::FilePath path) {
+                         ADD_FAILURE() << "Cancelled download completed";
+                       }));
+  task_environment_.RunUntilIdle();
+  ASSERT_TRUE(base::PathExists(resume_map_path()));
+
+  base::RunLoop run_loop;
+  downloader->Cancel(run_loop.QuitClosure());
+  run_loop.Run();
+  EXPECT_FALSE(base::PathExists(path_));
+  EXPECT_FALSE(base::PathExists(resume_map_path()));
+
+  // Destroying the cancelled downloader doesn't save the resume map again.
+  downloader.reset();
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(base::PathExists(resume_map_path()));
+
+  // A restart starts over instead of resuming.
+  stall_segments_ = false;
+  requested_ranges_.clear();
+  downloader = CreateDownloader(2);
+  EXPECT_EQ(path_, Download(downloader.get()));
+  EXPECT_EQ(content_, ReadFile());
+  EXPECT_EQ(kProbeRange, requested_ranges_.front());
+}
+
+TEST_F(PlaylistRangeDownloaderTest, FallsBackWithoutRangeSupport) {
+  supports_ranges_ = false;
+  auto downloader = CreateDownloader(4);
+  EXPECT_EQ(path_, Download(downloader.get()));
+  EXPECT_EQ(content_, ReadFile());
+  EXPECT_FALSE(base::PathExists(resume_map_path()));
+  EXPECT_EQ((std::vector<std::string>{kProbeRange, ""}), requested_ranges_);
+}
+
+TEST_F(PlaylistRangeDownloaderTest, ResumeMapFromValue) {
+  PlaylistDownloadResumeMap resume_map;
+  resume_map.url = kMediaUrl;
+  resume_map.validator = kETag;
+  resume_map.total_size = 5000000000;
+  resume_map.segments = {{0, 2499999999, 42},
+                         {2500000000, 4999999999, 2500000000}};
+
+  absl::optional<PlaylistDownloadResumeMap> result =
+      PlaylistDownloadResumeMap::FromValue(resume_map.ToValue());
+  ASSERT_TRUE(result);
+  EXPECT_EQ(resume_map.url, result->url);
+  EXPECT_EQ(resume_map.validator, result->validator);
+  EXPECT_EQ(resume_map.total_size, result->total_size);
+  ASSERT_EQ(2u, result->segments.size());
+  EXPECT_EQ(2500000000, result->segments[1].start);
+  EXPECT_EQ(4999999999, result->segments[1].end);
+  EXPECT_TRUE(result->segments[1].complete());
+  EXPECT_EQ(42, result->segments[0].received);
+
+  // More received than the segment holds.
+  resume_map.segments[0].received = 2500000001;
+  EXPECT_FALSE(PlaylistDownloadResumeMap::FromValue(resume_map.ToValue()));
+
+  EXPECT_FALSE(PlaylistDownloadResumeMap::FromValue(
+      base::Value(base::Value::Type::LIST)));
+}
+
+}  // namespace playlist
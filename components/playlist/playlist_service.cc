@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/containers/cxx20_erase.h"
 #include "base/containers/flat_set.h"
 #include "base/files/file_enumerator.h"
 #include "base/files/file_util.h"
@@ -19,6 +20,7 @@
 #include "base/token.h"
 #include "brave/components/playlist/playlist_constants.h"
 #include "brave/components/playlist/playlist_data_source.h"
+#include "brave/components/playlist/playlist_range_downloader.h"
 #include "brave/components/playlist/playlist_service_helper.h"
 #include "brave/components/playlist/playlist_service_observer.h"
 #include "brave/components/playlist/playlist_types.h"
@@ -28,6 +30,7 @@
 #include "content/public/browser/browser_context.h"
 #include "services/preferences/public/cpp/dictionary_value_update.h"
 #include "services/preferences/public/cpp/scoped_pref_update.h"
+#include "url/gurl.h"
 
 namespace playlist {
 namespace {
@@ -50,6 +53,17 @@ std::vector<base::FilePath> GetOrphanedPaths(
   return orphaned_paths;
 }
 
+std::vector<PlaylistItemInfo> GetItemsWithResumeMap(
+    const base::FilePath& base_dir,
+    std::vector<PlaylistItemInfo> items) {
+  base::EraseIf(items, [&base_dir](const auto& item) {
+    return !base::PathExists(PlaylistRangeDownloader::GetResumeMapPath(
+        base_dir.AppendASCII(item.id).Append(
+            PlaylistMediaFileDownloadManager::kMediaFileName)));
+  });
+  return items;
+}
+
 }  // namespace
 
 PlaylistService::PlaylistService(content::BrowserContext* context,
@@ -66,6 +80,7 @@ PlaylistService::PlaylistService(content::BrowserContext* context,
   download_request_manager_ =
       std::make_unique<PlaylistDownloadRequestManager>(context, manager);
   CleanUp();
+  ResumeInterruptedMediaFileDownloads();
 }
 
 PlaylistService::~PlaylistService() = default;
@@ -449,32 +464,38 @@ void PlaylistService::RecoverPlaylistItem(const std::string& id) {
 }
 
 void PlaylistService::DeletePlaylistItem(const std::string& id) {
-  media_file_download_manager_->CancelDownloadRequest(id);
+  // Delete assets from filesystem once the partial media file is gone, so
+  // that a late write can't recreate it in the deleted directory.
+  media_file_download_manager_->CancelDownloadRequest(
+      id, base::BindOnce(&PlaylistService::DeletePlaylistItemDirectory,
+                         weak_factory_.GetWeakPtr(),
+                         GetPlaylistItemDirPath(id)));
+  // TODO(simonhong): Delete after getting cancel complete message from the
+  // thumbnail downloader too.
   thumbnail_downloader_->CancelDownloadRequest(id);
   RemovePlaylistItemValue(id);
 
   NotifyPlaylistChanged({PlaylistChangeParams::Type::kItemDeleted, id});
+}
 
-  // TODO(simonhong): Delete after getting cancel complete message from all
-  // downloader.
-  // Delete assets from filesystem after updating db.
-  task_runner()->PostTask(FROM_HERE, base::GetDeletePathRecursivelyCallback(
-                                         GetPlaylistItemDirPath(id)));
+void PlaylistService::DeletePlaylistItemDirectory(const base::FilePath& path) {
+  task_runner()->PostTask(FROM_HERE,
+                          base::GetDeletePathRecursivelyCallback(path));
 }
 
 void PlaylistService::DeleteAllPlaylistItems() {
   VLOG(2) << __func__;
 
   // Cancel currently generated playlist if needed and pending thumbnail
-  // download jobs.
-  media_file_download_manager_->CancelAllDownloadRequests();
+  // download jobs. Every directory is orphaned once the pref is cleared, and
+  // is deleted after the partial media files.
+  media_file_download_manager_->CancelAllDownloadRequests(base::BindOnce(
+      &PlaylistService::CleanUp, weak_factory_.GetWeakPtr()));
   thumbnail_downloader_->CancelAllDownloadRequests();
 
   prefs_->ClearPref(kPlaylistItemsPref);
 
   NotifyPlaylistChanged({PlaylistChangeParams::Type::kAllDeleted, ""});
-
-  CleanUp();
 }
 
 void PlaylistService::AddObserver(PlaylistServiceObserver* observer) {
@@ -573,6 +594,33 @@ bool PlaylistService::GetMediaPath(const std::string& id,
   return true;
 }
 
+void PlaylistService::ResumeInterruptedMediaFileDownloads() {
+  std::vector<PlaylistItemInfo> items = GetAllPlaylistItems();
+  base::EraseIf(items, [](const auto& item) {
+    return item.ready || !GURL(item.media_file_path).SchemeIsHTTPOrHTTPS();
+  });
+  if (items.empty())
+    return;
+
+  task_runner()->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&GetItemsWithResumeMap, base_dir_, std::move(items)),
+      base::BindOnce(&PlaylistService::OnGetInterruptedMediaFileDownloads,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void PlaylistService::OnGetInterruptedMediaFileDownloads(
+    std::vector<PlaylistItemInfo> items) {
+  for (const auto& item : items) {
+    // The item could have been removed in the meantime.
+    if (!IsValidPlaylistItem(item.id))
+      continue;
+
+    VLOG(2) << __func__ << ": resuming " << item.id;
+    GenerateMediafileForPlaylistItem(item);
+  }
+}
+
 base::SequencedTaskRunner* PlaylistService::task_runner() {
   if (!task_runner_) {
     task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
@@ -126,9 +126,16 @@ class PlaylistService : public KeyedService,
   base::SequencedTaskRunner* task_runner();
 
   // Delete orphaned playlist item directories that are not included in db.
+  void DeletePlaylistItemDirectory(const base::FilePath& path);
   void CleanUp();
   void OnGetOrphanedPaths(const std::vector<base::FilePath> paths);
 
+  // Restart media file downloads that were interrupted by shutdown. They
+  // continue from their partial files.
+  void ResumeInterruptedMediaFileDownloads();
+  void OnGetInterruptedMediaFileDownloads(
+      std::vector<PlaylistItemInfo> items);
+
   void NotifyPlaylistChanged(const PlaylistChangeParams& params);
 
   void UpdatePlaylistItemValue(const std::string& id, base::Value value);
@@ -174,6 +174,22 @@ void BatAdsClientMojoBridge::Save(
       std::move(callback)));
 }
 
+void OnAppend(const ads::ResultCallback& callback, const bool success) {
+  callback(success);
+}
+
+void BatAdsClientMojoBridge::Append(const std::string& name,
+                                    const std::string& value,
+                                    ads::ResultCallback callback) {
+  if (!connected()) {
+    callback(/* success */ false);
+    return;
+  }
+
+  bat_ads_client_->Append(name, value,
+                          base::BindOnce(&OnAppend, std::move(callback)));
+}
+
 void BatAdsClientMojoBridge::LoadFileResource(const std::string& id,
                                               const int version,
                                               ads::LoadFileCallback callback) {
@@ -69,6 +69,9 @@ class BatAdsClientMojoBridge
   void Save(const std::string& name,
             const std::string& value,
             ads::ResultCallback callback) override;
+  void Append(const std::string& name,
+              const std::string& value,
+              ads::ResultCallback callback) override;
   void Load(
       const std::string& name,
       ads::LoadCallback callback) override;
@@ -6,8 +6,10 @@
 #include "brave/components/services/bat_ads/bat_ads_impl.h"
 
 #include <functional>
+#include <string>
 #include <vector>
 
+#include "base/memory/shared_memory_mapping.h"
 #include "bat/ads/ad_content_info.h"
 #include "bat/ads/ads.h"
 #include "bat/ads/category_content_info.h"
@@ -35,6 +37,22 @@ ads::CategoryContentOptActionType ToCategoryContentOptActionType(
   return static_cast<ads::CategoryContentOptActionType>(opt_action_type);
 }
 
+// The page content is mapped here, where it is consumed, rather than in the
+// browser process.
+std::string ReadSharedMemoryRegion(
+    const base::ReadOnlySharedMemoryRegion& region) {
+  if (!region.IsValid()) {
+    return {};
+  }
+
+  const base::ReadOnlySharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid()) {
+    return {};
+  }
+
+  return std::string(mapping.GetMemoryAs<char>(), mapping.size());
+}
+
 }  // namespace
 
 BatAdsImpl::BatAdsImpl(
@@ -71,14 +89,14 @@ void BatAdsImpl::OnPrefChanged(const std::string& path) {
 
 void BatAdsImpl::OnHtmlLoaded(const int32_t tab_id,
                               const std::vector<GURL>& redirect_chain,
-                              const std::string& html) {
-  ads_->OnHtmlLoaded(tab_id, redirect_chain, html);
+                              base::ReadOnlySharedMemoryRegion html) {
+  ads_->OnHtmlLoaded(tab_id, redirect_chain, ReadSharedMemoryRegion(html));
 }
 
 void BatAdsImpl::OnTextLoaded(const int32_t tab_id,
                               const std::vector<GURL>& redirect_chain,
-                              const std::string& text) {
-  ads_->OnTextLoaded(tab_id, redirect_chain, text);
+                              base::ReadOnlySharedMemoryRegion text) {
+  ads_->OnTextLoaded(tab_id, redirect_chain, ReadSharedMemoryRegion(text));
 }
 
 void BatAdsImpl::OnUserGesture(const int32_t page_transition_type) {
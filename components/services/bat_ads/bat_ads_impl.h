@@ -12,6 +12,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/weak_ptr.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "brave/vendor/bat-native-ads/include/bat/ads/public/interfaces/ads.mojom.h"
@@ -53,10 +54,10 @@ class BatAdsImpl :
 
   void OnHtmlLoaded(const int32_t tab_id,
                     const std::vector<GURL>& redirect_chain,
-                    const std::string& html) override;
+                    base::ReadOnlySharedMemoryRegion html) override;
   void OnTextLoaded(const int32_t tab_id,
                     const std::vector<GURL>& redirect_chain,
-                    const std::string& text) override;
+                    base::ReadOnlySharedMemoryRegion text) override;
 
   void OnIdle() override;
   void OnUnIdle(const base::TimeDelta idle_time,
@@ -69,6 +69,19 @@ void AdsClientMojoBridge::OnSave(CallbackHolder<SaveCallback>* callback_holder,
   delete callback_holder;
 }
 
+// static
+void AdsClientMojoBridge::OnAppend(
+    CallbackHolder<AppendCallback>* callback_holder,
+    const bool success) {
+  DCHECK(callback_holder);
+
+  if (callback_holder->is_valid()) {
+    std::move(callback_holder->get()).Run(success);
+  }
+
+  delete callback_holder;
+}
+
 // static
 void AdsClientMojoBridge::OnLoad(CallbackHolder<LoadCallback>* callback_holder,
                                  const bool success,
@@ -229,6 +242,17 @@ void AdsClientMojoBridge::Save(
       name, value, std::bind(AdsClientMojoBridge::OnSave, callback_holder, _1));
 }
 
+void AdsClientMojoBridge::Append(const std::string& name,
+                                 const std::string& value,
+                                 AppendCallback callback) {
+  // Callback holder will be deleted in |OnAppend|.
+  auto* callback_holder =
+      new CallbackHolder<AppendCallback>(AsWeakPtr(), std::move(callback));
+  ads_client_->Append(name, value,
+                      std::bind(AdsClientMojoBridge::OnAppend, callback_holder,
+                                _1));
+}
+
 void AdsClientMojoBridge::Load(const std::string& name, LoadCallback callback) {
   // Callback holder will be deleted in |OnLoad|.
   auto* callback_holder =
@@ -63,6 +63,8 @@ class AdsClientMojoBridge
 
   static void OnSave(CallbackHolder<SaveCallback>* callback_holder,
                      const bool success);
+  static void OnAppend(CallbackHolder<AppendCallback>* callback_holder,
+                       const bool success);
   static void OnLoad(CallbackHolder<LoadCallback>* callback_holder,
                      const bool success,
                      const std::string& value);
@@ -116,6 +118,9 @@ class AdsClientMojoBridge
   void Save(const std::string& name,
             const std::string& value,
             SaveCallback callback) override;
+  void Append(const std::string& name,
+              const std::string& value,
+              AppendCallback callback) override;
   void Load(const std::string& name, LoadCallback callback) override;
   void LoadFileResource(const std::string& id,
                         const int version,
@@ -129,12 +129,12 @@ void BatLedgerImpl::OnPostData(const std::string& url,
       url, first_party_url, referrer, post_data, std::move(visit_data));
 }
 
-void BatLedgerImpl::OnXHRLoad(uint32_t tab_id, const std::string& url,
-    const base::flat_map<std::string, std::string>& parts,
-    const std::string& first_party_url, const std::string& referrer,
-    ledger::type::VisitDataPtr visit_data) {
-    ledger_->OnXHRLoad(tab_id, url, parts,
-        first_party_url, referrer, std::move(visit_data));
+void BatLedgerImpl::OnXHRLoads(uint32_t tab_id,
+                               std::vector<mojom::XHRLoadPtr> loads) {
+  for (auto& load : loads) {
+    ledger_->OnXHRLoad(tab_id, load->url, load->parts, load->first_party_url,
+                       load->referrer, std::move(load->visit_data));
+  }
 }
 
 void BatLedgerImpl::SetPublisherExclude(const std::string& publisher_key,
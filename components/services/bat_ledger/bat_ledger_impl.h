@@ -70,10 +70,8 @@ class BatLedgerImpl :
       const std::string& referrer,
       const std::string& post_data,
       ledger::type::VisitDataPtr visit_data) override;
-  void OnXHRLoad(uint32_t tab_id, const std::string& url,
-      const base::flat_map<std::string, std::string>& parts,
-      const std::string& first_party_url, const std::string& referrer,
-      ledger::type::VisitDataPtr visit_data) override;
+  void OnXHRLoads(uint32_t tab_id,
+                  std::vector<mojom::XHRLoadPtr> loads) override;
 
   void SetPublisherExclude(const std::string& publisher_key,
                            ledger::type::PublisherExclude exclude,
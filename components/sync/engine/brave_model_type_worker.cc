@@ -11,6 +11,7 @@
 #include "base/logging.h"
 #include "base/metrics/histogram_functions.h"
 #include "components/sync/engine/model_type_processor.h"
+#include "components/sync/protocol/sync_entity.pb.h"
 
 namespace syncer {
 
@@ -20,6 +21,11 @@ namespace features {
 const base::Feature kBraveSyncResetProgressMarker{
     "ResetProgressMarkerOnCommitFailures", base::FEATURE_ENABLED_BY_DEFAULT};
 
+// Enables the option of moving progress marker back to a token received while
+// commits were succeeding before resetting it.
+const base::Feature kBraveSyncRewindProgressMarker{
+    "RewindProgressMarkerOnCommitFailures", base::FEATURE_ENABLED_BY_DEFAULT};
+
 }  // namespace features
 
 namespace {
@@ -31,6 +37,26 @@ namespace {
 size_t kFailuresToResetMarker = 7;
 // Allow reset progress marker for type not often than once in 30 minutes
 base::TimeDelta kMinimalTimeBetweenResetMarker = base::Minutes(30);
+// Remember a progress marker token received while commits succeed not more
+// often than once in 10 minutes
+base::TimeDelta kGoodMarkerInterval = base::Minutes(10);
+// Don't rewind progress marker further than one day, older changes are
+// downloaded by resetting it
+base::TimeDelta kMaxRewindPeriod = base::Days(1);
+
+bool HasConflictOrTransientError(
+    const FailedCommitResponseDataList& error_response_list) {
+  for (const syncer::FailedCommitResponseData& failed_response_entry :
+       error_response_list) {
+    if (failed_response_entry.response_type ==
+            sync_pb::CommitResponse_ResponseType_CONFLICT ||
+        failed_response_entry.response_type ==
+            sync_pb::CommitResponse_ResponseType_TRANSIENT_ERROR) {
+      return true;
+    }
+  }
+  return false;
+}
 }  // namespace
 
 BraveModelTypeWorker::BraveModelTypeWorker(
@@ -62,7 +88,35 @@ void BraveModelTypeWorker::OnCommitResponse(
   }
 
   if (IsResetProgressMarkerRequired(error_response_list)) {
-    ResetProgressMarker();
+    if (!RewindProgressMarker(error_response_list)) {
+      ResetProgressMarker();
+    }
+  } else if (recovery_mode_ != RecoveryMode::kNone &&
+             !HasConflictOrTransientError(error_response_list)) {
+    FinishRecovery();
+  }
+}
+
+void BraveModelTypeWorker::ProcessGetUpdatesResponse(
+    const sync_pb::DataTypeProgressMarker& progress_marker,
+    const sync_pb::DataTypeContext& mutated_context,
+    const SyncEntityList& applicable_updates,
+    StatusController* status) {
+  ModelTypeWorker::ProcessGetUpdatesResponse(progress_marker, mutated_context,
+                                             applicable_updates, status);
+
+  if (recovery_mode_ == RecoveryMode::kNone) {
+    if (failed_commit_times_ == 0) {
+      RecordGoodProgressMarker();
+    }
+    return;
+  }
+
+  entities_redownloaded_ += applicable_updates.size();
+  for (const sync_pb::SyncEntity* update_entity : applicable_updates) {
+    if (failed_client_tag_hashes_.erase(update_entity->client_tag_hash())) {
+      ++failed_entities_redownloaded_;
+    }
   }
 }
 
@@ -76,6 +130,16 @@ base::TimeDelta BraveModelTypeWorker::MinimalTimeBetweenResetForTests() {
   return kMinimalTimeBetweenResetMarker;
 }
 
+// static
+base::TimeDelta BraveModelTypeWorker::GoodMarkerIntervalForTests() {
+  return kGoodMarkerInterval;
+}
+
+// static
+base::TimeDelta BraveModelTypeWorker::MaxRewindPeriodForTests() {
+  return kMaxRewindPeriod;
+}
+
 bool BraveModelTypeWorker::IsResetProgressMarkerRequired(
     const FailedCommitResponseDataList& error_response_list) {
   if (!last_reset_marker_time_.is_null() &&
@@ -88,19 +152,7 @@ bool BraveModelTypeWorker::IsResetProgressMarkerRequired(
     return false;
   }
 
-  bool found_conflict_or_transient = false;
-  for (const syncer::FailedCommitResponseData& failed_response_entry :
-       error_response_list) {
-    if (failed_response_entry.response_type ==
-            sync_pb::CommitResponse_ResponseType_CONFLICT ||
-        failed_response_entry.response_type ==
-            sync_pb::CommitResponse_ResponseType_TRANSIENT_ERROR) {
-      found_conflict_or_transient = true;
-      break;
-    }
-  }
-
-  if (found_conflict_or_transient) {
+  if (HasConflictOrTransientError(error_response_list)) {
     ++failed_commit_times_;
   } else {
     failed_commit_times_ = 0;
@@ -116,6 +168,92 @@ void BraveModelTypeWorker::ResetProgressMarker() {
   base::UmaHistogramExactLinear("Brave.Sync.ProgressTokenEverReset", 0, 1);
   last_reset_marker_time_ = base::Time::Now();
   model_type_state_.mutable_progress_marker()->clear_token();
+  good_progress_markers_.clear();
+  failed_client_tag_hashes_.clear();
+  entities_redownloaded_ = 0;
+  failed_entities_redownloaded_ = 0;
+  recovery_mode_ = RecoveryMode::kReset;
+}
+
+bool BraveModelTypeWorker::RewindProgressMarker(
+    const FailedCommitResponseDataList& error_response_list) {
+  if (!base::FeatureList::IsEnabled(features::kBraveSyncRewindProgressMarker) ||
+      rewind_attempted_) {
+    return false;
+  }
+
+  const base::Time now = base::Time::Now();
+  while (!good_progress_markers_.empty() &&
+         now - good_progress_markers_.front().time > kMaxRewindPeriod) {
+    good_progress_markers_.pop_front();
+  }
+
+  if (good_progress_markers_.empty() ||
+      good_progress_markers_.front().token ==
+          model_type_state_.progress_marker().token()) {
+    return false;
+  }
+
+  VLOG(1) << "Rewind progress marker for type "
+          << ModelTypeToDebugString(type_) << " to "
+          << now - good_progress_markers_.front().time << " ago";
+  model_type_state_.mutable_progress_marker()->set_token(
+      good_progress_markers_.front().token);
+  good_progress_markers_.clear();
+
+  // Failures after the rewind end up resetting progress marker.
+  rewind_attempted_ = true;
+  failed_commit_times_ = 0;
+
+  failed_client_tag_hashes_.clear();
+  for (const FailedCommitResponseData& failed_response_entry :
+       error_response_list) {
+    failed_client_tag_hashes_.insert(
+        failed_response_entry.client_tag_hash.value());
+  }
+  recovery_mode_ = RecoveryMode::kRewind;
+  return true;
+}
+
+void BraveModelTypeWorker::RecordGoodProgressMarker() {
+  const std::string& token = model_type_state_.progress_marker().token();
+  if (token.empty()) {
+    return;
+  }
+
+  const base::Time now = base::Time::Now();
+  if (!good_progress_markers_.empty() &&
+      now - good_progress_markers_.back().time < kGoodMarkerInterval) {
+    return;
+  }
+
+  good_progress_markers_.push_back({now, token});
+  while (now - good_progress_markers_.front().time > kMaxRewindPeriod) {
+    good_progress_markers_.pop_front();
+  }
+}
+
+void BraveModelTypeWorker::FinishRecovery() {
+  VLOG(1) << "Recovered type " << ModelTypeToDebugString(type_) << " after "
+          << entities_redownloaded_ << " entities were downloaded again";
+  if (recovery_mode_ == RecoveryMode::kRewind) {
+    base::UmaHistogramCounts100000(
+        "Brave.Sync.RewindProgressMarker.EntitiesRedownloaded",
+        entities_redownloaded_);
+    base::UmaHistogramCounts1000(
+        "Brave.Sync.RewindProgressMarker.FailedEntitiesRedownloaded",
+        failed_entities_redownloaded_);
+  } else {
+    base::UmaHistogramCounts100000(
+        "Brave.Sync.ResetProgressMarker.EntitiesRedownloaded",
+        entities_redownloaded_);
+  }
+
+  recovery_mode_ = RecoveryMode::kNone;
+  rewind_attempted_ = false;
+  failed_client_tag_hashes_.clear();
+  entities_redownloaded_ = 0;
+  failed_entities_redownloaded_ = 0;
 }
 
 }  // namespace syncer
@@ -7,7 +7,10 @@
 #define BRAVE_COMPONENTS_SYNC_ENGINE_BRAVE_MODEL_TYPE_WORKER_H_
 
 #include <memory>
+#include <set>
+#include <string>
 
+#include "base/containers/circular_deque.h"
 #include "base/feature_list.h"
 #include "components/sync/base/model_type.h"
 #include "components/sync/base/passphrase_enums.h"
@@ -19,11 +22,13 @@ namespace syncer {
 class CancelationSignal;
 class Cryptographer;
 class NudgeHandler;
+class StatusController;
 class ModelTypeProcessor;
 
 namespace features {
 
 extern const base::Feature kBraveSyncResetProgressMarker;
+extern const base::Feature kBraveSyncRewindProgressMarker;
 
 }  // namespace features
 
@@ -31,6 +36,13 @@ FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest, ResetProgressMarker);
 FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest, ResetProgressMarkerMaxPeriod);
 FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest,
                      ResetProgressMarkerDisabledFeature);
+FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest, RewindProgressMarker);
+FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest,
+                     RewindProgressMarkerFallsBackToReset);
+FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest,
+                     RewindProgressMarkerMaxPeriod);
+FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest,
+                     RewindProgressMarkerDropsExpiredMarker);
 
 class BraveModelTypeWorker : public ModelTypeWorker {
  public:
@@ -46,24 +58,66 @@ class BraveModelTypeWorker : public ModelTypeWorker {
   BraveModelTypeWorker& operator=(const BraveModelTypeWorker&) = delete;
 
  private:
+  friend class BraveModelTypeWorkerTest;
   FRIEND_TEST_ALL_PREFIXES(BraveModelTypeWorkerTest, ResetProgressMarker);
   FRIEND_TEST_ALL_PREFIXES(BraveModelTypeWorkerTest,
                            ResetProgressMarkerMaxPeriod);
   FRIEND_TEST_ALL_PREFIXES(BraveModelTypeWorkerTest,
                            ResetProgressMarkerDisabledFeature);
+  FRIEND_TEST_ALL_PREFIXES(BraveModelTypeWorkerTest, RewindProgressMarker);
+  FRIEND_TEST_ALL_PREFIXES(BraveModelTypeWorkerTest,
+                           RewindProgressMarkerFallsBackToReset);
+  FRIEND_TEST_ALL_PREFIXES(BraveModelTypeWorkerTest,
+                           RewindProgressMarkerMaxPeriod);
+  FRIEND_TEST_ALL_PREFIXES(BraveModelTypeWorkerTest,
+                           RewindProgressMarkerDropsExpiredMarker);
+
+  enum class RecoveryMode { kNone, kRewind, kReset };
+
+  struct GoodProgressMarker {
+    base::Time time;
+    std::string token;
+  };
 
   void OnCommitResponse(
       const CommitResponseDataList& committed_response_list,
       const FailedCommitResponseDataList& error_response_list) override;
+  void ProcessGetUpdatesResponse(
+      const sync_pb::DataTypeProgressMarker& progress_marker,
+      const sync_pb::DataTypeContext& mutated_context,
+      const SyncEntityList& applicable_updates,
+      StatusController* status) override;
 
   bool IsResetProgressMarkerRequired(
       const FailedCommitResponseDataList& error_response_list);
   void ResetProgressMarker();
 
+  // Moves the progress marker back to the oldest token received while commits
+  // were succeeding, at most |kMaxRewindPeriod| ago, so that the server only
+  // sends again the entities changed since then. Returns false when there is
+  // no such token or a rewind already failed to help since the last
+  // successful commit; the progress marker must be reset then.
+  bool RewindProgressMarker(
+      const FailedCommitResponseDataList& error_response_list);
+  void RecordGoodProgressMarker();
+  void FinishRecovery();
+
   size_t failed_commit_times_ = 0;
   base::Time last_reset_marker_time_;
+
+  base::circular_deque<GoodProgressMarker> good_progress_markers_;
+  RecoveryMode recovery_mode_ = RecoveryMode::kNone;
+  bool rewind_attempted_ = false;
+  // Client tag hashes of the entities which failed to commit when the
+  // recovery started and have not been downloaded again yet.
+  std::set<std::string> failed_client_tag_hashes_;
+  size_t entities_redownloaded_ = 0;
+  size_t failed_entities_redownloaded_ = 0;
+
   static size_t GetFailuresToResetMarkerForTests();
   static base::TimeDelta MinimalTimeBetweenResetForTests();
+  static base::TimeDelta GoodMarkerIntervalForTests();
+  static base::TimeDelta MaxRewindPeriodForTests();
 };
 
 }  // namespace syncer
@@ -5,18 +5,24 @@
 
 #include "brave/components/sync/engine/brave_model_type_worker.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/test/task_environment.h"
 #include "base/time/time_override.h"
+#include "components/sync/base/client_tag_hash.h"
 #include "components/sync/engine/cancelation_signal.h"
+#include "components/sync/engine/cycle/status_controller.h"
 #include "components/sync/nigori/cryptographer_impl.h"
 #include "components/sync/protocol/sync.pb.h"
 #include "components/sync/test/engine/fake_cryptographer.h"
 #include "components/sync/test/engine/mock_model_type_processor.h"
 #include "components/sync/test/engine/mock_nudge_handler.h"
+#include "components/sync/test/engine/single_type_mock_server.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 using base::subtle::ScopedTimeClockOverrides;
@@ -31,7 +37,9 @@ namespace syncer {
 class BraveModelTypeWorkerTest : public ::testing::Test {
  protected:
   explicit BraveModelTypeWorkerTest(ModelType model_type = PREFERENCES)
-      : model_type_(model_type), is_processor_disconnected_(false) {}
+      : model_type_(model_type),
+        mock_server_(model_type),
+        is_processor_disconnected_(false) {}
 
   ~BraveModelTypeWorkerTest() override {}
 
@@ -81,6 +89,49 @@ class BraveModelTypeWorkerTest : public ::testing::Test {
     worker()->model_type_state_.mutable_progress_marker()->set_token("TOKEN1");
   }
 
+  const std::string& GetProgressMarkerToken() {
+    return worker()->model_type_state_.progress_marker().token();
+  }
+
+  ClientTagHash GetClientTagHash(const std::string& tag) {
+    return ClientTagHash::FromUnhashed(model_type_, tag);
+  }
+
+  // Delivers a GetUpdates response from the mock server with an update for
+  // each of |tags| and |token| as the new progress marker token.
+  void DeliverUpdates(const std::string& token,
+                      const std::vector<std::string>& tags) {
+    std::vector<sync_pb::SyncEntity> entities;
+    for (const auto& tag : tags) {
+      sync_pb::EntitySpecifics specifics;
+      specifics.mutable_preference()->set_name(tag);
+      specifics.mutable_preference()->set_value("value");
+      entities.push_back(mock_server_.UpdateFromServer(
+          /*version_offset=*/10, GetClientTagHash(tag), specifics));
+    }
+
+    SyncEntityList entity_list;
+    for (const auto& entity : entities) {
+      entity_list.push_back(&entity);
+    }
+
+    sync_pb::DataTypeProgressMarker progress_marker;
+    progress_marker.set_data_type_id(
+        GetSpecificsFieldNumberFromModelType(model_type_));
+    progress_marker.set_token(token);
+
+    StatusController status;
+    worker()->ProcessGetUpdatesResponse(
+        progress_marker, mock_server_.GetContext(), entity_list, &status);
+  }
+
+  void DeliverFailedCommits(const FailedCommitResponseDataList& error_list) {
+    for (size_t i = 0;
+         i < BraveModelTypeWorker::GetFailuresToResetMarkerForTests(); ++i) {
+      worker()->OnCommitResponse(CommitResponseDataList(), error_list);
+    }
+  }
+
  private:
   base::test::SingleThreadTaskEnvironment task_environment;
   const ModelType model_type_;
@@ -88,6 +139,7 @@ class BraveModelTypeWorkerTest : public ::testing::Test {
   CancelationSignal cancelation_signal_;
   std::unique_ptr<BraveModelTypeWorker> worker_;
   MockNudgeHandler mock_nudge_handler_;
+  SingleTypeMockServer mock_server_;
   bool is_processor_disconnected_;
 };
 
@@ -122,6 +174,14 @@ FailedCommitResponseDataList MakeErrorResponseList(
   return FailedCommitResponseDataList({data});
 }
 
+FailedCommitResponseDataList MakeConflictResponseList(
+    const ClientTagHash& client_tag_hash) {
+  FailedCommitResponseData data;
+  data.client_tag_hash = client_tag_hash;
+  data.response_type = CommitResponse_ResponseType_CONFLICT;
+  return FailedCommitResponseDataList({data});
+}
+
 }  // namespace
 
 TEST_F(BraveModelTypeWorkerTest, ResetProgressMarker) {
@@ -213,4 +273,127 @@ TEST_F(BraveModelTypeWorkerTest, ResetProgressMarkerDisabledFeature) {
   EXPECT_FALSE(IsProgressMarkerEmpty());
 }
 
+TEST_F(BraveModelTypeWorkerTest, RewindProgressMarker) {
+  base::HistogramTester histogram_tester;
+  NormalInitialize();
+
+  DeliverUpdates("TOKEN1", {});
+  {
+    auto time_override = OverrideForTimeDelta(
+        BraveModelTypeWorker::GoodMarkerIntervalForTests());
+    DeliverUpdates("TOKEN2", {});
+  }
+  EXPECT_EQ(GetProgressMarkerToken(), "TOKEN2");
+
+  // Progress marker is moved back to the oldest good token instead of being
+  // reset
+  DeliverFailedCommits(MakeConflictResponseList(GetClientTagHash("tag1")));
+  EXPECT_EQ(GetProgressMarkerToken(), "TOKEN1");
+
+  // Only the entities changed since TOKEN1 are downloaded again
+  DeliverUpdates("TOKEN3", {"tag1", "tag2"});
+  EXPECT_EQ(worker()->entities_redownloaded_, 2u);
+  EXPECT_EQ(worker()->failed_entities_redownloaded_, 1u);
+
+  worker()->OnCommitResponse(CommitResponseDataList(),
+                             FailedCommitResponseDataList());
+  histogram_tester.ExpectUniqueSample(
+      "Brave.Sync.RewindProgressMarker.EntitiesRedownloaded", 2, 1);
+  histogram_tester.ExpectUniqueSample(
+      "Brave.Sync.RewindProgressMarker.FailedEntitiesRedownloaded", 1, 1);
+  histogram_tester.ExpectTotalCount("Brave.Sync.ProgressTokenEverReset", 0);
+  EXPECT_EQ(worker()->entities_redownloaded_, 0u);
+}
+
+TEST_F(BraveModelTypeWorkerTest, RewindProgressMarkerFallsBackToReset) {
+  base::HistogramTester histogram_tester;
+  NormalInitialize();
+
+  DeliverUpdates("TOKEN1", {});
+  {
+    auto time_override = OverrideForTimeDelta(
+        BraveModelTypeWorker::GoodMarkerIntervalForTests());
+    DeliverUpdates("TOKEN2", {});
+  }
+
+  auto error_response_list =
+      MakeConflictResponseList(GetClientTagHash("tag1"));
+  DeliverFailedCommits(error_response_list);
+  EXPECT_EQ(GetProgressMarkerToken(), "TOKEN1");
+
+  // The rewind didn't help, so the next failures reset progress marker
+  DeliverUpdates("TOKEN3", {"tag2"});
+  DeliverFailedCommits(error_response_list);
+  EXPECT_TRUE(IsProgressMarkerEmpty());
+
+  DeliverUpdates("TOKEN4", {"tag1", "tag2", "tag3"});
+  worker()->OnCommitResponse(CommitResponseDataList(),
+                             FailedCommitResponseDataList());
+  histogram_tester.ExpectUniqueSample(
+      "Brave.Sync.ResetProgressMarker.EntitiesRedownloaded", 3, 1);
+  histogram_tester.ExpectUniqueSample("Brave.Sync.ProgressTokenEverReset", 0,
+                                      1);
+}
+
+TEST_F(BraveModelTypeWorkerTest, RewindProgressMarkerMaxPeriod) {
+  NormalInitialize();
+
+  DeliverUpdates("TOKEN1", {});
+
+  // TOKEN1 is too old to rewind to, so progress marker is reset
+  auto time_override =
+      OverrideForTimeDelta(BraveModelTypeWorker::MaxRewindPeriodForTests() +
+                           BraveModelTypeWorker::GoodMarkerIntervalForTests());
+  DeliverUpdates("TOKEN2", {});
+  DeliverFailedCommits(MakeConflictResponseList(GetClientTagHash("tag1")));
+  EXPECT_TRUE(IsProgressMarkerEmpty());
+}
+
+TEST_F(BraveModelTypeWorkerTest, RewindProgressMarkerDropsExpiredMarker) {
+  NormalInitialize();
+
+  const base::Time start = TimeNowIgnoringOverride();
+  const base::TimeDelta max_rewind_period =
+      BraveModelTypeWorker::MaxRewindPeriodForTests();
+  const base::TimeDelta good_marker_interval =
+      BraveModelTypeWorker::GoodMarkerIntervalForTests();
+
+  DeliverUpdates("TOKEN1", {});
+  {
+    auto time_override = OverrideForTimeDelta(max_rewind_period / 2, start);
+    DeliverUpdates("TOKEN2", {});
+  }
+  {
+    auto time_override = OverrideForTimeDelta(
+        max_rewind_period / 2 + good_marker_interval, start);
+    DeliverUpdates("TOKEN3", {});
+  }
+  ASSERT_EQ(worker()->good_progress_markers_.size(), 3u);
+
+  // TOKEN1 gets older than the max period while no updates arrive, so the
+  // rewind skips it and goes back to TOKEN2
+  auto time_override =
+      OverrideForTimeDelta(max_rewind_period + good_marker_interval, start);
+  DeliverFailedCommits(MakeConflictResponseList(GetClientTagHash("tag1")));
+  EXPECT_EQ(GetProgressMarkerToken(), "TOKEN2");
+  EXPECT_TRUE(worker()->good_progress_markers_.empty());
+}
+
+TEST_F(BraveModelTypeWorkerTest, RewindProgressMarkerDisabledFeature) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndDisableFeature(features::kBraveSyncRewindProgressMarker);
+
+  NormalInitialize();
+
+  DeliverUpdates("TOKEN1", {});
+  {
+    auto time_override = OverrideForTimeDelta(
+        BraveModelTypeWorker::GoodMarkerIntervalForTests());
+    DeliverUpdates("TOKEN2", {});
+  }
+
+  DeliverFailedCommits(MakeConflictResponseList(GetClientTagHash("tag1")));
+  EXPECT_TRUE(IsProgressMarkerEmpty());
+}
+
 }  // namespace syncer
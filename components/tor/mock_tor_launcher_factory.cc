@@ -13,3 +13,8 @@ MockTorLauncherFactory& MockTorLauncherFactory::GetInstance() {
 
 MockTorLauncherFactory::MockTorLauncherFactory() = default;
 MockTorLauncherFactory::~MockTorLauncherFactory() = default;
+
+void MockTorLauncherFactory::SetLaunchTimeForTesting(
+    base::TimeTicks launch_time) {
+  launch_time_ = launch_time;
+}
@@ -9,6 +9,7 @@
 #include <string>
 
 #include "base/no_destructor.h"
+#include "base/time/time.h"
 #include "brave/components/tor/tor_launcher_factory.h"
 #include "testing/gmock/include/gmock/gmock.h"
 
@@ -26,6 +27,9 @@ class MockTorLauncherFactory : public TorLauncherFactory {
   MOCK_METHOD(bool, IsTorConnected, (), (const override));
   MOCK_METHOD(std::string, GetTorProxyURI, (), (const override));
 
+  // Starts the startup timeline as if tor had been launched at |launch_time|.
+  void SetLaunchTimeForTesting(base::TimeTicks launch_time);
+
  private:
   friend class base::NoDestructor<MockTorLauncherFactory>;
 
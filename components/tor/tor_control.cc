@@ -91,6 +91,7 @@ TorControl::TorControl(base::WeakPtr<TorControl::Delegate> delegate,
     : running_(false),
       owner_task_runner_(base::SequencedTaskRunnerHandle::Get()),
       io_task_runner_(task_runner),
+      connected_(false),
       writing_(false),
       reading_(false),
       read_start_(-1),
@@ -107,7 +108,9 @@ TorControl::~TorControl() {
 // Start()
 //
 //      Start watching for the Tor control channel.  If we are able to
-//      connect, issue OnTorControlReady to delegate.
+//      connect, issue OnTorControlReady to delegate.  Commands issued
+//      after Start() are pipelined behind authentication, without
+//      waiting for OnTorControlReady.
 //
 void TorControl::Start(std::vector<uint8_t> cookie, int port) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(owner_sequence_checker_);
@@ -148,12 +151,24 @@ void TorControl::OpenControl(int portno, std::vector<uint8_t> cookie) {
       net::IPAddress::IPv4Localhost(), portno);
   socket_ = std::make_unique<net::TCPClientSocket>(
       addrlist, nullptr, nullptr, net::NetLog::Get(), net::NetLogSource());
-  int rv = socket_->Connect(base::BindOnce(&TorControl::Connected,
-                                           weak_ptr_factory_.GetWeakPtr(),
-                                           std::move(cookie)));
+
+  // Queue authentication ahead of anything the delegate asks for while we
+  // are connecting.  Tor processes commands in order, so everything queued
+  // behind AUTHENTICATE is written back-to-back as soon as we are connected
+  // instead of waiting for each reply in turn.
+  DoCmd("AUTHENTICATE " + base::HexEncode(cookie.data(), cookie.size()),
+        base::DoNothing(),
+        base::BindOnce(&TorControl::Authenticated,
+                       weak_ptr_factory_.GetWeakPtr()));
+  DoCmd("TAKEOWNERSHIP", base::DoNothing(), base::DoNothing());
+  DoCmd("RESETCONF __OwningControllerProcess", base::DoNothing(),
+        base::DoNothing());
+
+  int rv = socket_->Connect(
+      base::BindOnce(&TorControl::Connected, weak_ptr_factory_.GetWeakPtr()));
   if (rv == net::ERR_IO_PENDING)
     return;
-  Connected(std::move(cookie), rv);
+  Connected(rv);
 }
 
 void TorControl::StopOnTaskRunner() {
@@ -166,28 +181,32 @@ void TorControl::StopOnTaskRunner() {
   Error();
 }
 
-// Connected(rv, cookie)
+// Connected(rv)
 //
-//      Connection completed.  If it failed, poll again if there was
-//      activity while we were busy connecting, or go back to watching
-//      and waiting.  If it succeeded, start authenticating.
+//      Connection completed.  If it failed, fail every queued command
+//      and let the delegate decide whether to watch for the control
+//      files again.  If it succeeded, start writing the queued
+//      commands, beginning with AUTHENTICATE.
 //
-void TorControl::Connected(std::vector<uint8_t> cookie, int rv) {
+void TorControl::Connected(int rv) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
 
   if (rv != net::OK) {
-    // Connection failed but there may have been more watch directory
-    // activity while we were waiting.  If so, try again; if not, go
-    // back to watching and waiting.
     VLOG(1) << "tor: control connection failed: " << net::ErrorToString(rv);
-    NotifyTorControlClosed();
+    Error();
     return;
   }
 
-  DoCmd("AUTHENTICATE " + base::HexEncode(cookie.data(), cookie.size()),
-        base::DoNothing(),
-        base::BindOnce(&TorControl::Authenticated,
-                       weak_ptr_factory_.GetWeakPtr()));
+  connected_ = true;
+  DCHECK(!writeq_.empty());
+  writing_ = true;
+  StartWrite();
+  DoWrites();
+  if (!reading_ && connected_) {
+    reading_ = true;
+    StartRead();
+    DoReads();
+  }
 }
 
 // Authenticated(error, status, reply)
@@ -210,9 +229,6 @@ void TorControl::Authenticated(bool error,
   }
   VLOG(2) << "tor: control connection ready";
 
-  DoCmd("TAKEOWNERSHIP", base::DoNothing(), base::DoNothing());
-  DoCmd("RESETCONF __OwningControllerProcess", base::DoNothing(),
-        base::DoNothing());
   NotifyTorControlReady();
 }
 
@@ -228,31 +244,46 @@ void TorControl::Authenticated(bool error,
 //      Subsequently, whenever the event happens, notify delegate the
 //      OnTorEvent.
 //
+// Subscribe(events, callback)
+//
+//      Same as above for several events at once, sending at most one
+//      SETEVENTS.
+//
 void TorControl::Subscribe(TorControlEvent event,
                            base::OnceCallback<void(bool error)> callback) {
+  Subscribe(std::vector<TorControlEvent>{event}, std::move(callback));
+}
+
+void TorControl::Subscribe(const std::vector<TorControlEvent>& events,
+                           base::OnceCallback<void(bool error)> callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(owner_sequence_checker_);
   io_task_runner_->PostTask(
       FROM_HERE,
       base::BindOnce(&TorControl::DoSubscribe, weak_ptr_factory_.GetWeakPtr(),
-                     event, std::move(callback)));
+                     events, std::move(callback)));
 }
 
-void TorControl::DoSubscribe(TorControlEvent event,
+void TorControl::DoSubscribe(std::vector<TorControlEvent> events,
                              base::OnceCallback<void(bool error)> callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(io_sequence_checker_);
-  if (async_events_[event]++ != 0) {
+  // Only events we were not subscribed to yet need a SETEVENTS.
+  std::vector<TorControlEvent> new_events;
+  for (const auto event : events) {
+    if (async_events_[event]++ == 0)
+      new_events.push_back(event);
+  }
+  if (new_events.empty()) {
     bool error = false;
     std::move(callback).Run(error);
     return;
   }
 
-  async_events_[event] = 1;
   DoCmd(SetEventsCmd(), base::DoNothing(),
         base::BindOnce(&TorControl::Subscribed, weak_ptr_factory_.GetWeakPtr(),
-                       event, std::move(callback)));
+                       std::move(new_events), std::move(callback)));
 }
 
-void TorControl::Subscribed(TorControlEvent event,
+void TorControl::Subscribed(std::vector<TorControlEvent> events,
                             base::OnceCallback<void(bool error)> callback,
                             bool error,
                             const std::string& status,
@@ -263,8 +294,10 @@ void TorControl::Subscribed(TorControlEvent event,
       error = true;
   }
   if (error) {
-    if (--async_events_[event] == 0)
-      async_events_.erase(event);
+    for (const auto event : events) {
+      if (--async_events_[event] == 0)
+        async_events_.erase(event);
+    }
   }
   std::move(callback).Run(error);
 }
@@ -361,6 +394,9 @@ void TorControl::DoCmd(std::string cmd,
   }
   writeq_.push(cmd + "\r\n");
   cmdq_.push(std::make_pair(std::move(perline), std::move(callback)));
+  // Still connecting; Connected() will issue the queued commands.
+  if (!connected_)
+    return;
   if (!writing_) {
     writing_ = true;
     StartWrite();
@@ -1072,6 +1108,7 @@ void TorControl::Error() {
 
   // Clear the socket.
   socket_.reset();
+  connected_ = false;
 }
 
 void TorControl::NotifyTorControlReady() {
@@ -80,6 +80,9 @@ class TorControl {
 
   void Subscribe(TorControlEvent event,
                  base::OnceCallback<void(bool error)> callback);
+  // Subscribes to all of |events| with a single SETEVENTS command.
+  void Subscribe(const std::vector<TorControlEvent>& events,
+                 base::OnceCallback<void(bool error)> callback);
   void Unsubscribe(TorControlEvent event,
                    base::OnceCallback<void(bool error)> callback);
 
@@ -120,7 +123,7 @@ class TorControl {
  private:
   void OpenControl(int port, std::vector<uint8_t> cookie);
   void StopOnTaskRunner();
-  void Connected(std::vector<uint8_t> cookie, int rv);
+  void Connected(int rv);
   void Authenticated(bool error,
                      const std::string& status,
                      const std::string& reply);
@@ -156,9 +159,9 @@ class TorControl {
       const std::string& status,
       const std::string& reply);
 
-  void DoSubscribe(TorControlEvent event,
+  void DoSubscribe(std::vector<TorControlEvent> events,
                    base::OnceCallback<void(bool error)> callback);
-  void Subscribed(TorControlEvent event,
+  void Subscribed(std::vector<TorControlEvent> events,
                   base::OnceCallback<void(bool error)> callback,
                   bool error,
                   const std::string& status,
@@ -218,6 +221,9 @@ class TorControl {
   SEQUENCE_CHECKER(io_sequence_checker_);
 
   std::unique_ptr<net::TCPClientSocket> socket_;
+  // Commands issued before the socket is connected are queued and written
+  // once it is.
+  bool connected_;
 
   // Write state machine.
   std::queue<std::string> writeq_;
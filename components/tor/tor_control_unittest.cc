@@ -5,11 +5,23 @@
 
 #include "brave/components/tor/tor_control.h"
 
+#include <string>
+#include <vector>
+
 #include "base/callback_helpers.h"
 #include "base/run_loop.h"
+#include "base/test/bind.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/test/browser_task_environment.h"
+#include "net/base/io_buffer.h"
+#include "net/base/ip_address.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
+#include "net/log/net_log_source.h"
+#include "net/socket/stream_socket.h"
+#include "net/socket/tcp_server_socket.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -28,6 +40,19 @@ class MockTorControlDelegate : public TorControl::Delegate {
   MOCK_METHOD2(OnTorRawMid, void(const std::string&, const std::string&));
   MOCK_METHOD2(OnTorRawEnd, void(const std::string&, const std::string&));
 };
+
+// Listens on an ephemeral localhost port and returns it.
+int Listen(net::TCPServerSocket* server_socket) {
+  if (server_socket->Listen(
+          net::IPEndPoint(net::IPAddress::IPv4Localhost(), 0),
+          /*backlog=*/1) != net::OK) {
+    return 0;
+  }
+  net::IPEndPoint address;
+  if (server_socket->GetLocalAddress(&address) != net::OK)
+    return 0;
+  return address.port();
+}
 }  // namespace
 
 TEST(TorControlTest, ParseQuoted) {
@@ -300,4 +325,86 @@ TEST(TorControlTest, GetCircuitEstablishedDone) {
   base::RunLoop().RunUntilIdle();
 }
 
+TEST(TorControlTest, WriteCommandsQueuedBeforeConnectedInOrder) {
+  content::BrowserTaskEnvironment task_environment(
+      content::BrowserTaskEnvironment::IO_MAINLOOP);
+
+  net::TCPServerSocket server_socket(nullptr, net::NetLogSource());
+  const int port = Listen(&server_socket);
+  ASSERT_NE(0, port);
+
+  testing::NiceMock<MockTorControlDelegate> delegate;
+  std::unique_ptr<TorControl> control = std::make_unique<TorControl>(
+      delegate.AsWeakPtr(), content::GetIOThreadTaskRunner({}));
+
+  // Nothing runs until the server accepts below, so these are issued while
+  // the control connection is still connecting.
+  control->Start({0x01, 0x02}, port);
+  control->Subscribe(TorControlEvent::CIRC, base::DoNothing());
+  control->GetVersion(base::DoNothing());
+
+  std::unique_ptr<net::StreamSocket> accepted_socket;
+  net::TestCompletionCallback accept_callback;
+  ASSERT_EQ(net::OK, accept_callback.GetResult(server_socket.Accept(
+                         &accepted_socket, accept_callback.callback())));
+
+  const std::string expected_commands =
+      "AUTHENTICATE 0102\r\n"
+      "TAKEOWNERSHIP\r\n"
+      "RESETCONF __OwningControllerProcess\r\n"
+      "SETEVENTS CIRC\r\n"
+      "GETINFO version\r\n";
+  std::string commands;
+  while (commands.size() < expected_commands.size()) {
+    constexpr int kBufferSize = 1024;
+    auto buffer = base::MakeRefCounted<net::IOBuffer>(kBufferSize);
+    net::TestCompletionCallback read_callback;
+    const int rv = read_callback.GetResult(accepted_socket->Read(
+        buffer.get(), kBufferSize, read_callback.callback()));
+    ASSERT_GT(rv, 0);
+    commands.append(buffer->data(), rv);
+  }
+  EXPECT_EQ(expected_commands, commands);
+
+  control->Stop();
+  base::RunLoop().RunUntilIdle();
+}
+
+TEST(TorControlTest, FailCommandsQueuedBeforeConnectedOnConnectError) {
+  content::BrowserTaskEnvironment task_environment(
+      content::BrowserTaskEnvironment::IO_MAINLOOP);
+
+  // Pick a port nothing is listening on anymore.
+  int port = 0;
+  {
+    net::TCPServerSocket server_socket(nullptr, net::NetLogSource());
+    port = Listen(&server_socket);
+  }
+  ASSERT_NE(0, port);
+
+  testing::NiceMock<MockTorControlDelegate> delegate;
+  std::unique_ptr<TorControl> control = std::make_unique<TorControl>(
+      delegate.AsWeakPtr(), content::GetIOThreadTaskRunner({}));
+
+  std::vector<std::string> failed_commands;
+  base::RunLoop run_loop;
+  control->Start({0x01, 0x02}, port);
+  control->Subscribe(TorControlEvent::CIRC,
+                     base::BindLambdaForTesting([&](bool error) {
+                       EXPECT_TRUE(error);
+                       failed_commands.push_back("SETEVENTS");
+                     }));
+  control->GetVersion(base::BindLambdaForTesting(
+      [&](bool error, const std::string& version) {
+        EXPECT_TRUE(error);
+        EXPECT_TRUE(version.empty());
+        failed_commands.push_back("GETINFO version");
+        run_loop.Quit();
+      }));
+  run_loop.Run();
+
+  EXPECT_THAT(failed_commands,
+              testing::ElementsAre("SETEVENTS", "GETINFO version"));
+}
+
 }  // namespace tor
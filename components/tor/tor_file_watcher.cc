@@ -35,11 +35,19 @@ constexpr char kLineBreak[] = "\n";
 #endif
 constexpr char kControlAuthCookieName[] = "control_auth_cookie";
 constexpr char kControlPortName[] = "controlport";
+
+// Change notifications can be coalesced or, depending on the platform,
+// dropped, so the control files are also re-read after these delays, doubling
+// each time, until they are read successfully or we run out of attempts.
+constexpr base::TimeDelta kFallbackPollDelay = base::Milliseconds(250);
+constexpr int kMaxFallbackPolls = 6;
 }  // namespace
 
 TorFileWatcher::TorFileWatcher(const base::FilePath& watch_dir_path)
     : polling_(false),
       repoll_(false),
+      fallback_poll_pending_(false),
+      fallback_polls_(0),
       watch_dir_path_(std::move(watch_dir_path)),
       watch_task_runner_(
           base::ThreadPool::CreateSequencedTaskRunner(kWatchTaskTraits)),
@@ -161,9 +169,37 @@ void TorFileWatcher::PollDone() {
   } else {
     VLOG(2) << "tor: control connection not yet ready";
     polling_ = false;
+    ScheduleFallbackPoll();
   }
 }
 
+// ScheduleFallbackPoll()
+//
+//      Arrange to poll again after a delay even if the watch directory
+//      does not change, unless a fallback poll is already scheduled or
+//      we already gave up on them.
+//
+void TorFileWatcher::ScheduleFallbackPoll() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(watch_sequence_checker_);
+  if (fallback_poll_pending_ || fallback_polls_ >= kMaxFallbackPolls)
+    return;
+
+  fallback_poll_pending_ = true;
+  watch_task_runner_->PostDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&TorFileWatcher::OnFallbackPoll,
+                     weak_ptr_factory_.GetWeakPtr()),
+      kFallbackPollDelay * (1 << fallback_polls_));
+  fallback_polls_++;
+}
+
+void TorFileWatcher::OnFallbackPoll() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(watch_sequence_checker_);
+  fallback_poll_pending_ = false;
+  VLOG(2) << "tor: polling watch directory";
+  OnWatchDirChanged(watch_dir_path_, false);
+}
+
 // EatControlCookie(cookie, mtime)
 //
 //      Try to read the control auth cookie.  Return true and set
@@ -24,9 +24,12 @@ namespace tor {
 
 FORWARD_DECLARE_TEST(TorFileWatcherTest, EatControlCookie);
 FORWARD_DECLARE_TEST(TorFileWatcherTest, EatControlPort);
+FORWARD_DECLARE_TEST(TorFileWatcherTest, FallbackPollsBackOffAndStop);
 
 // This is used to fetch Tor cookie and port which are required to establish
-// control channel. It will delete itself when WatchCallback is called.
+// control channel. The files are read whenever the watch directory changes,
+// with a bounded number of backed-off re-reads in case a change notification
+// is missed. It will delete itself when WatchCallback is called.
 // The destructor must run on the watch_task_runner which is the sequence we
 // post task to FilePathWatcher, so the weak ptr can invalidated on the sequence
 class TorFileWatcher {
@@ -46,11 +49,14 @@ class TorFileWatcher {
   // friend class TorFileWatcherTest;
   FRIEND_TEST_ALL_PREFIXES(TorFileWatcherTest, EatControlCookie);
   FRIEND_TEST_ALL_PREFIXES(TorFileWatcherTest, EatControlPort);
+  FRIEND_TEST_ALL_PREFIXES(TorFileWatcherTest, FallbackPollsBackOffAndStop);
 
   void StartWatchingOnTaskRunner();
   void OnWatchDirChanged(const base::FilePath& path, bool error);
   void Poll();
   void PollDone();
+  void ScheduleFallbackPoll();
+  void OnFallbackPoll();
   bool EatControlCookie(std::vector<uint8_t>&, base::Time&);
   bool EatControlPort(int&, base::Time&);
 
@@ -59,6 +65,8 @@ class TorFileWatcher {
 
   bool polling_;
   bool repoll_;
+  bool fallback_poll_pending_;
+  int fallback_polls_;
   base::FilePath watch_dir_path_;
 
   WatchCallback watch_callback_;
@@ -6,7 +6,10 @@
 #include <utility>
 
 #include "base/base_paths.h"
+#include "base/callback_helpers.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/path_service.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/time/time.h"
 #include "brave/components/tor/tor_file_watcher.h"
 #include "build/build_config.h"
@@ -63,7 +66,9 @@ constexpr char kNormalControlport[] =
 
 class TorFileWatcherTest : public testing::Test {
  public:
-  TorFileWatcherTest() {}
+  TorFileWatcherTest()
+      : task_environment_(
+            base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
 
   void SetUp() override {
     testing::Test::SetUp();
@@ -77,6 +82,10 @@ class TorFileWatcherTest : public testing::Test {
     return test_data_dir_.AppendASCII("tor").AppendASCII("tor_control");
   }
 
+  content::BrowserTaskEnvironment* task_environment() {
+    return &task_environment_;
+  }
+
  private:
   content::BrowserTaskEnvironment task_environment_;
   base::FilePath test_data_dir_;
@@ -212,4 +221,40 @@ TEST_F(TorFileWatcherTest, EatControlPort) {
   EXPECT_NE(time.ToJsTime(), 0u);
 }
 
+TEST_F(TorFileWatcherTest, FallbackPollsBackOffAndStop) {
+  // Tor never writes the control files to this directory.
+  base::ScopedTempDir watch_dir;
+  ASSERT_TRUE(watch_dir.CreateUniqueTempDir());
+
+  TorFileWatcher* tor_file_watcher = new TorFileWatcher(watch_dir.GetPath());
+  tor_file_watcher->StartWatching(base::DoNothing());
+  task_environment()->RunUntilIdle();
+
+  // The initial poll failed, so the first fallback poll is scheduled.
+  EXPECT_EQ(1, tor_file_watcher->fallback_polls_);
+  EXPECT_TRUE(tor_file_watcher->fallback_poll_pending_);
+
+  task_environment()->FastForwardBy(base::Milliseconds(249));
+  EXPECT_EQ(1, tor_file_watcher->fallback_polls_);
+
+  task_environment()->FastForwardBy(base::Milliseconds(1));
+  EXPECT_EQ(2, tor_file_watcher->fallback_polls_);
+
+  // The delay doubles for each fallback poll.
+  task_environment()->FastForwardBy(base::Milliseconds(499));
+  EXPECT_EQ(2, tor_file_watcher->fallback_polls_);
+
+  task_environment()->FastForwardBy(base::Milliseconds(1));
+  EXPECT_EQ(3, tor_file_watcher->fallback_polls_);
+
+  // Fallback polls stop after a bounded number of attempts.
+  task_environment()->FastForwardBy(base::Hours(1));
+  EXPECT_EQ(6, tor_file_watcher->fallback_polls_);
+  EXPECT_FALSE(tor_file_watcher->fallback_poll_pending_);
+
+  tor_file_watcher->watch_task_runner_->DeleteSoon(FROM_HERE,
+                                                   tor_file_watcher);
+  task_environment()->RunUntilIdle();
+}
+
 }  // namespace tor
@@ -10,6 +10,7 @@
 
 #include "base/bind.h"
 #include "base/callback_helpers.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/task/bind_post_task.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/components/tor/tor_file_watcher.h"
@@ -20,6 +21,9 @@
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/service_process_host.h"
 
+const char TorLauncherFactory::kTimeToCircuitEstablishedHistogramName[] =
+    "Brave.Tor.TimeToCircuitEstablished";
+
 namespace {
 constexpr char kTorProxyScheme[] = "socks5://";
 // tor::TorControlEvent::STATUS_CLIENT response
@@ -101,6 +105,7 @@ void TorLauncherFactory::LaunchTorInternal() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   if (tor_launcher_.is_bound()) {
+    launch_time_ = base::TimeTicks::Now();
     auto config = tor::mojom::TorConfig::New(config_);
     tor_launcher_->Launch(std::move(config),
                           base::BindOnce(&TorLauncherFactory::OnTorLaunched,
@@ -119,6 +124,7 @@ void TorLauncherFactory::KillTorProcess() {
   tor_pid_ = -1;
   is_starting_ = false;
   is_connected_ = false;
+  launch_time_ = base::TimeTicks();
   tor_log_.clear();
 }
 
@@ -227,31 +233,6 @@ void TorLauncherFactory::OnTorLaunched(bool result, int64_t pid) {
 void TorLauncherFactory::OnTorControlReady() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   VLOG(2) << "TOR CONTROL: Ready!";
-  control_->GetVersion(
-      base::BindPostTask(base::SequencedTaskRunnerHandle::Get(),
-                         base::BindOnce(&TorLauncherFactory::GotVersion,
-                                        weak_ptr_factory_.GetWeakPtr())));
-  control_->GetSOCKSListeners(
-      base::BindPostTask(base::SequencedTaskRunnerHandle::Get(),
-                         base::BindOnce(&TorLauncherFactory::GotSOCKSListeners,
-                                        weak_ptr_factory_.GetWeakPtr())));
-  // A Circuit might have been established when Tor control is ready, in that
-  // case we will not receive circuit established events. So we query the status
-  // directly as fail safe, otherwise Tor window might stuck in disconnected
-  // state while Tor circuit is ready.
-  control_->GetCircuitEstablished(base::BindPostTask(
-      base::SequencedTaskRunnerHandle::Get(),
-      base::BindOnce(&TorLauncherFactory::GotCircuitEstablished,
-                     weak_ptr_factory_.GetWeakPtr())));
-  control_->Subscribe(tor::TorControlEvent::NETWORK_LIVENESS,
-                      base::DoNothing());
-  control_->Subscribe(tor::TorControlEvent::STATUS_CLIENT, base::DoNothing());
-  control_->Subscribe(tor::TorControlEvent::STATUS_GENERAL, base::DoNothing());
-  control_->Subscribe(tor::TorControlEvent::STREAM, base::DoNothing());
-  control_->Subscribe(tor::TorControlEvent::NOTICE, base::DoNothing());
-  control_->Subscribe(tor::TorControlEvent::WARN, base::DoNothing());
-  control_->Subscribe(tor::TorControlEvent::ERR, base::DoNothing());
-
   for (auto& observer : observers_) {
     observer.OnTorControlReady();
   }
@@ -298,10 +279,21 @@ void TorLauncherFactory::GotCircuitEstablished(bool error, bool established) {
     return;
   }
   is_connected_ = established;
+  if (established)
+    RecordTimeToCircuitEstablished();
   for (auto& observer : observers_)
     observer.OnTorCircuitEstablished(established);
 }
 
+void TorLauncherFactory::RecordTimeToCircuitEstablished() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (launch_time_.is_null())
+    return;
+  base::UmaHistogramMediumTimes(kTimeToCircuitEstablishedHistogramName,
+                                base::TimeTicks::Now() - launch_time_);
+  launch_time_ = base::TimeTicks();
+}
+
 void TorLauncherFactory::OnTorControlClosed(bool was_running) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   VLOG(2) << "TOR CONTROL: Closed!";
@@ -329,6 +321,31 @@ void TorLauncherFactory::OnTorControlPrerequisitesReady(
   }
   if (ready) {
     control_->Start(std::move(cookie), port);
+    // These are pipelined behind authentication rather than issued once
+    // OnTorControlReady arrives.
+    control_->Subscribe(
+        {tor::TorControlEvent::NETWORK_LIVENESS,
+         tor::TorControlEvent::STATUS_CLIENT,
+         tor::TorControlEvent::STATUS_GENERAL, tor::TorControlEvent::STREAM,
+         tor::TorControlEvent::NOTICE, tor::TorControlEvent::WARN,
+         tor::TorControlEvent::ERR},
+        base::DoNothing());
+    control_->GetVersion(base::BindPostTask(
+        base::SequencedTaskRunnerHandle::Get(),
+        base::BindOnce(&TorLauncherFactory::GotVersion,
+                       weak_ptr_factory_.GetWeakPtr())));
+    control_->GetSOCKSListeners(base::BindPostTask(
+        base::SequencedTaskRunnerHandle::Get(),
+        base::BindOnce(&TorLauncherFactory::GotSOCKSListeners,
+                       weak_ptr_factory_.GetWeakPtr())));
+    // A Circuit might have been established when Tor control is ready, in
+    // that case we will not receive circuit established events. So we query
+    // the status directly as fail safe, otherwise Tor window might stuck in
+    // disconnected state while Tor circuit is ready.
+    control_->GetCircuitEstablished(base::BindPostTask(
+        base::SequencedTaskRunnerHandle::Get(),
+        base::BindOnce(&TorLauncherFactory::GotCircuitEstablished,
+                       weak_ptr_factory_.GetWeakPtr())));
   } else {
     tor::TorFileWatcher* tor_file_watcher =
         new tor::TorFileWatcher(config_.tor_watch_path);
@@ -388,6 +405,7 @@ void TorLauncherFactory::OnTorEvent(
         observer.OnTorInitializing(percentage, message);
     } else if (initial.find(kStatusClientCircuitEstablished) !=
                std::string::npos) {
+      RecordTimeToCircuitEstablished();
       for (auto& observer : observers_)
         observer.OnTorCircuitEstablished(true);
       is_connected_ = true;
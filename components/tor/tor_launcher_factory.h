@@ -18,6 +18,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/sequence_checker.h"
+#include "base/time/time.h"
 #include "brave/components/services/tor/public/interfaces/tor.mojom.h"
 #include "brave/components/tor/tor_control.h"
 #include "brave/components/tor/tor_utils.h"
@@ -35,6 +36,10 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
  public:
   using GetLogCallback = base::OnceCallback<void(bool, const std::string&)>;
 
+  // Time from asking the launcher to start tor until the first circuit is
+  // established.
+  static const char kTimeToCircuitEstablishedHistogramName[];
+
   TorLauncherFactory(const TorLauncherFactory&) = delete;
   TorLauncherFactory& operator=(const TorLauncherFactory&) = delete;
 
@@ -86,6 +91,7 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
   void GotVersion(bool error, const std::string& version);
   void GotSOCKSListeners(bool error, const std::vector<std::string>& listeners);
   void GotCircuitEstablished(bool error, bool established);
+  void RecordTimeToCircuitEstablished();
 
   void LaunchTorInternal();
   void RelaunchTor();
@@ -103,6 +109,9 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
 
   int64_t tor_pid_;
 
+  // Set when tor is launched and reset once its startup time is recorded.
+  base::TimeTicks launch_time_;
+
   tor::mojom::TorConfig config_;
 
   base::ObserverList<TorLauncherObserver> observers_;
@@ -0,0 +1,69 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/tor/tor_launcher_factory.h"
+
+#include <map>
+#include <string>
+
+#include "base/test/metrics/histogram_tester.h"
+#include "base/time/time.h"
+#include "brave/components/tor/mock_tor_launcher_factory.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace tor {
+
+class TorLauncherFactoryTest : public testing::Test {
+ public:
+  TorLauncherFactoryTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
+
+  MockTorLauncherFactory& tor_launcher_factory() {
+    return MockTorLauncherFactory::GetInstance();
+  }
+
+  void FastForwardBy(base::TimeDelta delta) {
+    task_environment_.FastForwardBy(delta);
+  }
+
+  void EstablishCircuit() {
+    tor_launcher_factory().OnTorEvent(TorControlEvent::STATUS_CLIENT,
+                                      "NOTICE CIRCUIT_ESTABLISHED", {});
+  }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_;
+};
+
+TEST_F(TorLauncherFactoryTest, RecordTimeToCircuitEstablished) {
+  base::HistogramTester histogram_tester;
+
+  tor_launcher_factory().SetLaunchTimeForTesting(base::TimeTicks::Now());
+  FastForwardBy(base::Seconds(7));
+  EstablishCircuit();
+
+  histogram_tester.ExpectUniqueTimeSample(
+      TorLauncherFactory::kTimeToCircuitEstablishedHistogramName,
+      base::Seconds(7), 1);
+
+  // Only the first circuit after launching is part of the startup timeline.
+  FastForwardBy(base::Seconds(3));
+  EstablishCircuit();
+
+  histogram_tester.ExpectTotalCount(
+      TorLauncherFactory::kTimeToCircuitEstablishedHistogramName, 1);
+}
+
+TEST_F(TorLauncherFactoryTest, NoTimeToCircuitEstablishedWithoutLaunch) {
+  base::HistogramTester histogram_tester;
+
+  EstablishCircuit();
+
+  histogram_tester.ExpectTotalCount(
+      TorLauncherFactory::kTimeToCircuitEstablishedHistogramName, 0);
+}
+
+}  // namespace tor
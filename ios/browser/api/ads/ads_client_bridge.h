@@ -40,6 +40,9 @@
 - (void)save:(const std::string&)name
        value:(const std::string&)value
     callback:(ads::ResultCallback)callback;
+- (void)append:(const std::string&)name
+         value:(const std::string&)value
+      callback:(ads::ResultCallback)callback;
 - (void)showNotificationAd:(const ads::NotificationAdInfo&)info;
 - (void)closeNotificationAd:(const std::string&)placement_id;
 - (void)recordAdEventForId:(const std::string&)id
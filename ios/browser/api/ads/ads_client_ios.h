@@ -41,6 +41,9 @@ class AdsClientIOS : public ads::AdsClient {
   void Save(const std::string& name,
             const std::string& value,
             ads::ResultCallback callback) override;
+  void Append(const std::string& name,
+              const std::string& value,
+              ads::ResultCallback callback) override;
   void Load(const std::string& name, ads::LoadCallback callback) override;
   void LoadFileResource(const std::string& id,
                         const int version,
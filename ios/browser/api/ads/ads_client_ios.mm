@@ -76,6 +76,12 @@ void AdsClientIOS::Save(const std::string& name,
   [bridge_ save:name value:value callback:callback];
 }
 
+void AdsClientIOS::Append(const std::string& name,
+                          const std::string& value,
+                          ads::ResultCallback callback) {
+  [bridge_ append:name value:value callback:callback];
+}
+
 void AdsClientIOS::LoadFileResource(const std::string& id,
                                     const int version,
                                     ads::LoadFileCallback callback) {
@@ -1211,6 +1211,16 @@ ads::mojom::DBCommandResponseInfoPtr RunDBTransactionOnTaskRunner(
   }
 }
 
+- (void)append:(const std::string&)name
+         value:(const std::string&)value
+      callback:(ads::ResultCallback)callback {
+  if ([self.commonOps appendContents:value name:name]) {
+    callback(/* success */ true);
+  } else {
+    callback(/* success */ false);
+  }
+}
+
 #pragma mark - Logging
 
 - (void)log:(const char*)file
@@ -53,6 +53,10 @@ OBJC_EXPORT
 
 /// Save the contents to a file with the given name
 - (bool)saveContents:(const std::string&)contents name:(const std::string&)name;
+/// Append the contents to the end of a file with the given name, creating the
+/// file if it does not exist
+- (bool)appendContents:(const std::string&)contents
+                  name:(const std::string&)name;
 /// Load the contents of a saved file with the given name
 - (std::string)loadContentsFromFileWithName:(const std::string&)name;
 /// Remove the saved file with the given name
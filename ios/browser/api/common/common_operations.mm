@@ -175,6 +175,37 @@
   return result;
 }
 
+- (bool)appendContents:(const std::string&)contents
+                  name:(const std::string&)name {
+  const auto filename = [NSString stringWithUTF8String:name.c_str()];
+  const auto path = [self dataPathForFilename:filename];
+  if (![NSFileManager.defaultManager fileExistsAtPath:path] &&
+      ![NSFileManager.defaultManager createFileAtPath:path
+                                             contents:nil
+                                           attributes:nil]) {
+    LOG(ERROR) << "Failed to create file for " << name;
+    return false;
+  }
+
+  NSError* error = nil;
+  NSFileHandle* fileHandle = [NSFileHandle fileHandleForWritingAtPath:path];
+  if (!fileHandle) {
+    LOG(ERROR) << "Failed to open file for " << name;
+    return false;
+  }
+
+  const auto data = [NSData dataWithBytes:contents.data()
+                                   length:contents.size()];
+  const bool result = [fileHandle seekToEndReturningOffset:nil error:&error] &&
+                      [fileHandle writeData:data error:&error];
+  [fileHandle closeAndReturnError:nil];
+  if (!result) {
+    LOG(ERROR) << "Failed to append data for " << name << ": "
+               << base::SysNSStringToUTF8(error.localizedDescription);
+  }
+  return result;
+}
+
 - (std::string)loadContentsFromFileWithName:(const std::string&)name {
   const auto filename = [NSString stringWithUTF8String:name.c_str()];
   NSError* error = nil;
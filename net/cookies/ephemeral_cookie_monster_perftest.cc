@@ -0,0 +1,150 @@
+/* Copyright 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/callback_helpers.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/bind.h"
+#include "base/timer/elapsed_timer.h"
+#include "net/base/url_util.h"
+#include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_deletion_info.h"
+#include "net/cookies/cookie_monster.h"
+#include "net/cookies/cookie_options.h"
+#include "net/test/test_with_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+// npm run test -- brave_perftests --filter=EphemeralCookieMonsterPerfTest*
+
+namespace net {
+
+namespace {
+
+constexpr int kPartitionCount = 500;
+constexpr int kCookiesPerPartition = 5;
+
+const char kThirdPartyURL[] = "https://tracker.example/";
+
+CookieOptions MakeEphemeralOptions(const GURL& top_frame_url) {
+  CookieOptions options = CookieOptions::MakeAllInclusive();
+  options.set_should_use_ephemeral_storage(true);
+  options.set_top_frame_origin(url::Origin::Create(top_frame_url));
+  return options;
+}
+
+}  // namespace
+
+class EphemeralCookieMonsterPerfTest : public ::testing::Test,
+                                       public WithTaskEnvironment {
+ public:
+  EphemeralCookieMonsterPerfTest()
+      : cookie_monster_(std::make_unique<CookieMonster>(
+            nullptr /* store */,
+            nullptr /* net_log */,
+            /*first_party_sets_enabled=*/false)) {
+    for (int i = 0; i < kPartitionCount; ++i) {
+      top_frame_urls_.emplace_back("https://site" + base::NumberToString(i) +
+                                   ".com/");
+    }
+  }
+
+ protected:
+  void SetCookies(const std::vector<GURL>& top_frame_urls) {
+    const GURL url(kThirdPartyURL);
+    for (const auto& top_frame_url : top_frame_urls) {
+      const CookieOptions options = MakeEphemeralOptions(top_frame_url);
+      for (int i = 0; i < kCookiesPerPartition; ++i) {
+        cookie_monster_->SetCanonicalCookieAsync(
+            CanonicalCookie::Create(url, "c" + base::NumberToString(i) + "=1",
+                                    base::Time::Now(),
+                                    /*server_time=*/absl::nullopt,
+                                    /*cookie_partition_key=*/absl::nullopt),
+            url, options, base::DoNothing());
+      }
+    }
+  }
+
+  size_t GetCookies(const std::vector<GURL>& top_frame_urls) {
+    const GURL url(kThirdPartyURL);
+    size_t count = 0;
+    for (const auto& top_frame_url : top_frame_urls) {
+      cookie_monster_->GetCookieListWithOptionsAsync(
+          url, MakeEphemeralOptions(top_frame_url),
+          CookiePartitionKeyCollection(),
+          base::BindLambdaForTesting(
+              [&count](const CookieAccessResultList& included,
+                       const CookieAccessResultList& excluded) {
+                count += included.size();
+              }));
+    }
+    return count;
+  }
+
+  std::unique_ptr<CookieMonster> cookie_monster_;
+  std::vector<GURL> top_frame_urls_;
+};
+
+TEST_F(EphemeralCookieMonsterPerfTest, Partitions) {
+  perf_test::PerfResultReporter reporter("EphemeralCookieMonster",
+                                         "Partitions");
+  reporter.RegisterImportantMetric(".set", "us/partition");
+  reporter.RegisterImportantMetric(".get", "us/partition");
+  reporter.RegisterImportantMetric(".get_unset", "us/partition");
+  reporter.RegisterImportantMetric(".delete_partition", "us/partition");
+  reporter.RegisterImportantMetric(".delete_all", "us");
+  constexpr double kPartitions = kPartitionCount;
+
+  base::ElapsedTimer set_timer;
+  SetCookies(top_frame_urls_);
+  reporter.AddResult(".set",
+                     set_timer.Elapsed().InMicrosecondsF() / kPartitions);
+
+  base::ElapsedTimer get_timer;
+  EXPECT_EQ(GetCookies(top_frame_urls_),
+            static_cast<size_t>(kPartitionCount * kCookiesPerPartition));
+  reporter.AddResult(".get",
+                     get_timer.Elapsed().InMicrosecondsF() / kPartitions);
+
+  // Third-party frames which never set a cookie are the common case.
+  std::vector<GURL> unset_top_frame_urls;
+  for (int i = 0; i < kPartitionCount; ++i) {
+    unset_top_frame_urls.emplace_back("https://unset" +
+                                      base::NumberToString(i) + ".com/");
+  }
+  base::ElapsedTimer get_unset_timer;
+  EXPECT_EQ(GetCookies(unset_top_frame_urls), 0u);
+  reporter.AddResult(
+      ".get_unset", get_unset_timer.Elapsed().InMicrosecondsF() / kPartitions);
+
+  base::ElapsedTimer delete_partition_timer;
+  for (const auto& top_frame_url : top_frame_urls_) {
+    CookieDeletionInfo delete_info;
+    delete_info.ephemeral_storage_domain =
+        URLToEphemeralStorageDomain(top_frame_url);
+    cookie_monster_->DeleteAllMatchingInfoAsync(std::move(delete_info),
+                                                base::DoNothing());
+  }
+  reporter.AddResult(
+      ".delete_partition",
+      delete_partition_timer.Elapsed().InMicrosecondsF() / kPartitions);
+  EXPECT_EQ(GetCookies(top_frame_urls_), 0u);
+
+  SetCookies(top_frame_urls_);
+  base::ElapsedTimer delete_all_timer;
+  cookie_monster_->DeleteAllCreatedInTimeRangeAsync(
+      CookieDeletionInfo::TimeRange(), base::DoNothing());
+  reporter.AddResult(".delete_all",
+                     delete_all_timer.Elapsed().InMicrosecondsF());
+  EXPECT_EQ(GetCookies(top_frame_urls_), 0u);
+}
+
+}  // namespace net
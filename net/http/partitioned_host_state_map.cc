@@ -5,15 +5,18 @@
 
 #include "brave/net/http/partitioned_host_state_map.h"
 
+#include <algorithm>
 #include <utility>
 
-#include "base/strings/strcat.h"
 #include "crypto/sha2.h"
 #include "net/base/network_isolation_key.h"
 
 namespace net {
 
-PartitionedHostStateMapBase::PartitionedHostStateMapBase() = default;
+PartitionedHostStateMapBase::PartitionedHostStateMapBase() {
+  key_buffer_.reserve(crypto::kSHA256Length);
+}
+
 PartitionedHostStateMapBase::~PartitionedHostStateMapBase() = default;
 
 base::AutoReset<absl::optional<std::string>>
@@ -33,13 +36,35 @@ bool PartitionedHostStateMapBase::IsPartitionHashValid() const {
   return partition_hash_ && !partition_hash_->empty();
 }
 
-std::string PartitionedHostStateMapBase::GetKeyWithPartitionHash(
-    const std::string& k) const {
+const std::string& PartitionedHostStateMapBase::GetKeyWithPartitionHash(
+    const std::string& k,
+    std::string* buffer) const {
+  DCHECK(buffer);
+  CHECK(IsPartitionHashValid());
+  if (k == *partition_hash_) {
+    return k;
+  }
+  const base::StringPiece host_half_key = GetHalfKey(k);
+  const base::StringPiece partition_half_key = GetHalfKey(*partition_hash_);
+  buffer->assign(host_half_key.data(), host_half_key.size());
+  buffer->append(partition_half_key.data(), partition_half_key.size());
+  return *buffer;
+}
+
+base::StringPiece PartitionedHostStateMapBase::GetKeyWithPartitionHash(
+    const std::string& k,
+    KeyBuffer* buffer) const {
+  DCHECK(buffer);
   CHECK(IsPartitionHashValid());
   if (k == *partition_hash_) {
     return k;
   }
-  return base::StrCat({GetHalfKey(k), GetHalfKey(*partition_hash_)});
+  const base::StringPiece host_half_key = GetHalfKey(k);
+  const base::StringPiece partition_half_key = GetHalfKey(*partition_hash_);
+  auto it = std::copy(host_half_key.begin(), host_half_key.end(),
+                      buffer->begin());
+  std::copy(partition_half_key.begin(), partition_half_key.end(), it);
+  return base::StringPiece(buffer->data(), buffer->size());
 }
 
 // static
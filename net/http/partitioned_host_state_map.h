@@ -6,11 +6,13 @@
 #ifndef BRAVE_NET_HTTP_PARTITIONED_HOST_STATE_MAP_H_
 #define BRAVE_NET_HTTP_PARTITIONED_HOST_STATE_MAP_H_
 
+#include <array>
 #include <string>
+#include <type_traits>
 
 #include "base/auto_reset.h"
-#include "base/ranges/algorithm.h"
 #include "base/strings/string_piece.h"
+#include "crypto/sha2.h"
 #include "net/base/net_export.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
@@ -34,13 +36,27 @@ class NET_EXPORT PartitionedHostStateMapBase {
   // Returns true if |partition_hash_| contains a non empty valid hash.
   bool IsPartitionHashValid() const;
   // Creates a host hash by concatenating first 16 bytes (half of SHA256) from
-  // |k| and first 16 bytes from |partition_hash_|.
+  // |k| and first 16 bytes from |partition_hash_|. The result is written to
+  // |buffer|, so that a buffer reused by the caller saves an allocation per
+  // lookup. The returned reference is valid as long as |k| and |buffer| are.
   // CHECKs if |partition_hash_| is not valid.
-  std::string GetKeyWithPartitionHash(const std::string& k) const;
+  const std::string& GetKeyWithPartitionHash(const std::string& k,
+                                             std::string* buffer) const;
+
+  // Fixed size buffer for keys built on the stack.
+  using KeyBuffer = std::array<char, crypto::kSHA256Length>;
+  // Same as above, but writes to a fixed size |buffer|, so that callers which
+  // can't share a buffer don't allocate.
+  base::StringPiece GetKeyWithPartitionHash(const std::string& k,
+                                            KeyBuffer* buffer) const;
 
   // Returns first 16 bytes from |k|.
   static base::StringPiece GetHalfKey(base::StringPiece k);
 
+ protected:
+  // Reused by the non-const lookups.
+  std::string key_buffer_;
+
  private:
   // Partition hash can be of these values:
   //   nullopt - unpartitioned;
@@ -78,7 +94,7 @@ class NET_EXPORT PartitionedHostStateMap : public PartitionedHostStateMapBase {
       return size_type();
     }
 
-    return map_.erase(GetKeyWithPartitionHash(k));
+    return map_.erase(GetKeyWithPartitionHash(k, &key_buffer_));
   }
 
   mapped_type& operator[](const key_type& k) {
@@ -93,7 +109,19 @@ class NET_EXPORT PartitionedHostStateMap : public PartitionedHostStateMapBase {
       return temporary_item_;
     }
 
-    return map_[GetKeyWithPartitionHash(k)];
+    return map_[GetKeyWithPartitionHash(k, &key_buffer_)];
+  }
+
+  iterator find(const key_type& k) {
+    if (!HasPartitionHash()) {
+      return map_.find(k);
+    }
+
+    if (!IsPartitionHashValid()) {
+      return map_.end();
+    }
+
+    return map_.find(GetKeyWithPartitionHash(k, &key_buffer_));
   }
 
   const_iterator find(const key_type& k) const {
@@ -105,25 +133,48 @@ class NET_EXPORT PartitionedHostStateMap : public PartitionedHostStateMapBase {
       return map_.end();
     }
 
-    return map_.find(GetKeyWithPartitionHash(k));
+    // Const lookups don't share |key_buffer_|, so concurrent readers are safe.
+    KeyBuffer key_buffer;
+    const base::StringPiece key = GetKeyWithPartitionHash(k, &key_buffer);
+    if constexpr (kHasTransparentCompare) {
+      return map_.find(key);
+    } else {
+      return map_.find(key_type(key));
+    }
   }
 
   // Removes all items with similar first 16 bytes of |k|, effectively ignoring
   // partition hash part.
   bool DeleteDataInAllPartitions(const key_type& k) {
-    auto equal_range_pair = base::ranges::equal_range(
-        map_, GetHalfKey(k), {},
-        [](const value_type& v) { return GetHalfKey(v.first); });
+    // Keys are ordered and the items of a host all start with its half key, so
+    // they are adjacent, right after the half key itself.
+    const base::StringPiece half_key = GetHalfKey(k);
+    key_buffer_.assign(half_key.data(), half_key.size());
+    const auto first = map_.lower_bound(key_buffer_);
+    auto last = first;
+    while (last != map_.end() && GetHalfKey(last->first) == half_key) {
+      ++last;
+    }
 
-    if (equal_range_pair.first == equal_range_pair.second) {
+    if (first == last) {
       return false;
     }
 
-    map_.erase(equal_range_pair.first, equal_range_pair.second);
+    map_.erase(first, last);
     return true;
   }
 
  private:
+  template <typename C, typename = void>
+  struct IsTransparent : std::false_type {};
+  template <typename C>
+  struct IsTransparent<C, std::void_t<typename C::is_transparent>>
+      : std::true_type {};
+  // Maps with a transparent comparator are looked up without building a
+  // key_type, i.e. without allocating.
+  static constexpr bool kHasTransparentCompare =
+      IsTransparent<typename T::key_compare>::value;
+
   T map_;
   mapped_type temporary_item_;
 };
@@ -0,0 +1,106 @@
+/* Copyright 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/net/http/partitioned_host_state_map.h"
+#include "crypto/sha2.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// npm run test -- brave_perftests --filter=PartitionedHostStateMapPerfTest*
+
+namespace net {
+
+namespace {
+
+using StateMap = std::map<std::string, std::string>;
+using PartitionedMap = PartitionedHostStateMap<StateMap>;
+
+constexpr int kHostCount = 10000;
+constexpr int kPartitionCount = 16;
+constexpr int kLookupRounds = 20;
+
+std::vector<std::string> HashHosts(const std::string& prefix, int count) {
+  std::vector<std::string> hashes;
+  for (int i = 0; i < count; ++i) {
+    hashes.push_back(crypto::SHA256HashString(prefix + base::NumberToString(i) +
+                                              ".example.com"));
+  }
+  return hashes;
+}
+
+}  // namespace
+
+// Compares lookups in a partitioned map with the same lookups in a plain map
+// holding the same number of hosts per partition.
+TEST(PartitionedHostStateMapPerfTest, Lookups) {
+  const std::vector<std::string> hosts = HashHosts("host", kHostCount);
+  const std::vector<std::string> partitions =
+      HashHosts("partition", kPartitionCount);
+
+  StateMap plain_map;
+  for (const auto& host : hosts) {
+    plain_map[host] = "value";
+  }
+
+  PartitionedMap partitioned_map;
+  for (const auto& partition : partitions) {
+    auto auto_reset_partition_hash =
+        partitioned_map.SetScopedPartitionHash(partition);
+    for (const auto& host : hosts) {
+      partitioned_map[host] = "value";
+    }
+  }
+
+  perf_test::PerfResultReporter reporter("PartitionedHostStateMap",
+                                         "Lookups");
+  reporter.RegisterImportantMetric(".plain_find", "ns/op");
+  reporter.RegisterImportantMetric(".partitioned_find", "ns/op");
+  reporter.RegisterImportantMetric(".partitioned_insert", "ns/op");
+  constexpr double kOperationCount = kHostCount * kLookupRounds;
+
+  size_t found = 0;
+  base::ElapsedTimer plain_timer;
+  for (int round = 0; round < kLookupRounds; ++round) {
+    for (const auto& host : hosts) {
+      found += plain_map.find(host) != plain_map.end();
+    }
+  }
+  reporter.AddResult(".plain_find",
+                     plain_timer.Elapsed().InNanoseconds() / kOperationCount);
+  EXPECT_EQ(found, static_cast<size_t>(kOperationCount));
+
+  auto auto_reset_partition_hash =
+      partitioned_map.SetScopedPartitionHash(partitions.back());
+  found = 0;
+  base::ElapsedTimer partitioned_timer;
+  for (int round = 0; round < kLookupRounds; ++round) {
+    for (const auto& host : hosts) {
+      found += partitioned_map.find(host) != partitioned_map.end();
+    }
+  }
+  reporter.AddResult(
+      ".partitioned_find",
+      partitioned_timer.Elapsed().InNanoseconds() / kOperationCount);
+  EXPECT_EQ(found, static_cast<size_t>(kOperationCount));
+
+  base::ElapsedTimer insert_timer;
+  for (int round = 0; round < kLookupRounds; ++round) {
+    for (const auto& host : hosts) {
+      partitioned_map[host] = "value";
+    }
+  }
+  reporter.AddResult(".partitioned_insert",
+                     insert_timer.Elapsed().InNanoseconds() / kOperationCount);
+  EXPECT_EQ(partitioned_map.size(),
+            static_cast<size_t>(kHostCount * kPartitionCount));
+}
+
+}  // namespace net
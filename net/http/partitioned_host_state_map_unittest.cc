@@ -5,6 +5,7 @@
 
 #include "brave/net/http/partitioned_host_state_map.h"
 
+#include <functional>
 #include <map>
 #include <string>
 
@@ -17,6 +18,8 @@ namespace {
 
 using PartitionedMap =
     PartitionedHostStateMap<std::map<std::string, std::string>>;
+using TransparentPartitionedMap =
+    PartitionedHostStateMap<std::map<std::string, std::string, std::less<>>>;
 
 std::string HashHost(base::StringPiece canonicalized_host) {
   char hashed[crypto::kSHA256Length];
@@ -139,4 +142,56 @@ TEST(PartitionedHostStateMapTest, MultiplePartitions) {
   EXPECT_EQ(map.find(HashHost("key2"))->second, "12");
 }
 
+TEST(PartitionedHostStateMapTest, DeleteDataInAllPartitionsKeepsOtherHosts) {
+  PartitionedMap map;
+  map[HashHost("key1")] = "1";
+  for (const char* partition : {"partition1", "partition2", "partition3"}) {
+    auto auto_reset_partition_hash =
+        map.SetScopedPartitionHash(HashHost(partition));
+    for (const char* key : {"key1", "key2", "key3"}) {
+      map[HashHost(key)] = partition;
+    }
+  }
+  EXPECT_EQ(map.size(), 10u);
+
+  // Should delete key2 in all partitions only.
+  EXPECT_TRUE(map.DeleteDataInAllPartitions(HashHost("key2")));
+  EXPECT_EQ(map.size(), 7u);
+  EXPECT_FALSE(map.DeleteDataInAllPartitions(HashHost("key2")));
+
+  EXPECT_EQ(map.find(HashHost("key1"))->second, "1");
+  auto auto_reset_partition_hash =
+      map.SetScopedPartitionHash(HashHost("partition2"));
+  EXPECT_EQ(map.find(HashHost("key1"))->second, "partition2");
+  EXPECT_EQ(map.find(HashHost("key2")), map.end());
+  EXPECT_EQ(map.find(HashHost("key3"))->second, "partition2");
+}
+
+template <typename Map>
+void ExpectConstLookupsInPartition() {
+  Map map;
+  map[HashHost("key1")] = "1";
+  auto auto_reset_partition_hash =
+      map.SetScopedPartitionHash(HashHost("partition1"));
+  map[HashHost("key1")] = "11";
+  map[HashHost("partition1")] = "partition1";
+
+  const Map& const_map = map;
+  EXPECT_EQ(const_map.find(HashHost("key1"))->second, "11");
+  EXPECT_EQ(const_map.find(HashHost("partition1"))->second, "partition1");
+  EXPECT_EQ(const_map.find(HashHost("key2")), const_map.end());
+
+  auto_reset_partition_hash =
+      map.SetScopedPartitionHash(HashHost("partition2"));
+  EXPECT_EQ(const_map.find(HashHost("key1")), const_map.end());
+}
+
+TEST(PartitionedHostStateMapTest, ConstLookups) {
+  ExpectConstLookupsInPartition<PartitionedMap>();
+}
+
+TEST(PartitionedHostStateMapTest, ConstLookupsWithTransparentCompare) {
+  ExpectConstLookupsInPartition<TransparentPartitionedMap>();
+}
+
 }  // namespace net
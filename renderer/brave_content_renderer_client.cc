@@ -7,6 +7,7 @@
 
 #include "base/feature_list.h"
 #include "brave/components/brave_ads/common/features.h"
+#include "brave/components/brave_ads/renderer/brave_ads_page_content_extractor.h"
 #include "brave/components/brave_ads/renderer/brave_ads_render_frame_observer.h"
 #include "brave/components/brave_search/common/brave_search_utils.h"
 #include "brave/components/brave_search/renderer/brave_search_render_frame_observer.h"
@@ -91,6 +92,11 @@ void BraveContentRendererClient::RenderFrameCreated(
         render_frame, content::ISOLATED_WORLD_ID_GLOBAL);
   }
 
+  if (render_frame->IsMainFrame()) {
+    new brave_ads::BraveAdsPageContentExtractor(
+        render_frame, ISOLATED_WORLD_ID_BRAVE_INTERNAL);
+  }
+
   if (brave_ads::features::IsRequestAdsEnabledApiEnabled()) {
     new brave_ads::BraveAdsRenderFrameObserver(
         render_frame, content::ISOLATED_WORLD_ID_GLOBAL);
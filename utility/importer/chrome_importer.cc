@@ -234,13 +234,19 @@ void ChromeImporter::ImportHistory() {
     return;
   }
 
+  // Visits are aggregated per URL in SQL and the rows are sent to the
+  // browser in bounded chunks, so neither process has to hold the whole
+  // history of a large profile at once.
   const char query[] =
-      "SELECT u.url, u.title, v.visit_time, u.typed_count, u.visit_count "
+      "SELECT u.url, u.title, MAX(v.visit_time), u.typed_count, "
+      "u.visit_count "
       "FROM urls u JOIN visits v ON u.id = v.url "
       "WHERE hidden = 0 "
       "AND (transition & ?) != 0 "              // CHAIN_END
-      "AND (transition & ?) NOT IN (?, ?, ?)";  // No SUBFRAME or
+      "AND (transition & ?) NOT IN (?, ?, ?) "  // No SUBFRAME or
                                                 // KEYWORD_GENERATED
+      "GROUP BY u.id "
+      "ORDER BY u.id";
 
   sql::Statement s(db.GetUniqueStatement(query));
   s.BindInt64(0, ui::PAGE_TRANSITION_CHAIN_END);
@@ -250,6 +256,8 @@ void ChromeImporter::ImportHistory() {
   s.BindInt64(4, ui::PAGE_TRANSITION_KEYWORD_GENERATED);
 
   std::vector<ImporterURLRow> rows;
+  rows.reserve(history_chunk_size_);
+  size_t imported_count = 0;
   while (s.Step() && !cancelled()) {
     GURL url(s.ColumnString(0));
 
@@ -261,7 +269,13 @@ void ChromeImporter::ImportHistory() {
     row.typed_count = s.ColumnInt(3);
     row.visit_count = s.ColumnInt(4);
 
-    rows.push_back(row);
+    rows.push_back(std::move(row));
+    if (rows.size() >= history_chunk_size_) {
+      imported_count += rows.size();
+      bridge_->SetHistoryItems(rows, importer::VISIT_SOURCE_CHROME_IMPORTED);
+      rows.clear();
+      VLOG(1) << "Imported " << imported_count << " history urls";
+    }
   }
 
   if (!rows.empty() && !cancelled())
@@ -329,66 +343,73 @@ void ChromeImporter::ImportBookmarks() {
   if (!db.Open(copy_favicon_file.copied_file_path()))
     return;
 
-  FaviconMap favicon_map;
-  ImportFaviconURLs(&db, &favicon_map);
-  // Write favicons into profile.
-  if (!favicon_map.empty() && !cancelled()) {
-    favicon_base::FaviconUsageDataList favicons;
-    LoadFaviconData(&db, favicon_map, &favicons);
-    bridge_->SetFavicons(favicons);
-  }
+  ImportFavicons(&db);
 }
 
-void ChromeImporter::ImportFaviconURLs(sql::Database* db,
-                                       FaviconMap* favicon_map) {
-  const char query[] = "SELECT icon_id, page_url FROM icon_mapping;";
-  sql::Statement s(db->GetUniqueStatement(query));
-
-  while (s.Step() && !cancelled()) {
-    int64_t icon_id = s.ColumnInt64(0);
-    GURL url = GURL(s.ColumnString(1));
-    (*favicon_map)[icon_id].insert(url);
-  }
-}
-
-void ChromeImporter::LoadFaviconData(
-    sql::Database* db,
-    const FaviconMap& favicon_map,
-    favicon_base::FaviconUsageDataList* favicons) {
+void ChromeImporter::ImportFavicons(sql::Database* db) {
+  // One pass over the icons joined with their first bitmap and the pages
+  // using them. Rows of the same icon are adjacent, so each icon is decoded
+  // once and the icons are sent to the browser in bounded chunks.
   const char query[] =
-      "SELECT f.url, fb.image_data "
+      "SELECT f.id, f.url, fb.image_data, m.page_url "
       "FROM favicons f "
-      "JOIN favicon_bitmaps fb "
-      "ON f.id = fb.icon_id "
-      "WHERE f.id = ?;";
+      "JOIN favicon_bitmaps fb ON fb.id = "
+      "(SELECT MIN(id) FROM favicon_bitmaps WHERE icon_id = f.id) "
+      "JOIN icon_mapping m ON m.icon_id = f.id "
+      "ORDER BY f.id;";
   sql::Statement s(db->GetUniqueStatement(query));
 
   if (!s.is_valid())
     return;
 
-  for (FaviconMap::const_iterator i = favicon_map.begin();
-       i != favicon_map.end(); ++i) {
-    s.BindInt64(0, i->first);
-    if (s.Step()) {
-      favicon_base::FaviconUsageData usage;
-
-      usage.favicon_url = GURL(s.ColumnString(0));
-      if (!usage.favicon_url.is_valid())
-        continue;  // Don't bother importing favicons with invalid URLs.
+  favicon_base::FaviconUsageDataList favicons;
+  absl::optional<favicon_base::FaviconUsageData> usage;
+  int64_t icon_id = 0;
+  bool skip_icon = false;
+  while (s.Step() && !cancelled()) {
+    if (!usage || s.ColumnInt64(0) != icon_id) {
+      if (usage) {
+        favicons.push_back(std::move(*usage));
+        usage.reset();
+      }
+      if (favicons.size() >= kFaviconChunkSize) {
+        bridge_->SetFavicons(favicons);
+        favicons.clear();
+      }
 
-      std::vector<unsigned char> data;
-      s.ColumnBlobAsVector(1, &data);
-      if (data.empty())
-        continue;  // Data definitely invalid.
+      icon_id = s.ColumnInt64(0);
+      skip_icon = !LoadFaviconData(&s, &usage.emplace());
+      if (skip_icon)
+        usage.reset();
+    }
 
-      if (!importer::ReencodeFavicon(&data[0], data.size(), &usage.png_data))
-        continue;  // Unable to decode.
+    if (skip_icon)
+      continue;
 
-      usage.urls = i->second;
-      favicons->push_back(usage);
-    }
-    s.Reset(true);
+    usage->urls.insert(GURL(s.ColumnString(3)));
   }
+
+  if (usage)
+    favicons.push_back(std::move(*usage));
+
+  // Write favicons into profile.
+  if (!favicons.empty() && !cancelled())
+    bridge_->SetFavicons(favicons);
+}
+
+bool ChromeImporter::LoadFaviconData(sql::Statement* s,
+                                     favicon_base::FaviconUsageData* usage) {
+  usage->favicon_url = GURL(s->ColumnString(1));
+  if (!usage->favicon_url.is_valid())
+    return false;  // Don't bother importing favicons with invalid URLs.
+
+  std::vector<unsigned char> data;
+  s->ColumnBlobAsVector(2, &data);
+  if (data.empty())
+    return false;  // Data definitely invalid.
+
+  // Unable to decode otherwise.
+  return importer::ReencodeFavicon(&data[0], data.size(), &usage->png_data);
 }
 
 void ChromeImporter::RecursiveReadBookmarksFolder(
@@ -8,8 +8,6 @@
 
 #include <stdint.h>
 
-#include <map>
-#include <set>
 #include <string>
 #include <vector>
 
@@ -25,6 +23,7 @@ struct ImportedBookmarkEntry;
 
 namespace sql {
 class Database;
+class Statement;
 }
 
 class ChromeImporter : public Importer {
@@ -38,6 +37,10 @@ class ChromeImporter : public Importer {
                    uint16_t items,
                    ImporterBridge* bridge) override;
 
+  void set_history_chunk_size_for_testing(size_t history_chunk_size) {
+    history_chunk_size_ = history_chunk_size;
+  }
+
  protected:
   ~ChromeImporter() override;
 
@@ -51,18 +54,17 @@ class ChromeImporter : public Importer {
   base::FilePath source_path_;
 
  private:
-  // Multiple URLs can share the same favicon; this is a map
-  // of URLs -> IconIDs that we load as a temporary step before
-  // actually loading the icons.
-  typedef std::map<int64_t, std::set<GURL>> FaviconMap;
+  // Maximum number of history rows and favicons sent to the bridge at once.
+  static constexpr size_t kHistoryChunkSize = 1000;
+  static constexpr size_t kFaviconChunkSize = 100;
 
-  // Loads the urls associated with the favicons into favicon_map;
-  void ImportFaviconURLs(sql::Database* db, FaviconMap* favicon_map);
+  // Loads, reencodes and imports the favicons along with the urls using them.
+  void ImportFavicons(sql::Database* db);
 
-  // Loads and reencodes the individual favicons.
-  void LoadFaviconData(sql::Database* db,
-                       const FaviconMap& favicon_map,
-                       favicon_base::FaviconUsageDataList* favicons);
+  // Fills |usage| with the favicon of the current row of |s|. Returns false
+  // if the favicon is invalid.
+  bool LoadFaviconData(sql::Statement* s,
+                       favicon_base::FaviconUsageData* usage);
 
   void RecursiveReadBookmarksFolder(
       const base::Value::Dict* folder,
@@ -71,6 +73,7 @@ class ChromeImporter : public Importer {
       std::vector<ImportedBookmarkEntry>* bookmarks);
 
   std::u16string importer_name_;
+  size_t history_chunk_size_ = kHistoryChunkSize;
 };
 
 #endif  // BRAVE_UTILITY_IMPORTER_CHROME_IMPORTER_H_
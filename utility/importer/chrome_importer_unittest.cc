@@ -87,6 +87,28 @@ TEST_F(ChromeImporterTest, ImportHistory) {
   EXPECT_EQ("https://www.nytimes.com/", history[2].url.spec());
 }
 
+TEST_F(ChromeImporterTest, ImportHistoryInChunks) {
+  std::vector<ImporterURLRow> first_chunk;
+  std::vector<ImporterURLRow> second_chunk;
+
+  EXPECT_CALL(*bridge_, NotifyStarted());
+  EXPECT_CALL(*bridge_, NotifyItemStarted(importer::HISTORY));
+  EXPECT_CALL(*bridge_, SetHistoryItems(_, _))
+      .WillOnce(::testing::SaveArg<0>(&first_chunk))
+      .WillOnce(::testing::SaveArg<0>(&second_chunk));
+  EXPECT_CALL(*bridge_, NotifyItemEnded(importer::HISTORY));
+  EXPECT_CALL(*bridge_, NotifyEnded());
+
+  importer_->set_history_chunk_size_for_testing(2);
+  importer_->StartImport(profile_, importer::HISTORY, bridge_.get());
+
+  ASSERT_EQ(2u, first_chunk.size());
+  EXPECT_EQ("https://brave.com/", first_chunk[0].url.spec());
+  EXPECT_EQ("https://github.com/brave", first_chunk[1].url.spec());
+  ASSERT_EQ(1u, second_chunk.size());
+  EXPECT_EQ("https://www.nytimes.com/", second_chunk[0].url.spec());
+}
+
 TEST_F(ChromeImporterTest, ImportBookmarks) {
   std::vector<ImportedBookmarkEntry> bookmarks;
 
@@ -135,6 +157,7 @@ TEST_F(ChromeImporterTest, ImportFavicons) {
             favicons[2].favicon_url.spec());
   EXPECT_EQ("https://static.nytimes.com/favicon.ico",
             favicons[3].favicon_url.spec());
+  EXPECT_EQ(2u, favicons[3].urls.size());
 }
 
 // The mock keychain only works on macOS, so only run this test on macOS (for